@@ -36,28 +36,8 @@ bool blocktris_collision_can_place_piece(const game_board_t *board, piece_type_t
         return false;
     }
     
-    // Check each cell of the piece
-    for (int py = 0; py < PIECE_SIZE; py++) {
-        for (int px = 0; px < PIECE_SIZE; px++) {
-            if (blocktris_piece_is_cell_filled(piece_type, piece_rotation, px, py)) {
-                int board_x = piece_x + px;
-                int board_y = piece_y + py;
-                
-                // Check bounds
-                if (board_x < 0 || board_x >= BOARD_WIDTH || 
-                    board_y < 0 || board_y >= BOARD_HEIGHT) {
-                    return false;
-                }
-                
-                // Check if board cell is already occupied
-                if (game_board_is_cell_filled(board, board_x, board_y)) {
-                    return false;
-                }
-            }
-        }
-    }
-    
-    return true;
+    // Bounds and overlap are tested on the board bitboard in one pass
+    return game_board_piece_fits(board, piece_type, piece_rotation, piece_x, piece_y);
 }
 
 bool blocktris_collision_can_move_piece(const game_board_t *board, piece_type_t piece_type,
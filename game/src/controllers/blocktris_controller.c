@@ -4,207 +4,126 @@
  */
 
 #include "blocktris_controller.h"
-#include "blocktris_collision.h"
-#include "clock.h"
 #include "constants.h"
 
+/**
+ * Count a tick since an input was applied, stopping once its repeat is due
+ */
+static int count_repeat_tick(int ticks, int delay) {
+    return blocktris_controller_can_repeat_input(ticks, delay) ? ticks : ticks + 1;
+}
+
 void blocktris_controller_init(blocktris_controller_t *controller) {
     if (!controller) {
         return;
     }
     
-    controller->last_move_time = 0;
-    controller->last_rotate_time = 0;
-    controller->last_drop_time = 0;
+    controller->move_ticks = 0;
+    controller->rotate_ticks = 0;
     controller->left_held = false;
     controller->right_held = false;
-    controller->down_held = false;
     controller->space_held = false;
     controller->up_held = false;
+    controller->hold_held = false;
 }
 
-void blocktris_controller_update(blocktris_controller_t *controller, game_t *game, 
-                             keyboard_state_t *keyboard) {
-    if (!controller || !game || !keyboard) {
-        return;
-    }
-    
-    // Only process input if game is in playing state and not paused
-    if (game->current_screen != SCREEN_PLAYING || game->paused) {
-        return;
+sim_input_t blocktris_controller_update(blocktris_controller_t *controller, keyboard_state_t *keyboard) {
+    if (!controller || !keyboard) {
+        return 0;
     }
     
     // Handle all input types
-    blocktris_controller_handle_movement(controller, game, keyboard);
-    blocktris_controller_handle_rotation(controller, game, keyboard);
-    blocktris_controller_handle_soft_drop(controller, game, keyboard);
-    blocktris_controller_handle_hard_drop(controller, game, keyboard);
+    sim_input_t input = 0;
+    input |= blocktris_controller_handle_movement(controller, keyboard);
+    input |= blocktris_controller_handle_rotation(controller, keyboard);
+    input |= blocktris_controller_handle_soft_drop(controller, keyboard);
+    input |= blocktris_controller_handle_hard_drop(controller, keyboard);
+    input |= blocktris_controller_handle_hold(controller, keyboard);
+    return input;
 }
 
-void blocktris_controller_handle_movement(blocktris_controller_t *controller, game_t *game,
-                                      keyboard_state_t *keyboard) {
-    if (!controller || !game || !keyboard) {
-        return;
+sim_input_t blocktris_controller_handle_movement(blocktris_controller_t *controller, keyboard_state_t *keyboard) {
+    if (!controller || !keyboard) {
+        return 0;
     }
     
-    timestamp_ms_t current_time = get_clock_ticks_ms();
-    bool can_move = blocktris_controller_can_repeat_input(controller->last_move_time, MOVE_REPEAT_DELAY);
+    controller->move_ticks = count_repeat_tick(controller->move_ticks, MOVE_REPEAT_DELAY);
+    bool can_move = blocktris_controller_can_repeat_input(controller->move_ticks, MOVE_REPEAT_DELAY);
+    sim_input_t input = 0;
     
     // Handle left movement
     bool left_pressed = is_left_key_pressed(keyboard);
     if (left_pressed && (!controller->left_held || can_move)) {
-        if (blocktris_controller_move_piece(game, -1, 0)) {
-            controller->last_move_time = current_time;
-        }
+        input |= SIM_INPUT_LEFT;
+        controller->move_ticks = 0;
     }
     controller->left_held = left_pressed;
     
     // Handle right movement
     bool right_pressed = is_right_key_pressed(keyboard);
     if (right_pressed && (!controller->right_held || can_move)) {
-        if (blocktris_controller_move_piece(game, 1, 0)) {
-            controller->last_move_time = current_time;
-        }
+        input |= SIM_INPUT_RIGHT;
+        controller->move_ticks = 0;
     }
     controller->right_held = right_pressed;
+    
+    return input;
 }
 
-void blocktris_controller_handle_rotation(blocktris_controller_t *controller, game_t *game,
-                                      keyboard_state_t *keyboard) {
-    if (!controller || !game || !keyboard) {
-        return;
+sim_input_t blocktris_controller_handle_rotation(blocktris_controller_t *controller, keyboard_state_t *keyboard) {
+    if (!controller || !keyboard) {
+        return 0;
     }
     
-    timestamp_ms_t current_time = get_clock_ticks_ms();
-    bool can_rotate = blocktris_controller_can_repeat_input(controller->last_rotate_time, ROTATE_REPEAT_DELAY);
+    controller->rotate_ticks = count_repeat_tick(controller->rotate_ticks, ROTATE_REPEAT_DELAY);
+    bool can_rotate = blocktris_controller_can_repeat_input(controller->rotate_ticks, ROTATE_REPEAT_DELAY);
+    sim_input_t input = 0;
     
     // Handle rotation (up arrow for clockwise)
     bool up_pressed = is_up_key_pressed(keyboard);
     if (up_pressed && (!controller->up_held || can_rotate)) {
-        if (blocktris_controller_rotate_piece_clockwise(game)) {
-            controller->last_rotate_time = current_time;
-        }
+        input |= SIM_INPUT_ROTATE_CW;
+        controller->rotate_ticks = 0;
     }
     controller->up_held = up_pressed;
+    
+    return input;
 }
 
-void blocktris_controller_handle_soft_drop(blocktris_controller_t *controller, game_t *game,
-                                       const keyboard_state_t *keyboard) {
-    if (!controller || !game || !keyboard) {
-        return;
+sim_input_t blocktris_controller_handle_soft_drop(blocktris_controller_t *controller,
+                                                  const keyboard_state_t *keyboard) {
+    if (!controller || !keyboard || !keyboard->keys) {
+        return 0;
     }
     
-    // Handle soft drop (down arrow - using space for now since down key not available)
-    bool down_pressed = false; // Disabled for now until down key is implemented
-    if (down_pressed) {
-        // Override fall speed for faster dropping
-        game->fall_speed = FAST_FALL_SPEED;
-    } else if (controller->down_held) {
-        // Reset fall speed when key is released
-        game->fall_speed = INITIAL_FALL_SPEED - (game->level - 1) * SPEED_INCREASE_PER_LEVEL;
-        if (game->fall_speed < FAST_FALL_SPEED) {
-            game->fall_speed = FAST_FALL_SPEED;
-        }
-    }
-    controller->down_held = down_pressed;
+    // Handle soft drop (down arrow); the simulation speeds up gravity while it's held
+    return keyboard->keys[SDL_SCANCODE_DOWN] ? SIM_INPUT_SOFT_DROP : 0;
 }
 
-void blocktris_controller_handle_hard_drop(blocktris_controller_t *controller, game_t *game,
-                                       keyboard_state_t *keyboard) {
-    if (!controller || !game || !keyboard) {
-        return;
+sim_input_t blocktris_controller_handle_hard_drop(blocktris_controller_t *controller, keyboard_state_t *keyboard) {
+    if (!controller || !keyboard) {
+        return 0;
     }
     
     // Handle hard drop (space bar)
     bool space_pressed = is_space_key_pressed(keyboard);
-    if (space_pressed && !controller->space_held) {
-        int lines_dropped = blocktris_controller_hard_drop_piece(game);
-        
-        // Add score for hard drop
-        game->score += lines_dropped * POINTS_HARD_DROP;
-    }
+    sim_input_t input = space_pressed && !controller->space_held ? SIM_INPUT_HARD_DROP : 0;
     controller->space_held = space_pressed;
+    return input;
 }
 
-bool blocktris_controller_move_piece(game_t *game, int dx, int dy) {
-    if (!game || game->current_piece_type == PIECE_EMPTY) {
-        return false;
-    }
-    
-    // Check if movement is valid
-    if (blocktris_collision_can_move_piece(&game->board, game->current_piece_type,
-                                       game->current_piece_rotation,
-                                       game->current_piece_x, game->current_piece_y,
-                                       dx, dy)) {
-        game->current_piece_x += dx;
-        game->current_piece_y += dy;
-        return true;
-    }
-    
-    return false;
-}
-
-bool blocktris_controller_rotate_piece_clockwise(game_t *game) {
-    if (!game || game->current_piece_type == PIECE_EMPTY) {
-        return false;
-    }
-    
-    int new_rotation = (game->current_piece_rotation + 1) % 4;
-    int test_x = game->current_piece_x;
-    int test_y = game->current_piece_y;
-    
-    // Try wall kick
-    if (blocktris_collision_wall_kick_test(&game->board, game->current_piece_type,
-                                       game->current_piece_rotation, new_rotation,
-                                       &test_x, &test_y)) {
-        game->current_piece_rotation = new_rotation;
-        game->current_piece_x = test_x;
-        game->current_piece_y = test_y;
-        return true;
-    }
-    
-    return false;
-}
-
-bool blocktris_controller_rotate_piece_counter_clockwise(game_t *game) {
-    if (!game || game->current_piece_type == PIECE_EMPTY) {
-        return false;
-    }
-    
-    int new_rotation = (game->current_piece_rotation + 3) % 4; // +3 is same as -1 mod 4
-    int test_x = game->current_piece_x;
-    int test_y = game->current_piece_y;
-    
-    // Try wall kick
-    if (blocktris_collision_wall_kick_test(&game->board, game->current_piece_type,
-                                       game->current_piece_rotation, new_rotation,
-                                       &test_x, &test_y)) {
-        game->current_piece_rotation = new_rotation;
-        game->current_piece_x = test_x;
-        game->current_piece_y = test_y;
-        return true;
-    }
-    
-    return false;
-}
-
-int blocktris_controller_hard_drop_piece(game_t *game) {
-    if (!game || game->current_piece_type == PIECE_EMPTY) {
+sim_input_t blocktris_controller_handle_hold(blocktris_controller_t *controller, const keyboard_state_t *keyboard) {
+    if (!controller || !keyboard || !keyboard->keys) {
         return 0;
     }
     
-    int start_y = game->current_piece_y;
-    int drop_y = blocktris_collision_find_drop_position(&game->board, game->current_piece_type,
-                                                    game->current_piece_rotation,
-                                                    game->current_piece_x, start_y);
-    
-    game->current_piece_y = drop_y;
-    
-    // Return number of lines dropped
-    return drop_y - start_y;
+    // Handle hold (C key); the simulation allows one hold per piece
+    bool hold_pressed = keyboard->keys[SDL_SCANCODE_C] != 0;
+    sim_input_t input = hold_pressed && !controller->hold_held ? SIM_INPUT_HOLD : 0;
+    controller->hold_held = hold_pressed;
+    return input;
 }
 
-bool blocktris_controller_can_repeat_input(timestamp_ms_t last_time, int delay) {
-    timestamp_ms_t current_time = get_clock_ticks_ms();
-    return (current_time - last_time) >= (timestamp_ms_t)delay;
+bool blocktris_controller_can_repeat_input(int ticks, int delay) {
+    return ticks >= MS_TO_SIM_TICKS(delay);
 }
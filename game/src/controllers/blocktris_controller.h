@@ -2,8 +2,11 @@
  * @file blocktris_controller.h
  * @brief BlockTris game input controller
  *
- * Handles input processing for BlockTris game including piece movement,
- * rotation, and special actions like hard drop and pause.
+ * Turns the keyboard state into the simulation input of each tick: piece
+ * movement, rotation, and special actions like hard drop and hold. The
+ * simulation applies the input; the controller never touches the game.
+ * It is updated once per simulation tick, and held keys repeat after a
+ * number of ticks, so auto-repeat doesn't depend on the frame rate.
  */
 
 #ifndef BLOCKTRIS_CONTROLLER_H_
@@ -11,20 +14,20 @@
 
 #include "game.h"
 #include "keyboard.h"
+#include "blocktris_sim.h"
 #include <stdbool.h>
 
 /**
  * BlockTris input controller state
  */
 typedef struct {
-    timestamp_ms_t last_move_time;
-    timestamp_ms_t last_rotate_time;
-    timestamp_ms_t last_drop_time;
+    int move_ticks;   // Ticks since the last move
+    int rotate_ticks; // Ticks since the last rotation
     bool left_held;
     bool right_held;
-    bool down_held;
     bool space_held;
     bool up_held;
+    bool hold_held;
 } blocktris_controller_t;
 
 typedef blocktris_controller_t *blocktris_controller_ptr;
@@ -37,96 +40,67 @@ typedef blocktris_controller_t *blocktris_controller_ptr;
 void blocktris_controller_init(blocktris_controller_t *controller);
 
 /**
- * Update the controller state and process input
+ * Get the simulation input for one tick from the keyboard state; call once per tick
  *
  * @param controller Pointer to controller
- * @param game Pointer to game state
  * @param keyboard Pointer to keyboard state
+ * @return SIM_INPUT_* flags for the tick
  */
-void blocktris_controller_update(blocktris_controller_t *controller, game_t *game, 
-                             keyboard_state_t *keyboard);
+sim_input_t blocktris_controller_update(blocktris_controller_t *controller, keyboard_state_t *keyboard);
 
 /**
  * Handle piece movement input
  *
  * @param controller Pointer to controller
- * @param game Pointer to game state
  * @param keyboard Pointer to keyboard state
+ * @return SIM_INPUT_LEFT and/or SIM_INPUT_RIGHT, 0 if no move is due
  */
-void blocktris_controller_handle_movement(blocktris_controller_t *controller, game_t *game,
-                                      keyboard_state_t *keyboard);
+sim_input_t blocktris_controller_handle_movement(blocktris_controller_t *controller, keyboard_state_t *keyboard);
 
 /**
  * Handle piece rotation input
  *
  * @param controller Pointer to controller
- * @param game Pointer to game state
  * @param keyboard Pointer to keyboard state
+ * @return SIM_INPUT_ROTATE_CW, 0 if no rotation is due
  */
-void blocktris_controller_handle_rotation(blocktris_controller_t *controller, game_t *game,
-                                      keyboard_state_t *keyboard);
+sim_input_t blocktris_controller_handle_rotation(blocktris_controller_t *controller, keyboard_state_t *keyboard);
 
 /**
- * Handle soft drop input (down arrow)
+ * Handle soft drop input (down arrow), held for as long as the key is down
  *
  * @param controller Pointer to controller
- * @param game Pointer to game state
  * @param keyboard Pointer to keyboard state
+ * @return SIM_INPUT_SOFT_DROP while the key is down, 0 otherwise
  */
-void blocktris_controller_handle_soft_drop(blocktris_controller_t *controller, game_t *game,
-                                       const keyboard_state_t *keyboard);
+sim_input_t blocktris_controller_handle_soft_drop(blocktris_controller_t *controller,
+                                                  const keyboard_state_t *keyboard);
 
 /**
- * Handle hard drop input (space bar)
+ * Handle hard drop input (space bar), once per press
  *
  * @param controller Pointer to controller
- * @param game Pointer to game state
  * @param keyboard Pointer to keyboard state
+ * @return SIM_INPUT_HARD_DROP, 0 if the key isn't newly pressed
  */
-void blocktris_controller_handle_hard_drop(blocktris_controller_t *controller, game_t *game,
-                                       keyboard_state_t *keyboard);
+sim_input_t blocktris_controller_handle_hard_drop(blocktris_controller_t *controller, keyboard_state_t *keyboard);
 
 /**
- * Attempt to move the current piece
+ * Handle hold input (C key), once per press
  *
- * @param game Pointer to game state
- * @param dx X offset
- * @param dy Y offset
- * @return true if piece was moved, false if blocked
- */
-bool blocktris_controller_move_piece(game_t *game, int dx, int dy);
-
-/**
- * Attempt to rotate the current piece clockwise
- *
- * @param game Pointer to game state
- * @return true if piece was rotated, false if blocked
- */
-bool blocktris_controller_rotate_piece_clockwise(game_t *game);
-
-/**
- * Attempt to rotate the current piece counter-clockwise
- *
- * @param game Pointer to game state
- * @return true if piece was rotated, false if blocked
- */
-bool blocktris_controller_rotate_piece_counter_clockwise(game_t *game);
-
-/**
- * Perform hard drop (drop piece to bottom)
- *
- * @param game Pointer to game state
- * @return Number of lines dropped
+ * @param controller Pointer to controller
+ * @param keyboard Pointer to keyboard state
+ * @return SIM_INPUT_HOLD, 0 if the key isn't newly pressed
  */
-int blocktris_controller_hard_drop_piece(game_t *game);
+sim_input_t blocktris_controller_handle_hold(blocktris_controller_t *controller, const keyboard_state_t *keyboard);
 
 /**
- * Check if enough time has passed for repeated input
+ * Check if a held key is due to repeat
  *
- * @param last_time Last time the input was processed
- * @param delay Delay between repeated inputs
- * @return true if enough time has passed
+ * @param ticks Ticks since the input was last applied
+ * @param delay Delay between repeated inputs in milliseconds
+ * @return true if at least the delay has passed in simulation ticks
  */
-bool blocktris_controller_can_repeat_input(timestamp_ms_t last_time, int delay);
+bool blocktris_controller_can_repeat_input(int ticks, int delay);
 
 #endif // BLOCKTRIS_CONTROLLER_H_
@@ -9,6 +9,7 @@
 
 // Cache for generated rotations - computed on demand
 static bool rotation_cache[NUM_PIECE_TYPES][4][PIECE_SIZE][PIECE_SIZE];
+static blocktris_piece_masks_t masks_cache[NUM_PIECE_TYPES][4];
 static bool cache_initialized[NUM_PIECE_TYPES] = {false};
 
 // Piece colors for all 18 pentominoes (using available colors)
@@ -39,7 +40,6 @@ void blocktris_piece_init(blocktris_piece_t* piece) {
     piece->y = 0;
     piece->rotation = 0;
     piece->active = false;
-    piece->color = COLOR_WHITE;
 }
 
 color_t blocktris_piece_get_color(piece_type_t type) {
@@ -49,6 +49,62 @@ color_t blocktris_piece_get_color(piece_type_t type) {
     return piece_colors[type];
 }
 
+static void build_piece_masks(const bool shape[PIECE_SIZE][PIECE_SIZE], blocktris_piece_masks_t *masks) {
+    int min_x = PIECE_SIZE, max_x = -1;
+    int min_y = PIECE_SIZE, max_y = -1;
+    
+    // Find the bounding box of the shape
+    for (int y = 0; y < PIECE_SIZE; y++) {
+        for (int x = 0; x < PIECE_SIZE; x++) {
+            if (shape[y][x]) {
+                if (x < min_x) min_x = x;
+                if (x > max_x) max_x = x;
+                if (y < min_y) min_y = y;
+                if (y > max_y) max_y = y;
+            }
+        }
+    }
+    
+    for (int i = 0; i < PIECE_SIZE; i++) {
+        masks->rows[i] = 0;
+    }
+    
+    if (max_x < 0) {
+        masks->offset_x = 0;
+        masks->offset_y = 0;
+        masks->width = 0;
+        masks->height = 0;
+        return;
+    }
+    
+    // Pack each row of the bounding box into a bit mask
+    for (int y = min_y; y <= max_y; y++) {
+        for (int x = min_x; x <= max_x; x++) {
+            if (shape[y][x]) {
+                masks->rows[y - min_y] |= (uint8_t)(1u << (x - min_x));
+            }
+        }
+    }
+    
+    masks->offset_x = (int8_t)min_x;
+    masks->offset_y = (int8_t)min_y;
+    masks->width = (int8_t)(max_x - min_x + 1);
+    masks->height = (int8_t)(max_y - min_y + 1);
+}
+
+static void ensure_piece_cache(piece_type_t type) {
+    if (cache_initialized[type]) {
+        return;
+    }
+    
+    generate_pentomino_rotations(type, rotation_cache[type]);
+    for (int rotation = 0; rotation < 4; rotation++) {
+        build_piece_masks((const bool (*)[PIECE_SIZE])rotation_cache[type][rotation],
+                          &masks_cache[type][rotation]);
+    }
+    cache_initialized[type] = true;
+}
+
 const bool (*blocktris_piece_get_shape(piece_type_t type, int rotation))[PIECE_SIZE] {
     // Validate inputs
     if (type >= NUM_PIECE_TYPES || type == PIECE_EMPTY || rotation < 0) {
@@ -59,14 +115,28 @@ const bool (*blocktris_piece_get_shape(piece_type_t type, int rotation))[PIECE_S
     rotation = rotation % 4;
     
     // Initialize cache for this piece type if needed
-    if (!cache_initialized[type]) {
-        generate_pentomino_rotations(type, rotation_cache[type]);
-        cache_initialized[type] = true;
-    }
+    ensure_piece_cache(type);
     
     return rotation_cache[type][rotation];
 }
 
+void blocktris_piece_warm_cache(void) {
+    for (int type = 0; type < NUM_PIECE_TYPES; type++) {
+        ensure_piece_cache((piece_type_t)type);
+    }
+}
+
+const blocktris_piece_masks_t *blocktris_piece_get_masks(piece_type_t type, int rotation) {
+    // Validate inputs
+    if (type >= NUM_PIECE_TYPES || type == PIECE_EMPTY || rotation < 0) {
+        return NULL;
+    }
+    
+    ensure_piece_cache(type);
+    
+    return &masks_cache[type][rotation % 4];
+}
+
 void blocktris_piece_rotate_clockwise(blocktris_piece_t* piece) {
     piece->rotation = (piece->rotation + 1) % 4;
 }
@@ -86,11 +156,10 @@ piece_type_t blocktris_piece_random_type(void) {
 
 void blocktris_piece_reset(blocktris_piece_t* piece, piece_type_t type, int x, int y) {
     piece->type = type;
-    piece->x = x;
-    piece->y = y;
+    piece->x = (int16_t)x;
+    piece->y = (int16_t)y;
     piece->rotation = 0;
     piece->active = true;
-    piece->color = blocktris_piece_get_color(type);
 }
 
 bool blocktris_piece_is_cell_filled(piece_type_t type, int rotation, int x, int y) {
@@ -12,16 +12,30 @@
 #include "constants.h"
 #include "color.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /**
- * BlockTris piece structure
+ * Row masks for a piece shape, used by the board bitboard kernels.
+ * The masks are normalized so the shape's bounding box starts at bit 0 of rows[0];
+ * offset_x/offset_y give the bounding box position within the PIECE_SIZE grid.
+ */
+typedef struct {
+    uint8_t rows[PIECE_SIZE]; // Bit n set = column (offset_x + n) filled, unused rows are 0
+    int8_t offset_x;
+    int8_t offset_y;
+    int8_t width;
+    int8_t height;
+} blocktris_piece_masks_t;
+
+/**
+ * BlockTris piece structure, kept small because the simulation holds it by
+ * value and copies it every tick (the color comes from blocktris_piece_get_color)
  */
 typedef struct {
     piece_type_t type;
-    int rotation; // 0, 1, 2, or 3 (90 degree increments)
-    int x, y; // Position on the board
+    int16_t x, y; // Position on the board
+    int8_t rotation; // 0, 1, 2, or 3 (90 degree increments)
     bool active; // Whether this piece is currently in use
-    color_t color; // Color for rendering
 } blocktris_piece_t;
 
 typedef blocktris_piece_t *blocktris_piece_ptr;
@@ -42,6 +56,23 @@ void blocktris_piece_init(blocktris_piece_t *piece);
  */
 const bool (*blocktris_piece_get_shape(piece_type_t type, int rotation))[PIECE_SIZE];
 
+/**
+ * Build the shape and mask caches of every piece type up front
+ *
+ * The caches are otherwise filled on first use; warming them before
+ * simulations run on several threads keeps every later lookup read-only.
+ */
+void blocktris_piece_warm_cache(void);
+
+/**
+ * Get the normalized row masks for a piece type and rotation
+ *
+ * @param type Piece type
+ * @param rotation Rotation (0-3)
+ * @return Pointer to the row masks, or NULL for invalid piece types
+ */
+const blocktris_piece_masks_t *blocktris_piece_get_masks(piece_type_t type, int rotation);
+
 /**
  * Rotate a piece clockwise
  *
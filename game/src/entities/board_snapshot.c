@@ -0,0 +1,162 @@
+/**
+ * @file board_snapshot.c
+ * @brief Copy-on-write game board snapshots implementation
+ */
+
+#include "board_snapshot.h"
+#include <stdlib.h>
+#include <string.h>
+
+static board_row_chunk_t *acquire_chunk(board_snapshot_store_t *store) {
+    board_row_chunk_t *chunk = store->free_chunks;
+    
+    if (chunk) {
+        store->free_chunks = chunk->next_free;
+    } else {
+        chunk = malloc(sizeof(board_row_chunk_t));
+        if (!chunk) {
+            return NULL;
+        }
+        store->chunks_allocated++;
+    }
+    
+    chunk->refcount = 1;
+    chunk->next_free = NULL;
+    store->chunks_in_use++;
+    return chunk;
+}
+
+static board_row_chunk_t *retain_chunk(board_row_chunk_t *chunk) {
+    chunk->refcount++;
+    return chunk;
+}
+
+static void release_chunk(board_snapshot_store_t *store, board_row_chunk_t *chunk) {
+    if (--chunk->refcount > 0 || chunk == &store->empty_row) {
+        return;
+    }
+    
+    chunk->next_free = store->free_chunks;
+    store->free_chunks = chunk;
+    store->chunks_in_use--;
+}
+
+void board_snapshot_store_init(board_snapshot_store_t *store) {
+    if (!store) {
+        return;
+    }
+    
+    store->free_chunks = NULL;
+    store->chunks_allocated = 0;
+    store->chunks_in_use = 0;
+    
+    // Shared empty row, owned by the store and never recycled
+    store->empty_row.refcount = 1;
+    store->empty_row.next_free = NULL;
+    store->empty_row.bits = 0;
+    memset(store->empty_row.cells, BOARD_CELL_EMPTY, sizeof(store->empty_row.cells));
+}
+
+void board_snapshot_store_cleanup(board_snapshot_store_t *store) {
+    if (!store) {
+        return;
+    }
+    
+    while (store->free_chunks) {
+        board_row_chunk_t *next = store->free_chunks->next_free;
+        free(store->free_chunks);
+        store->free_chunks = next;
+    }
+    
+    store->chunks_allocated = store->chunks_in_use;
+}
+
+board_snapshot_t *board_snapshot_take(board_snapshot_store_t *store, game_board_t *board,
+                                      const board_snapshot_t *base) {
+    if (!store || !board) {
+        return NULL;
+    }
+    
+    board_snapshot_t *snapshot = malloc(sizeof(board_snapshot_t) +
+                                        (size_t)board->height * sizeof(board_row_chunk_t *));
+    if (!snapshot) {
+        return NULL;
+    }
+    
+    snapshot->refcount = 1;
+    snapshot->width = board->width;
+    snapshot->height = board->height;
+    
+    // A base of another size can't share rows
+    board_line_mask_t dirty = board->dirty_rows;
+    if (!base || base->width != board->width || base->height != board->height) {
+        dirty = BOARD_ROW_MASK(board->height);
+    }
+    
+    for (int y = 0; y < board->height; y++) {
+        if (!((dirty >> y) & 1)) {
+            snapshot->rows[y] = retain_chunk(base->rows[y]);
+            continue;
+        }
+        
+        if (board->rows[y] == 0) {
+            snapshot->rows[y] = retain_chunk(&store->empty_row);
+            continue;
+        }
+        
+        board_row_chunk_t *chunk = acquire_chunk(store);
+        if (!chunk) {
+            // Undo the rows taken so far
+            for (int i = 0; i < y; i++) {
+                release_chunk(store, snapshot->rows[i]);
+            }
+            free(snapshot);
+            return NULL;
+        }
+        
+        chunk->bits = board->rows[y];
+        memcpy(chunk->cells, &board->cells[y * board->width], (size_t)board->width * sizeof(board_cell_t));
+        snapshot->rows[y] = chunk;
+    }
+    
+    board->dirty_rows = 0;
+    return snapshot;
+}
+
+void board_snapshot_restore(const board_snapshot_t *snapshot, game_board_t *board) {
+    if (!snapshot || !board) {
+        return;
+    }
+    
+    if (board->width != snapshot->width || board->height != snapshot->height) {
+        game_board_init(board, snapshot->width, snapshot->height);
+    }
+    
+    for (int y = 0; y < snapshot->height; y++) {
+        const board_row_chunk_t *chunk = snapshot->rows[y];
+        board->rows[y] = chunk->bits;
+        memcpy(&board->cells[y * board->width], chunk->cells, (size_t)board->width * sizeof(board_cell_t));
+    }
+    
+    board->dirty_rows = 0;
+}
+
+board_snapshot_t *board_snapshot_retain(board_snapshot_t *snapshot) {
+    if (snapshot) {
+        snapshot->refcount++;
+    }
+    
+    return snapshot;
+}
+
+void board_snapshot_release(board_snapshot_store_t *store, board_snapshot_t *snapshot) {
+    if (!store || !snapshot || --snapshot->refcount > 0) {
+        return;
+    }
+    
+    for (int y = 0; y < snapshot->height; y++) {
+        release_chunk(store, snapshot->rows[y]);
+    }
+    
+    free(snapshot);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file board_snapshot.h
+ * @brief Copy-on-write game board snapshots
+ *
+ * A snapshot is an immutable view of a board made of reference-counted row
+ * chunks. Taking a snapshot against a previous one only allocates chunks for
+ * the rows marked dirty on the board since then (rows touched by piece
+ * placement or line clears); all other rows share the previous chunks.
+ * This keeps frequent snapshots for AI search, undo and replay seeking cheap.
+ */
+
+#ifndef BOARD_SNAPSHOT_H_
+#define BOARD_SNAPSHOT_H_
+
+#include "game_board.h"
+#include <stddef.h>
+
+/**
+ * Immutable, reference-counted board row
+ */
+typedef struct board_row_chunk_t {
+    int refcount;
+    struct board_row_chunk_t *next_free; // Free list link while unused
+    board_row_t bits;
+    board_cell_t cells[MAX_BOARD_WIDTH];
+} board_row_chunk_t;
+
+/**
+ * Immutable, reference-counted board snapshot
+ */
+typedef struct {
+    int refcount;
+    int width;
+    int height;
+    board_row_chunk_t *rows[]; // One chunk per board row
+} board_snapshot_t;
+
+typedef board_snapshot_t *board_snapshot_ptr;
+
+/**
+ * Snapshot store: recycles row chunks and shares a single empty row.
+ * A store is not thread-safe; use one per simulation thread.
+ */
+typedef struct {
+    board_row_chunk_t *free_chunks;
+    board_row_chunk_t empty_row;
+    size_t chunks_allocated; // Chunks obtained from the heap so far
+    size_t chunks_in_use;    // Chunks referenced by live snapshots
+} board_snapshot_store_t;
+
+typedef board_snapshot_store_t *board_snapshot_store_ptr;
+
+/**
+ * Initialize a snapshot store
+ *
+ * @param store Pointer to the store to initialize
+ */
+void board_snapshot_store_init(board_snapshot_store_t *store);
+
+/**
+ * Free the recycled chunks of a store (live snapshots must be released first)
+ *
+ * @param store Pointer to the store to clean up
+ */
+void board_snapshot_store_cleanup(board_snapshot_store_t *store);
+
+/**
+ * Take a snapshot of a board
+ *
+ * Rows that are not dirty on the board share their chunk with `base`, which
+ * must be the last snapshot taken from or restored into this board (or NULL
+ * to copy every row). Clears the board's dirty rows.
+ *
+ * @param store Pointer to the snapshot store
+ * @param board Pointer to the board to snapshot
+ * @param base Previous snapshot of the same board, or NULL
+ * @return New snapshot with a reference count of 1, or NULL on allocation failure
+ */
+board_snapshot_t *board_snapshot_take(board_snapshot_store_t *store, game_board_t *board,
+                                      const board_snapshot_t *base);
+
+/**
+ * Restore a board from a snapshot
+ *
+ * The board becomes an exact copy of the snapshot with no dirty rows, so the
+ * snapshot can be used as the base of the next board_snapshot_take.
+ *
+ * @param snapshot Pointer to the snapshot to restore
+ * @param board Pointer to the board to overwrite
+ */
+void board_snapshot_restore(const board_snapshot_t *snapshot, game_board_t *board);
+
+/**
+ * Add a reference to a snapshot
+ *
+ * @param snapshot Pointer to the snapshot
+ * @return The same snapshot
+ */
+board_snapshot_t *board_snapshot_retain(board_snapshot_t *snapshot);
+
+/**
+ * Drop a reference to a snapshot, recycling its chunks when unused
+ *
+ * @param store Pointer to the snapshot store the snapshot was taken from
+ * @param snapshot Pointer to the snapshot (may be NULL)
+ */
+void board_snapshot_release(board_snapshot_store_t *store, board_snapshot_t *snapshot);
+
+#endif // BOARD_SNAPSHOT_H_
@@ -7,148 +7,261 @@
 #include "blocktris_piece.h"
 #include <string.h>
 
-void game_board_init(game_board_t *board) {
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Test a piece bounding box at (left, top) against the bitboard.
+ * Bounds are checked once for the whole box; the row tests are a fixed-length
+ * AND/OR sequence (rows below the board are padding and always empty).
+ */
+static inline bool piece_fits_kernel(const game_board_t *board, const blocktris_piece_masks_t *masks,
+                                     int left, int top) {
+    if ((left | top) < 0 || left + masks->width > board->width || top + masks->height > board->height) {
+        return false;
+    }
+    
+    board_row_t overlap = 0;
+    for (int row = 0; row < PIECE_SIZE; row++) {
+        overlap |= board->rows[top + row] & ((board_row_t)masks->rows[row] << left);
+    }
+    
+    return overlap == 0;
+}
+
+// Garbage cells keep no piece type, so they get their own palette entry
+static const color_t GARBAGE_CELL_COLOR = GRAY(128);
+
+static inline board_cell_t *row_cells(game_board_t *board, int y) {
+    return &board->cells[y * board->width];
+}
+
+static void clear_row_cells(game_board_t *board, int y) {
+    memset(row_cells(board, y), BOARD_CELL_EMPTY, (size_t)board->width * sizeof(board_cell_t));
+}
+
+/**
+ * Copy the cells of one row into another (rows never overlap).
+ * Uses 32/16-byte vector copies when available, scalar memcpy otherwise.
+ */
+static inline void copy_row_cells(board_cell_t *dst, const board_cell_t *src, int width) {
+    size_t size = (size_t)width * sizeof(board_cell_t);
+    unsigned char *d = (unsigned char *)dst;
+    const unsigned char *s = (const unsigned char *)src;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for (; i + 32 <= size; i += 32) {
+        _mm256_storeu_si256((__m256i *)(d + i), _mm256_loadu_si256((const __m256i *)(s + i)));
+    }
+#elif defined(__SSE2__)
+    for (; i + 16 <= size; i += 16) {
+        _mm_storeu_si128((__m128i *)(d + i), _mm_loadu_si128((const __m128i *)(s + i)));
+    }
+#endif
+    
+    // Scalar tail (or the whole row without vector support)
+    memcpy(d + i, s + i, size - i);
+}
+
+/**
+ * Remove the rows set in clear_mask (bit y = row y) and move the surviving
+ * rows down in a single bottom-up sweep; freed rows at the top are emptied.
+ */
+static void compact_rows(game_board_t *board, board_line_mask_t clear_mask) {
+    if (clear_mask == 0) {
+        return;
+    }
+    
+    // Rows below the lowest cleared row keep their position
+    int lowest_cleared = board->height - 1;
+    while (!((clear_mask >> lowest_cleared) & 1)) {
+        lowest_cleared--;
+    }
+    
+    int dst = lowest_cleared;
+    for (int src = lowest_cleared; src >= 0; src--) {
+        if ((clear_mask >> src) & 1) {
+            continue;
+        }
+        
+        board->rows[dst] = board->rows[src];
+        copy_row_cells(row_cells(board, dst), row_cells(board, src), board->width);
+        dst--;
+    }
+    
+    // Every row up to the lowest cleared one has new contents
+    board->dirty_rows |= BOARD_ROW_MASK(lowest_cleared + 1);
+    
+    // Empty the rows freed at the top
+    for (; dst >= 0; dst--) {
+        board->rows[dst] = 0;
+        clear_row_cells(board, dst);
+    }
+}
+
+void game_board_init(game_board_t *board, int width, int height) {
     if (!board) {
         return;
     }
     
+    clamp_board_dimensions(&width, &height);
+    
+    board->width = width;
+    board->height = height;
+    board->full_row = BOARD_ROW_MASK(width);
+    
     game_board_reset(board);
 }
 
+void game_board_copy(game_board_t *dst, const game_board_t *src) {
+    if (!dst || !src || dst == src) {
+        return;
+    }
+    
+    dst->width = src->width;
+    dst->height = src->height;
+    dst->full_row = src->full_row;
+    
+    // Rows in use plus the empty padding below them
+    memcpy(dst->rows, src->rows, (size_t)src->height * sizeof(board_row_t));
+    memset(&dst->rows[src->height], 0, PIECE_SIZE * sizeof(board_row_t));
+    
+    memcpy(dst->cells, src->cells, (size_t)src->width * src->height * sizeof(board_cell_t));
+    dst->dirty_rows = src->dirty_rows;
+}
+
 void game_board_reset(game_board_t *board) {
     if (!board) {
         return;
     }
     
-    for (int y = 0; y < BOARD_HEIGHT; y++) {
-        for (int x = 0; x < BOARD_WIDTH; x++) {
-            board->cells[y][x].filled = false;
-            board->cells[y][x].piece_type = PIECE_EMPTY;
-            board->cells[y][x].color = COLOR_BLACK;
-        }
-    }
+    // Padding rows below the board must stay empty as well
+    memset(board->rows, 0, sizeof(board->rows));
+    memset(board->cells, BOARD_CELL_EMPTY, (size_t)board->width * board->height * sizeof(board_cell_t));
+    board->dirty_rows = BOARD_ROW_MASK(board->height);
 }
 
-void game_board_set_cell(game_board_t *board, int x, int y, piece_type_t piece_type, color_t color) {
-    if (!board || !game_board_is_position_valid(x, y)) {
+void game_board_set_cell(game_board_t *board, int x, int y, piece_type_t piece_type, board_cell_t flags) {
+    if (!board || !game_board_is_position_valid(board, x, y)) {
         return;
     }
     
-    board->cells[y][x].filled = true;
-    board->cells[y][x].piece_type = piece_type;
-    board->cells[y][x].color = color;
+    board->rows[y] |= (board_row_t)1 << x;
+    board->dirty_rows |= (board_line_mask_t)1 << y;
+    row_cells(board, y)[x] = (board_cell_t)((piece_type & BOARD_CELL_TYPE_MASK) | (flags & ~BOARD_CELL_TYPE_MASK));
 }
 
 void game_board_clear_cell(game_board_t *board, int x, int y) {
-    if (!board || !game_board_is_position_valid(x, y)) {
+    if (!board || !game_board_is_position_valid(board, x, y)) {
         return;
     }
     
-    board->cells[y][x].filled = false;
-    board->cells[y][x].piece_type = PIECE_EMPTY;
-    board->cells[y][x].color = COLOR_BLACK;
+    board->rows[y] &= ~((board_row_t)1 << x);
+    board->dirty_rows |= (board_line_mask_t)1 << y;
+    row_cells(board, y)[x] = BOARD_CELL_EMPTY;
+}
+
+board_cell_t game_board_get_cell(const game_board_t *board, int x, int y) {
+    if (!board || !game_board_is_position_valid(board, x, y)) {
+        return BOARD_CELL_EMPTY;
+    }
+    
+    return board->cells[y * board->width + x];
+}
+
+piece_type_t game_board_get_cell_type(const game_board_t *board, int x, int y) {
+    return BOARD_CELL_TYPE(game_board_get_cell(board, x, y));
 }
 
 bool game_board_is_cell_filled(const game_board_t *board, int x, int y) {
-    if (!board || !game_board_is_position_valid(x, y)) {
+    if (!board || !game_board_is_position_valid(board, x, y)) {
         return true; // Consider out-of-bounds as filled
     }
     
-    return board->cells[y][x].filled;
+    return (board->rows[y] >> x) & 1;
 }
 
-bool game_board_is_position_valid(int x, int y) {
-    return (x >= 0 && x < BOARD_WIDTH && y >= 0 && y < BOARD_HEIGHT);
+bool game_board_is_position_valid(const game_board_t *board, int x, int y) {
+    return (x >= 0 && x < board->width && y >= 0 && y < board->height);
 }
 
-bool game_board_is_line_complete(const game_board_t *board, int y) {
-    if (!board || y < 0 || y >= BOARD_HEIGHT) {
+bool game_board_piece_fits(const game_board_t *board, piece_type_t piece_type,
+                           int piece_rotation, int piece_x, int piece_y) {
+    if (!board) {
         return false;
     }
     
-    for (int x = 0; x < BOARD_WIDTH; x++) {
-        if (!board->cells[y][x].filled) {
-            return false;
-        }
+    const blocktris_piece_masks_t *masks = blocktris_piece_get_masks(piece_type, piece_rotation);
+    if (!masks) {
+        return true; // An empty piece has no cells to collide
     }
     
-    return true;
+    return piece_fits_kernel(board, masks, piece_x + masks->offset_x, piece_y + masks->offset_y);
+}
+
+bool game_board_is_line_complete(const game_board_t *board, int y) {
+    if (!board || y < 0 || y >= board->height) {
+        return false;
+    }
+    
+    return board->rows[y] == board->full_row;
 }
 
 void game_board_clear_line(game_board_t *board, int y) {
-    if (!board || y < 0 || y >= BOARD_HEIGHT) {
+    if (!board || y < 0 || y >= board->height) {
         return;
     }
     
     // Move all lines above down by one
-    for (int line = y; line > 0; line--) {
-        for (int x = 0; x < BOARD_WIDTH; x++) {
-            board->cells[line][x] = board->cells[line - 1][x];
-        }
-    }
-    
-    // Clear the top line
-    for (int x = 0; x < BOARD_WIDTH; x++) {
-        board->cells[0][x].filled = false;
-        board->cells[0][x].piece_type = PIECE_EMPTY;
-        board->cells[0][x].color = COLOR_BLACK;
-    }
+    compact_rows(board, (board_line_mask_t)1 << y);
 }
 
-int game_board_find_complete_lines(const game_board_t *board, int lines[4]) {
-    if (!board || !lines) {
+board_line_mask_t game_board_find_complete_lines(const game_board_t *board) {
+    if (!board) {
         return 0;
     }
     
-    int count = 0;
-    
-    // Check from bottom to top
-    for (int y = BOARD_HEIGHT - 1; y >= 0 && count < 4; y--) {
-        if (game_board_is_line_complete(board, y)) {
-            lines[count] = y;
-            count++;
-        }
+    // One branchless pass over the bitboard
+    board_line_mask_t complete = 0;
+    for (int y = 0; y < board->height; y++) {
+        complete |= (board_line_mask_t)(board->rows[y] == board->full_row) << y;
     }
     
-    return count;
+    return complete;
+}
+
+int game_board_count_lines(board_line_mask_t lines) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(lines);
+#else
+    // Parallel bit count
+    lines = lines - ((lines >> 1) & 0x5555555555555555ULL);
+    lines = (lines & 0x3333333333333333ULL) + ((lines >> 2) & 0x3333333333333333ULL);
+    lines = (lines + (lines >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((lines * 0x0101010101010101ULL) >> 56);
+#endif
 }
 
-void game_board_clear_lines(game_board_t *board, const int lines[], int num_lines) {
-    if (!board || !lines || num_lines <= 0) {
+void game_board_clear_lines(game_board_t *board, board_line_mask_t lines) {
+    if (!board) {
         return;
     }
     
-    // Sort lines in descending order to clear from bottom to top
-    int sorted_lines[4];
-    for (int i = 0; i < num_lines; i++) {
-        sorted_lines[i] = lines[i];
-    }
-    
-    // Simple bubble sort for small array
-    for (int i = 0; i < num_lines - 1; i++) {
-        for (int j = 0; j < num_lines - i - 1; j++) {
-            if (sorted_lines[j] < sorted_lines[j + 1]) {
-                int temp = sorted_lines[j];
-                sorted_lines[j] = sorted_lines[j + 1];
-                sorted_lines[j + 1] = temp;
-            }
-        }
-    }
-    
-    // Clear lines from bottom to top
-    for (int i = 0; i < num_lines; i++) {
-        game_board_clear_line(board, sorted_lines[i]);
-    }
+    // Ignore rows outside the board, then move the surviving rows down in one pass
+    board_line_mask_t valid_rows = BOARD_ROW_MASK(board->height);
+    compact_rows(board, lines & valid_rows);
 }
 
-void game_board_place_piece(game_board_t *board, piece_type_t piece_type, 
+void game_board_place_piece(game_board_t *board, piece_type_t piece_type,
                            int piece_rotation, int piece_x, int piece_y) {
     if (!board) {
         return;
     }
     
-    color_t piece_color = blocktris_piece_get_color(piece_type);
-    
     // Place each filled cell of the piece on the board
     for (int py = 0; py < PIECE_SIZE; py++) {
         for (int px = 0; px < PIECE_SIZE; px++) {
@@ -156,20 +269,63 @@ void game_board_place_piece(game_board_t *board, piece_type_t piece_type,
                 int board_x = piece_x + px;
                 int board_y = piece_y + py;
                 
-                if (game_board_is_position_valid(board_x, board_y)) {
-                    game_board_set_cell(board, board_x, board_y, piece_type, piece_color);
+                if (game_board_is_position_valid(board, board_x, board_y)) {
+                    game_board_set_cell(board, board_x, board_y, piece_type, BOARD_CELL_LOCKED);
                 }
             }
         }
     }
 }
 
+bool game_board_add_garbage_rows(game_board_t *board, int count, int hole_x) {
+    if (!board || count <= 0) {
+        return false;
+    }
+    
+    if (count > board->height) {
+        count = board->height;
+    }
+    hole_x = ((hole_x % board->width) + board->width) % board->width;
+    
+    // Anything in the rows about to leave the top tops the player out
+    board_row_t overflow = 0;
+    for (int y = 0; y < count; y++) {
+        overflow |= board->rows[y];
+    }
+    
+    // Shift the stack up: one move for the row masks, one for the packed cells
+    int kept_rows = board->height - count;
+    memmove(board->rows, &board->rows[count], (size_t)kept_rows * sizeof(board_row_t));
+    memmove(board->cells, row_cells(board, count), (size_t)kept_rows * board->width * sizeof(board_cell_t));
+    
+    // Fill the new bottom rows, leaving the hole open
+    board_row_t garbage_row = board->full_row & ~((board_row_t)1 << hole_x);
+    for (int y = kept_rows; y < board->height; y++) {
+        board_cell_t *cells = row_cells(board, y);
+        board->rows[y] = garbage_row;
+        memset(cells, BOARD_CELL_GARBAGE, (size_t)board->width * sizeof(board_cell_t));
+        cells[hole_x] = BOARD_CELL_EMPTY;
+    }
+    
+    // Every row moved
+    board->dirty_rows |= BOARD_ROW_MASK(board->height);
+    
+    return overflow != 0;
+}
+
 color_t game_board_get_cell_color(const game_board_t *board, int x, int y) {
-    if (!board || !game_board_is_position_valid(x, y)) {
+    return game_board_cell_color(game_board_get_cell(board, x, y));
+}
+
+color_t game_board_cell_color(board_cell_t cell) {
+    if (BOARD_CELL_TYPE(cell) == PIECE_EMPTY) {
         return COLOR_BLACK;
     }
+    if (BOARD_CELL_TYPE(cell) == BOARD_CELL_GARBAGE_TYPE) {
+        return GARBAGE_CELL_COLOR;
+    }
     
-    return board->cells[y][x].color;
+    return blocktris_piece_get_color(BOARD_CELL_TYPE(cell));
 }
 
 bool game_board_is_game_over(const game_board_t *board) {
@@ -178,13 +334,10 @@ bool game_board_is_game_over(const game_board_t *board) {
     }
     
     // Check if any cell in the top few rows is filled
+    board_row_t top_rows = 0;
     for (int y = 0; y < 4; y++) { // Check top 4 rows for game over
-        for (int x = 0; x < BOARD_WIDTH; x++) {
-            if (board->cells[y][x].filled) {
-                return true;
-            }
-        }
+        top_rows |= board->rows[y];
     }
     
-    return false;
+    return top_rows != 0;
 }
@@ -4,6 +4,10 @@
  *
  * Defines the game board structure and provides functions for
  * board management, line clearing, and piece placement.
+ *
+ * Board dimensions are chosen at runtime (up to MAX_BOARD_WIDTH x MAX_BOARD_HEIGHT).
+ * Occupancy is kept in a bitboard with one 64-bit mask per row, which the
+ * collision and line detection kernels work on directly.
  */
 
 #ifndef GAME_BOARD_H_
@@ -12,21 +16,53 @@
 #include "constants.h"
 #include "color.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /**
- * Game board cell structure
+ * Occupancy mask for a single board row (bit x set = column x filled)
  */
-typedef struct {
-    bool filled;
-    piece_type_t piece_type;
-    color_t color;
-} board_cell_t;
+typedef uint64_t board_row_t;
+
+/**
+ * Mask with the low `width` bits set (a completely filled row)
+ */
+#define BOARD_ROW_MASK(width) \
+    ((width) >= 64 ? ~(board_row_t)0 : (((board_row_t)1 << (width)) - 1))
+
+/**
+ * Set of board rows (bit y set = row y), enough for MAX_BOARD_HEIGHT rows
+ */
+typedef uint64_t board_line_mask_t;
+
+/**
+ * Packed game board cell: piece type in the low 5 bits, flags in the rest.
+ * Empty cells hold PIECE_EMPTY and garbage cells a type of their own; the
+ * cell color is resolved from the piece palette when rendering.
+ */
+typedef uint8_t board_cell_t;
+
+#define BOARD_CELL_TYPE_MASK 0x1F
+#define BOARD_CELL_LOCKED 0x20 // Cell belongs to a piece locked on the board
+#define BOARD_CELL_EMPTY ((board_cell_t)PIECE_EMPTY)
+#define BOARD_CELL_GARBAGE_TYPE ((piece_type_t)(PIECE_EMPTY + 1)) // Filled, but by no piece
+#define BOARD_CELL_GARBAGE ((board_cell_t)BOARD_CELL_GARBAGE_TYPE) // Cell of a garbage row
+#define BOARD_CELL_TYPE(cell) ((piece_type_t)((cell) & BOARD_CELL_TYPE_MASK))
 
 /**
  * Game board structure
  */
 typedef struct {
-    board_cell_t cells[BOARD_HEIGHT][BOARD_WIDTH];
+    int width;
+    int height;
+    board_row_t full_row; // BOARD_ROW_MASK(width)
+    // Occupancy bitboard; the PIECE_SIZE extra rows stay empty so kernels can
+    // test a whole piece without bounds checks per row
+    board_row_t rows[MAX_BOARD_HEIGHT + PIECE_SIZE];
+    // Cells packed row by row with a stride of `width`, so only the first
+    // width * height bytes are in use
+    board_cell_t cells[MAX_BOARD_HEIGHT * MAX_BOARD_WIDTH];
+    // Rows changed since the last snapshot taken from (or restored into) this board
+    board_line_mask_t dirty_rows;
 } game_board_t;
 
 typedef game_board_t *game_board_ptr;
@@ -35,8 +71,18 @@ typedef game_board_t *game_board_ptr;
  * Initialize the game board
  *
  * @param board Pointer to the board to initialize
+ * @param width Board width in cells (clamped to MIN_BOARD_WIDTH..MAX_BOARD_WIDTH)
+ * @param height Board height in cells (clamped to MIN_BOARD_HEIGHT..MAX_BOARD_HEIGHT)
+ */
+void game_board_init(game_board_t *board, int width, int height);
+
+/**
+ * Copy a board, touching only the rows and cells in use
+ *
+ * @param dst Pointer to the destination board
+ * @param src Pointer to the source board
  */
-void game_board_init(game_board_t *board);
+void game_board_copy(game_board_t *dst, const game_board_t *src);
 
 /**
  * Reset the game board to empty state
@@ -51,10 +97,10 @@ void game_board_reset(game_board_t *board);
  * @param board Pointer to the board
  * @param x X coordinate
  * @param y Y coordinate
- * @param piece_type Type of piece to place
- * @param color Color of the cell
+ * @param piece_type Type of piece to place (BOARD_CELL_GARBAGE_TYPE for garbage)
+ * @param flags Cell flags (BOARD_CELL_LOCKED)
  */
-void game_board_set_cell(game_board_t *board, int x, int y, piece_type_t piece_type, color_t color);
+void game_board_set_cell(game_board_t *board, int x, int y, piece_type_t piece_type, board_cell_t flags);
 
 /**
  * Clear a cell on the board
@@ -65,6 +111,27 @@ void game_board_set_cell(game_board_t *board, int x, int y, piece_type_t piece_t
  */
 void game_board_clear_cell(game_board_t *board, int x, int y);
 
+/**
+ * Get the packed value of a cell
+ *
+ * @param board Pointer to the board
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @return Packed cell (BOARD_CELL_EMPTY for out-of-bounds positions)
+ */
+board_cell_t game_board_get_cell(const game_board_t *board, int x, int y);
+
+/**
+ * Get the piece type stored in a cell
+ *
+ * @param board Pointer to the board
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @return Piece type of the cell, BOARD_CELL_GARBAGE_TYPE for garbage, PIECE_EMPTY for empty or
+ *         out-of-bounds cells
+ */
+piece_type_t game_board_get_cell_type(const game_board_t *board, int x, int y);
+
 /**
  * Check if a cell is filled
  *
@@ -78,11 +145,25 @@ bool game_board_is_cell_filled(const game_board_t *board, int x, int y);
 /**
  * Check if a position is valid (within board bounds)
  *
+ * @param board Pointer to the board
  * @param x X coordinate
  * @param y Y coordinate
  * @return true if position is valid, false otherwise
  */
-bool game_board_is_position_valid(int x, int y);
+bool game_board_is_position_valid(const game_board_t *board, int x, int y);
+
+/**
+ * Check if a piece fits on the board (inside the bounds and not overlapping filled cells)
+ *
+ * @param board Pointer to the board
+ * @param piece_type Type of piece to test
+ * @param piece_rotation Rotation of the piece
+ * @param piece_x X position of the piece
+ * @param piece_y Y position of the piece
+ * @return true if the piece fits, false otherwise
+ */
+bool game_board_piece_fits(const game_board_t *board, piece_type_t piece_type,
+                           int piece_rotation, int piece_x, int piece_y);
 
 /**
  * Check if a line is complete (all cells filled)
@@ -105,19 +186,25 @@ void game_board_clear_line(game_board_t *board, int y);
  * Find all complete lines
  *
  * @param board Pointer to the board
- * @param lines Array to store line indices (size 4)
- * @return Number of complete lines found
+ * @return Mask of complete lines (bit y set = line y complete), 0 if none
+ */
+board_line_mask_t game_board_find_complete_lines(const game_board_t *board);
+
+/**
+ * Count the lines in a line mask
+ *
+ * @param lines Mask of lines
+ * @return Number of lines set in the mask
  */
-int game_board_find_complete_lines(const game_board_t *board, int lines[4]);
+int game_board_count_lines(board_line_mask_t lines);
 
 /**
  * Clear multiple lines at once
  *
  * @param board Pointer to the board
- * @param lines Array of line indices to clear
- * @param num_lines Number of lines to clear
+ * @param lines Mask of lines to clear (bit y set = clear line y)
  */
-void game_board_clear_lines(game_board_t *board, const int lines[], int num_lines);
+void game_board_clear_lines(game_board_t *board, board_line_mask_t lines);
 
 /**
  * Place a piece on the board
@@ -128,11 +215,24 @@ void game_board_clear_lines(game_board_t *board, const int lines[], int num_line
  * @param piece_x X position of the piece
  * @param piece_y Y position of the piece
  */
-void game_board_place_piece(game_board_t *board, piece_type_t piece_type, 
+void game_board_place_piece(game_board_t *board, piece_type_t piece_type,
                            int piece_rotation, int piece_x, int piece_y);
 
 /**
- * Get the color of a cell
+ * Push garbage rows in from the bottom, moving the whole stack up
+ *
+ * The row bitboard is shifted up by `count` rows in one move; each new row
+ * is filled except for the hole column.
+ *
+ * @param board Pointer to the board
+ * @param count Number of garbage rows (clamped to the board height)
+ * @param hole_x Empty column of the garbage rows (taken modulo the board width)
+ * @return true if filled cells were pushed off the top of the board, false otherwise
+ */
+bool game_board_add_garbage_rows(game_board_t *board, int count, int hole_x);
+
+/**
+ * Get the color of a cell, resolved from the piece palette
  *
  * @param board Pointer to the board
  * @param x X coordinate
@@ -141,6 +241,14 @@ void game_board_place_piece(game_board_t *board, piece_type_t piece_type,
  */
 color_t game_board_get_cell_color(const game_board_t *board, int x, int y);
 
+/**
+ * Resolve the color of a packed cell from the piece palette
+ *
+ * @param cell Packed cell
+ * @return Color of the cell
+ */
+color_t game_board_cell_color(board_cell_t cell);
+
 /**
  * Check if the board has reached the top (game over condition)
  *
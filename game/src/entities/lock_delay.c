@@ -0,0 +1,58 @@
+/**
+ * @file lock_delay.c
+ * @brief Lock delay with move reset implementation
+ */
+
+#include "lock_delay.h"
+
+void lock_delay_init(lock_delay_t *lock, int delay_ticks, int reset_limit) {
+    if (!lock) {
+        return;
+    }
+    
+    lock->delay_ticks = delay_ticks > 0 ? delay_ticks : 0;
+    lock->reset_limit = reset_limit > 0 ? reset_limit : 0;
+    lock_delay_start_piece(lock);
+}
+
+void lock_delay_start_piece(lock_delay_t *lock) {
+    if (!lock) {
+        return;
+    }
+    
+    lock->ticks = 0;
+    lock->resets = 0;
+    lock->lowest_row = LOCK_DELAY_NO_ROW;
+}
+
+void lock_delay_on_move(lock_delay_t *lock) {
+    if (!lock) {
+        return;
+    }
+    
+    // Only a grounded piece has a delay to restart
+    if (lock->ticks > 0 && lock->resets < lock->reset_limit) {
+        lock->ticks = 0;
+        lock->resets++;
+    }
+}
+
+bool lock_delay_step(lock_delay_t *lock, bool grounded, int row) {
+    if (!lock) {
+        return grounded;
+    }
+    
+    // Falling further than ever before gives the delay and the resets back
+    if (row > lock->lowest_row) {
+        lock->lowest_row = row;
+        lock->ticks = 0;
+        lock->resets = 0;
+    }
+    
+    if (!grounded) {
+        return false;
+    }
+    
+    lock->ticks++;
+    return lock->ticks > lock->delay_ticks;
+}
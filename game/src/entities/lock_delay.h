@@ -0,0 +1,73 @@
+/**
+ * @file lock_delay.h
+ * @brief Lock delay with move reset, counted in simulation ticks
+ *
+ * A piece that can't fall any further only locks after it has rested on the
+ * stack for a number of ticks. Moving or rotating it restarts the delay, up
+ * to a limited number of resets per piece. Only falling to a row lower than
+ * any it reached before gives the delay and the resets back; a piece kicked
+ * upwards keeps what it has used, so it can't be stalled forever.
+ * Everything is counted in simulation ticks, so the same inputs always lock
+ * on the same tick.
+ */
+
+#ifndef LOCK_DELAY_H_
+#define LOCK_DELAY_H_
+
+#include <limits.h>
+#include <stdbool.h>
+
+// Lowest row of a piece that hasn't been stepped yet
+#define LOCK_DELAY_NO_ROW INT_MIN
+
+/**
+ * Lock delay state of the current piece
+ */
+typedef struct {
+    int delay_ticks; // Ticks a grounded piece waits before locking
+    int reset_limit; // Move/rotate resets allowed per piece
+    int ticks;       // Ticks spent grounded since the last reset
+    int resets;      // Resets used by the current piece
+    int lowest_row;  // Lowest row the current piece has reached (LOCK_DELAY_NO_ROW before its first step)
+} lock_delay_t;
+
+typedef lock_delay_t *lock_delay_ptr;
+
+/**
+ * Initialize the lock delay
+ *
+ * @param lock Pointer to the lock delay to initialize
+ * @param delay_ticks Ticks a grounded piece waits before locking (0 locks on landing)
+ * @param reset_limit Move/rotate resets allowed per piece
+ */
+void lock_delay_init(lock_delay_t *lock, int delay_ticks, int reset_limit);
+
+/**
+ * Start tracking a new piece
+ *
+ * @param lock Pointer to the lock delay
+ */
+void lock_delay_start_piece(lock_delay_t *lock);
+
+/**
+ * Notify a successful move or rotation; restarts the delay of a grounded
+ * piece while resets remain
+ *
+ * @param lock Pointer to the lock delay
+ */
+void lock_delay_on_move(lock_delay_t *lock);
+
+/**
+ * Advance one simulation tick
+ *
+ * Ticks in the air neither count towards locking nor restart the delay;
+ * only reaching a new lowest row does.
+ *
+ * @param lock Pointer to the lock delay
+ * @param grounded Whether the piece can't fall any further
+ * @param row Row the piece is on
+ * @return true if the piece must lock now
+ */
+bool lock_delay_step(lock_delay_t *lock, bool grounded, int row);
+
+#endif // LOCK_DELAY_H_
@@ -0,0 +1,72 @@
+/**
+ * @file piece_queue.c
+ * @brief Seeded preview queue of upcoming piece types implementation
+ */
+
+#include "piece_queue.h"
+#include "utils.h"
+
+#define QUEUE_INDEX(queue, i) (((queue)->head + (i)) & (PIECE_QUEUE_CAPACITY - 1))
+
+/**
+ * Append a batch of random piece types
+ */
+static void refill(piece_queue_t *queue) {
+    for (int i = 0; i < PIECE_QUEUE_BATCH; i++) {
+        uint64_t r = utils_next_random(&queue->rng_state);
+        queue->types[QUEUE_INDEX(queue, queue->count)] = (uint8_t)((r >> 32) % NUM_PIECE_TYPES);
+        queue->count++;
+    }
+    
+    queue->generated += PIECE_QUEUE_BATCH;
+}
+
+void piece_queue_init(piece_queue_t *queue, int depth, uint64_t seed) {
+    if (!queue) {
+        return;
+    }
+    
+    if (depth < PIECE_QUEUE_MIN_DEPTH) {
+        depth = PIECE_QUEUE_MIN_DEPTH;
+    } else if (depth > PIECE_QUEUE_MAX_DEPTH) {
+        depth = PIECE_QUEUE_MAX_DEPTH;
+    }
+    
+    queue->head = 0;
+    queue->count = 0;
+    queue->depth = (uint8_t)depth;
+    queue->seed = seed;
+    // Mix the seed so small seeds don't start in a low-entropy state
+    queue->rng_state = (seed ^ 0x9E3779B97F4A7C15ULL) | 1;
+    queue->generated = 0;
+    
+    refill(queue);
+}
+
+piece_type_t piece_queue_pop(piece_queue_t *queue) {
+    if (!queue || queue->count == 0) {
+        return PIECE_EMPTY;
+    }
+    
+    piece_type_t type = (piece_type_t)queue->types[queue->head];
+    queue->head = (uint8_t)QUEUE_INDEX(queue, 1);
+    queue->count--;
+    
+    if (queue->count < queue->depth) {
+        refill(queue);
+    }
+    
+    return type;
+}
+
+piece_type_t piece_queue_peek(const piece_queue_t *queue, int index) {
+    if (!queue || index < 0 || index >= queue->count) {
+        return PIECE_EMPTY;
+    }
+    
+    return (piece_type_t)queue->types[QUEUE_INDEX(queue, index)];
+}
+
+int piece_queue_lookahead(const piece_queue_t *queue) {
+    return queue ? queue->count : 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file piece_queue.h
+ * @brief Seeded preview queue of upcoming piece types
+ *
+ * Upcoming pieces are generated ahead of time in batches from a seeded
+ * random number generator and kept in a ring buffer. The same seed always
+ * produces the same sequence, so planners and replays can look ahead or
+ * verify pieces without calling the generator on demand.
+ */
+
+#ifndef PIECE_QUEUE_H_
+#define PIECE_QUEUE_H_
+
+#include "constants.h"
+#include <stdint.h>
+
+#define PIECE_QUEUE_MIN_DEPTH 1
+#define PIECE_QUEUE_MAX_DEPTH 7
+#define DEFAULT_PIECE_QUEUE_DEPTH 3
+
+// Piece types generated per refill
+#define PIECE_QUEUE_BATCH 8
+
+// Ring buffer size (power of two, holds a full batch on top of a visible queue)
+#define PIECE_QUEUE_CAPACITY 16
+
+/**
+ * Preview queue structure
+ */
+typedef struct {
+    uint8_t types[PIECE_QUEUE_CAPACITY]; // Ring buffer of piece_type_t
+    uint8_t head;  // Index of the next piece
+    uint8_t count; // Pieces generated and not yet popped (>= depth)
+    uint8_t depth; // Pieces shown in the preview
+    uint64_t seed; // Seed the sequence started from
+    uint64_t rng_state;
+    uint32_t generated; // Total pieces generated since init
+} piece_queue_t;
+
+typedef piece_queue_t *piece_queue_ptr;
+
+/**
+ * Initialize the queue and generate the first batch
+ *
+ * @param queue Pointer to the queue to initialize
+ * @param depth Preview depth (clamped to PIECE_QUEUE_MIN_DEPTH..PIECE_QUEUE_MAX_DEPTH)
+ * @param seed Seed of the piece sequence
+ */
+void piece_queue_init(piece_queue_t *queue, int depth, uint64_t seed);
+
+/**
+ * Take the next piece type, refilling the queue with a new batch when it
+ * runs shorter than its depth
+ *
+ * @param queue Pointer to the queue
+ * @return Next piece type
+ */
+piece_type_t piece_queue_pop(piece_queue_t *queue);
+
+/**
+ * Look at an upcoming piece without taking it
+ *
+ * @param queue Pointer to the queue
+ * @param index 0 for the next piece, 1 for the one after, ...
+ * @return Piece type, PIECE_EMPTY if index is beyond the generated pieces
+ */
+piece_type_t piece_queue_peek(const piece_queue_t *queue, int index);
+
+/**
+ * Get the number of pieces that can be peeked (at least the depth)
+ *
+ * @param queue Pointer to the queue
+ * @return Number of generated pieces not yet popped
+ */
+int piece_queue_lookahead(const piece_queue_t *queue);
+
+#endif // PIECE_QUEUE_H_
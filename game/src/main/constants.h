@@ -12,64 +12,80 @@
 // Screen height scale factor (window will be 90% of actual screen height)
 #define SCREEN_HEIGHT_SCALE 0.9
 
-// BlockTris board dimensions (reduced width to fit window better)
-#define BOARD_WIDTH 12
-#define BOARD_HEIGHT 30
+// Default BlockTris board dimensions (reduced width to fit window better)
+#define DEFAULT_BOARD_WIDTH 12
+#define DEFAULT_BOARD_HEIGHT 30
+
+// Board dimension limits (each board row is stored as a 64-bit occupancy mask)
+#define MIN_BOARD_WIDTH PIECE_SIZE
+#define MIN_BOARD_HEIGHT (PIECE_SIZE * 2)
+#define MAX_BOARD_WIDTH 64
+#define MAX_BOARD_HEIGHT 64
 
 // Piece dimensions
 #define PIECE_SIZE 5 // 5x5 grid for each piece
 
-// Dynamic sizing - calculated at runtime based on screen dimensions
-extern int screen_width;
-extern int screen_height;
-extern int window_width;
-extern int window_height;
-extern int cell_size;
-extern int field_width;
-extern int field_height;
-extern int ui_panel_width;
-extern int ui_margin;
-extern int board_offset_x;
-extern int board_offset_y;
-
-// Macros to use the dynamic values
-#define LOGICAL_WIDTH window_width
-#define LOGICAL_HEIGHT window_height
-#define CELL_SIZE cell_size
-#define FIELD_WIDTH field_width
-#define FIELD_HEIGHT field_height
-#define UI_PANEL_WIDTH ui_panel_width
-#define UI_MARGIN ui_margin
-#define BOARD_OFFSET_X board_offset_x
-#define BOARD_OFFSET_Y board_offset_y
-
-// Function to calculate dynamic sizing based on actual screen dimensions
-void calculate_window_dimensions(int screen_width, int screen_height);
+// Fixed-point board coordinates for drawing between cells: SUBCELL_ONE units per cell
+#define SUBCELL_BITS 8
+#define SUBCELL_ONE (1 << SUBCELL_BITS)
+
+// Board dimensions are a runtime option (game_config_t); each game_board_t carries its own
+
+// Function to clamp board dimensions to the supported limits
+void clamp_board_dimensions(int *width, int *height);
+
+// Screen layout (cell size, board offsets, side panel) is calculated per window in game_layout.h
+#define LAYOUT_SETTLE_MS 250 // Window size held this long before the background is resampled to it
 
 // Game timing
 #define FPS 60
 #define FRAME_DELAY (1000 / FPS)
 
+// Simulation clock: gameplay advances in fixed ticks independent of the frame rate
+#define SIM_TICK_RATE 100 // Ticks per second
+#define SIM_TICK_MS (1000 / SIM_TICK_RATE)
+#define MS_TO_SIM_TICKS(ms) (((ms) + SIM_TICK_MS - 1) / SIM_TICK_MS)
+#define MAX_SIM_TICKS_PER_FRAME 10 // Drop the backlog after a stall instead of fast-forwarding
+
 // Border size around the game board
 #define BORDER_SIZE 2
 
-// UI positioning
-#define NEXT_PIECE_X (BOARD_OFFSET_X + FIELD_WIDTH + UI_MARGIN)
-#define NEXT_PIECE_Y (BOARD_OFFSET_Y + UI_MARGIN)
-#define NEXT_PIECE_SIZE (CELL_SIZE * 3)
-#define SCORE_X (NEXT_PIECE_X)
-#define SCORE_Y (NEXT_PIECE_Y + NEXT_PIECE_SIZE + UI_MARGIN)
-#define MENU_TITLE_Y (LOGICAL_HEIGHT / 3)
-#define MENU_START_Y (LOGICAL_HEIGHT * 2 / 3)
-
 // Game speeds (fall intervals in milliseconds)
 #define INITIAL_FALL_SPEED 800
 #define FAST_FALL_SPEED 50
 #define SPEED_INCREASE_PER_LEVEL 50
+#define SOFT_DROP_GRAVITY_MULTIPLIER 20 // Gravity speed-up while soft drop is held (at least 1 row per tick)
 
 // Line clear delays
 #define LINE_CLEAR_DELAY 300
 
+// Lock delay: a landed piece can still slide or spin for this long,
+// restarted by each move or rotation up to the reset limit
+#define DEFAULT_LOCK_DELAY_MS 500
+#define MAX_LOCK_DELAY_MS 5000
+#define DEFAULT_LOCK_RESET_LIMIT 15
+#define MAX_LOCK_RESET_LIMIT 100
+
+// Versus garbage becomes pending on the receiver this many ticks after it was sent.
+// Must exceed MAX_SIM_TICKS_PER_FRAME so neither player sees garbage due on a tick it
+// already stepped, whichever player's batch runs first.
+#define GARBAGE_DELAY_TICKS (MAX_SIM_TICKS_PER_FRAME * 2)
+
+// Online versus options
+#define DEFAULT_NET_PORT 7777
+#define MAX_NET_PORT 65535
+#define MAX_NET_LATENCY_MS 1000
+
+// Single-player save, relative to the working directory unless --save-file says otherwise
+#define DEFAULT_SAVE_PATH "blocktris.sav"
+#define DEFAULT_SCORES_PATH "blocktris.scores"
+
+// Resampled background images, kept between launches
+#define DEFAULT_CACHE_DIR "blocktris-cache"
+
+// Most encoder threads a replay export uses
+#define MAX_EXPORT_THREADS 16
+
 // Piece movement timing
 #define MOVE_REPEAT_DELAY 250    // Delay between repeated inputs when key held (higher = less sensitive)
 #define ROTATE_REPEAT_DELAY 300
@@ -79,12 +95,11 @@ void calculate_window_dimensions(int screen_width, int screen_height);
 #define POINTS_DOUBLE_LINE 300
 #define POINTS_TRIPLE_LINE 500
 #define POINTS_TETRIS 800
+#define POINTS_PENTRIS 1200
+#define POINTS_PER_EXTRA_LINE 400 // Each line beyond five (large boards)
 #define POINTS_SOFT_DROP 1
 #define POINTS_HARD_DROP 2
 
-// Maximum number of pieces in object pool
-#define MAX_PIECES 4
-
 // Pentomino piece types (18 total - 6 symmetric + 12 asymmetric in pairs)
 typedef enum {
     PIECE_I = 0,        // Symmetric
@@ -7,74 +7,119 @@
 #include "constants.h"
 #include "clock.h"
 #include "resource_manager.h"
-#include "object_pool.h"
+#include "blocktris_score.h"
 #include "events.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 
+uint64_t game_piece_seed(const game_t *game) {
+    if (game->config.seed != 0) {
+        return (uint64_t)game->config.seed;
+    }
+    
+    // Vary the sequence between games started within the same second
+    static uint64_t games_started = 0;
+    return ((uint64_t)time(NULL) << 16) ^ ++games_started;
+}
+
+bool game_update_layout(game_t *game) {
+    if (!game || !game->graphics_context.renderer) {
+        return false;
+    }
+    
+    int width = 0;
+    int height = 0;
+    if (SDL_GetRendererOutputSize(game->graphics_context.renderer, &width, &height) != 0 ||
+        width <= 0 || height <= 0) {
+        return false;
+    }
+    // A resumed game may be played on a board of another size
+    const game_board_t *board = &game->sim.board;
+    if (width == game->layout.width && height == game->layout.height &&
+        board->width == game->layout.board_width && board->height == game->layout.board_height) {
+        return false;
+    }
+    
+    game_layout_calculate(&game->layout, board->width, board->height, width, height);
+    game->layout_changed_time = get_clock_ticks_ms();
+    return true;
+}
 
+/**
+ * Start a new game in the simulation, with the line clear delay of the single-player game
+ */
+static void start_sim(game_t *game) {
+    blocktris_sim_init(&game->sim, &game->config, game_piece_seed(game));
+    blocktris_sim_set_line_clear_delay(&game->sim, MS_TO_SIM_TICKS(LINE_CLEAR_DELAY));
+}
 
-bool game_init(game_t *game) {
+/**
+ * Clear what is shown of the game until its first piece enters
+ */
+static void clear_shown_game(game_t *game) {
+    game_board_init(&game->board, game->sim.board.width, game->sim.board.height);
+    blocktris_piece_init(&game->current_piece);
+    game->hold_type = PIECE_EMPTY;
+    game->hold_used = false;
+    game->piece_queue = game->sim.queue;
+    game->sim_tick = 0;
+    game->replay_hash = HIGH_SCORES_REPLAY_HASH_INIT;
+    
+    game->line_clear_active = false;
+    game->num_lines_to_clear = 0;
+    game->line_clear_start_tick = 0;
+    game->lines_to_clear = 0;
+}
+
+bool game_init(game_t *game, const game_config_t *config) {
     if (!game) {
         return false;
     }
     
+    // Apply runtime configuration before the window layout is calculated
+    if (config) {
+        game->config = *config;
+    } else {
+        game_config_init(&game->config);
+    }
+    
     // Seed random number generator
     srand((unsigned int)time(NULL));
-
+    
+    // Start the rules first: the window is laid out around their board
+    start_sim(game);
+    
+    // The high-score log is read by the asset loader, off the main thread
+    high_scores_open(&game->high_scores, game->config.scores_path, DEFAULT_HIGH_SCORES_SIZE);
+    
     // Load all game resources (graphics, audio, fonts)
     if (!load_game_resources(game)) {
         return false;
     }
-
+    
     // Initialize event system
     game->event_system = create_event_system();
-
+    
     // Initialize keyboard state
     game->keyboard_state = init_keyboard_state();
-
+    
     // Initialize game state
     game->running = true;
     game->paused = false;
     game->current_screen = SCREEN_INTRO;
     game->current_stage = NULL;
     
-    // Initialize game board
-    game_board_init(&game->board);
-    
-    // Initialize object pools
-    game->piece_pool = create_object_pool(sizeof(blocktris_piece_t), MAX_PIECES);
-    
-    // Initialize game statistics
-    game->score = 0;
-    game->level = 1;
-    game->lines_cleared = 0;
-    
-    // Initialize timing
-    game->last_fall_time = get_clock_ticks_ms();
-    game->last_move_time = 0;
-    game->last_rotate_time = 0;
-    game->fall_speed = INITIAL_FALL_SPEED;
+    // Show the rules' game from its start
+    clear_shown_game(game);
     
-    // Initialize piece state
-    game->current_piece_x = BOARD_WIDTH / 2;
-    game->current_piece_y = 0;
-    game->current_piece_rotation = 0;
-    game->current_piece_type = PIECE_EMPTY;
-    game->next_piece_type = PIECE_EMPTY;
-    
-    // Initialize line clear state
-    game->line_clear_active = false;
-    game->num_lines_to_clear = 0;
-    game->line_clear_start_time = 0;
-    for (int i = 0; i < 4; i++) {
-        game->lines_to_clear[i] = -1;
-    }
+    // Initialize game statistics and the score log
+    blocktris_score_reset(game);
     
     // Initialize countdown display state
     game->show_countdown = false;
     game->countdown_start_time = 0;
+    game->resume_pending = false;
     
     return true;
 }
@@ -84,9 +129,6 @@ void game_terminate(game_t *game) {
         return;
     }
     
-    // Cleanup object pools
-    pool_destroy(&game->piece_pool);
-    
     // Free all game resources
     free_game_resources(game);
     
@@ -98,34 +140,12 @@ void game_reset(game_t *game) {
         return;
     }
     
-    // Reset game board
-    game_board_reset(&game->board);
-    
-    // Reset game statistics
-    game->score = 0;
-    game->level = 1;
-    game->lines_cleared = 0;
-    
-    // Reset timing
-    game->last_fall_time = get_clock_ticks_ms();
-    game->last_move_time = 0;
-    game->last_rotate_time = 0;
-    game->fall_speed = INITIAL_FALL_SPEED;
+    // Start a new game; its first piece is shown once the countdown is over
+    start_sim(game);
+    clear_shown_game(game);
     
-    // Reset piece state
-    game->current_piece_x = BOARD_WIDTH / 2;
-    game->current_piece_y = 0;
-    game->current_piece_rotation = 0;
-    game->current_piece_type = PIECE_EMPTY;
-    game->next_piece_type = PIECE_EMPTY;
-    
-    // Reset line clear state
-    game->line_clear_active = false;
-    game->num_lines_to_clear = 0;
-    game->line_clear_start_time = 0;
-    for (int i = 0; i < 4; i++) {
-        game->lines_to_clear[i] = -1;
-    }
+    // Reset game statistics and the score log
+    blocktris_score_reset(game);
     
     // Show countdown when game resets
     game->show_countdown = true;
@@ -136,6 +156,158 @@ void game_reset(game_t *game) {
     game->paused = false;
 }
 
+bool game_capture_snapshot(const game_t *game, game_snapshot_t *snapshot) {
+    if (!game || !snapshot) {
+        return false;
+    }
+    
+    if (game->show_countdown) {
+        return false; // Still counting down; there is nothing to resume yet
+    }
+    
+    const blocktris_sim_t *sim = &game->sim;
+    game_board_copy(&snapshot->board, &sim->board);
+    snapshot->piece = sim->piece;
+    snapshot->hold_type = sim->hold_type;
+    snapshot->hold_used = sim->hold_used;
+    snapshot->queue = sim->queue;
+    snapshot->lock_delay = sim->lock_delay;
+    snapshot->score = sim->score;
+    snapshot->level = sim->level;
+    snapshot->lines_cleared = sim->lines_cleared;
+    snapshot->fall_speed = sim->fall_speed;
+    snapshot->fall_ticks = sim->fall_ticks;
+    snapshot->sim_tick = sim->tick;
+    snapshot->line_clear_active = sim->clearing != 0;
+    snapshot->lines_to_clear = sim->clearing;
+    snapshot->num_lines_to_clear = game_board_count_lines(sim->clearing);
+    snapshot->line_clear_start_tick = sim->clear_start_tick;
+    snapshot->replay_hash = game->replay_hash;
+    return true;
+}
+
+bool game_save_snapshot(const game_t *game) {
+    game_snapshot_t snapshot;
+    if (!game_capture_snapshot(game, &snapshot)) {
+        return false;
+    }
+    
+    return game_snapshot_save(game->config.save_path, &snapshot);
+}
+
+/**
+ * Show the falling piece, the held one and the queue; there is no falling
+ * piece while completed lines are being cleared
+ */
+static void show_pieces(game_t *game, const blocktris_piece_t *piece, piece_type_t hold_type,
+                        const piece_queue_t *queue) {
+    game->current_piece = *piece;
+    game->hold_type = hold_type;
+    game->piece_queue = *queue;
+}
+
+void game_show_sim(game_t *game) {
+    if (!game) {
+        return;
+    }
+    
+    const blocktris_sim_t *sim = &game->sim;
+    game_board_copy(&game->board, &sim->board);
+    
+    game->score = sim->score;
+    game->level = sim->level;
+    game->lines_cleared = sim->lines_cleared;
+    game->sim_tick = sim->tick;
+    
+    show_pieces(game, &sim->piece, sim->hold_type, &sim->queue);
+    game->hold_used = sim->hold_used;
+    
+    game->line_clear_active = sim->clearing != 0;
+    game->lines_to_clear = sim->clearing;
+    game->num_lines_to_clear = game_board_count_lines(sim->clearing);
+    game->line_clear_start_tick = sim->clear_start_tick;
+}
+
+void game_apply_snapshot(game_t *game, const game_snapshot_t *snapshot) {
+    if (!game || !snapshot) {
+        return;
+    }
+    
+    game_board_copy(&game->board, &snapshot->board);
+    
+    game->score = snapshot->score;
+    game->level = snapshot->level;
+    game->lines_cleared = snapshot->lines_cleared;
+    game->sim_tick = snapshot->sim_tick;
+    
+    show_pieces(game, &snapshot->piece, snapshot->hold_type, &snapshot->queue);
+    game->hold_used = snapshot->hold_used;
+    game->replay_hash = snapshot->replay_hash;
+    
+    game->line_clear_active = snapshot->line_clear_active;
+    game->lines_to_clear = snapshot->lines_to_clear;
+    game->num_lines_to_clear = snapshot->num_lines_to_clear;
+    game->line_clear_start_tick = snapshot->line_clear_start_tick;
+}
+
+void game_restore_snapshot(game_t *game, const game_snapshot_t *snapshot) {
+    if (!game || !snapshot) {
+        return;
+    }
+    
+    // The simulation carries on from the snapshot, with the settings of a new game
+    blocktris_sim_t *sim = &game->sim;
+    start_sim(game);
+    game_board_copy(&sim->board, &snapshot->board);
+    sim->piece = snapshot->piece;
+    sim->hold_type = snapshot->hold_type;
+    sim->hold_used = snapshot->hold_used;
+    sim->queue = snapshot->queue;
+    sim->lock_delay = snapshot->lock_delay;
+    sim->score = snapshot->score;
+    sim->level = snapshot->level;
+    sim->lines_cleared = snapshot->lines_cleared;
+    sim->fall_speed = snapshot->fall_speed;
+    sim->fall_ticks = snapshot->fall_ticks;
+    sim->tick = snapshot->sim_tick;
+    sim->clearing = snapshot->line_clear_active ? snapshot->lines_to_clear : 0;
+    sim->clear_start_tick = snapshot->line_clear_start_tick;
+    
+    // Statistics are reset first: that also clears the score log, which isn't saved
+    blocktris_score_reset(game);
+    game_apply_snapshot(game, snapshot);
+    
+    // Resume paused, so the player isn't dropped straight back into a falling piece
+    game->show_countdown = false;
+    game->paused = true;
+    game->resume_pending = true;
+}
+
+high_scores_t *game_high_scores(game_t *game) {
+    if (!game) {
+        return NULL;
+    }
+    
+    asset_loader_wait_high_scores(&game->asset_loader);
+    return &game->high_scores;
+}
+
+bool game_record_high_score(game_t *game) {
+    if (!game) {
+        return false;
+    }
+    
+    high_score_t entry;
+    entry.score = (uint32_t)game->score;
+    entry.lines = (uint32_t)game->lines_cleared;
+    entry.duration_ms = game->sim_tick * SIM_TICK_MS;
+    entry.level = (uint16_t)game->level;
+    entry.seed = game->piece_queue.seed;
+    entry.replay_hash = game->replay_hash;
+    
+    return high_scores_add(game_high_scores(game), &entry);
+}
+
 void handle_events(event_system_t *event_system) {
     (void)event_system; // Unused for now
     
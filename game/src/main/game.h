@@ -16,14 +16,31 @@
 #include "event_system.h"
 #include "graphics.h"
 #include "keyboard.h"
-#include "object_pool.h"
 #include "constants.h"
+#include "game_config.h"
+#include "game_layout.h"
 #include "arcade_font.h"
 #include "texture.h"
 
 // Entity modules
 #include "blocktris_piece.h"
 #include "game_board.h"
+#include "piece_queue.h"
+#include "lock_delay.h"
+
+// Rules
+#include "blocktris_sim.h"
+
+// Scoring
+#include "score_log.h"
+
+// Startup: background asset loading and timing
+#include "asset_loader.h"
+#include "startup_timing.h"
+
+// Saved games and high scores
+#include "game_snapshot.h"
+#include "high_scores.h"
 
 // Forward declarations for stage system
 typedef struct stage_t stage_t;
@@ -44,7 +61,9 @@ typedef enum {
     SCREEN_MENU, 
     SCREEN_PLAYING, 
     SCREEN_GAME_OVER, 
-    SCREEN_PAUSED 
+    SCREEN_PAUSED,
+    SCREEN_VERSUS,
+    SCREEN_ONLINE
 } game_screen_t;
 
 /**
@@ -52,53 +71,67 @@ typedef enum {
  * Contains all game data including graphics, audio, entities, and game state
  */
 typedef struct {
+    // Runtime configuration
+    game_config_t config;
+    
     // Core systems
     graphics_context_t graphics_context;
     audio_context_t audio_context;
     event_system_t event_system;
     keyboard_state_t keyboard_state;
     arcade_font_t arcade_font;
-    texture_t background_texture;
-
+    texture_t background_texture; // Empty until the asset loader uploads it
+    int background_width;         // Size the background was last queued to be resampled to
+    int background_height;
+    game_layout_t layout;         // Window layout, recalculated when the window is resized or changes display
+    timestamp_ms_t layout_changed_time;
+    asset_loader_t asset_loader;
+    startup_timing_t startup_timing;
+    
     // Game state
     bool running;
     bool paused;
     game_screen_t current_screen;
     stage_t *current_stage; // Current active stage (for stage system)
-
+    
+    // Rules of the game in progress; the fields below show its latest state
+    blocktris_sim_t sim;
+    
     // Game entities
     game_board_t board;
     
-    // Object pools for efficient entity management
-    object_pool_t piece_pool;
-
     // Game statistics
     int score;
     int level;
     int lines_cleared;
+    score_log_t score_log; // Every scoring event, for analytics
+    high_scores_t high_scores; // Local leaderboard, read by the asset loader (use game_high_scores)
+    uint64_t replay_hash;      // Hash of the placements so far, identifying this game
     
-    // Timing
-    timestamp_ms_t last_fall_time;
-    timestamp_ms_t last_move_time;
-    timestamp_ms_t last_rotate_time;
-    int fall_speed;
+    // Simulation clock (SIM_TICK_MS per tick)
+    uint32_t sim_tick;
+    int piece_offset_y; // Drawn this far below its row, in SUBCELL_ONE units (render only, see piece_motion.h)
     
-    // Current piece state
-    int current_piece_x;
-    int current_piece_y;
-    int current_piece_rotation;
-    piece_type_t current_piece_type;
-    piece_type_t next_piece_type;
+    // Falling piece (inactive when there is none) and held piece type (PIECE_EMPTY when none)
+    blocktris_piece_t current_piece;
+    piece_type_t hold_type;
+    bool hold_used; // Hold already used for the current piece
+    
+    // Upcoming pieces
+    piece_queue_t piece_queue;
     
     // Game board state for visual effects
     bool line_clear_active;
-    int lines_to_clear[4]; // Maximum 4 lines can be cleared at once
+    board_line_mask_t lines_to_clear; // Bit y set = line y is being cleared
     int num_lines_to_clear;
-    timestamp_ms_t line_clear_start_time;
+    uint32_t line_clear_start_tick;
     
     // Countdown sequence at game start (3, 2)
     bool show_countdown;
     timestamp_ms_t countdown_start_time;
+    
+    // A saved game was restored; the playing stage carries on with it instead of starting over
+    bool resume_pending;
 } game_t;
 
 // Pointer typedef for game
@@ -109,9 +142,10 @@ typedef game_t *game_ptr;
  * Sets up graphics, audio, loads resources, and initializes game state
  *
  * @param game Pointer to game structure to initialize
+ * @param config Runtime configuration (board size, ...), NULL for defaults
  * @return true if initialization successful, false otherwise
  */
-bool game_init(game_t *game);
+bool game_init(game_t *game, const game_config_t *config);
 
 /**
  * Clean up and terminate the game
@@ -128,6 +162,92 @@ void game_terminate(game_t *game);
  */
 void game_reset(game_t *game);
 
+/**
+ * Recalculate the window layout if the drawable size, or the size of the
+ * board being played, has changed
+ *
+ * The size is read from the renderer every frame rather than from window
+ * events, so it also catches a move to a display of another pixel density,
+ * where the drawable size changes but the window's doesn't.
+ *
+ * @param game Pointer to game structure
+ * @return true if the layout changed
+ */
+bool game_update_layout(game_t *game);
+
+/**
+ * Get the seed for the next game's piece sequence
+ *
+ * @param game Pointer to game structure
+ * @return The configured seed, or a fresh one for every game when none is set
+ */
+uint64_t game_piece_seed(const game_t *game);
+
+/**
+ * Copy the single-player game in progress into a snapshot
+ *
+ * @param game Pointer to game structure
+ * @param snapshot Set to the game's state
+ * @return false while the game is still counting down
+ */
+bool game_capture_snapshot(const game_t *game, game_snapshot_t *snapshot);
+
+/**
+ * Save the single-player game in progress to config.save_path
+ *
+ * @param game Pointer to game structure
+ * @return true if saved, false while counting down or if the file can't be written
+ */
+bool game_save_snapshot(const game_t *game);
+
+/**
+ * Show the latest state of the game's simulation
+ *
+ * Sets the board, pieces, queue and statistics that are drawn and saved
+ * from the simulation stepped by the playing stage.
+ *
+ * @param game Pointer to game structure
+ */
+void game_show_sim(game_t *game);
+
+/**
+ * Set the board, pieces, queue and statistics shown from a snapshot
+ *
+ * Unlike game_restore_snapshot the simulation, the score log and the screen
+ * state are left alone, so this also serves to mirror a game running on
+ * another thread. The board size must already match the snapshot's.
+ *
+ * @param game Pointer to an initialized game structure
+ * @param snapshot Snapshot to copy from
+ */
+void game_apply_snapshot(game_t *game, const game_snapshot_t *snapshot);
+
+/**
+ * Restore a saved single-player game, to be picked up paused by the playing stage
+ *
+ * The board size and preview depth must already match the snapshot's.
+ *
+ * @param game Pointer to an initialized game structure
+ * @param snapshot Snapshot loaded with game_snapshot_load
+ */
+void game_restore_snapshot(game_t *game, const game_snapshot_t *snapshot);
+
+/**
+ * Get the high-score table, once the asset loader is done reading it
+ *
+ * @param game Pointer to game structure
+ * @return The table, NULL without a game
+ */
+high_scores_t *game_high_scores(game_t *game);
+
+/**
+ * Log the finished game in the high-score table
+ *
+ * @param game Pointer to game structure
+ * @return true if the game made the table
+ */
+bool game_record_high_score(game_t *game);
+
 /**
  * Handle SDL events and update event system
  *
@@ -0,0 +1,148 @@
+/**
+ * @file game_config.c
+ * @brief BlockTris runtime game configuration implementation
+ */
+
+#include "game_config.h"
+#include "constants.h"
+#include "piece_queue.h"
+#include "utils.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Parse a --join value of the form HOST:PORT
+ */
+static bool parse_join_option(const char *name, const char *value, game_config_t *config) {
+    const char *colon = value ? strrchr(value, ':') : NULL;
+    size_t host_length = colon ? (size_t)(colon - value) : 0;
+    
+    if (!colon || host_length == 0 || host_length >= NET_HOST_NAME_SIZE) {
+        printf("Invalid value for %s: %s (expected HOST:PORT)\n", name, value ? value : "");
+        return false;
+    }
+    
+    if (!utils_parse_int_option(name, colon + 1, 1, MAX_NET_PORT, &config->net_port)) {
+        return false;
+    }
+    
+    memcpy(config->net_host, value, host_length);
+    config->net_host[host_length] = '\0';
+    config->net_role = NET_ROLE_JOIN;
+    return true;
+}
+
+/**
+ * Parse a path option value that fits in size bytes
+ */
+static bool parse_path_option(const char *name, const char *value, char *out, size_t size) {
+    if (!value || value[0] == '\0' || strlen(value) >= size) {
+        printf("Invalid value for %s: %s (expected a path under %d characters)\n",
+               name, value ? value : "", (int)size);
+        return false;
+    }
+    
+    strcpy(out, value);
+    return true;
+}
+
+void game_config_init(game_config_t *config) {
+    if (!config) {
+        return;
+    }
+    
+    config->board_width = DEFAULT_BOARD_WIDTH;
+    config->board_height = DEFAULT_BOARD_HEIGHT;
+    config->preview_depth = DEFAULT_PIECE_QUEUE_DEPTH;
+    config->seed = 0;
+    config->lock_delay_ms = DEFAULT_LOCK_DELAY_MS;
+    config->lock_reset_limit = DEFAULT_LOCK_RESET_LIMIT;
+    config->net_role = NET_ROLE_NONE;
+    config->net_host[0] = '\0';
+    config->net_port = DEFAULT_NET_PORT;
+    config->net_loss_percent = 0;
+    config->net_latency_ms = 0;
+    config->net_jitter_ms = 0;
+    strcpy(config->save_path, DEFAULT_SAVE_PATH);
+    strcpy(config->scores_path, DEFAULT_SCORES_PATH);
+    strcpy(config->cache_dir, DEFAULT_CACHE_DIR);
+    config->export_replay[0] = '\0';
+    config->export_png_dir[0] = '\0';
+    config->export_threads = 0;
+}
+
+bool game_config_parse_args(game_config_t *config, int argc, char *argv[]) {
+    if (!config) {
+        return false;
+    }
+    
+    bool valid = true;
+    
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        
+        if (strcmp(arg, "--board-width") == 0) {
+            valid &= utils_parse_int_option(arg, value, MIN_BOARD_WIDTH, MAX_BOARD_WIDTH,
+                                      &config->board_width);
+            i++;
+        } else if (strcmp(arg, "--board-height") == 0) {
+            valid &= utils_parse_int_option(arg, value, MIN_BOARD_HEIGHT, MAX_BOARD_HEIGHT,
+                                      &config->board_height);
+            i++;
+        } else if (strcmp(arg, "--preview") == 0) {
+            valid &= utils_parse_int_option(arg, value, PIECE_QUEUE_MIN_DEPTH, PIECE_QUEUE_MAX_DEPTH,
+                                      &config->preview_depth);
+            i++;
+        } else if (strcmp(arg, "--seed") == 0) {
+            valid &= utils_parse_int_option(arg, value, 1, INT_MAX, &config->seed);
+            i++;
+        } else if (strcmp(arg, "--lock-delay") == 0) {
+            valid &= utils_parse_int_option(arg, value, 0, MAX_LOCK_DELAY_MS, &config->lock_delay_ms);
+            i++;
+        } else if (strcmp(arg, "--lock-resets") == 0) {
+            valid &= utils_parse_int_option(arg, value, 0, MAX_LOCK_RESET_LIMIT, &config->lock_reset_limit);
+            i++;
+        } else if (strcmp(arg, "--host") == 0) {
+            valid &= utils_parse_int_option(arg, value, 1, MAX_NET_PORT, &config->net_port);
+            config->net_role = NET_ROLE_HOST;
+            i++;
+        } else if (strcmp(arg, "--join") == 0) {
+            valid &= parse_join_option(arg, value, config);
+            i++;
+        } else if (strcmp(arg, "--net-loss") == 0) {
+            valid &= utils_parse_int_option(arg, value, 0, 100, &config->net_loss_percent);
+            i++;
+        } else if (strcmp(arg, "--net-latency") == 0) {
+            valid &= utils_parse_int_option(arg, value, 0, MAX_NET_LATENCY_MS, &config->net_latency_ms);
+            i++;
+        } else if (strcmp(arg, "--net-jitter") == 0) {
+            valid &= utils_parse_int_option(arg, value, 0, MAX_NET_LATENCY_MS, &config->net_jitter_ms);
+            i++;
+        } else if (strcmp(arg, "--save-file") == 0) {
+            valid &= parse_path_option(arg, value, config->save_path, sizeof(config->save_path));
+            i++;
+        } else if (strcmp(arg, "--scores-file") == 0) {
+            valid &= parse_path_option(arg, value, config->scores_path, sizeof(config->scores_path));
+            i++;
+        } else if (strcmp(arg, "--cache-dir") == 0) {
+            valid &= parse_path_option(arg, value, config->cache_dir, sizeof(config->cache_dir));
+            i++;
+        } else if (strcmp(arg, "--export-replay") == 0) {
+            valid &= parse_path_option(arg, value, config->export_replay, sizeof(config->export_replay));
+            i++;
+        } else if (strcmp(arg, "--export-png") == 0) {
+            valid &= parse_path_option(arg, value, config->export_png_dir, sizeof(config->export_png_dir));
+            i++;
+        } else if (strcmp(arg, "--export-threads") == 0) {
+            valid &= utils_parse_int_option(arg, value, 0, MAX_EXPORT_THREADS, &config->export_threads);
+            i++;
+        } else {
+            printf("Ignoring unknown option: %s\n", arg);
+        }
+    }
+    
+    return valid;
+}
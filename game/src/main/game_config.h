@@ -0,0 +1,93 @@
+/**
+ * @file game_config.h
+ * @brief BlockTris runtime game configuration
+ *
+ * Holds the options that can be changed without recompiling (board size, ...)
+ * and parses them from the command line.
+ */
+
+#ifndef BLOCKTRIS_GAME_CONFIG_H_
+#define BLOCKTRIS_GAME_CONFIG_H_
+
+#include <stdbool.h>
+
+// Longest host name accepted by --join, including the terminator
+#define NET_HOST_NAME_SIZE 64
+
+// Longest path accepted by --save-file, including the terminator
+#define SAVE_PATH_SIZE 256
+
+/**
+ * Role in an online versus match
+ */
+typedef enum {
+    NET_ROLE_NONE, // Offline
+    NET_ROLE_HOST, // Waits for a player on net_port and picks the match settings
+    NET_ROLE_JOIN  // Connects to net_host:net_port
+} net_role_t;
+
+/**
+ * Runtime game configuration
+ */
+typedef struct {
+    int board_width;  // Board width in cells (MIN_BOARD_WIDTH..MAX_BOARD_WIDTH)
+    int board_height; // Board height in cells (MIN_BOARD_HEIGHT..MAX_BOARD_HEIGHT)
+    int preview_depth; // Pieces shown in the preview queue (PIECE_QUEUE_MIN_DEPTH..PIECE_QUEUE_MAX_DEPTH)
+    int seed;          // Piece sequence seed, 0 for a new seed every game
+    int lock_delay_ms;    // Time a landed piece waits before locking (0..MAX_LOCK_DELAY_MS)
+    int lock_reset_limit; // Moves/rotations that restart the lock delay (0..MAX_LOCK_RESET_LIMIT)
+    net_role_t net_role;
+    char net_host[NET_HOST_NAME_SIZE]; // Host to join
+    int net_port;          // Port to host on or join
+    int net_loss_percent;  // Simulated packet loss (0..100)
+    int net_latency_ms;    // Simulated latency added to each packet (0..MAX_NET_LATENCY_MS)
+    int net_jitter_ms;     // Simulated random extra latency (0..MAX_NET_LATENCY_MS)
+    char save_path[SAVE_PATH_SIZE]; // Single-player game saved on pause or quit and resumed at start
+    char scores_path[SAVE_PATH_SIZE]; // High-score log
+    char cache_dir[SAVE_PATH_SIZE];   // Directory of cached resampled images
+    char export_replay[SAVE_PATH_SIZE];  // Replay to export as frames instead of playing, empty to play
+    char export_png_dir[SAVE_PATH_SIZE]; // Directory of the exported PNG sequence, empty for raw RGBA on stdout
+    int export_threads;                  // PNG encoder threads (0 for one per CPU, up to MAX_EXPORT_THREADS)
+} game_config_t;
+
+typedef game_config_t *game_config_ptr;
+
+/**
+ * Initialize a configuration with the default values
+ *
+ * @param config Pointer to the configuration to initialize
+ */
+void game_config_init(game_config_t *config);
+
+/**
+ * Parse command line options into a configuration
+ *
+ * Supported options:
+ *   --board-width N   Board width in cells
+ *   --board-height N  Board height in cells
+ *   --preview N       Number of upcoming pieces shown
+ *   --seed N          Fixed piece sequence seed
+ *   --lock-delay MS   Lock delay in milliseconds
+ *   --lock-resets N   Lock delay resets per piece
+ *   --host PORT       Host an online versus match
+ *   --join HOST:PORT  Join an online versus match
+ *   --net-loss PCT    Drop this percentage of outgoing packets
+ *   --net-latency MS  Delay outgoing packets
+ *   --net-jitter MS   Delay outgoing packets by up to this much more
+ *   --save-file PATH  Where the game in progress is saved
+ *   --scores-file PATH Where finished games are logged for the high-score table
+ *   --cache-dir DIR    Where the background resampled to the window is cached
+ *   --export-replay PATH Render a replay's frames headless and exit
+ *   --export-png DIR   Write the exported frames as PNGs instead of raw RGBA on stdout
+ *   --export-threads N PNG encoder threads
+ *
+ * Unknown options are ignored with a warning.
+ *
+ * @param config Pointer to the configuration to update
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return true if all recognized options had valid values, false otherwise
+ */
+bool game_config_parse_args(game_config_t *config, int argc, char *argv[]);
+
+#endif // BLOCKTRIS_GAME_CONFIG_H_
@@ -0,0 +1,64 @@
+/**
+ * @file game_layout.c
+ * @brief Board layout calculation
+ */
+
+#include "game_layout.h"
+#include "constants.h"
+#include <stddef.h>
+
+/**
+ * Cell size that fits a board in an area: the field takes most of the
+ * height, and the width holds the field, UI panel and margins (width + 10 cells)
+ */
+static int fit_cell_size(int board_width, int board_height, int width, int height) {
+    int available_field_height = (int)(height * 0.9);
+    int cell_size = available_field_height / board_height;
+    
+    int max_cell_size_for_width = width / (board_width + 10);
+    if (cell_size > max_cell_size_for_width) {
+        cell_size = max_cell_size_for_width;
+    }
+    
+    return cell_size < MIN_LAYOUT_CELL_SIZE ? MIN_LAYOUT_CELL_SIZE : cell_size;
+}
+
+void game_layout_window_size(int board_width, int board_height, int screen_width, int screen_height,
+                             int *width, int *height) {
+    if (!width || !height || board_width <= 0 || board_height <= 0) {
+        return;
+    }
+    
+    // Window height is a share of the screen's; the width fits field + UI + margins (minimal width)
+    *height = (int)(screen_height * SCREEN_HEIGHT_SCALE);
+    int cell_size = fit_cell_size(board_width, board_height, screen_width, *height);
+    *width = (board_width + 10) * cell_size;
+}
+
+void game_layout_calculate(game_layout_t *layout, int board_width, int board_height, int width, int height) {
+    if (!layout || board_width <= 0 || board_height <= 0) {
+        return;
+    }
+    
+    layout->width = width;
+    layout->height = height;
+    layout->board_width = board_width;
+    layout->board_height = board_height;
+    layout->cell_size = fit_cell_size(board_width, board_height, width, height);
+    
+    // Calculate field dimensions based on cell size
+    layout->field_width = board_width * layout->cell_size;
+    layout->field_height = board_height * layout->cell_size;
+    
+    // Calculate UI dimensions
+    layout->ui_panel_width = layout->cell_size * 7;
+    layout->ui_margin = layout->cell_size;
+    
+    // Centre field + UI + margins in the width left over, if any
+    int content_width = layout->field_width + layout->ui_panel_width + layout->ui_margin * 3;
+    int spare_width = width > content_width ? width - content_width : 0;
+    
+    // Position the board within the area
+    layout->board_offset_x = spare_width / 2 + layout->ui_margin;
+    layout->board_offset_y = (height - layout->field_height) / 2;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file game_layout.h
+ * @brief Screen layout of a board and its side panel
+ *
+ * A layout places one board, with the next/hold/score panel to its right,
+ * in a drawable area: it picks the cell size and the offsets everything
+ * else is drawn at. The renderer takes the layout it draws with as a
+ * parameter, so nothing about the screen is global: two boards can be laid
+ * out at different sizes, and the window's layout can be recalculated
+ * whenever it's resized or moved to a display of another pixel density.
+ *
+ * Sizes are in drawable pixels, which on a high-density display are more
+ * than the window's size in screen coordinates.
+ *
+ * A layout can also carry a software canvas: the renderer then draws
+ * everything laid out with it into the canvas, with no window or GPU
+ * involved, for headless rendering and golden-image tests.
+ */
+
+#ifndef GAME_LAYOUT_H_
+#define GAME_LAYOUT_H_
+
+#include "soft_raster.h"
+
+// Smallest cell size a layout uses, even if the board then overflows the area
+#define MIN_LAYOUT_CELL_SIZE 8
+
+/**
+ * Where a board and its side panel are drawn
+ */
+typedef struct {
+    int width;          // Drawable area laid out, in pixels
+    int height;
+    int board_width;    // Board laid out, in cells
+    int board_height;
+    int cell_size;
+    int field_width;    // Board size in pixels
+    int field_height;
+    int ui_panel_width; // Space for next piece and UI
+    int ui_margin;      // Margins around the field
+    int board_offset_x; // Top left of the board
+    int board_offset_y;
+    soft_canvas_t *canvas;                 // Drawn into instead of the graphics context, NULL for the window
+    const soft_image_t *canvas_background; // Image drawn as the canvas background, NULL for none
+} game_layout_t;
+
+typedef game_layout_t *game_layout_ptr;
+
+// Side panel positions
+#define NEXT_PIECE_X(layout) ((layout)->board_offset_x + (layout)->field_width + (layout)->ui_margin)
+#define NEXT_PIECE_Y(layout) ((layout)->board_offset_y + (layout)->ui_margin)
+#define NEXT_PIECE_SIZE(layout) ((layout)->cell_size * 3)
+#define QUEUE_PREVIEW_X(layout) (NEXT_PIECE_X(layout) + NEXT_PIECE_SIZE(layout) + (layout)->ui_margin)
+#define QUEUE_PREVIEW_Y(layout) (NEXT_PIECE_Y(layout))
+#define QUEUE_PREVIEW_SIZE(layout) ((layout)->cell_size * 2) // One slot per queued piece after the next one
+#define SCORE_X(layout) (NEXT_PIECE_X(layout))
+#define SCORE_Y(layout) (NEXT_PIECE_Y(layout) + NEXT_PIECE_SIZE(layout) + (layout)->ui_margin)
+#define HOLD_PIECE_X(layout) (NEXT_PIECE_X(layout))
+#define HOLD_PIECE_Y(layout) (SCORE_Y(layout) + 60 + (layout)->ui_margin + 30) // Below the 60px score box, with 30px for the label
+#define MENU_TITLE_Y(layout) ((layout)->height / 3)
+#define MENU_START_Y(layout) ((layout)->height * 2 / 3)
+
+/**
+ * Get the window size to open for a board on a screen
+ *
+ * The window is SCREEN_HEIGHT_SCALE of the screen's height and just wide
+ * enough for the board and its side panel.
+ *
+ * @param board_width Board width in cells
+ * @param board_height Board height in cells
+ * @param screen_width Screen width in pixels
+ * @param screen_height Screen height in pixels
+ * @param width Set to the window width
+ * @param height Set to the window height
+ */
+void game_layout_window_size(int board_width, int board_height, int screen_width, int screen_height,
+                             int *width, int *height);
+
+/**
+ * Lay a board out in a drawable area
+ *
+ * The cell size is the largest that fits the board in most of the height
+ * and the board, side panel and margins in the width; the content is
+ * centred in whatever width is left over. The canvas, if any, is kept.
+ *
+ * @param layout Pointer to the layout to calculate
+ * @param board_width Board width in cells
+ * @param board_height Board height in cells
+ * @param width Drawable width in pixels
+ * @param height Drawable height in pixels
+ */
+void game_layout_calculate(game_layout_t *layout, int board_width, int board_height, int width, int height);
+
+#endif // GAME_LAYOUT_H_
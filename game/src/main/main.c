@@ -4,50 +4,128 @@
  */
 
 #include "constants.h"
+#include "clock.h"
 #include "frame_limiter.h"
 #include "game.h"
+#include "replay_export.h"
+#include "resource_manager.h"
 #include "stage_director.h"
 #include <stdbool.h>
 #include <stdio.h>
 
-int main(int argc, char *argv[]) {
-    (void)argc;
-    (void)argv;
+/**
+ * Render a replay's frames headless instead of playing
+ *
+ * Raw frames go to stdout, so everything else is reported on stderr.
+ *
+ * @param config Parsed options naming the replay and the output
+ * @return Process exit status
+ */
+static int export_replay(const game_config_t *config) {
+    static replay_t replay;
+    if (!replay_load(config->export_replay, &replay)) {
+        fprintf(stderr, "Cannot read replay %s\n", config->export_replay);
+        return 1;
+    }
+    
+    replay_export_options_t options;
+    replay_export_options_init(&options);
+    if (config->export_png_dir[0] != '\0') {
+        options.format = REPLAY_EXPORT_PNG;
+        options.png_dir = config->export_png_dir;
+    }
+    options.threads = config->export_threads;
+    
+    timestamp_ms_t start_time = get_clock_ticks_ms();
+    replay_export_result_t result;
+    bool ok = replay_export_run(&replay, &options, &result);
+    timestamp_ms_t elapsed = get_clock_ticks_ms() - start_time;
+    replay_free(&replay);
+    
+    if (!ok) {
+        fprintf(stderr, "Exporting %s failed\n", config->export_replay);
+        return 1;
+    }
+    fprintf(stderr, "Exported %lu frames of %dx%d at %d fps in %lu ms\n", (unsigned long)result.frames,
+            result.width, result.height, options.frame_rate, (unsigned long)elapsed);
+    return 0;
+}
 
+int main(int argc, char *argv[]) {
     game_t game = {0};
-
-    if (!game_init(&game)) {
+    startup_timing_start(&game.startup_timing);
+    
+    // Parse runtime options (board size, ...)
+    game_config_t config;
+    game_config_init(&config);
+    if (!game_config_parse_args(&config, argc, argv)) {
+        return 1;
+    }
+    if (config.export_replay[0] != '\0') {
+        return export_replay(&config);
+    }
+    
+    // Pick up a saved single-player game where it was left, on the board it was played on
+    static game_snapshot_t snapshot;
+    bool resume = config.net_role == NET_ROLE_NONE && game_snapshot_load(config.save_path, &snapshot);
+    if (resume) {
+        config.board_width = snapshot.board.width;
+        config.board_height = snapshot.board.height;
+        config.preview_depth = snapshot.queue.depth;
+    }
+    
+    if (!game_init(&game, &config)) {
         game_terminate(&game);
         return 1;
     }
-
+    if (resume) {
+        game_restore_snapshot(&game, &snapshot);
+        printf("Resuming the saved game from %s (paused, press S to continue)\n", config.save_path);
+    }
+    
     printf("BlockTris - Press ESC to quit\n");
     printf("Controls: Arrow keys to move, Space to drop, P to pause\n");
-
+    
     // Initialize stage director
     stage_director_t stage_director = {0};
     if (!stage_director_init(&stage_director, &game)) {
         game_terminate(&game);
         return 1;
     }
-
+    if (resume) {
+        game.current_screen = SCREEN_PLAYING; // Skip the intro
+    }
+    startup_timing_mark(&game.startup_timing, "stages");
+    
     // Initialize frame limiter
     int target_fps = 1000 / FRAME_DELAY; // Convert from frame delay to FPS
     frame_limiter_t frame_limiter = create_frame_limiter(target_fps);
-
+    
     // Game loop
     while (game.running) {
+        // Follow the window if it was resized or moved to another display
+        game_update_layout(&game);
+        
+        // Pick up images the loader has decoded since the last frame
+        update_game_resources(&game);
+        
         // Update stages and handle transitions
         game_stage_action_t action = stage_director_update(&stage_director, &game);
-
+        
+        // Report the startup breakdown once the first frame is up and the assets are in
+        startup_timing_first_frame(&game.startup_timing);
+        if (asset_loader_done(&game.asset_loader)) {
+            startup_timing_report(&game.startup_timing);
+        }
+        
         if (action == QUIT) {
             game.running = false;
         }
-
+        
         // Frame rate limiting using engine
         frame_limiter_wait(&frame_limiter);
     }
-
+    
     // Cleanup
     stage_director_cleanup(&stage_director);
     game_terminate(&game);
@@ -0,0 +1,224 @@
+/**
+ * @file asset_loader.c
+ * @brief Background image decoding implementation
+ */
+
+#include "asset_loader.h"
+#include "background_cache.h"
+#include <SDL_image.h>
+#include <stdio.h>
+
+/**
+ * Decode an image straight to its target size, from the disk cache when it has it
+ */
+static SDL_Surface *decode_scaled(const asset_request_t *request) {
+    SDL_Surface *scaled = SDL_CreateRGBSurfaceWithFormat(0, request->width, request->height, 32,
+                                                         SDL_PIXELFORMAT_RGBA32);
+    if (!scaled) {
+        return NULL;
+    }
+    
+    uint64_t hash = 0;
+    char cache_path[BACKGROUND_CACHE_PATH_SIZE];
+    bool cacheable = request->cache_dir && background_cache_hash_file(request->path, &hash) &&
+                     background_cache_path(cache_path, sizeof(cache_path), request->cache_dir, hash,
+                                           request->width, request->height);
+    if (cacheable && background_cache_load(cache_path, hash, request->width, request->height,
+                                           scaled->pixels, scaled->pitch)) {
+        return scaled;
+    }
+    
+    // Cache miss: decode, convert to the cache's pixel format and resample
+    SDL_Surface *image = IMG_Load(request->path);
+    SDL_Surface *rgba = image ? SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0) : NULL;
+    if (image) {
+        SDL_FreeSurface(image);
+    }
+    if (!rgba) {
+        SDL_FreeSurface(scaled);
+        return NULL;
+    }
+    
+    background_cache_resample(rgba->pixels, rgba->w, rgba->h, rgba->pitch,
+                              scaled->pixels, request->width, request->height, scaled->pitch);
+    SDL_FreeSurface(rgba);
+    
+    if (cacheable && !background_cache_save(request->cache_dir, cache_path, hash, request->width,
+                                            request->height, scaled->pixels, scaled->pitch)) {
+        printf("Couldn't cache %s in %s\n", request->path, request->cache_dir);
+    }
+    return scaled;
+}
+
+/**
+ * Decode every queued image, publishing each as soon as it's done, then read the high scores,
+ * which nothing needs until the first game over
+ */
+static void decode_all(asset_loader_t *loader) {
+    for (int i = 0; i < loader->count; i++) {
+        asset_request_t *request = &loader->requests[i];
+        request->surface = request->width > 0 ? decode_scaled(request) : IMG_Load(request->path);
+        if (!request->surface) {
+            printf("Failed to decode %s: %s\n", request->path, SDL_GetError());
+        }
+        SDL_AtomicAdd(&loader->decoded, 1);
+    }
+    
+    if (loader->high_scores) {
+        high_scores_load(loader->high_scores);
+        SDL_AtomicSet(&loader->high_scores_loaded, 1);
+    }
+}
+
+static int loader_main(void *data) {
+    decode_all((asset_loader_t *)data);
+    return 0;
+}
+
+void asset_loader_init(asset_loader_t *loader) {
+    if (!loader) {
+        return;
+    }
+    
+    loader->count = 0;
+    loader->high_scores = NULL;
+    SDL_AtomicSet(&loader->high_scores_loaded, 0);
+    loader->thread = NULL;
+    SDL_AtomicSet(&loader->decoded, 0);
+    loader->uploaded = 0;
+    loader->failed = 0;
+}
+
+bool asset_loader_add(asset_loader_t *loader, const char *path, texture_t *destination) {
+    if (!loader || !path || !destination || loader->count >= ASSET_LOADER_MAX_ASSETS ||
+        loader->thread || SDL_AtomicGet(&loader->decoded) > 0) {
+        return false;
+    }
+    
+    asset_request_t *request = &loader->requests[loader->count++];
+    request->path = path;
+    request->destination = destination;
+    request->width = 0;
+    request->height = 0;
+    request->cache_dir = NULL;
+    request->surface = NULL;
+    return true;
+}
+
+bool asset_loader_add_scaled(asset_loader_t *loader, const char *path, texture_t *destination,
+                             int width, int height, const char *cache_dir) {
+    if (width <= 0 || height <= 0 || !asset_loader_add(loader, path, destination)) {
+        return false;
+    }
+    
+    asset_request_t *request = &loader->requests[loader->count - 1];
+    request->width = width;
+    request->height = height;
+    request->cache_dir = cache_dir;
+    return true;
+}
+
+bool asset_loader_add_high_scores(asset_loader_t *loader, high_scores_t *table) {
+    if (!loader || !table || loader->high_scores || loader->thread || SDL_AtomicGet(&loader->decoded) > 0) {
+        return false;
+    }
+    
+    loader->high_scores = table;
+    return true;
+}
+
+void asset_loader_start(asset_loader_t *loader) {
+    if (!loader || (loader->count == 0 && !loader->high_scores)) {
+        return;
+    }
+    
+    loader->thread = SDL_CreateThread(loader_main, "asset_loader", loader);
+    if (!loader->thread) {
+        decode_all(loader);
+    }
+}
+
+/**
+ * Turn a decoded surface into a texture and let the surface go
+ */
+static void upload(asset_loader_t *loader, asset_request_t *request, SDL_Renderer *renderer) {
+    SDL_Texture *texture = request->surface ? SDL_CreateTextureFromSurface(renderer, request->surface) : NULL;
+    if (texture) {
+        // Reloading at another size replaces the texture uploaded before
+        if (request->destination->texture) {
+            SDL_DestroyTexture(request->destination->texture);
+        }
+        request->destination->texture = texture;
+        request->destination->width = request->surface->w;
+        request->destination->height = request->surface->h;
+    } else {
+        if (request->surface) {
+            printf("Failed to upload %s: %s\n", request->path, SDL_GetError());
+        }
+        loader->failed++;
+    }
+    
+    if (request->surface) {
+        SDL_FreeSurface(request->surface);
+        request->surface = NULL;
+    }
+}
+
+bool asset_loader_poll(asset_loader_t *loader, SDL_Renderer *renderer) {
+    if (!loader) {
+        return true;
+    }
+    
+    int decoded = SDL_AtomicGet(&loader->decoded);
+    while (loader->uploaded < decoded) {
+        upload(loader, &loader->requests[loader->uploaded], renderer);
+        loader->uploaded++;
+    }
+    
+    // The thread has nothing left to do once everything is decoded
+    if (asset_loader_done(loader) && loader->thread) {
+        SDL_WaitThread(loader->thread, NULL);
+        loader->thread = NULL;
+    }
+    
+    return asset_loader_done(loader);
+}
+
+void asset_loader_wait_high_scores(asset_loader_t *loader) {
+    if (!loader || !loader->high_scores || SDL_AtomicGet(&loader->high_scores_loaded)) {
+        return;
+    }
+    
+    // Either the thread is still on it, or the loader was never started
+    if (loader->thread) {
+        SDL_WaitThread(loader->thread, NULL);
+        loader->thread = NULL;
+    }
+    high_scores_load(loader->high_scores);
+    SDL_AtomicSet(&loader->high_scores_loaded, 1);
+}
+
+bool asset_loader_done(const asset_loader_t *loader) {
+    return !loader || loader->uploaded >= loader->count;
+}
+
+void asset_loader_stop(asset_loader_t *loader) {
+    if (!loader) {
+        return;
+    }
+    
+    if (loader->thread) {
+        SDL_WaitThread(loader->thread, NULL);
+        loader->thread = NULL;
+    }
+    
+    // Quitting before the first frames: drop what was never uploaded
+    int decoded = SDL_AtomicGet(&loader->decoded);
+    for (int i = loader->uploaded; i < decoded; i++) {
+        if (loader->requests[i].surface) {
+            SDL_FreeSurface(loader->requests[i].surface);
+            loader->requests[i].surface = NULL;
+        }
+    }
+    loader->uploaded = loader->count;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file asset_loader.h
+ * @brief Background decoding of image assets
+ *
+ * Image files are decoded into surfaces by a loader thread, so the first
+ * frame doesn't wait on them. Turning a surface into a texture needs the
+ * renderer, which belongs to the main thread: asset_loader_poll does that
+ * for whatever has been decoded, and is called once per frame.
+ *
+ * An image can be resampled to a fixed size as it is decoded, and the
+ * result cached on disk so later launches skip the decode
+ * (background_cache.h).
+ *
+ * All assets are added before the loader starts; to load more, stop it and
+ * initialize it again. The loader thread then owns the request list up to
+ * the decoded counter, and the main thread everything below it; the counter
+ * is atomic, so publishing it also publishes the surfaces.
+ *
+ * An upload replaces whatever texture its destination already held, so an
+ * image can be reloaded at a new size while the old one is still drawn.
+ *
+ * The loader thread can also read the high-score log once the images are
+ * decoded, so the table is ready by the first game over without the main
+ * thread ever reading it or the first frames waiting on it.
+ */
+
+#ifndef TETRIS_ASSET_LOADER_H
+#define TETRIS_ASSET_LOADER_H
+
+#include "texture.h"
+#include "high_scores.h"
+#include <stdbool.h>
+
+/**
+ * @brief Most assets one loader can stream
+ */
+#define ASSET_LOADER_MAX_ASSETS 8
+
+/**
+ * @brief One image to load
+ */
+typedef struct {
+    const char *path;       // Static string, the image file
+    texture_t *destination; // Filled in on upload; left empty if loading fails
+    int width;              // Size to resample to, 0 to keep the image's own
+    int height;
+    const char *cache_dir;  // Where resampled pixels are cached, NULL for no disk cache
+    SDL_Surface *surface;   // Decoded image, NULL if decoding failed
+} asset_request_t;
+
+/**
+ * @brief Images being decoded in the background
+ */
+typedef struct {
+    asset_request_t requests[ASSET_LOADER_MAX_ASSETS];
+    int count;
+    high_scores_t *high_scores;      // Table read after the images, NULL for none
+    SDL_atomic_t high_scores_loaded; // Set once the loader thread is done with the table
+    SDL_Thread *thread;   // NULL before start, once stopped, or if the thread couldn't be created
+    SDL_atomic_t decoded; // Requests the loader thread is done with
+    int uploaded;         // Requests turned into textures or given up on (main thread only)
+    int failed;           // Requests that didn't produce a texture
+} asset_loader_t;
+
+typedef asset_loader_t *asset_loader_ptr;
+
+/**
+ * @brief Initialize an empty loader
+ * @param loader Loader to initialize
+ */
+void asset_loader_init(asset_loader_t *loader);
+
+/**
+ * @brief Queue an image, before the loader starts
+ * @param loader Loader to add to
+ * @param path Static string, the image file
+ * @param destination Texture to fill in once the image is uploaded
+ * @return false if the loader is full or already started
+ */
+bool asset_loader_add(asset_loader_t *loader, const char *path, texture_t *destination);
+
+/**
+ * @brief Queue an image resampled to a fixed size, before the loader starts
+ * @param loader Loader to add to
+ * @param path Static string, the image file
+ * @param destination Texture to fill in once the image is uploaded
+ * @param width Width to resample to
+ * @param height Height to resample to
+ * @param cache_dir Directory caching the resampled pixels, outliving the loader; NULL for none
+ * @return false if the loader is full or already started, or the size is empty
+ */
+bool asset_loader_add_scaled(asset_loader_t *loader, const char *path, texture_t *destination,
+                             int width, int height, const char *cache_dir);
+
+/**
+ * @brief Have the high-score table read after the images, before the loader starts
+ * @param loader Loader to add to
+ * @param table Table to read, left alone by the main thread until asset_loader_wait_high_scores
+ * @return false if the loader already has a table or is started
+ */
+bool asset_loader_add_high_scores(asset_loader_t *loader, high_scores_t *table);
+
+/**
+ * @brief Start decoding the queued images
+ *
+ * Without a thread the images are decoded on the spot, as before.
+ *
+ * @param loader Loader to start
+ */
+void asset_loader_start(asset_loader_t *loader);
+
+/**
+ * @brief Upload the images decoded so far (main thread)
+ * @param loader Loader to poll
+ * @param renderer Renderer that owns the textures
+ * @return true once every image has been uploaded or has failed
+ */
+bool asset_loader_poll(asset_loader_t *loader, SDL_Renderer *renderer);
+
+/**
+ * @brief Check whether every image has been uploaded or has failed
+ * @param loader Loader to check
+ * @return true when nothing is left to load
+ */
+bool asset_loader_done(const asset_loader_t *loader);
+
+/**
+ * @brief Make sure the loader is done with the high-score table (main thread)
+ *
+ * Waits for the loader thread only if it hasn't read the table yet; the
+ * images it decoded are still uploaded by asset_loader_poll.
+ *
+ * @param loader Loader to wait for
+ */
+void asset_loader_wait_high_scores(asset_loader_t *loader);
+
+/**
+ * @brief Wait for the loader thread and drop any surfaces not uploaded
+ * @param loader Loader to stop
+ */
+void asset_loader_stop(asset_loader_t *loader);
+
+#endif // TETRIS_ASSET_LOADER_H
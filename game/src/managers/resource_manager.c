@@ -10,6 +10,7 @@
 #include "drawing_primitives.h"
 #include "arcade_font.h"
 #include "texture.h"
+#include "clock.h"
 #include <stdio.h>
 
 // Custom graphics context initialization that gets screen info first, calculates dimensions, then creates properly sized window
@@ -26,8 +27,11 @@ bool initialize_game_graphics(game_ptr game) {
         return false;
     }
     
-    // Calculate our desired window dimensions
-    calculate_window_dimensions(sdl_display_mode.w, sdl_display_mode.h);
+    // Calculate our desired window dimensions, around the board being played
+    int window_width = 0;
+    int window_height = 0;
+    game_layout_window_size(game->sim.board.width, game->sim.board.height, sdl_display_mode.w, sdl_display_mode.h,
+                            &window_width, &window_height);
     
     // Create window with our calculated dimensions
     game->graphics_context.screen_width = sdl_display_mode.w;
@@ -40,14 +44,41 @@ bool initialize_game_graphics(game_ptr game) {
         return false;
     }
     
+    // The layout follows the window from then on (game_update_layout)
+    SDL_SetWindowResizable(game->graphics_context.window, SDL_TRUE);
+    
     game->graphics_context.renderer = create_application_renderer(game->graphics_context.window, false);
     if (!game->graphics_context.renderer) {
         return false;
     }
     
+    // Lay out the drawable size, which is larger than the window on high-density displays
+    game_update_layout(game);
+    if (game->layout.width <= 0) {
+        game_layout_calculate(&game->layout, game->sim.board.width, game->sim.board.height,
+                              window_width, window_height);
+    }
+    
     return true;
 }
 
+/**
+ * Decode the background off the main thread, resampled to the window's layout; it's
+ * drawn once uploaded, replacing the one drawn so far. The high scores, if given,
+ * are read after it.
+ */
+static void queue_background(game_ptr game, const char *cache_dir, high_scores_t *high_scores) {
+    asset_loader_init(&game->asset_loader);
+    if (high_scores) {
+        asset_loader_add_high_scores(&game->asset_loader, high_scores);
+    }
+    asset_loader_add_scaled(&game->asset_loader, "game/assets/images/background.jpg", &game->background_texture,
+                            game->layout.width, game->layout.height, cache_dir);
+    asset_loader_start(&game->asset_loader);
+    game->background_width = game->layout.width;
+    game->background_height = game->layout.height;
+}
+
 bool load_game_resources(game_ptr game) {
     if (!game) {
         return false;
@@ -58,30 +89,54 @@ bool load_game_resources(game_ptr game) {
         printf("Failed to initialize graphics context\n");
         return false;
     }
+    startup_timing_mark(&game->startup_timing, "video");
     
     // Initialize audio context  
     game->audio_context = init_audio_context(8, 64); // 8 sounds max, half volume
+    startup_timing_mark(&game->startup_timing, "audio");
     
     // Initialize drawing primitives
     init_circle_lookup();
+    startup_timing_mark(&game->startup_timing, "circle lookup");
     
-    // Load arcade font
+    // Load arcade font, needed by the intro's first frame
     game->arcade_font = load_arcade_font(&game->graphics_context);
     if (!game->arcade_font.bitmap_font.texture.texture) {
         printf("Failed to load arcade font\n");
         return false;
     }
+    startup_timing_mark(&game->startup_timing, "font");
     
-    // Load background texture
-    game->background_texture = load_texture(game->graphics_context.renderer, "game/assets/images/background.jpg");
-    if (!game->background_texture.texture) {
-        printf("Failed to load background image\n");
-        return false;
-    }
+    // Read the high scores and decode the background off the main thread (or read it back from the disk cache)
+    queue_background(game, game->config.cache_dir, &game->high_scores);
+    startup_timing_mark(&game->startup_timing, "loader started");
     
     return true;
 }
 
+void update_game_resources(game_ptr game) {
+    if (!game) {
+        return;
+    }
+    
+    if (!asset_loader_done(&game->asset_loader)) {
+        if (asset_loader_poll(&game->asset_loader, game->graphics_context.renderer) &&
+            !game->startup_timing.reported) {
+            startup_timing_mark(&game->startup_timing, "assets ready");
+        }
+        return;
+    }
+    
+    // Resample the background once a resize has settled; the old one is stretched until
+    // then. Only the launch size is cached on disk, so resizing leaves no file per size.
+    bool resized = game->layout.width != game->background_width ||
+                   game->layout.height != game->background_height;
+    if (resized && get_clock_ticks_ms() - game->layout_changed_time >= LAYOUT_SETTLE_MS) {
+        asset_loader_stop(&game->asset_loader);
+        queue_background(game, NULL, NULL);
+    }
+}
+
 void free_game_resources(game_ptr game) {
     if (!game) {
         return;
@@ -90,7 +145,8 @@ void free_game_resources(game_ptr game) {
     // Cleanup font
     free_arcade_font(&game->arcade_font);
     
-    // Cleanup background texture
+    // Cleanup background texture, once the loader is done with it
+    asset_loader_stop(&game->asset_loader);
     free_texture(&game->background_texture);
     
     // Cleanup audio
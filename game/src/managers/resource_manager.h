@@ -13,12 +13,23 @@
 #include <stdbool.h>
 
 /**
- * @brief Load all game resources (graphics, audio, fonts)
+ * @brief Load the resources the first frame needs (graphics, audio, fonts)
+ * and start decoding the images in the background
  * @param game Game state to load resources into
  * @return true if all resources loaded successfully, false otherwise
  */
 bool load_game_resources(game_ptr game);
 
+/**
+ * @brief Upload the images decoded since the last frame (main thread)
+ *
+ * Once the window has been resized and the new size has held for
+ * LAYOUT_SETTLE_MS, the background is decoded again at that size.
+ *
+ * @param game Game state the images are loaded into
+ */
+void update_game_resources(game_ptr game);
+
 /**
  * @brief Free all game resources
  * @param game Game state containing resources to free
@@ -8,20 +8,29 @@
 #include "menu_stage.h"
 #include "playing_stage.h"
 #include "game_over_stage.h"
+#include "versus_stage.h"
+#include "online_stage.h"
+#include <stdlib.h>
 #include <string.h>
 
 /**
- * Register a stage with the director
+ * Register a stage with the director, carving its arena out of the reserved memory
  */
 static bool register_stage(stage_director_ptr director, game_screen_t screen_type, 
-                          stage_ptr (*create_fn)(void)) {
-    if (!director || director->stage_count >= MAX_STAGES) {
+                          stage_ptr (*create_fn)(stage_arena_ptr arena), size_t arena_size) {
+    if (!director || director->stage_count >= MAX_STAGES ||
+        director->arena_used + arena_size > STAGE_ARENA_MEMORY_SIZE) {
         return false;
     }
     
-    director->stages[director->stage_count].screen_type = screen_type;
-    director->stages[director->stage_count].create_stage_fn = create_fn;
-    director->stages[director->stage_count].instance = NULL;
+    stage_registry_entry_t *entry = &director->stages[director->stage_count];
+    entry->screen_type = screen_type;
+    entry->create_stage_fn = create_fn;
+    entry->instance = NULL;
+    stage_arena_init(&entry->arena,
+                     (unsigned char *)director->arena_memory + director->arena_used,
+                     arena_size);
+    director->arena_used += arena_size;
     director->stage_count++;
     
     return true;
@@ -53,7 +62,9 @@ static stage_ptr get_stage_instance(stage_registry_entry_t* entry) {
     }
     
     if (!entry->instance && entry->create_stage_fn) {
-        entry->instance = entry->create_stage_fn();
+        entry->instance = entry->create_stage_fn(&entry->arena);
+        // The stage outlives its state, so keep it across arena resets
+        stage_arena_keep(&entry->arena);
     }
     
     return entry->instance;
@@ -68,24 +79,47 @@ bool stage_director_init(stage_director_ptr director, game_ptr game) {
     director->stage_count = 0;
     director->current_stage = NULL;
     director->previous_screen = SCREEN_INTRO;
+    director->arena_used = 0;
+    
+    // Reserve the stage arenas once; transitions only reset them
+    director->arena_memory = malloc(STAGE_ARENA_MEMORY_SIZE);
+    if (!director->arena_memory) {
+        return false;
+    }
     
     // Register all stages
-    if (!register_stage(director, SCREEN_INTRO, create_intro_stage_instance)) {
+    if (!register_stage(director, SCREEN_INTRO, create_intro_stage_instance, STAGE_ARENA_SIZE)) {
+        return false;
+    }
+    
+    if (!register_stage(director, SCREEN_MENU, create_menu_stage_instance, STAGE_ARENA_SIZE)) {
+        return false;
+    }
+    
+    if (!register_stage(director, SCREEN_PLAYING, create_playing_stage_instance, STAGE_ARENA_SIZE)) {
         return false;
     }
     
-    if (!register_stage(director, SCREEN_MENU, create_menu_stage_instance)) {
+    if (!register_stage(director, SCREEN_GAME_OVER, create_game_over_stage_instance, STAGE_ARENA_SIZE)) {
         return false;
     }
     
-    if (!register_stage(director, SCREEN_PLAYING, create_playing_stage_instance)) {
+    if (!register_stage(director, SCREEN_VERSUS, create_versus_stage_instance, VERSUS_STAGE_ARENA_SIZE)) {
         return false;
     }
     
-    if (!register_stage(director, SCREEN_GAME_OVER, create_game_over_stage_instance)) {
+    // The online session itself lives on the heap, so a regular arena is enough
+    if (!register_stage(director, SCREEN_ONLINE, create_online_stage_instance, STAGE_ARENA_SIZE)) {
         return false;
     }
     
+    // Create every stage up front, so what a stage reuses on each entry is allocated once, here
+    for (size_t i = 0; i < director->stage_count; i++) {
+        if (!get_stage_instance(&director->stages[i])) {
+            return false;
+        }
+    }
+    
     // Initialize with intro stage
     stage_registry_entry_t* intro_entry = find_stage_entry(director, SCREEN_INTRO);
     if (!intro_entry) {
@@ -134,8 +168,8 @@ game_stage_action_t stage_director_update(stage_director_ptr director, game_ptr
             return action;
         }
         
-        // Cleanup current stage if it's different
-        if (director->current_stage != new_stage && director->current_stage->cleanup) {
+        // Cleanup current stage, even when re-entering it, so its arena is reset before init
+        if (director->current_stage->cleanup) {
             director->current_stage->cleanup(director->current_stage);
         }
         
@@ -166,5 +200,9 @@ void stage_director_cleanup(stage_director_ptr director) {
     }
     
     director->stage_count = 0;
+    director->arena_used = 0;
     director->current_stage = NULL;
+    
+    free(director->arena_memory);
+    director->arena_memory = NULL;
 }
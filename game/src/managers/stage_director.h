@@ -12,19 +12,27 @@
 
 #include "game.h"
 #include "stage.h"
+#include "versus_stage.h"
 
 /**
  * @brief Maximum number of stages that can be registered
  */
 #define MAX_STAGES 8
 
+/**
+ * @brief Memory reserved for all stage arenas: STAGE_ARENA_SIZE for each
+ * regular stage plus the larger versus arena, which holds two simulations
+ */
+#define STAGE_ARENA_MEMORY_SIZE ((MAX_STAGES - 1) * STAGE_ARENA_SIZE + VERSUS_STAGE_ARENA_SIZE)
+
 /**
  * @brief Stage registry entry
  */
 typedef struct {
     game_screen_t screen_type;
-    stage_ptr (*create_stage_fn)(void);
+    stage_ptr (*create_stage_fn)(stage_arena_ptr arena);
     stage_ptr instance;
+    stage_arena_t arena; // Holds the stage and its state
 } stage_registry_entry_t;
 
 typedef stage_registry_entry_t *stage_registry_entry_ptr;
@@ -35,6 +43,8 @@ typedef stage_registry_entry_t *stage_registry_entry_ptr;
 typedef struct {
     stage_registry_entry_t stages[MAX_STAGES];
     size_t stage_count;
+    void *arena_memory; // STAGE_ARENA_MEMORY_SIZE bytes reserved at init
+    size_t arena_used;  // Bytes already handed to registered stages
     stage_ptr current_stage;
     game_screen_t previous_screen;
 } stage_director_t;
@@ -0,0 +1,60 @@
+/**
+ * @file startup_timing.c
+ * @brief Startup timing breakdown implementation
+ */
+
+#include "startup_timing.h"
+#include <stdio.h>
+
+static double elapsed_ms(const startup_timing_t *timing) {
+    uint64_t ticks = SDL_GetPerformanceCounter() - timing->start;
+    return (double)ticks * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+void startup_timing_start(startup_timing_t *timing) {
+    if (!timing) {
+        return;
+    }
+    
+    timing->start = SDL_GetPerformanceCounter();
+    timing->count = 0;
+    timing->first_frame_ms = 0;
+    timing->reported = false;
+}
+
+void startup_timing_mark(startup_timing_t *timing, const char *name) {
+    if (!timing || timing->count >= STARTUP_TIMING_MAX_MARKS) {
+        return;
+    }
+    
+    timing->marks[timing->count].name = name;
+    timing->marks[timing->count].ms = elapsed_ms(timing);
+    timing->count++;
+}
+
+void startup_timing_first_frame(startup_timing_t *timing) {
+    if (!timing || timing->first_frame_ms > 0) {
+        return;
+    }
+    
+    timing->first_frame_ms = elapsed_ms(timing);
+    startup_timing_mark(timing, "first frame");
+}
+
+void startup_timing_report(startup_timing_t *timing) {
+    if (!timing || timing->reported) {
+        return;
+    }
+    timing->reported = true;
+    
+    printf("Startup timing (ms since launch, phase time):\n");
+    double previous = 0;
+    for (int i = 0; i < timing->count; i++) {
+        const startup_mark_t *mark = &timing->marks[i];
+        printf("  %-18s %8.1f %8.1f\n", mark->name, mark->ms, mark->ms - previous);
+        previous = mark->ms;
+    }
+    if (timing->first_frame_ms > STARTUP_FIRST_FRAME_BUDGET_MS) {
+        printf("  First frame over the %.0f ms budget\n", STARTUP_FIRST_FRAME_BUDGET_MS);
+    }
+}
@@ -0,0 +1,73 @@
+/**
+ * @file startup_timing.h
+ * @brief Breakdown of the time from launch to the first frame
+ *
+ * Each startup phase is marked as it finishes, against the high-resolution
+ * counter read at launch. The breakdown is printed once the first frame is
+ * on screen and the background assets have streamed in.
+ */
+
+#ifndef TETRIS_STARTUP_TIMING_H
+#define TETRIS_STARTUP_TIMING_H
+
+#include "graphics.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Most phases that can be marked
+ */
+#define STARTUP_TIMING_MAX_MARKS 12
+
+/**
+ * @brief Launch-to-first-frame budget, flagged in the breakdown when missed
+ */
+#define STARTUP_FIRST_FRAME_BUDGET_MS 150.0
+
+/**
+ * @brief One finished startup phase
+ */
+typedef struct {
+    const char *name; // Static string naming the phase
+    double ms;        // Time since launch when it finished
+} startup_mark_t;
+
+/**
+ * @brief Startup phases marked so far
+ */
+typedef struct {
+    uint64_t start; // Performance counter at launch
+    startup_mark_t marks[STARTUP_TIMING_MAX_MARKS];
+    int count;
+    double first_frame_ms; // 0 until the first frame is presented
+    bool reported;
+} startup_timing_t;
+
+typedef startup_timing_t *startup_timing_ptr;
+
+/**
+ * @brief Start timing from now
+ * @param timing Timing to reset
+ */
+void startup_timing_start(startup_timing_t *timing);
+
+/**
+ * @brief Mark a phase as finished now
+ * @param timing Timing to mark
+ * @param name Static string naming the phase
+ */
+void startup_timing_mark(startup_timing_t *timing, const char *name);
+
+/**
+ * @brief Mark the first frame as presented (only the first call counts)
+ * @param timing Timing to mark
+ */
+void startup_timing_first_frame(startup_timing_t *timing);
+
+/**
+ * @brief Print the breakdown, once
+ * @param timing Timing to report
+ */
+void startup_timing_report(startup_timing_t *timing);
+
+#endif // TETRIS_STARTUP_TIMING_H
@@ -0,0 +1,154 @@
+/**
+ * @file net_link.c
+ * @brief Packet link implementation
+ */
+
+#include "net_link.h"
+#include "utils.h"
+#include <string.h>
+
+static uint32_t random_below(uint64_t *state, uint32_t bound) {
+    return bound > 0 ? (uint32_t)((utils_next_random(state) >> 32) % bound) : 0;
+}
+
+static void init_link(net_link_t *link, const net_conditions_t *conditions) {
+    if (conditions) {
+        link->conditions = *conditions;
+    } else {
+        memset(&link->conditions, 0, sizeof(link->conditions));
+    }
+    
+    link->socket = NULL;
+    link->peer = NULL;
+    link->rng_state = (link->conditions.seed ^ 0x9E3779B97F4A7C15ULL) | 1;
+    link->delayed_count = 0;
+    link->inbox_head = 0;
+    link->inbox_count = 0;
+    link->bytes_sent = 0;
+    link->packets_sent = 0;
+    link->packets_dropped = 0;
+}
+
+/**
+ * Put a packet on the wire: the socket, or the peer's inbox for an in-memory link
+ */
+static void deliver(net_link_t *link, const uint8_t *data, size_t size) {
+    if (link->socket) {
+        udp_socket_send(link->socket, data, size);
+        return;
+    }
+    
+    net_link_t *peer = link->peer;
+    if (!peer || peer->inbox_count >= NET_LINK_QUEUE_CAPACITY) {
+        link->packets_dropped++;
+        return;
+    }
+    
+    net_link_packet_t *slot = &peer->inbox[(peer->inbox_head + peer->inbox_count) % NET_LINK_QUEUE_CAPACITY];
+    memcpy(slot->data, data, size);
+    slot->size = (uint16_t)size;
+    peer->inbox_count++;
+}
+
+void net_link_init_udp(net_link_t *link, udp_socket_t *sock, const net_conditions_t *conditions) {
+    if (!link) {
+        return;
+    }
+    
+    init_link(link, conditions);
+    link->socket = sock;
+}
+
+void net_link_init_pair(net_link_t *first, net_link_t *second, const net_conditions_t *conditions) {
+    if (!first || !second) {
+        return;
+    }
+    
+    init_link(first, conditions);
+    init_link(second, conditions);
+    first->peer = second;
+    second->peer = first;
+    
+    // Give the two directions their own loss and jitter patterns
+    second->rng_state = (second->rng_state * 0x2545F4914F6CDD1DULL) | 1;
+}
+
+void net_link_send(net_link_t *link, const uint8_t *data, size_t size, uint32_t now_ms) {
+    if (!link || !data || size == 0 || size > NET_PACKET_MAX_SIZE) {
+        return;
+    }
+    
+    link->packets_sent++;
+    link->bytes_sent += (uint32_t)size + NET_UDP_OVERHEAD;
+    
+    const net_conditions_t *conditions = &link->conditions;
+    if (conditions->loss_percent > 0 && (int)random_below(&link->rng_state, 100) < conditions->loss_percent) {
+        link->packets_dropped++;
+        return;
+    }
+    
+    uint32_t delay = (uint32_t)conditions->latency_ms;
+    if (conditions->jitter_ms > 0) {
+        delay += random_below(&link->rng_state, (uint32_t)conditions->jitter_ms + 1);
+    }
+    if (delay == 0) {
+        deliver(link, data, size);
+        return;
+    }
+    
+    // A real network would drop what it can't buffer too
+    if (link->delayed_count >= NET_LINK_QUEUE_CAPACITY) {
+        link->packets_dropped++;
+        return;
+    }
+    
+    net_link_packet_t *slot = &link->delayed[link->delayed_count++];
+    memcpy(slot->data, data, size);
+    slot->size = (uint16_t)size;
+    slot->due_ms = now_ms + delay;
+}
+
+void net_link_flush(net_link_t *link, uint32_t now_ms) {
+    if (!link) {
+        return;
+    }
+    
+    int i = 0;
+    while (i < link->delayed_count) {
+        net_link_packet_t *slot = &link->delayed[i];
+        if ((int32_t)(now_ms - slot->due_ms) < 0) {
+            i++;
+            continue;
+        }
+        
+        deliver(link, slot->data, slot->size);
+        
+        // Order among held packets doesn't matter: jitter already reorders them
+        *slot = link->delayed[--link->delayed_count];
+    }
+}
+
+size_t net_link_receive(net_link_t *link, uint8_t *buffer, size_t capacity) {
+    if (!link || !buffer) {
+        return 0;
+    }
+    
+    if (link->socket) {
+        return udp_socket_receive(link->socket, buffer, capacity);
+    }
+    
+    if (link->inbox_count == 0) {
+        return 0;
+    }
+    
+    net_link_packet_t *slot = &link->inbox[link->inbox_head];
+    link->inbox_head = (link->inbox_head + 1) % NET_LINK_QUEUE_CAPACITY;
+    link->inbox_count--;
+    
+    if (slot->size > capacity) {
+        return 0; // Too big for the caller, treat as lost
+    }
+    
+    memcpy(buffer, slot->data, slot->size);
+    return slot->size;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file net_link.h
+ * @brief Packet link between two peers, with simulated loss and latency
+ *
+ * The online session sends and receives through a link instead of a socket
+ * so the same code runs over UDP or over an in-memory pair in tests. Either
+ * kind of link can hold outgoing packets back by a latency plus random
+ * jitter and drop a percentage of them, all driven by a seeded generator
+ * and caller-supplied timestamps, so bad networks can be reproduced exactly
+ * in CI or played against on purpose from the command line.
+ */
+
+#ifndef BLOCKTRIS_NET_LINK_H_
+#define BLOCKTRIS_NET_LINK_H_
+
+#include "net_packet.h"
+#include "udp_socket.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Packets a link can hold back (outgoing) or queue up (incoming, in-memory links)
+#define NET_LINK_QUEUE_CAPACITY 64
+
+// IPv4 and UDP header bytes added to every datagram, counted in the bandwidth stats
+#define NET_UDP_OVERHEAD 28
+
+/**
+ * Simulated network conditions of the outgoing direction
+ */
+typedef struct {
+    int loss_percent; // Packets dropped, 0-100
+    int latency_ms;   // Delay added to every packet
+    int jitter_ms;    // Extra random delay of 0..jitter_ms, which can reorder packets
+    uint64_t seed;    // Seed of the loss and jitter draws
+} net_conditions_t;
+
+/**
+ * A packet held by a link
+ */
+typedef struct {
+    uint8_t data[NET_PACKET_MAX_SIZE];
+    uint16_t size;
+    uint32_t due_ms; // When a held-back packet goes out
+} net_link_packet_t;
+
+typedef struct net_link net_link_t;
+
+/**
+ * One end of a link
+ */
+struct net_link {
+    udp_socket_t *socket; // NULL for an in-memory link
+    net_link_t *peer;     // Receiving end of an in-memory link
+    net_conditions_t conditions;
+    uint64_t rng_state;
+    net_link_packet_t delayed[NET_LINK_QUEUE_CAPACITY]; // Held-back outgoing packets
+    int delayed_count;
+    net_link_packet_t inbox[NET_LINK_QUEUE_CAPACITY]; // Delivered packets of an in-memory link
+    int inbox_head;
+    int inbox_count;
+    uint32_t bytes_sent;      // Including NET_UDP_OVERHEAD per packet
+    uint32_t packets_sent;    // Packets handed to the link, dropped ones included
+    uint32_t packets_dropped; // Lost to the simulated conditions or a full queue
+};
+
+typedef net_link_t *net_link_ptr;
+
+/**
+ * Set up a link sending through a UDP socket
+ *
+ * @param link Pointer to the link to initialize
+ * @param sock Open socket (its peer may still be unknown)
+ * @param conditions Simulated conditions, or NULL for none
+ */
+void net_link_init_udp(net_link_t *link, udp_socket_t *sock, const net_conditions_t *conditions);
+
+/**
+ * Set up two in-memory links delivering to each other
+ *
+ * @param first One end
+ * @param second The other end
+ * @param conditions Simulated conditions of both directions, or NULL for none
+ */
+void net_link_init_pair(net_link_t *first, net_link_t *second, const net_conditions_t *conditions);
+
+/**
+ * Send a packet, subject to the simulated conditions
+ *
+ * @param link Pointer to the link
+ * @param data Packet contents
+ * @param size Packet size (at most NET_PACKET_MAX_SIZE)
+ * @param now_ms Current time in milliseconds
+ */
+void net_link_send(net_link_t *link, const uint8_t *data, size_t size, uint32_t now_ms);
+
+/**
+ * Send the held-back packets whose latency has passed
+ *
+ * @param link Pointer to the link
+ * @param now_ms Current time in milliseconds
+ */
+void net_link_flush(net_link_t *link, uint32_t now_ms);
+
+/**
+ * Receive one packet without blocking
+ *
+ * @param link Pointer to the link
+ * @param buffer Output buffer of at least NET_PACKET_MAX_SIZE bytes
+ * @param capacity Output buffer size in bytes
+ * @return Packet size, or 0 if none is pending
+ */
+size_t net_link_receive(net_link_t *link, uint8_t *buffer, size_t capacity);
+
+#endif // BLOCKTRIS_NET_LINK_H_
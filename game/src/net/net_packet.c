@@ -0,0 +1,148 @@
+/**
+ * @file net_packet.c
+ * @brief Online versus wire format implementation
+ */
+
+#include "net_packet.h"
+#include "constants.h"
+#include "piece_queue.h"
+#include "utils.h"
+
+// HELLO: magic, type, version, reply flag, seed (8), width, height, preview, lock delay (2), lock resets
+#define HELLO_SIZE 18
+
+// INPUT: magic, type, ack (4), first tick (4), advantage, run count, then (flags, length) pairs
+#define INPUT_HEADER_SIZE 12
+#define INPUT_MAX_RUN 255
+
+net_packet_type_t net_packet_type(const uint8_t *data, size_t size) {
+    if (!data || size < 2 || data[0] != NET_PACKET_MAGIC) {
+        return NET_PACKET_INVALID;
+    }
+    
+    if (data[1] == NET_PACKET_HELLO || data[1] == NET_PACKET_INPUT) {
+        return (net_packet_type_t)data[1];
+    }
+    
+    return NET_PACKET_INVALID;
+}
+
+size_t net_packet_write_hello(uint8_t *buffer, size_t capacity, const net_hello_t *hello) {
+    if (!buffer || !hello || capacity < HELLO_SIZE) {
+        return 0;
+    }
+    
+    buffer[0] = NET_PACKET_MAGIC;
+    buffer[1] = NET_PACKET_HELLO;
+    buffer[2] = NET_PROTOCOL_VERSION;
+    buffer[3] = hello->reply ? 1 : 0;
+    utils_write_u32_be(buffer + 4, (uint32_t)(hello->seed >> 32));
+    utils_write_u32_be(buffer + 8, (uint32_t)hello->seed);
+    buffer[12] = (uint8_t)hello->config.board_width;
+    buffer[13] = (uint8_t)hello->config.board_height;
+    buffer[14] = (uint8_t)hello->config.preview_depth;
+    utils_write_u16_be(buffer + 15, (uint32_t)hello->config.lock_delay_ms);
+    buffer[17] = (uint8_t)hello->config.lock_reset_limit;
+    
+    return HELLO_SIZE;
+}
+
+bool net_packet_read_hello(const uint8_t *data, size_t size, net_hello_t *hello) {
+    if (!hello || size < HELLO_SIZE || net_packet_type(data, size) != NET_PACKET_HELLO ||
+        data[2] != NET_PROTOCOL_VERSION) {
+        return false;
+    }
+    
+    hello->reply = data[3] != 0;
+    hello->seed = ((uint64_t)utils_read_u32_be(data + 4) << 32) | utils_read_u32_be(data + 8);
+    if (!hello->reply) {
+        return true; // A request carries no settings
+    }
+    
+    int width = data[12];
+    int height = data[13];
+    int preview = data[14];
+    int lock_delay = (int)utils_read_u16_be(data + 15);
+    int lock_resets = data[17];
+    
+    // Never build a simulation from settings the local command line would reject
+    if (width < MIN_BOARD_WIDTH || width > MAX_BOARD_WIDTH ||
+        height < MIN_BOARD_HEIGHT || height > MAX_BOARD_HEIGHT ||
+        preview < PIECE_QUEUE_MIN_DEPTH || preview > PIECE_QUEUE_MAX_DEPTH ||
+        lock_delay > MAX_LOCK_DELAY_MS || lock_resets > MAX_LOCK_RESET_LIMIT) {
+        return false;
+    }
+    
+    hello->config.board_width = width;
+    hello->config.board_height = height;
+    hello->config.preview_depth = preview;
+    hello->config.lock_delay_ms = lock_delay;
+    hello->config.lock_reset_limit = lock_resets;
+    
+    return true;
+}
+
+size_t net_packet_write_inputs(uint8_t *buffer, size_t capacity, const net_input_packet_t *packet) {
+    if (!buffer || !packet || capacity < INPUT_HEADER_SIZE) {
+        return 0;
+    }
+    
+    int count = packet->count < NET_PACKET_MAX_INPUTS ? packet->count : NET_PACKET_MAX_INPUTS;
+    size_t size = INPUT_HEADER_SIZE;
+    int runs = 0;
+    int i = 0;
+    
+    // Runs are written until the inputs or the buffer run out
+    while (i < count && size + 2 <= capacity && runs < UINT8_MAX) {
+        sim_input_t input = packet->inputs[i];
+        int length = 1;
+        while (i + length < count && length < INPUT_MAX_RUN && packet->inputs[i + length] == input) {
+            length++;
+        }
+        
+        buffer[size] = input;
+        buffer[size + 1] = (uint8_t)length;
+        size += 2;
+        runs++;
+        i += length;
+    }
+    
+    buffer[0] = NET_PACKET_MAGIC;
+    buffer[1] = NET_PACKET_INPUT;
+    utils_write_u32_be(buffer + 2, packet->ack_tick);
+    utils_write_u32_be(buffer + 6, packet->first_tick);
+    buffer[10] = (uint8_t)packet->advantage;
+    buffer[11] = (uint8_t)runs;
+    
+    return size;
+}
+
+bool net_packet_read_inputs(const uint8_t *data, size_t size, net_input_packet_t *packet) {
+    if (!packet || size < INPUT_HEADER_SIZE || net_packet_type(data, size) != NET_PACKET_INPUT) {
+        return false;
+    }
+    
+    int runs = data[11];
+    if (size < INPUT_HEADER_SIZE + (size_t)runs * 2) {
+        return false;
+    }
+    
+    packet->ack_tick = utils_read_u32_be(data + 2);
+    packet->first_tick = utils_read_u32_be(data + 6);
+    packet->advantage = (int8_t)data[10];
+    packet->count = 0;
+    
+    const uint8_t *run = data + INPUT_HEADER_SIZE;
+    for (int i = 0; i < runs; i++, run += 2) {
+        int length = run[1];
+        if (length == 0 || packet->count + length > NET_PACKET_MAX_INPUTS) {
+            return false;
+        }
+        
+        for (int j = 0; j < length; j++) {
+            packet->inputs[packet->count++] = run[0];
+        }
+    }
+    
+    return true;
+}
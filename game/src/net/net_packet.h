@@ -0,0 +1,118 @@
+/**
+ * @file net_packet.h
+ * @brief Wire format of the online versus protocol
+ *
+ * Two packet types travel between the peers:
+ *
+ *   HELLO  The joiner asks to play; the host answers with the seed and the
+ *          game settings both simulations must share.
+ *   INPUT  The sender's input flags for a range of ticks, plus how far it
+ *          has received the receiver's inputs (the ack).
+ *
+ * Inputs are run-length encoded as (flags, run length) byte pairs, which
+ * keeps an INPUT packet to a dozen or so bytes while keys are idle or held.
+ * Multi-byte fields are big-endian.
+ */
+
+#ifndef BLOCKTRIS_NET_PACKET_H_
+#define BLOCKTRIS_NET_PACKET_H_
+
+#include "blocktris_sim.h"
+#include "game_config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NET_PACKET_MAGIC 0xB7
+#define NET_PROTOCOL_VERSION 1
+
+// Largest datagram either peer sends
+#define NET_PACKET_MAX_SIZE 256
+
+// Most ticks of input a single INPUT packet carries
+#define NET_PACKET_MAX_INPUTS 128
+
+/**
+ * Packet types
+ */
+typedef enum {
+    NET_PACKET_INVALID = 0,
+    NET_PACKET_HELLO = 1,
+    NET_PACKET_INPUT = 2
+} net_packet_type_t;
+
+/**
+ * HELLO packet contents
+ */
+typedef struct {
+    bool reply;            // Sent by the host in answer to the joiner
+    uint64_t seed;         // Piece sequence seed (reply only)
+    game_config_t config;  // Board size, preview depth and lock delay (reply only)
+} net_hello_t;
+
+/**
+ * INPUT packet contents
+ */
+typedef struct {
+    uint32_t ack_tick;   // The sender has the receiver's inputs for all ticks below this
+    uint32_t first_tick; // Tick of inputs[0]
+    int8_t advantage;    // How many ticks the sender thinks it is ahead of the receiver
+    int count;           // Ticks of input carried
+    sim_input_t inputs[NET_PACKET_MAX_INPUTS];
+} net_input_packet_t;
+
+/**
+ * Get the type of a received datagram
+ *
+ * @param data Datagram contents
+ * @param size Datagram size in bytes
+ * @return Packet type, or NET_PACKET_INVALID if it isn't one of ours
+ */
+net_packet_type_t net_packet_type(const uint8_t *data, size_t size);
+
+/**
+ * Encode a HELLO packet
+ *
+ * @param buffer Output buffer
+ * @param capacity Output buffer size in bytes
+ * @param hello Packet contents
+ * @return Encoded size, or 0 if it doesn't fit
+ */
+size_t net_packet_write_hello(uint8_t *buffer, size_t capacity, const net_hello_t *hello);
+
+/**
+ * Decode a HELLO packet
+ *
+ * Settings outside the ranges the command line accepts make the packet invalid.
+ *
+ * @param data Datagram contents
+ * @param size Datagram size in bytes
+ * @param hello Output packet contents (config fields that aren't sent keep their values)
+ * @return true if the packet is a valid HELLO of this protocol version, false otherwise
+ */
+bool net_packet_read_hello(const uint8_t *data, size_t size, net_hello_t *hello);
+
+/**
+ * Encode an INPUT packet
+ *
+ * Inputs past the ones whose runs fit in the buffer are left out; the
+ * encoded packet is still valid and simply carries fewer ticks.
+ *
+ * @param buffer Output buffer
+ * @param capacity Output buffer size in bytes
+ * @param packet Packet contents
+ * @return Encoded size, or 0 if not even the header fits
+ */
+size_t net_packet_write_inputs(uint8_t *buffer, size_t capacity, const net_input_packet_t *packet);
+
+/**
+ * Decode an INPUT packet
+ *
+ * @param data Datagram contents
+ * @param size Datagram size in bytes
+ * @param packet Output packet contents
+ * @return true if the packet is a well-formed INPUT packet, false otherwise
+ */
+bool net_packet_read_inputs(const uint8_t *data, size_t size, net_input_packet_t *packet);
+
+#endif // BLOCKTRIS_NET_PACKET_H_
@@ -0,0 +1,287 @@
+/**
+ * @file rollback_session.c
+ * @brief Online versus session implementation
+ */
+
+#include "rollback_session.h"
+#include "constants.h"
+#include <string.h>
+
+#define WINDOW_SLOT(tick) ((tick) % NET_ROLLBACK_WINDOW)
+#define HISTORY_SLOT(tick) ((tick) % NET_INPUT_HISTORY)
+
+// Half a send interval in 1/16 ticks
+#define SEND_INTERVAL_BIAS (NET_SEND_INTERVAL_MS * 16 / (2 * SIM_TICK_MS))
+
+// Remote inputs further ahead of the local tick than this would overwrite history still in use
+#define MAX_REMOTE_LEAD (NET_INPUT_HISTORY - NET_ROLLBACK_WINDOW - NET_INPUT_DELAY_TICKS - 2)
+
+static void send_packet(rollback_session_t *session, const uint8_t *data, size_t size, uint32_t now_ms) {
+    net_link_send(session->link, data, size, now_ms);
+    session->last_send_ms = now_ms;
+}
+
+static void send_hello(rollback_session_t *session, bool reply, uint32_t now_ms) {
+    net_hello_t hello;
+    hello.reply = reply;
+    hello.seed = session->seed;
+    hello.config = session->config;
+    
+    uint8_t buffer[NET_PACKET_MAX_SIZE];
+    size_t size = net_packet_write_hello(buffer, sizeof(buffer), &hello);
+    send_packet(session, buffer, size, now_ms);
+}
+
+/**
+ * Ticks this peer is ahead of the peer's last known tick
+ */
+static int local_advantage(const rollback_session_t *session) {
+    return (int)((int32_t)(session->tick - session->remote_seen_end) + NET_INPUT_DELAY_TICKS);
+}
+
+/**
+ * Send every local input the peer hasn't acknowledged yet
+ */
+static void send_inputs(rollback_session_t *session, uint32_t now_ms) {
+    net_input_packet_t packet;
+    uint32_t first = session->remote_acked;
+    if (session->local_end - first > NET_PACKET_MAX_INPUTS) {
+        first = session->local_end - NET_PACKET_MAX_INPUTS;
+    }
+    
+    int advantage = local_advantage(session);
+    packet.ack_tick = session->remote_end;
+    packet.first_tick = first;
+    packet.advantage = (int8_t)(advantage > INT8_MAX ? INT8_MAX : advantage < INT8_MIN ? INT8_MIN : advantage);
+    packet.count = (int)(session->local_end - first);
+    for (int i = 0; i < packet.count; i++) {
+        packet.inputs[i] = session->inputs[session->local_player][HISTORY_SLOT(first + (uint32_t)i)];
+    }
+    
+    uint8_t buffer[NET_PACKET_MAX_SIZE];
+    size_t size = net_packet_write_inputs(buffer, sizeof(buffer), &packet);
+    send_packet(session, buffer, size, now_ms);
+}
+
+static void start_match(rollback_session_t *session, uint32_t now_ms) {
+    versus_match_init(&session->match, &session->config, session->seed);
+    memset(session->inputs, 0, sizeof(session->inputs));
+    
+    // Both peers know the delayed first ticks have no input
+    session->tick = 0;
+    session->local_end = NET_INPUT_DELAY_TICKS;
+    session->remote_end = NET_INPUT_DELAY_TICKS;
+    session->remote_acked = NET_INPUT_DELAY_TICKS;
+    session->remote_seen_end = NET_INPUT_DELAY_TICKS;
+    session->lead_average = 0;
+    session->resimulate_from = NET_NO_ROLLBACK;
+    session->last_receive_ms = now_ms;
+    session->status = NET_SESSION_RUNNING;
+}
+
+/**
+ * Save the state and step both players through the current tick
+ */
+static void simulate_tick(rollback_session_t *session) {
+    uint32_t tick = session->tick;
+    int remote = 1 - session->local_player;
+    
+    // Predict the remote player keeps holding its keys and starts no new action
+    if (tick >= session->remote_end) {
+        sim_input_t last = session->inputs[remote][HISTORY_SLOT(session->remote_end - 1)];
+        session->inputs[remote][HISTORY_SLOT(tick)] = (sim_input_t)(last & SIM_INPUT_HELD_MASK);
+    }
+    
+    versus_match_copy(&session->saved[WINDOW_SLOT(tick)], &session->match);
+    
+    // Players step in index order on both peers, so garbage lands identically
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        versus_match_step_player(&session->match, i, session->inputs[i][HISTORY_SLOT(tick)]);
+    }
+    session->tick++;
+}
+
+/**
+ * Go back to the earliest mispredicted tick and simulate up to the present again
+ */
+static void resimulate(rollback_session_t *session) {
+    if (session->resimulate_from == NET_NO_ROLLBACK) {
+        return;
+    }
+    
+    uint32_t end = session->tick;
+    session->tick = session->resimulate_from;
+    versus_match_copy(&session->match, &session->saved[WINDOW_SLOT(session->tick)]);
+    session->resimulate_from = NET_NO_ROLLBACK;
+    
+    // The saved dirty rows say nothing about what was published since: redraw every row
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        game_board_t *board = &session->match.players[i].sim.board;
+        board->dirty_rows = BOARD_ROW_MASK(board->height);
+    }
+    session->rollbacks++;
+    
+    while (session->tick < end) {
+        simulate_tick(session);
+        session->resimulated_ticks++;
+    }
+}
+
+static void receive_inputs(rollback_session_t *session, const net_input_packet_t *packet) {
+    int remote = 1 - session->local_player;
+    
+    // Acks only move forward and never past what was sent
+    if ((int32_t)(packet->ack_tick - session->remote_acked) > 0 &&
+        (int32_t)(packet->ack_tick - session->local_end) <= 0) {
+        session->remote_acked = packet->ack_tick;
+    }
+    
+    // Each side sees the other behind by the one-way latency, which cancels out
+    // in the difference of the two views: what is left is twice the real lead,
+    // less the half send interval the peer's view is older than ours on average
+    uint32_t end = packet->first_tick + (uint32_t)packet->count;
+    if ((int32_t)(end - session->remote_seen_end) > 0) {
+        session->remote_seen_end = end;
+        int lead = (local_advantage(session) - packet->advantage) * 16 + SEND_INTERVAL_BIAS;
+        session->lead_average += (lead - session->lead_average) / NET_SYNC_AVERAGE_WEIGHT;
+    }
+    
+    for (int i = 0; i < packet->count; i++) {
+        uint32_t tick = packet->first_tick + (uint32_t)i;
+        if ((int32_t)(tick - session->remote_end) < 0) {
+            continue; // Already known
+        }
+        if (tick != session->remote_end || (int32_t)(tick - session->tick) >= MAX_REMOTE_LEAD) {
+            break; // A gap or too far ahead; the peer sends it again until acknowledged
+        }
+        
+        // A tick already simulated with a different prediction has to be run again
+        sim_input_t input = packet->inputs[i];
+        sim_input_t *slot = &session->inputs[remote][HISTORY_SLOT(tick)];
+        if (tick < session->tick && *slot != input && tick < session->resimulate_from) {
+            session->resimulate_from = tick;
+        }
+        
+        *slot = input;
+        session->remote_end++;
+    }
+}
+
+static void receive_packets(rollback_session_t *session, uint32_t now_ms) {
+    uint8_t buffer[NET_PACKET_MAX_SIZE];
+    size_t size;
+    
+    while ((size = net_link_receive(session->link, buffer, sizeof(buffer))) > 0) {
+        net_packet_type_t type = net_packet_type(buffer, size);
+        
+        if (type == NET_PACKET_HELLO) {
+            net_hello_t hello;
+            hello.config = session->config;
+            if (!net_packet_read_hello(buffer, size, &hello)) {
+                continue;
+            }
+            
+            if (session->local_player == NET_HOST_PLAYER && !hello.reply) {
+                // Answer every request: the joiner keeps asking until a reply gets through
+                send_hello(session, true, now_ms);
+                if (session->status == NET_SESSION_CONNECTING) {
+                    start_match(session, now_ms);
+                }
+            } else if (session->local_player == NET_JOIN_PLAYER && hello.reply &&
+                       session->status == NET_SESSION_CONNECTING) {
+                session->config = hello.config;
+                session->seed = hello.seed;
+                start_match(session, now_ms);
+            }
+        } else if (type == NET_PACKET_INPUT && session->status == NET_SESSION_RUNNING) {
+            net_input_packet_t packet;
+            if (net_packet_read_inputs(buffer, size, &packet)) {
+                receive_inputs(session, &packet);
+                session->last_receive_ms = now_ms;
+            }
+        }
+    }
+}
+
+void rollback_session_init(rollback_session_t *session, net_link_t *link, int local_player,
+                           const game_config_t *config, uint64_t seed, uint32_t now_ms) {
+    if (!session || !link || !config) {
+        return;
+    }
+    
+    session->link = link;
+    session->status = NET_SESSION_CONNECTING;
+    session->local_player = local_player == NET_HOST_PLAYER ? NET_HOST_PLAYER : NET_JOIN_PLAYER;
+    session->config = *config;
+    session->seed = seed;
+    session->tick = 0;
+    session->rollbacks = 0;
+    session->resimulated_ticks = 0;
+    session->last_receive_ms = now_ms;
+    session->last_send_ms = now_ms - NET_HELLO_INTERVAL_MS; // Say hello on the first update
+}
+
+void rollback_session_update(rollback_session_t *session, uint32_t now_ms) {
+    if (!session || session->status == NET_SESSION_DISCONNECTED) {
+        return;
+    }
+    
+    net_link_flush(session->link, now_ms);
+    receive_packets(session, now_ms);
+    
+    if (session->status == NET_SESSION_CONNECTING) {
+        if (session->local_player == NET_JOIN_PLAYER && now_ms - session->last_send_ms >= NET_HELLO_INTERVAL_MS) {
+            send_hello(session, false, now_ms);
+        }
+        return;
+    }
+    
+    if (now_ms - session->last_receive_ms >= NET_TIMEOUT_MS) {
+        session->status = NET_SESSION_DISCONNECTED;
+        return;
+    }
+    
+    resimulate(session);
+    
+    if (now_ms - session->last_send_ms >= NET_SEND_INTERVAL_MS) {
+        send_inputs(session, now_ms);
+    }
+}
+
+bool rollback_session_advance(rollback_session_t *session, sim_input_t local_input) {
+    if (!session || session->status != NET_SESSION_RUNNING) {
+        return false;
+    }
+    
+    resimulate(session);
+    
+    // Going further would overwrite the state a late remote input may still need
+    if ((int32_t)(session->tick - session->remote_end) >= NET_ROLLBACK_WINDOW) {
+        return false;
+    }
+    
+    session->inputs[session->local_player][HISTORY_SLOT(session->local_end)] = local_input;
+    session->local_end++;
+    simulate_tick(session);
+    
+    return true;
+}
+
+bool rollback_session_should_wait(rollback_session_t *session) {
+    if (!session || session->status != NET_SESSION_RUNNING ||
+        session->lead_average < 2 * NET_SYNC_TOLERANCE_TICKS * 16) {
+        return false;
+    }
+    
+    // A skipped tick takes one off our lead and adds one to the peer's view of theirs
+    session->lead_average -= 2 * 16;
+    return true;
+}
+
+bool rollback_session_is_confirmed(const rollback_session_t *session) {
+    if (!session || session->status != NET_SESSION_RUNNING) {
+        return false;
+    }
+    
+    return session->resimulate_from == NET_NO_ROLLBACK && (int32_t)(session->remote_end - session->tick) >= 0;
+}
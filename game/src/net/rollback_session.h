@@ -0,0 +1,150 @@
+/**
+ * @file rollback_session.h
+ * @brief Online versus session: lockstep input exchange with rollback
+ *
+ * Both peers run the whole versus match. Only input flags cross the
+ * network: each tick's local input is scheduled NET_INPUT_DELAY_TICKS ahead
+ * and sent, run-length encoded and repeated until acknowledged, every
+ * NET_SEND_INTERVAL_MS. A tick whose remote input hasn't arrived yet is
+ * simulated with a prediction (the remote player keeps holding what it held
+ * last, with no new actions). When the real input turns out different, the
+ * session restores the state saved before that tick and simulates forward
+ * again, so both peers always converge on the same match.
+ *
+ * The state before each of the last NET_ROLLBACK_WINDOW ticks is kept, and
+ * the session stalls rather than predict further ahead of the remote player.
+ *
+ * The host (player 0) picks the seed and game settings and sends them in
+ * its HELLO reply; the joiner (player 1) adopts them before the match starts.
+ */
+
+#ifndef BLOCKTRIS_ROLLBACK_SESSION_H_
+#define BLOCKTRIS_ROLLBACK_SESSION_H_
+
+#include "versus_match.h"
+#include "net_link.h"
+#include "net_packet.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Ticks of saved state, so the deepest rollback (power of two)
+#define NET_ROLLBACK_WINDOW 32
+
+// Ticks of input kept per player; covers the rollback window plus the
+// remote player running up to a window ahead (power of two)
+#define NET_INPUT_HISTORY 128
+
+// Local inputs take effect this many ticks later, hiding that much latency
+// from the remote player before any rollback is needed
+#define NET_INPUT_DELAY_TICKS 2
+
+// About 17 INPUT packets per second: with the UDP/IP headers that stays
+// under 1 KB/s per player at the price of up to 60 ms of extra latency
+#define NET_SEND_INTERVAL_MS 60
+
+// The joiner repeats its HELLO until the host answers
+#define NET_HELLO_INTERVAL_MS 250
+
+// A peer silent for this long has gone
+#define NET_TIMEOUT_MS 5000
+
+// The peer further ahead than this holds back a tick to let the other catch up
+#define NET_SYNC_TOLERANCE_TICKS 2
+
+// Each INPUT packet moves the average lead 1/8 of the way to its own reading,
+// which smooths out how stale the packet was when it arrived
+#define NET_SYNC_AVERAGE_WEIGHT 8
+
+#define NET_HOST_PLAYER 0
+#define NET_JOIN_PLAYER 1
+
+/**
+ * Session status
+ */
+typedef enum {
+    NET_SESSION_CONNECTING,   // Waiting for the HELLO exchange
+    NET_SESSION_RUNNING,      // Match in progress
+    NET_SESSION_DISCONNECTED  // Peer timed out
+} net_session_status_t;
+
+/**
+ * Online versus session state
+ */
+typedef struct {
+    net_link_t *link;
+    net_session_status_t status;
+    int local_player;      // NET_HOST_PLAYER or NET_JOIN_PLAYER
+    game_config_t config;  // Settings of the match (the host's, once connected)
+    uint64_t seed;         // Piece seed of the match (the host's, once connected)
+    versus_match_t match;  // State after `tick` ticks, predicted from remote_end on
+    versus_match_t saved[NET_ROLLBACK_WINDOW];                // State before tick t at t % NET_ROLLBACK_WINDOW
+    sim_input_t inputs[VERSUS_PLAYERS][NET_INPUT_HISTORY];    // Input of tick t at t % NET_INPUT_HISTORY
+    uint32_t tick;            // Ticks simulated
+    uint32_t local_end;       // Local inputs are known for all ticks below this
+    uint32_t remote_end;      // Remote inputs are known for all ticks below this
+    uint32_t remote_acked;    // The peer has our inputs for all ticks below this
+    uint32_t remote_seen_end; // Furthest input tick the peer has sent
+    int lead_average;         // Average of our lead minus the peer's, in 1/16 ticks
+    uint32_t resimulate_from; // Earliest mispredicted tick, or NET_NO_ROLLBACK
+    uint32_t last_send_ms;
+    uint32_t last_receive_ms;
+    uint32_t rollbacks;         // Times the session went back to fix a prediction
+    uint32_t resimulated_ticks; // Ticks simulated again by those rollbacks
+} rollback_session_t;
+
+typedef rollback_session_t *rollback_session_ptr;
+
+#define NET_NO_ROLLBACK UINT32_MAX
+
+/**
+ * Set up a session; the match starts once the HELLO exchange is done
+ *
+ * @param session Pointer to the session to initialize
+ * @param link Link to the peer
+ * @param local_player NET_HOST_PLAYER or NET_JOIN_PLAYER
+ * @param config Match settings (the joiner's are replaced by the host's)
+ * @param seed Piece seed (ignored when joining)
+ * @param now_ms Current time in milliseconds
+ */
+void rollback_session_init(rollback_session_t *session, net_link_t *link, int local_player,
+                           const game_config_t *config, uint64_t seed, uint32_t now_ms);
+
+/**
+ * Exchange packets with the peer and fix any mispredicted ticks
+ *
+ * Call once per frame, before advancing.
+ *
+ * @param session Pointer to the session
+ * @param now_ms Current time in milliseconds
+ */
+void rollback_session_update(rollback_session_t *session, uint32_t now_ms);
+
+/**
+ * Simulate one tick with a new local input
+ *
+ * @param session Pointer to the session
+ * @param local_input SIM_INPUT_* flags of the local player
+ * @return true if the tick ran, false while connecting or stalled waiting for remote inputs
+ */
+bool rollback_session_advance(rollback_session_t *session, sim_input_t local_input);
+
+/**
+ * Check whether the local peer is far enough ahead to skip a tick
+ *
+ * Returning true counts the tick as skipped, so call it at most once per
+ * frame and hold back one tick whenever it says so.
+ *
+ * @param session Pointer to the session
+ * @return true if the caller should hold back one tick this frame
+ */
+bool rollback_session_should_wait(rollback_session_t *session);
+
+/**
+ * Check whether the current state rests on real inputs only
+ *
+ * @param session Pointer to the session
+ * @return true if no tick so far used a predicted remote input
+ */
+bool rollback_session_is_confirmed(const rollback_session_t *session);
+
+#endif // BLOCKTRIS_ROLLBACK_SESSION_H_
@@ -0,0 +1,138 @@
+/**
+ * @file udp_socket.c
+ * @brief Non-blocking IPv4 UDP socket implementation
+ */
+
+// getaddrinfo and friends are POSIX, not C99
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "udp_socket.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+bool udp_socket_open(udp_socket_t *sock, uint16_t port) {
+    if (!sock) {
+        return false;
+    }
+    
+    sock->fd = -1;
+    sock->has_peer = false;
+    
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    
+    // The game polls once per frame, so reads must never block
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0 ||
+        flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        close(fd);
+        return false;
+    }
+    
+    sock->fd = fd;
+    return true;
+}
+
+bool udp_socket_set_peer(udp_socket_t *sock, const char *host, uint16_t port) {
+    if (!sock || !host) {
+        return false;
+    }
+    
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    
+    struct addrinfo *result = NULL;
+    if (getaddrinfo(host, NULL, &hints, &result) != 0 || !result) {
+        return false;
+    }
+    
+    const struct sockaddr_in *address = (const struct sockaddr_in *)result->ai_addr;
+    sock->peer_address = address->sin_addr.s_addr;
+    sock->peer_port = htons(port);
+    sock->has_peer = true;
+    freeaddrinfo(result);
+    
+    return true;
+}
+
+uint16_t udp_socket_local_port(const udp_socket_t *sock) {
+    if (!sock || sock->fd < 0) {
+        return 0;
+    }
+    
+    struct sockaddr_in address;
+    socklen_t length = sizeof(address);
+    if (getsockname(sock->fd, (struct sockaddr *)&address, &length) < 0) {
+        return 0;
+    }
+    
+    return ntohs(address.sin_port);
+}
+
+bool udp_socket_send(udp_socket_t *sock, const void *data, size_t size) {
+    if (!sock || sock->fd < 0 || !sock->has_peer || !data) {
+        return false;
+    }
+    
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = sock->peer_address;
+    address.sin_port = sock->peer_port;
+    
+    ssize_t sent = sendto(sock->fd, data, size, 0, (const struct sockaddr *)&address, sizeof(address));
+    return sent == (ssize_t)size;
+}
+
+size_t udp_socket_receive(udp_socket_t *sock, void *buffer, size_t capacity) {
+    if (!sock || sock->fd < 0 || !buffer) {
+        return 0;
+    }
+    
+    for (;;) {
+        struct sockaddr_in address;
+        socklen_t length = sizeof(address);
+        ssize_t received = recvfrom(sock->fd, buffer, capacity, 0, (struct sockaddr *)&address, &length);
+        if (received <= 0) {
+            return 0; // Nothing pending (or a transient error, which reads the same to a poller)
+        }
+        
+        if (!sock->has_peer) {
+            sock->peer_address = address.sin_addr.s_addr;
+            sock->peer_port = address.sin_port;
+            sock->has_peer = true;
+        }
+        
+        // Drop strays from anyone but the peer and keep reading
+        if (address.sin_addr.s_addr == sock->peer_address && address.sin_port == sock->peer_port) {
+            return (size_t)received;
+        }
+    }
+}
+
+void udp_socket_close(udp_socket_t *sock) {
+    if (!sock || sock->fd < 0) {
+        return;
+    }
+    
+    close(sock->fd);
+    sock->fd = -1;
+    sock->has_peer = false;
+}
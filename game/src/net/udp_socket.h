@@ -0,0 +1,85 @@
+/**
+ * @file udp_socket.h
+ * @brief Non-blocking IPv4 UDP socket talking to a single peer
+ *
+ * A thin wrapper over POSIX sockets for online versus. The joining side sets
+ * its peer up front; the hosting side learns it from the first datagram it
+ * receives and ignores datagrams from any other address afterwards.
+ */
+
+#ifndef BLOCKTRIS_UDP_SOCKET_H_
+#define BLOCKTRIS_UDP_SOCKET_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * UDP socket and its peer address
+ */
+typedef struct {
+    int fd;                // -1 while closed
+    uint32_t peer_address; // IPv4 address in network byte order
+    uint16_t peer_port;    // Port in network byte order
+    bool has_peer;
+} udp_socket_t;
+
+typedef udp_socket_t *udp_socket_ptr;
+
+/**
+ * Open a non-blocking socket bound to a local port on all interfaces
+ *
+ * @param sock Pointer to the socket to open
+ * @param port Local port, or 0 for any free port
+ * @return true if the socket is open, false otherwise
+ */
+bool udp_socket_open(udp_socket_t *sock, uint16_t port);
+
+/**
+ * Resolve the peer every datagram is sent to
+ *
+ * @param sock Pointer to an open socket
+ * @param host Host name or dotted IPv4 address
+ * @param port Peer port
+ * @return true if the host resolved to an IPv4 address, false otherwise
+ */
+bool udp_socket_set_peer(udp_socket_t *sock, const char *host, uint16_t port);
+
+/**
+ * Get the local port the socket is bound to
+ *
+ * @param sock Pointer to an open socket
+ * @return Local port, or 0 if it can't be read
+ */
+uint16_t udp_socket_local_port(const udp_socket_t *sock);
+
+/**
+ * Send one datagram to the peer
+ *
+ * @param sock Pointer to an open socket
+ * @param data Datagram contents
+ * @param size Datagram size in bytes
+ * @return true if the datagram was handed to the OS, false if there is no peer or it failed
+ */
+bool udp_socket_send(udp_socket_t *sock, const void *data, size_t size);
+
+/**
+ * Receive one pending datagram from the peer without blocking
+ *
+ * Adopts the sender as the peer if none is set yet.
+ *
+ * @param sock Pointer to an open socket
+ * @param buffer Buffer for the datagram
+ * @param capacity Buffer size in bytes
+ * @return Datagram size, or 0 if nothing from the peer is pending
+ */
+size_t udp_socket_receive(udp_socket_t *sock, void *buffer, size_t capacity);
+
+/**
+ * Close the socket
+ *
+ * @param sock Pointer to the socket to close
+ */
+void udp_socket_close(udp_socket_t *sock);
+
+#endif // BLOCKTRIS_UDP_SOCKET_H_
@@ -0,0 +1,225 @@
+/**
+ * @file background_cache.c
+ * @brief Background resampling and disk cache implementation
+ */
+
+// mkdir is POSIX, not C99
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "background_cache.h"
+#include "utils.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+static const uint8_t CACHE_MAGIC[4] = { 'B', 'T', 'I', 'C' };
+
+// Bytes read at a time while hashing a source image
+#define HASH_CHUNK_SIZE 16384
+
+bool background_cache_hash_file(const char *path, uint64_t *hash) {
+    if (!path || !hash) {
+        return false;
+    }
+    
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    
+    uint8_t chunk[HASH_CHUNK_SIZE];
+    uint64_t value = UTILS_FNV64_OFFSET_BASIS;
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        value = utils_fnv1a_64(value, chunk, read);
+    }
+    bool ok = !ferror(file);
+    fclose(file);
+    
+    *hash = value;
+    return ok;
+}
+
+bool background_cache_path(char *out, size_t size, const char *dir, uint64_t hash, int width, int height) {
+    if (!out || !dir) {
+        return false;
+    }
+    
+    int length = snprintf(out, size, "%s/background-%08lx%08lx-%dx%d.raw", dir,
+                          (unsigned long)(hash >> 32), (unsigned long)(hash & 0xFFFFFFFFUL), width, height);
+    return length > 0 && (size_t)length < size;
+}
+
+static void encode_header(uint8_t *header, uint64_t hash, int width, int height) {
+    memcpy(header, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    utils_write_u16_le(header + 4, BACKGROUND_CACHE_VERSION);
+    utils_write_u16_le(header + 6, BACKGROUND_CACHE_PIXEL_SIZE);
+    utils_write_u32_le(header + 8, (uint32_t)width);
+    utils_write_u32_le(header + 12, (uint32_t)height);
+    utils_write_u64_le(header + 16, hash);
+}
+
+bool background_cache_load(const char *path, uint64_t hash, int width, int height, uint8_t *pixels, int pitch) {
+    if (!path || !pixels || width <= 0 || height <= 0) {
+        return false;
+    }
+    
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    
+    uint8_t header[BACKGROUND_CACHE_HEADER_SIZE];
+    uint8_t expected[BACKGROUND_CACHE_HEADER_SIZE];
+    encode_header(expected, hash, width, height);
+    bool ok = fread(header, 1, sizeof(header), file) == sizeof(header) &&
+              memcmp(header, expected, sizeof(header)) == 0;
+    
+    // Rows are read one by one unless the output is packed like the file
+    size_t row_size = (size_t)width * BACKGROUND_CACHE_PIXEL_SIZE;
+    if (ok && (size_t)pitch == row_size) {
+        ok = fread(pixels, row_size, (size_t)height, file) == (size_t)height;
+    } else {
+        for (int y = 0; ok && y < height; y++) {
+            ok = fread(pixels + (size_t)y * pitch, 1, row_size, file) == row_size;
+        }
+    }
+    
+    // Anything past the pixels means the file isn't what its header says
+    ok = ok && fgetc(file) == EOF;
+    fclose(file);
+    return ok;
+}
+
+bool background_cache_save(const char *dir, const char *path, uint64_t hash, int width, int height,
+                           const uint8_t *pixels, int pitch) {
+    if (!dir || !path || !pixels || width <= 0 || height <= 0) {
+        return false;
+    }
+    
+    char temp_path[BACKGROUND_CACHE_PATH_SIZE + 4];
+    if (snprintf(temp_path, sizeof(temp_path), "%s.tmp", path) >= (int)sizeof(temp_path)) {
+        return false;
+    }
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        return false;
+    }
+    
+    FILE *file = fopen(temp_path, "wb");
+    if (!file) {
+        return false;
+    }
+    
+    uint8_t header[BACKGROUND_CACHE_HEADER_SIZE];
+    encode_header(header, hash, width, height);
+    bool ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    
+    size_t row_size = (size_t)width * BACKGROUND_CACHE_PIXEL_SIZE;
+    for (int y = 0; ok && y < height; y++) {
+        ok = fwrite(pixels + (size_t)y * pitch, 1, row_size, file) == row_size;
+    }
+    
+    // No fsync: a file cut short by a crash fails the size check and is simply rebuilt
+    ok &= fclose(file) == 0;
+    if (!ok || rename(temp_path, path) != 0) {
+        remove(temp_path);
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+ * Average each target pixel's footprint in the source (both axes shrinking)
+ */
+static void resample_box(const uint8_t *src, int src_width, int src_height, int src_pitch,
+                         uint8_t *dst, int dst_width, int dst_height, int dst_pitch) {
+    for (int y = 0; y < dst_height; y++) {
+        int y0 = (int)((int64_t)y * src_height / dst_height);
+        int y1 = (int)((int64_t)(y + 1) * src_height / dst_height);
+        if (y1 <= y0) {
+            y1 = y0 + 1;
+        }
+        
+        uint8_t *out = dst + (size_t)y * dst_pitch;
+        for (int x = 0; x < dst_width; x++, out += BACKGROUND_CACHE_PIXEL_SIZE) {
+            int x0 = (int)((int64_t)x * src_width / dst_width);
+            int x1 = (int)((int64_t)(x + 1) * src_width / dst_width);
+            if (x1 <= x0) {
+                x1 = x0 + 1;
+            }
+            
+            uint64_t sums[BACKGROUND_CACHE_PIXEL_SIZE] = { 0 };
+            for (int sy = y0; sy < y1; sy++) {
+                const uint8_t *in = src + (size_t)sy * src_pitch + (size_t)x0 * BACKGROUND_CACHE_PIXEL_SIZE;
+                for (int sx = x0; sx < x1; sx++, in += BACKGROUND_CACHE_PIXEL_SIZE) {
+                    for (int c = 0; c < BACKGROUND_CACHE_PIXEL_SIZE; c++) {
+                        sums[c] += in[c];
+                    }
+                }
+            }
+            
+            uint64_t area = (uint64_t)(x1 - x0) * (uint64_t)(y1 - y0);
+            for (int c = 0; c < BACKGROUND_CACHE_PIXEL_SIZE; c++) {
+                out[c] = (uint8_t)((sums[c] + area / 2) / area);
+            }
+        }
+    }
+}
+
+/**
+ * Source position of a target pixel's centre, in 16.16 fixed point, clamped to the image
+ */
+static int64_t source_position(int i, int src_size, int dst_size) {
+    int64_t position = (((int64_t)(2 * i + 1) * src_size - dst_size) << 16) / (2 * (int64_t)dst_size);
+    int64_t last = (int64_t)(src_size - 1) << 16;
+    return position < 0 ? 0 : (position > last ? last : position);
+}
+
+/**
+ * Interpolate between the four nearest source pixels (either axis growing)
+ */
+static void resample_bilinear(const uint8_t *src, int src_width, int src_height, int src_pitch,
+                              uint8_t *dst, int dst_width, int dst_height, int dst_pitch) {
+    for (int y = 0; y < dst_height; y++) {
+        int64_t fy = source_position(y, src_height, dst_height);
+        int y0 = (int)(fy >> 16);
+        int y1 = y0 + 1 < src_height ? y0 + 1 : y0;
+        uint64_t wy = (uint64_t)(fy & 0xFFFF);
+        const uint8_t *row0 = src + (size_t)y0 * src_pitch;
+        const uint8_t *row1 = src + (size_t)y1 * src_pitch;
+        
+        uint8_t *out = dst + (size_t)y * dst_pitch;
+        for (int x = 0; x < dst_width; x++, out += BACKGROUND_CACHE_PIXEL_SIZE) {
+            int64_t fx = source_position(x, src_width, dst_width);
+            int x0 = (int)(fx >> 16);
+            int x1 = x0 + 1 < src_width ? x0 + 1 : x0;
+            uint64_t wx = (uint64_t)(fx & 0xFFFF);
+            
+            for (int c = 0; c < BACKGROUND_CACHE_PIXEL_SIZE; c++) {
+                uint64_t top = row0[x0 * BACKGROUND_CACHE_PIXEL_SIZE + c] * (65536 - wx) +
+                               row0[x1 * BACKGROUND_CACHE_PIXEL_SIZE + c] * wx;
+                uint64_t bottom = row1[x0 * BACKGROUND_CACHE_PIXEL_SIZE + c] * (65536 - wx) +
+                                  row1[x1 * BACKGROUND_CACHE_PIXEL_SIZE + c] * wx;
+                out[c] = (uint8_t)((top * (65536 - wy) + bottom * wy + ((uint64_t)1 << 31)) >> 32);
+            }
+        }
+    }
+}
+
+void background_cache_resample(const uint8_t *src, int src_width, int src_height, int src_pitch,
+                               uint8_t *dst, int dst_width, int dst_height, int dst_pitch) {
+    if (!src || !dst || src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+        return;
+    }
+    
+    if (src_width >= dst_width && src_height >= dst_height) {
+        resample_box(src, src_width, src_height, src_pitch, dst, dst_width, dst_height, dst_pitch);
+    } else {
+        resample_bilinear(src, src_width, src_height, src_pitch, dst, dst_width, dst_height, dst_pitch);
+    }
+}
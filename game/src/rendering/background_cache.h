@@ -0,0 +1,115 @@
+/**
+ * @file background_cache.h
+ * @brief Background image resampled to the window, cached on disk
+ *
+ * Drawing the full-resolution background scaled to the window every frame
+ * is a filtered blit of the whole image. Instead the image is resampled
+ * once, on the asset loader thread, to the exact window size, and the
+ * result is kept on disk: later launches at the same window size read the
+ * raw pixels back and skip the JPEG decode altogether.
+ *
+ * A cache file is keyed by a hash of the source image file and the target
+ * size, both in its name and in its header, so a changed asset or a new
+ * window size never picks up stale pixels.
+ *
+ * File layout, little-endian:
+ *
+ *   Header (BACKGROUND_CACHE_HEADER_SIZE bytes): magic "BTIC", version
+ *   (u16), bytes per pixel (u16), width (u32), height (u32), source hash
+ *   (u64)
+ *   Pixels: width * height * BACKGROUND_CACHE_PIXEL_SIZE bytes, rows top
+ *   to bottom, stored exactly as given
+ *
+ * Only 4-byte pixels are handled; the channels are averaged independently,
+ * so their order doesn't matter.
+ */
+
+#ifndef BACKGROUND_CACHE_H_
+#define BACKGROUND_CACHE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BACKGROUND_CACHE_VERSION 1
+#define BACKGROUND_CACHE_HEADER_SIZE 24
+#define BACKGROUND_CACHE_PIXEL_SIZE 4
+
+// Longest cache file path, including the terminator
+#define BACKGROUND_CACHE_PATH_SIZE 512
+
+/**
+ * Hash a source image file (FNV-1a over its bytes)
+ *
+ * Reading the file is far cheaper than decoding it.
+ *
+ * @param path Image file
+ * @param hash Output, the file's hash
+ * @return false if the file can't be read
+ */
+bool background_cache_hash_file(const char *path, uint64_t *hash);
+
+/**
+ * Build the cache file path for a source image at a size
+ *
+ * @param out Output path
+ * @param size Size of out
+ * @param dir Cache directory
+ * @param hash Source image hash
+ * @param width Target width
+ * @param height Target height
+ * @return false if the path doesn't fit
+ */
+bool background_cache_path(char *out, size_t size, const char *dir, uint64_t hash, int width, int height);
+
+/**
+ * Read cached pixels, if the file matches the hash and size
+ *
+ * @param path Cache file
+ * @param hash Source image hash expected
+ * @param width Width expected
+ * @param height Height expected
+ * @param pixels Output, width * height pixels, rows pitch bytes apart
+ * @param pitch Bytes from one output row to the next
+ * @return false on a missing, damaged or mismatched file (pixels may be partly written)
+ */
+bool background_cache_load(const char *path, uint64_t hash, int width, int height, uint8_t *pixels, int pitch);
+
+/**
+ * Write pixels to the cache, creating the directory if needed
+ *
+ * Written to a temporary file renamed into place, so a cache file is
+ * either whole or absent.
+ *
+ * @param dir Cache directory
+ * @param path Cache file, inside dir
+ * @param hash Source image hash
+ * @param width Width of the pixels
+ * @param height Height of the pixels
+ * @param pixels width * height pixels, rows pitch bytes apart
+ * @param pitch Bytes from one row to the next
+ * @return true if the file was written
+ */
+bool background_cache_save(const char *dir, const char *path, uint64_t hash, int width, int height,
+                           const uint8_t *pixels, int pitch);
+
+/**
+ * Resample an image to another size
+ *
+ * Shrinking averages every source pixel under each target pixel (a box
+ * filter), which keeps a downscaled photo from shimmering; growing
+ * interpolates between the four nearest source pixels.
+ *
+ * @param src Source pixels
+ * @param src_width Source width
+ * @param src_height Source height
+ * @param src_pitch Bytes from one source row to the next
+ * @param dst Output pixels
+ * @param dst_width Target width
+ * @param dst_height Target height
+ * @param dst_pitch Bytes from one output row to the next
+ */
+void background_cache_resample(const uint8_t *src, int src_width, int src_height, int src_pitch,
+                               uint8_t *dst, int dst_width, int dst_height, int dst_pitch);
+
+#endif // BACKGROUND_CACHE_H_
@@ -7,6 +7,7 @@
 #include "drawing_primitives.h"
 #include "blocktris_collision.h"
 #include "constants.h"
+#include "game_layout.h"
 #include "clock.h"
 #include "frame.h"
 #include "text.h"
@@ -14,7 +15,10 @@
 #include "bitmap_font.h"
 #include "geometry.h"
 #include "texture.h"
+#include "soft_raster.h"
+#include "line_clear_effect.h"
 #include <stdio.h>
+#include <stdint.h>
 
 // Color constants
 static const color_t BORDER_COLOR = COLOR(0, 0, 255); // Blue border
@@ -22,183 +26,273 @@ static const color_t GRID_COLOR = GRAY(64); // Dark gray grid
 static const int GHOST_ALPHA = 128; // Semi-transparent ghost piece
 static const color_t UI_BOX_COLOR = GRAY(64); // Semi-transparent dark gray for UI boxes
 
+static uint32_t canvas_pixel(color_t color) {
+    return soft_rgba(R(color), G(color), B(color), 255);
+}
+
+static uint32_t canvas_font_pixel(font_color_t color) {
+    switch (color) {
+        case FONT_COLOR_YELLOW:
+            return soft_rgba(255, 255, 0, 255);
+        case FONT_COLOR_CYAN:
+            return soft_rgba(0, 255, 255, 255);
+        case FONT_COLOR_RED:
+            return soft_rgba(255, 0, 0, 255);
+        default:
+            return soft_rgba(255, 255, 255, 255);
+    }
+}
+
+/*
+ * The target_* helpers draw to the layout's canvas when it has one and
+ * through the engine otherwise, so each render function has a single code path.
+ */
+
+static soft_canvas_t *target_canvas(const game_layout_t *layout) {
+    return layout ? layout->canvas : NULL;
+}
+
+static void target_clear(const game_layout_t *layout, const graphics_context_t *graphics_context) {
+    if (target_canvas(layout)) {
+        soft_canvas_clear(layout->canvas, soft_rgba(0, 0, 0, 255));
+    } else {
+        clear_frame((graphics_context_t*)graphics_context);
+    }
+}
+
+static void target_line(const game_layout_t *layout, const graphics_context_t *graphics_context,
+                        int x0, int y0, int x1, int y1, color_t color) {
+    if (target_canvas(layout)) {
+        soft_canvas_draw_line(layout->canvas, x0, y0, x1, y1, canvas_pixel(color));
+    } else {
+        draw_line((graphics_context_t*)graphics_context, x0, y0, x1, y1, color);
+    }
+}
+
+static void target_polygon(const game_layout_t *layout, const graphics_context_t *graphics_context,
+                           const SDL_Point *points, int count, color_t color) {
+    if (!target_canvas(layout)) {
+        draw_filled_polygon((graphics_context_t*)graphics_context, points, count, color);
+        return;
+    }
+    
+    soft_point_t vertices[SOFT_RASTER_MAX_POLYGON_POINTS];
+    if (count > SOFT_RASTER_MAX_POLYGON_POINTS) {
+        count = SOFT_RASTER_MAX_POLYGON_POINTS;
+    }
+    for (int i = 0; i < count; i++) {
+        vertices[i].x = points[i].x;
+        vertices[i].y = points[i].y;
+    }
+    soft_canvas_fill_polygon(layout->canvas, vertices, count, canvas_pixel(color));
+}
+
+static void target_text_alpha(const arcade_font_t *font, const game_layout_t *layout,
+                              const graphics_context_t *graphics_context,
+                              const char *text, int x, int y, font_color_t color, int scale, int alpha) {
+    if (target_canvas(layout)) {
+        soft_canvas_draw_text(layout->canvas, text, x, y, scale, canvas_font_pixel(color), alpha);
+    } else {
+        render_arcade_text_scaled_alpha((arcade_font_ptr)font, (graphics_context_ptr)graphics_context,
+                                        text, x, y, color, scale, alpha);
+    }
+}
+
+static void target_text(const arcade_font_t *font, const game_layout_t *layout,
+                        const graphics_context_t *graphics_context,
+                        const char *text, int x, int y, font_color_t color, int scale) {
+    if (target_canvas(layout)) {
+        soft_canvas_draw_text(layout->canvas, text, x, y, scale, canvas_font_pixel(color), 255);
+    } else {
+        render_arcade_text_scaled((arcade_font_ptr)font, (graphics_context_ptr)graphics_context,
+                                  text, x, y, color, scale);
+    }
+}
+
+static int target_text_width(const arcade_font_t *font, const game_layout_t *layout, const char *text, int scale) {
+    if (target_canvas(layout)) {
+        return soft_canvas_text_width(text, scale);
+    }
+    return get_arcade_text_width_scaled((arcade_font_ptr)font, text, scale);
+}
+
 bool blocktris_renderer_init(const graphics_context_t *graphics_context) {
     (void)graphics_context; // Not used for basic renderer
     return true;
 }
 
-void blocktris_renderer_render_game(const game_t *game, const graphics_context_t *graphics_context) {
-    if (!game || !graphics_context) {
+void blocktris_renderer_render_game(const game_t *game, const game_layout_t *layout,
+                                    const graphics_context_t *graphics_context) {
+    if (!game || !layout || !graphics_context) {
         return;
     }
     
     // Clear screen with background color
-    clear_frame((graphics_context_t*)graphics_context);
+    target_clear(layout, graphics_context);
     
     // Render background image
-    blocktris_renderer_render_background(game, graphics_context);
+    blocktris_renderer_render_background(game, layout, graphics_context);
     
     // Render game board and border
-    blocktris_renderer_render_board(game, graphics_context);
+    blocktris_renderer_render_board(game, layout, graphics_context);
     
     // Render placed pieces
-    blocktris_renderer_render_placed_pieces(&game->board, graphics_context);
+    blocktris_renderer_render_placed_pieces(&game->board, layout, graphics_context);
     
     // Render line clear effect if active
     if (game->line_clear_active) {
-        blocktris_renderer_render_line_clear_effect(game, graphics_context);
+        blocktris_renderer_render_line_clear_effect(game, layout, graphics_context);
     }
     
     // Render current piece if active
-    if (game->current_piece_type != PIECE_EMPTY) {
-        blocktris_renderer_render_ghost_piece(game, graphics_context);
-        blocktris_renderer_render_current_piece(game, graphics_context);
+    if (game->current_piece.active) {
+        blocktris_renderer_render_ghost_piece(game, layout, graphics_context);
+        blocktris_renderer_render_current_piece(game, layout, graphics_context);
     }
     
-    // Render next piece preview
-    blocktris_renderer_render_next_piece(game, graphics_context);
+    // Render next piece preview and the rest of the queue
+    blocktris_renderer_render_next_piece(game, layout, graphics_context);
+    blocktris_renderer_render_piece_queue(game, layout, graphics_context);
+    
+    // Render hold box
+    blocktris_renderer_render_hold_piece(game, layout, graphics_context);
     
     // Render UI elements
-    blocktris_renderer_render_ui(game, graphics_context);
+    blocktris_renderer_render_ui(game, layout, graphics_context);
     
     // Render countdown if active
     if (game->show_countdown) {
-        blocktris_renderer_render_countdown(game, graphics_context);
+        blocktris_renderer_render_countdown(game, layout, graphics_context);
     }
 }
 
-void blocktris_renderer_render_board(const game_t *game, const graphics_context_t *graphics_context) {
+void blocktris_renderer_render_board(const game_t *game, const game_layout_t *layout,
+                                     const graphics_context_t *graphics_context) {
     (void)game; // Board rendering doesn't need game state
     
     // Render 80% transparent background for playfield
-    blocktris_renderer_render_playfield_background(graphics_context);
+    blocktris_renderer_render_playfield_background(layout, graphics_context);
     
-    blocktris_renderer_render_board_border(graphics_context);
-    blocktris_renderer_render_board_grid(graphics_context);
+    blocktris_renderer_render_board_border(layout, graphics_context);
+    blocktris_renderer_render_board_grid(layout, graphics_context);
 }
 
-void blocktris_renderer_render_board_border(const graphics_context_t *graphics_context) {
-    if (!graphics_context) {
+void blocktris_renderer_render_board_border(const game_layout_t *layout, const graphics_context_t *graphics_context) {
+    if (!layout || !graphics_context) {
         return;
     }
     
-    int board_screen_width = BOARD_WIDTH * CELL_SIZE;
-    int board_screen_height = BOARD_HEIGHT * CELL_SIZE;
+    // Border corners, just outside the board
+    int left = layout->board_offset_x - BORDER_SIZE;
+    int top = layout->board_offset_y - BORDER_SIZE;
+    int right = layout->board_offset_x + layout->field_width + BORDER_SIZE;
+    int bottom = layout->board_offset_y + layout->field_height + BORDER_SIZE;
     
     // Draw border around the game board
     // Top border
-    draw_line((graphics_context_t*)graphics_context, 
-              BOARD_OFFSET_X - BORDER_SIZE, BOARD_OFFSET_Y - BORDER_SIZE,
-              BOARD_OFFSET_X + board_screen_width + BORDER_SIZE, BOARD_OFFSET_Y - BORDER_SIZE,
-              BORDER_COLOR);
+    target_line(layout, graphics_context, left, top, right, top, BORDER_COLOR);
     
     // Bottom border  
-    draw_line((graphics_context_t*)graphics_context,
-              BOARD_OFFSET_X - BORDER_SIZE, BOARD_OFFSET_Y + board_screen_height + BORDER_SIZE,
-              BOARD_OFFSET_X + board_screen_width + BORDER_SIZE, BOARD_OFFSET_Y + board_screen_height + BORDER_SIZE,
-              BORDER_COLOR);
+    target_line(layout, graphics_context, left, bottom, right, bottom, BORDER_COLOR);
     
     // Left border
-    draw_line((graphics_context_t*)graphics_context,
-              BOARD_OFFSET_X - BORDER_SIZE, BOARD_OFFSET_Y - BORDER_SIZE,
-              BOARD_OFFSET_X - BORDER_SIZE, BOARD_OFFSET_Y + board_screen_height + BORDER_SIZE,
-              BORDER_COLOR);
+    target_line(layout, graphics_context, left, top, left, bottom, BORDER_COLOR);
     
     // Right border
-    draw_line((graphics_context_t*)graphics_context,
-              BOARD_OFFSET_X + board_screen_width + BORDER_SIZE, BOARD_OFFSET_Y - BORDER_SIZE,
-              BOARD_OFFSET_X + board_screen_width + BORDER_SIZE, BOARD_OFFSET_Y + board_screen_height + BORDER_SIZE,
-              BORDER_COLOR);
+    target_line(layout, graphics_context, right, top, right, bottom, BORDER_COLOR);
 }
 
-void blocktris_renderer_render_board_grid(const graphics_context_t *graphics_context) {
-    if (!graphics_context) {
+void blocktris_renderer_render_board_grid(const game_layout_t *layout, const graphics_context_t *graphics_context) {
+    if (!layout || !graphics_context) {
         return;
     }
     
     // Draw vertical grid lines
-    for (int x = 1; x < BOARD_WIDTH; x++) {
-        int screen_x = BOARD_OFFSET_X + x * CELL_SIZE;
-        draw_line((graphics_context_t*)graphics_context,
-                  screen_x, BOARD_OFFSET_Y,
-                  screen_x, BOARD_OFFSET_Y + BOARD_HEIGHT * CELL_SIZE,
-                  GRID_COLOR);
+    for (int x = 1; x < layout->board_width; x++) {
+        int screen_x = layout->board_offset_x + x * layout->cell_size;
+        target_line(layout, graphics_context,
+                    screen_x, layout->board_offset_y,
+                    screen_x, layout->board_offset_y + layout->board_height * layout->cell_size,
+                    GRID_COLOR);
     }
     
     // Draw horizontal grid lines
-    for (int y = 1; y < BOARD_HEIGHT; y++) {
-        int screen_y = BOARD_OFFSET_Y + y * CELL_SIZE;
-        draw_line((graphics_context_t*)graphics_context,
-                  BOARD_OFFSET_X, screen_y,
-                  BOARD_OFFSET_X + BOARD_WIDTH * CELL_SIZE, screen_y,
-                  GRID_COLOR);
+    for (int y = 1; y < layout->board_height; y++) {
+        int screen_y = layout->board_offset_y + y * layout->cell_size;
+        target_line(layout, graphics_context,
+                    layout->board_offset_x, screen_y,
+                    layout->board_offset_x + layout->board_width * layout->cell_size, screen_y,
+                    GRID_COLOR);
     }
 }
 
-void blocktris_renderer_render_placed_pieces(const game_board_t *board, 
+void blocktris_renderer_render_placed_pieces(const game_board_t *board, const game_layout_t *layout, 
                                          const graphics_context_t *graphics_context) {
-    if (!board || !graphics_context) {
+    if (!board || !layout || !graphics_context) {
         return;
     }
     
-    for (int y = 0; y < BOARD_HEIGHT; y++) {
-        for (int x = 0; x < BOARD_WIDTH; x++) {
+    for (int y = 0; y < board->height; y++) {
+        for (int x = 0; x < board->width; x++) {
             if (game_board_is_cell_filled(board, x, y)) {
                 int screen_x, screen_y;
-                blocktris_renderer_board_to_screen(x, y, &screen_x, &screen_y);
+                blocktris_renderer_board_to_screen(layout, x, y, &screen_x, &screen_y);
                 
                 color_t cell_color = game_board_get_cell_color(board, x, y);
                 color_t border_color = COLOR(255, 255, 255); // White border
                 
-                blocktris_renderer_render_cell(screen_x, screen_y, CELL_SIZE, 
-                                           cell_color, border_color, graphics_context);
+                blocktris_renderer_render_cell(screen_x, screen_y, layout->cell_size, 
+                                           cell_color, border_color, layout, graphics_context);
             }
         }
     }
 }
 
-void blocktris_renderer_render_current_piece(const game_t *game, 
+void blocktris_renderer_render_current_piece(const game_t *game, const game_layout_t *layout, 
                                          const graphics_context_t *graphics_context) {
-    if (!game || !graphics_context || game->current_piece_type == PIECE_EMPTY) {
+    const blocktris_piece_t *piece = game ? &game->current_piece : NULL;
+    if (!piece || !piece->active || !layout || !graphics_context) {
         return;
     }
     
-    color_t piece_color = blocktris_piece_get_color(game->current_piece_type);
+    color_t piece_color = blocktris_piece_get_color(piece->type);
     color_t border_color = COLOR(255, 255, 255); // White border
     
     // Render each cell of the piece
     for (int py = 0; py < PIECE_SIZE; py++) {
         for (int px = 0; px < PIECE_SIZE; px++) {
-            if (blocktris_piece_is_cell_filled(game->current_piece_type, 
-                                           game->current_piece_rotation, px, py)) {
-                int board_x = game->current_piece_x + px;
-                int board_y = game->current_piece_y + py;
+            if (blocktris_piece_is_cell_filled(piece->type, piece->rotation, px, py)) {
+                int board_x = piece->x + px;
+                int board_y = piece->y + py;
                 
-                if (game_board_is_position_valid(board_x, board_y)) {
+                if (game_board_is_position_valid(&game->board, board_x, board_y)) {
+                    // Drawn part of the way to the next row as gravity builds up
                     int screen_x, screen_y;
-                    blocktris_renderer_board_to_screen(board_x, board_y, &screen_x, &screen_y);
+                    blocktris_renderer_board_to_screen_fixed(layout, board_x * SUBCELL_ONE,
+                                                             board_y * SUBCELL_ONE + game->piece_offset_y,
+                                                             &screen_x, &screen_y);
                     
-                    blocktris_renderer_render_cell(screen_x, screen_y, CELL_SIZE, 
-                                               piece_color, border_color, graphics_context);
+                    blocktris_renderer_render_cell(screen_x, screen_y, layout->cell_size, 
+                                               piece_color, border_color, layout, graphics_context);
                 }
             }
         }
     }
 }
 
-void blocktris_renderer_render_ghost_piece(const game_t *game, 
+void blocktris_renderer_render_ghost_piece(const game_t *game, const game_layout_t *layout, 
                                        const graphics_context_t *graphics_context) {
-    if (!game || !graphics_context || game->current_piece_type == PIECE_EMPTY) {
+    const blocktris_piece_t *piece = game ? &game->current_piece : NULL;
+    if (!piece || !piece->active || !layout || !graphics_context) {
         return;
     }
     
     // Find where the piece would land
-    int ghost_y = blocktris_collision_find_drop_position(&game->board, game->current_piece_type,
-                                                     game->current_piece_rotation,
-                                                     game->current_piece_x, game->current_piece_y);
+    int ghost_y = blocktris_collision_find_drop_position(&game->board, piece->type, piece->rotation,
+                                                     piece->x, piece->y);
     
     // Don't render ghost if it's at the same position as current piece
-    if (ghost_y == game->current_piece_y) {
+    if (ghost_y == piece->y) {
         return;
     }
     
@@ -207,81 +301,167 @@ void blocktris_renderer_render_ghost_piece(const game_t *game,
     // Render each cell of the ghost piece as white outline only
     for (int py = 0; py < PIECE_SIZE; py++) {
         for (int px = 0; px < PIECE_SIZE; px++) {
-            if (blocktris_piece_is_cell_filled(game->current_piece_type, 
-                                           game->current_piece_rotation, px, py)) {
-                int board_x = game->current_piece_x + px;
+            if (blocktris_piece_is_cell_filled(piece->type, piece->rotation, px, py)) {
+                int board_x = piece->x + px;
                 int board_y_ghost = ghost_y + py;
                 
-                if (game_board_is_position_valid(board_x, board_y_ghost)) {
+                if (game_board_is_position_valid(&game->board, board_x, board_y_ghost)) {
                     int screen_x, screen_y;
-                    blocktris_renderer_board_to_screen(board_x, board_y_ghost, &screen_x, &screen_y);
+                    blocktris_renderer_board_to_screen(layout, board_x, board_y_ghost, &screen_x, &screen_y);
                     
                     // Draw only the white border outline (no fill)
-                    draw_line((graphics_context_t*)graphics_context, 
-                             screen_x, screen_y, screen_x + CELL_SIZE, screen_y, white_outline); // Top
-                    draw_line((graphics_context_t*)graphics_context, 
-                             screen_x + CELL_SIZE, screen_y, screen_x + CELL_SIZE, screen_y + CELL_SIZE, white_outline); // Right
-                    draw_line((graphics_context_t*)graphics_context, 
-                             screen_x + CELL_SIZE, screen_y + CELL_SIZE, screen_x, screen_y + CELL_SIZE, white_outline); // Bottom
-                    draw_line((graphics_context_t*)graphics_context, 
-                             screen_x, screen_y + CELL_SIZE, screen_x, screen_y, white_outline); // Left
+                    int cell = layout->cell_size;
+                    target_line(layout, graphics_context, 
+                               screen_x, screen_y, screen_x + cell, screen_y, white_outline); // Top
+                    target_line(layout, graphics_context, 
+                               screen_x + cell, screen_y, screen_x + cell, screen_y + cell, white_outline); // Right
+                    target_line(layout, graphics_context, 
+                               screen_x + cell, screen_y + cell, screen_x, screen_y + cell, white_outline); // Bottom
+                    target_line(layout, graphics_context, 
+                               screen_x, screen_y + cell, screen_x, screen_y, white_outline); // Left
                 }
             }
         }
     }
 }
 
-void blocktris_renderer_render_next_piece(const game_t *game, 
+/**
+ * Render a bordered piece preview box with a label above it (NEXT, HOLD)
+ */
+static void render_piece_box(const game_t *game, const game_layout_t *layout,
+                             const graphics_context_t *graphics_context,
+                             int box_x, int box_y, const char *label,
+                             piece_type_t piece_type, color_t piece_color) {
+    // Draw blue border around the box
+    color_t border_color = COLOR(0, 100, 255); // Blue border
+    int border_thickness = 3;
+    
+    // Draw thick border
+    for (int i = 0; i < border_thickness; i++) {
+        target_line(layout, graphics_context, 
+                    box_x - i, box_y - i,
+                    box_x + NEXT_PIECE_SIZE(layout) + i, box_y - i, border_color);
+        target_line(layout, graphics_context,
+                    box_x + NEXT_PIECE_SIZE(layout) + i, box_y - i,
+                    box_x + NEXT_PIECE_SIZE(layout) + i, box_y + NEXT_PIECE_SIZE(layout) + i, border_color);
+        target_line(layout, graphics_context,
+                    box_x + NEXT_PIECE_SIZE(layout) + i, box_y + NEXT_PIECE_SIZE(layout) + i,
+                    box_x - i, box_y + NEXT_PIECE_SIZE(layout) + i, border_color);
+        target_line(layout, graphics_context,
+                    box_x - i, box_y + NEXT_PIECE_SIZE(layout) + i,
+                    box_x - i, box_y - i, border_color);
+    }
+    
+    // Render the label in yellow above the piece using arcade font with larger scale
+    int text_x = box_x + 5;
+    int text_y = box_y - 25; // Moved up slightly for larger text
+    target_text(&game->arcade_font, layout, graphics_context,
+               label, text_x, text_y, FONT_COLOR_YELLOW, 2);
+    
+    if (piece_type == PIECE_EMPTY) {
+        return;
+    }
+    
+    // Calculate piece position to center it in the box
+    int piece_cell_size = layout->cell_size / 2; // Smaller for previews
+    int piece_x = box_x + (NEXT_PIECE_SIZE(layout) - piece_cell_size * PIECE_SIZE) / 2;
+    int piece_y = box_y + (NEXT_PIECE_SIZE(layout) - piece_cell_size * PIECE_SIZE) / 2;
+    
+    blocktris_renderer_render_piece_at_position(piece_type, 0,
+                                            piece_x, piece_y, piece_cell_size,
+                                            piece_color, layout, graphics_context);
+}
+
+/**
+ * Render the semi-transparent background of a piece preview box, label included
+ */
+static void render_piece_box_background(const game_layout_t *layout, const graphics_context_t *graphics_context,
+                                        int box_x, int box_y) {
+    int padding = 5;
+    int x = box_x - padding;
+    int y = box_y - 30; // Include space for the label
+    int width = NEXT_PIECE_SIZE(layout) + padding * 2;
+    int height = NEXT_PIECE_SIZE(layout) + 35; // Extra height for text
+    
+    // Draw filled rectangle using horizontal lines
+    color_t semi_transparent_gray = COLOR(32, 32, 32);
+    for (int line_y = y; line_y < y + height; line_y++) {
+        target_line(layout, graphics_context, x, line_y, x + width, line_y, semi_transparent_gray);
+    }
+}
+
+void blocktris_renderer_render_next_piece(const game_t *game, const game_layout_t *layout, 
                                       const graphics_context_t *graphics_context) {
-    if (!game || !graphics_context || game->next_piece_type == PIECE_EMPTY) {
+    piece_type_t next_piece_type = game ? piece_queue_peek(&game->piece_queue, 0) : PIECE_EMPTY;
+    if (!layout || !graphics_context || next_piece_type == PIECE_EMPTY) {
         return;
     }
     
     // Render semi-transparent background for next piece box
-    blocktris_renderer_render_next_piece_background(graphics_context);
+    blocktris_renderer_render_next_piece_background(layout, graphics_context);
     
-    // Draw blue border around next piece area
-    color_t border_color = COLOR(0, 100, 255); // Blue border
-    int border_thickness = 3;
+    render_piece_box(game, layout, graphics_context, NEXT_PIECE_X(layout), NEXT_PIECE_Y(layout), "NEXT",
+                     next_piece_type, blocktris_piece_get_color(next_piece_type));
+}
+
+void blocktris_renderer_render_hold_piece(const game_t *game, const game_layout_t *layout, 
+                                      const graphics_context_t *graphics_context) {
+    if (!game || !layout || !graphics_context) {
+        return;
+    }
     
-    // Draw thick border
-    for (int i = 0; i < border_thickness; i++) {
-        draw_line((graphics_context_t*)graphics_context, 
-                  NEXT_PIECE_X - i, NEXT_PIECE_Y - i,
-                  NEXT_PIECE_X + NEXT_PIECE_SIZE + i, NEXT_PIECE_Y - i, border_color);
-        draw_line((graphics_context_t*)graphics_context,
-                  NEXT_PIECE_X + NEXT_PIECE_SIZE + i, NEXT_PIECE_Y - i,
-                  NEXT_PIECE_X + NEXT_PIECE_SIZE + i, NEXT_PIECE_Y + NEXT_PIECE_SIZE + i, border_color);
-        draw_line((graphics_context_t*)graphics_context,
-                  NEXT_PIECE_X + NEXT_PIECE_SIZE + i, NEXT_PIECE_Y + NEXT_PIECE_SIZE + i,
-                  NEXT_PIECE_X - i, NEXT_PIECE_Y + NEXT_PIECE_SIZE + i, border_color);
-        draw_line((graphics_context_t*)graphics_context,
-                  NEXT_PIECE_X - i, NEXT_PIECE_Y + NEXT_PIECE_SIZE + i,
-                  NEXT_PIECE_X - i, NEXT_PIECE_Y - i, border_color);
-    }
-    
-    // Render "NEXT" text in yellow above the piece using arcade font with larger scale
-    const char* next_text = "NEXT";
-    int text_x = NEXT_PIECE_X + 5;
-    int text_y = NEXT_PIECE_Y - 25; // Moved up slightly for larger text
-    render_arcade_text_scaled((arcade_font_ptr)&game->arcade_font,
-                             (graphics_context_ptr)graphics_context,
-                             next_text, text_x, text_y, FONT_COLOR_YELLOW, 2);
+    render_piece_box_background(layout, graphics_context, HOLD_PIECE_X(layout), HOLD_PIECE_Y(layout));
     
-    // Calculate piece position to center it in the box
-    int piece_cell_size = CELL_SIZE / 2; // Smaller for next piece preview
-    int piece_x = NEXT_PIECE_X + (NEXT_PIECE_SIZE - piece_cell_size * PIECE_SIZE) / 2;
-    int piece_y = NEXT_PIECE_Y + (NEXT_PIECE_SIZE - piece_cell_size * PIECE_SIZE) / 2;
+    // Dim the held piece while it can't be swapped back
+    piece_type_t hold_piece_type = game->hold_type;
+    color_t piece_color = blocktris_piece_get_color(hold_piece_type);
+    if (game->hold_used) {
+        piece_color = blocktris_renderer_get_alpha_color(piece_color, GHOST_ALPHA);
+    }
     
-    color_t piece_color = blocktris_piece_get_color(game->next_piece_type);
+    render_piece_box(game, layout, graphics_context, HOLD_PIECE_X(layout), HOLD_PIECE_Y(layout), "HOLD",
+                     hold_piece_type, piece_color);
+}
+
+void blocktris_renderer_render_piece_queue(const game_t *game, const game_layout_t *layout, 
+                                       const graphics_context_t *graphics_context) {
+    if (!game || !layout || !graphics_context || game->piece_queue.depth <= 1) {
+        return;
+    }
     
-    blocktris_renderer_render_piece_at_position(game->next_piece_type, 0,
-                                            piece_x, piece_y, piece_cell_size,
-                                            piece_color, graphics_context);
+    int slots = game->piece_queue.depth - 1;
+    int padding = 5;
+    
+    // Render semi-transparent background for the queue column
+    color_t semi_transparent_gray = COLOR(32, 32, 32);
+    for (int line_y = QUEUE_PREVIEW_Y(layout) - padding;
+         line_y < QUEUE_PREVIEW_Y(layout) + slots * QUEUE_PREVIEW_SIZE(layout) + padding; line_y++) {
+        target_line(layout, graphics_context,
+                    QUEUE_PREVIEW_X(layout) - padding, line_y,
+                    QUEUE_PREVIEW_X(layout) + QUEUE_PREVIEW_SIZE(layout) + padding, line_y, semi_transparent_gray);
+    }
+    
+    // Render each queued piece in its own slot, smaller than the next piece
+    int piece_cell_size = QUEUE_PREVIEW_SIZE(layout) / PIECE_SIZE;
+    for (int i = 0; i < slots; i++) {
+        piece_type_t piece_type = piece_queue_peek(&game->piece_queue, i + 1);
+        if (piece_type == PIECE_EMPTY) {
+            continue;
+        }
+        
+        int piece_x = QUEUE_PREVIEW_X(layout) + (QUEUE_PREVIEW_SIZE(layout) - piece_cell_size * PIECE_SIZE) / 2;
+        int piece_y = QUEUE_PREVIEW_Y(layout) + i * QUEUE_PREVIEW_SIZE(layout) +
+                      (QUEUE_PREVIEW_SIZE(layout) - piece_cell_size * PIECE_SIZE) / 2;
+        
+        blocktris_renderer_render_piece_at_position(piece_type, 0,
+                                                piece_x, piece_y, piece_cell_size,
+                                                blocktris_piece_get_color(piece_type), layout, graphics_context);
+    }
 }
 
 void blocktris_renderer_render_piece_at_position(piece_type_t piece_type, int rotation,
                                              int x, int y, int cell_size, color_t color,
+                                             const game_layout_t *layout,
                                              const graphics_context_t *graphics_context) {
     if (!graphics_context) {
         return;
@@ -296,14 +476,15 @@ void blocktris_renderer_render_piece_at_position(piece_type_t piece_type, int ro
                 int cell_y = y + py * cell_size;
                 
                 blocktris_renderer_render_cell(cell_x, cell_y, cell_size, 
-                                           color, border_color, graphics_context);
+                                           color, border_color, layout, graphics_context);
             }
         }
     }
 }
 
 void blocktris_renderer_render_cell(int x, int y, int size, color_t fill_color, 
-                                color_t border_color, const graphics_context_t *graphics_context) {
+                                color_t border_color, const game_layout_t *layout,
+                                const graphics_context_t *graphics_context) {
     if (!graphics_context) {
         return;
     }
@@ -315,93 +496,114 @@ void blocktris_renderer_render_cell(int x, int y, int size, color_t fill_color,
         {x + size, y + size},
         {x, y + size}
     };
-    draw_filled_polygon((graphics_context_t*)graphics_context, points, 4, fill_color);
+    target_polygon(layout, graphics_context, points, 4, fill_color);
     
     // Draw border
-    draw_line((graphics_context_t*)graphics_context, x, y, x + size, y, border_color); // Top
-    draw_line((graphics_context_t*)graphics_context, x + size, y, x + size, y + size, border_color); // Right
-    draw_line((graphics_context_t*)graphics_context, x + size, y + size, x, y + size, border_color); // Bottom
-    draw_line((graphics_context_t*)graphics_context, x, y + size, x, y, border_color); // Left
+    target_line(layout, graphics_context, x, y, x + size, y, border_color); // Top
+    target_line(layout, graphics_context, x + size, y, x + size, y + size, border_color); // Right
+    target_line(layout, graphics_context, x + size, y + size, x, y + size, border_color); // Bottom
+    target_line(layout, graphics_context, x, y + size, x, y, border_color); // Left
 }
 
-void blocktris_renderer_render_ui(const game_t *game, const graphics_context_t *graphics_context) {
-    if (!game || !graphics_context) {
+void blocktris_renderer_render_ui(const game_t *game, const game_layout_t *layout,
+                                 const graphics_context_t *graphics_context) {
+    if (!game || !layout || !graphics_context) {
         return;
     }
     
     // Render semi-transparent background for score box
-    blocktris_renderer_render_score_background(graphics_context);
+    blocktris_renderer_render_score_background(layout, graphics_context);
     
     // Render score in a bordered box
     color_t border_color = COLOR(255, 255, 255); // White border
     // Removed unused text_color variable
-    int box_width = NEXT_PIECE_SIZE;
+    int box_width = NEXT_PIECE_SIZE(layout);
     int box_height = 60;
+    int score_x = SCORE_X(layout);
+    int score_y = SCORE_Y(layout);
     
     // Draw score box border
-    draw_line((graphics_context_t*)graphics_context, 
-              SCORE_X, SCORE_Y, SCORE_X + box_width, SCORE_Y, border_color);
-    draw_line((graphics_context_t*)graphics_context,
-              SCORE_X + box_width, SCORE_Y, SCORE_X + box_width, SCORE_Y + box_height, border_color);
-    draw_line((graphics_context_t*)graphics_context,
-              SCORE_X + box_width, SCORE_Y + box_height, SCORE_X, SCORE_Y + box_height, border_color);
-    draw_line((graphics_context_t*)graphics_context,
-              SCORE_X, SCORE_Y + box_height, SCORE_X, SCORE_Y, border_color);
+    target_line(layout, graphics_context, 
+                score_x, score_y, score_x + box_width, score_y, border_color);
+    target_line(layout, graphics_context,
+                score_x + box_width, score_y, score_x + box_width, score_y + box_height, border_color);
+    target_line(layout, graphics_context,
+                score_x + box_width, score_y + box_height, score_x, score_y + box_height, border_color);
+    target_line(layout, graphics_context,
+                score_x, score_y + box_height, score_x, score_y, border_color);
     
     // Render "SCORE" label using arcade font
     const char* score_label = "SCORE";
-    render_arcade_text_scaled((arcade_font_ptr)&game->arcade_font,
-                             (graphics_context_ptr)graphics_context,
-                             score_label, SCORE_X + 10, SCORE_Y + 10, FONT_COLOR_YELLOW, 2);
+    target_text(&game->arcade_font, layout, graphics_context,
+               score_label, score_x + 10, score_y + 10, FONT_COLOR_YELLOW, 2);
     
     // Render score value using arcade font
     char score_text[32];
     snprintf(score_text, sizeof(score_text), "%d", game->score);
-    render_arcade_text_scaled((arcade_font_ptr)&game->arcade_font,
-                             (graphics_context_ptr)graphics_context,
-                             score_text, SCORE_X + 10, SCORE_Y + 35, FONT_COLOR_WHITE, 2);
+    target_text(&game->arcade_font, layout, graphics_context,
+               score_text, score_x + 10, score_y + 35, FONT_COLOR_WHITE, 2);
 }
 
-void blocktris_renderer_render_line_clear_effect(const game_t *game, 
+void blocktris_renderer_render_line_clear_effect(const game_t *game, const game_layout_t *layout, 
                                              const graphics_context_t *graphics_context) {
-    if (!game || !graphics_context || !game->line_clear_active) {
+    if (!game || !layout || !graphics_context || !game->line_clear_active) {
         return;
     }
-    
-    timestamp_ms_t elapsed = get_clock_ticks_ms() - game->line_clear_start_time;
-    if (elapsed > LINE_CLEAR_DELAY) {
+    if (!layout->canvas && !graphics_context->renderer) {
         return;
     }
     
-    // Create flashing effect
-    int flash_interval = 100;
-    bool flash_on = (elapsed / flash_interval) % 2 == 0;
+    uint32_t elapsed = (game->sim_tick - game->line_clear_start_tick) * SIM_TICK_MS;
+    int t = line_clear_effect_time(elapsed, LINE_CLEAR_DELAY);
     
-    if (flash_on) {
-        color_t flash_color = COLOR(255, 255, 255); // White flash
-        
-        for (int i = 0; i < game->num_lines_to_clear; i++) {
-            int line = game->lines_to_clear[i];
-            if (line >= 0 && line < BOARD_HEIGHT) {
-                int screen_x, screen_y;
-                blocktris_renderer_board_to_screen(0, line, &screen_x, &screen_y);
-                
-                // Draw line across the entire width
-                draw_thick_line((graphics_context_t*)graphics_context,
-                               screen_x, screen_y + CELL_SIZE / 2,
-                               screen_x + BOARD_WIDTH * CELL_SIZE, screen_y + CELL_SIZE / 2,
-                               flash_color);
-            }
+    line_clear_batch_t batch;
+    line_clear_effect_build(&batch, game->lines_to_clear, layout->board_width, layout->board_height, t,
+                            layout->board_offset_x, layout->board_offset_y, layout->cell_size);
+    if (batch.quad_count == 0 || batch.alpha == 0) {
+        return;
+    }
+    
+    if (layout->canvas) {
+        for (int i = 0; i < batch.quad_count; i++) {
+            const line_clear_quad_t *quad = &batch.quads[i];
+            soft_canvas_blend_rect(layout->canvas, quad->x, quad->y, quad->width, quad->height,
+                                   soft_rgba(255, 255, 255, 255), batch.alpha);
         }
+        return;
+    }
+    
+    // Every row shares the colour, so the whole flash is one draw call
+    SDL_Rect rects[MAX_BOARD_HEIGHT];
+    for (int i = 0; i < batch.quad_count; i++) {
+        const line_clear_quad_t *quad = &batch.quads[i];
+        rects[i] = (SDL_Rect){ quad->x, quad->y, quad->width, quad->height };
     }
+    
+    SDL_SetRenderDrawBlendMode(graphics_context->renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(graphics_context->renderer, 255, 255, 255, (Uint8)batch.alpha);
+    SDL_RenderFillRects(graphics_context->renderer, rects, batch.quad_count);
+    SDL_SetRenderDrawBlendMode(graphics_context->renderer, SDL_BLENDMODE_NONE);
+}
+
+void blocktris_renderer_board_to_screen(const game_layout_t *layout, int board_x, int board_y,
+                                        int *screen_x, int *screen_y) {
+    blocktris_renderer_board_to_screen_fixed(layout, board_x * SUBCELL_ONE, board_y * SUBCELL_ONE,
+                                             screen_x, screen_y);
 }
 
-void blocktris_renderer_board_to_screen(int board_x, int board_y, int *screen_x, int *screen_y) {
+void blocktris_renderer_board_to_screen_fixed(const game_layout_t *layout, int board_x, int board_y,
+                                              int *screen_x, int *screen_y) {
+    if (!layout) {
+        return;
+    }
+    
+    // Rounded to the nearest pixel; whole cells land exactly where they always did
+    int64_t cell = layout->cell_size;
     if (screen_x) {
-        *screen_x = BOARD_OFFSET_X + board_x * CELL_SIZE;
+        *screen_x = layout->board_offset_x + (int)((board_x * cell + SUBCELL_ONE / 2) >> SUBCELL_BITS);
     }
     if (screen_y) {
-        *screen_y = BOARD_OFFSET_Y + board_y * CELL_SIZE;
+        *screen_y = layout->board_offset_y + (int)((board_y * cell + SUBCELL_ONE / 2) >> SUBCELL_BITS);
     }
 }
 
@@ -421,29 +623,44 @@ color_t blocktris_renderer_get_alpha_color(color_t base_color, int alpha) {
 }
 
 
-void blocktris_renderer_render_background(const game_t *game, const graphics_context_t *graphics_context) {
+void blocktris_renderer_render_background(const game_t *game, const game_layout_t *layout,
+                                          const graphics_context_t *graphics_context) {
+    if (!layout) {
+        return;
+    }
+    if (layout->canvas) {
+        if (layout->canvas_background) {
+            soft_canvas_blit(layout->canvas, layout->canvas_background, 0, 0, layout->width, layout->height);
+        }
+        return;
+    }
     if (!game || !graphics_context || !game->background_texture.texture) {
         return;
     }
     
-    // Create destination rectangle to cover the entire screen
-    rect_t dst_rect = make_rect(0, 0, graphics_context->screen_width, graphics_context->screen_height);
+    // Resampled to the window when loaded, so a 1:1 copy; stretched while a resize settles
+    rect_t dst_rect = make_rect(0, 0, layout->width, layout->height);
     
-    // Render the background texture scaled to fit the entire screen
     render_sprite((graphics_context_ptr)graphics_context, (texture_ptr)&game->background_texture, NULL, &dst_rect);
 }
 
-void blocktris_renderer_render_playfield_background(const graphics_context_t *graphics_context) {
-    if (!graphics_context || !graphics_context->renderer) {
+void blocktris_renderer_render_playfield_background(const game_layout_t *layout,
+                                                    const graphics_context_t *graphics_context) {
+    if (!layout || (!layout->canvas && (!graphics_context || !graphics_context->renderer))) {
         return;
     }
     
     // Create 80% transparent (20% opaque) dark gray background for the playfield area
     int padding = 10;
-    int x = BOARD_OFFSET_X - padding;
-    int y = BOARD_OFFSET_Y - padding;
-    int width = BOARD_WIDTH * CELL_SIZE + padding * 2;
-    int height = BOARD_HEIGHT * CELL_SIZE + padding * 2;
+    int x = layout->board_offset_x - padding;
+    int y = layout->board_offset_y - padding;
+    int width = layout->board_width * layout->cell_size + padding * 2;
+    int height = layout->board_height * layout->cell_size + padding * 2;
+    
+    if (layout->canvas) {
+        soft_canvas_blend_rect(layout->canvas, x, y, width, height, soft_rgba(32, 32, 32, 255), 51);
+        return;
+    }
     
     // Set blend mode for alpha blending and draw semi-transparent rectangle
     SDL_SetRenderDrawBlendMode(graphics_context->renderer, SDL_BLENDMODE_BLEND);
@@ -456,46 +673,39 @@ void blocktris_renderer_render_playfield_background(const graphics_context_t *gr
     SDL_SetRenderDrawBlendMode(graphics_context->renderer, SDL_BLENDMODE_NONE);
 }
 
-void blocktris_renderer_render_next_piece_background(const graphics_context_t *graphics_context) {
-    if (!graphics_context) {
+void blocktris_renderer_render_next_piece_background(const game_layout_t *layout,
+                                                     const graphics_context_t *graphics_context) {
+    if (!layout || !graphics_context) {
         return;
     }
     
     // Create semi-transparent dark gray background for next piece box
-    int padding = 5;
-    int x = NEXT_PIECE_X - padding;
-    int y = NEXT_PIECE_Y - 30; // Include space for "NEXT" text
-    int width = NEXT_PIECE_SIZE + padding * 2;
-    int height = NEXT_PIECE_SIZE + 35; // Extra height for text
-    
-    // Draw filled rectangle using horizontal lines
-    color_t semi_transparent_gray = COLOR(32, 32, 32);
-    for (int line_y = y; line_y < y + height; line_y++) {
-        draw_line((graphics_context_t*)graphics_context, x, line_y, x + width, line_y, semi_transparent_gray);
-    }
+    render_piece_box_background(layout, graphics_context, NEXT_PIECE_X(layout), NEXT_PIECE_Y(layout));
 }
 
-void blocktris_renderer_render_score_background(const graphics_context_t *graphics_context) {
-    if (!graphics_context) {
+void blocktris_renderer_render_score_background(const game_layout_t *layout,
+                                                 const graphics_context_t *graphics_context) {
+    if (!layout || !graphics_context) {
         return;
     }
     
     // Create semi-transparent dark gray background for score box
     int padding = 5;
-    int x = SCORE_X - padding;
-    int y = SCORE_Y - padding;
-    int width = NEXT_PIECE_SIZE + padding * 2;
+    int x = SCORE_X(layout) - padding;
+    int y = SCORE_Y(layout) - padding;
+    int width = NEXT_PIECE_SIZE(layout) + padding * 2;
     int height = 60 + padding * 2;
     
     // Draw filled rectangle using horizontal lines
     color_t semi_transparent_gray = COLOR(32, 32, 32);
     for (int line_y = y; line_y < y + height; line_y++) {
-        draw_line((graphics_context_t*)graphics_context, x, line_y, x + width, line_y, semi_transparent_gray);
+        target_line(layout, graphics_context, x, line_y, x + width, line_y, semi_transparent_gray);
     }
 }
 
-void blocktris_renderer_render_countdown(const game_t *game, const graphics_context_t *graphics_context) {
-    if (!game || !graphics_context || !game->show_countdown) {
+void blocktris_renderer_render_countdown(const game_t *game, const game_layout_t *layout,
+                                         const graphics_context_t *graphics_context) {
+    if (!game || !layout || !graphics_context || !game->show_countdown) {
         return;
     }
     
@@ -564,14 +774,153 @@ void blocktris_renderer_render_countdown(const game_t *game, const graphics_cont
     }
     
     // Calculate text dimensions for proper centering
-    int text_width = get_arcade_text_width_scaled((arcade_font_ptr)&game->arcade_font, countdown_text, scale);
+    int text_width = target_text_width(&game->arcade_font, layout, countdown_text, scale);
     int text_height = 7 * scale;  // Arcade font character height is 7 pixels
     
     // Position text in exact center of screen
-    int text_x = (LOGICAL_WIDTH - text_width) / 2;
-    int text_y = (LOGICAL_HEIGHT - text_height) / 2;
+    int text_x = (layout->width - text_width) / 2;
+    int text_y = (layout->height - text_height) / 2;
+    
+    target_text_alpha(&game->arcade_font, layout, graphics_context,
+                     countdown_text, text_x, text_y, text_color, scale, alpha);
+}
+
+/**
+ * Draw a rectangle outline
+ */
+static void render_outline(const game_layout_t *layout, const graphics_context_t *graphics_context, int x, int y,
+                           int width, int height, color_t color) {
+    target_line(layout, graphics_context, x, y, x + width, y, color);
+    target_line(layout, graphics_context, x + width, y, x + width, y + height, color);
+    target_line(layout, graphics_context, x + width, y + height, x, y + height, color);
+    target_line(layout, graphics_context, x, y + height, x, y, color);
+}
+
+/**
+ * Draw a piece at row piece_y of a board drawn at (origin_x, origin_y), filled or as a ghost outline
+ */
+static void render_view_piece(const blocktris_piece_t *piece, int piece_y, bool ghost,
+                              int origin_x, int origin_y, int cell_size, int board_height,
+                              const game_layout_t *layout, const graphics_context_t *graphics_context) {
+    color_t white = COLOR(255, 255, 255);
+    color_t piece_color = blocktris_piece_get_color(piece->type);
+    
+    for (int py = 0; py < PIECE_SIZE; py++) {
+        for (int px = 0; px < PIECE_SIZE; px++) {
+            int board_y = piece_y + py;
+            if (!blocktris_piece_is_cell_filled(piece->type, piece->rotation, px, py) ||
+                board_y < 0 || board_y >= board_height) {
+                continue;
+            }
+            
+            int screen_x = origin_x + (piece->x + px) * cell_size;
+            int screen_y = origin_y + board_y * cell_size;
+            if (ghost) {
+                render_outline(layout, graphics_context, screen_x, screen_y, cell_size, cell_size, white);
+            } else {
+                blocktris_renderer_render_cell(screen_x, screen_y, cell_size, piece_color, white, layout,
+                                               graphics_context);
+            }
+        }
+    }
+}
+
+void blocktris_renderer_render_sim_view(const sim_view_t *view, const arcade_font_t *font,
+                                        int origin_x, int origin_y, int cell_size,
+                                        const game_layout_t *layout,
+                                        const graphics_context_t *graphics_context) {
+    if (!view || !view->board || !font || !graphics_context) {
+        return;
+    }
+    
+    const board_snapshot_t *board = view->board;
+    int board_screen_width = board->width * cell_size;
+    int board_screen_height = board->height * cell_size;
+    color_t white = COLOR(255, 255, 255);
+    
+    render_outline(layout, graphics_context, origin_x - BORDER_SIZE, origin_y - BORDER_SIZE,
+                   board_screen_width + BORDER_SIZE * 2, board_screen_height + BORDER_SIZE * 2, BORDER_COLOR);
+    
+    // Locked cells straight from the snapshot rows
+    for (int y = 0; y < board->height; y++) {
+        const board_row_chunk_t *row = board->rows[y];
+        if (!row->bits) {
+            continue;
+        }
+        
+        for (int x = 0; x < board->width; x++) {
+            if ((row->bits >> x) & 1) {
+                blocktris_renderer_render_cell(origin_x + x * cell_size, origin_y + y * cell_size, cell_size,
+                                               game_board_cell_color(row->cells[x]), white, layout,
+                                               graphics_context);
+            }
+        }
+    }
+    
+    if (view->piece.active) {
+        if (view->ghost_y != view->piece.y) {
+            render_view_piece(&view->piece, view->ghost_y, true, origin_x, origin_y, cell_size,
+                              board->height, layout, graphics_context);
+        }
+        render_view_piece(&view->piece, view->piece.y, false, origin_x, origin_y, cell_size,
+                          board->height, layout, graphics_context);
+    }
+    
+    // Pending garbage meter, growing up from the bottom left of the board
+    int meter_rows = view->garbage_pending < board->height ? view->garbage_pending : board->height;
+    if (meter_rows > 0) {
+        color_t meter_color = COLOR(255, 0, 0);
+        int meter_x = origin_x - BORDER_SIZE * 2 - 4;
+        for (int i = 0; i < 4; i++) {
+            target_line(layout, graphics_context,
+                        meter_x + i, origin_y + board_screen_height - meter_rows * cell_size,
+                        meter_x + i, origin_y + board_screen_height, meter_color);
+        }
+    }
     
-    render_arcade_text_scaled_alpha((arcade_font_ptr)&game->arcade_font,
-                                   (graphics_context_ptr)graphics_context,
-                                   countdown_text, text_x, text_y, text_color, scale, alpha);
+    // Side panel: next and hold previews with the score below
+    int panel_x = origin_x + board_screen_width + cell_size;
+    int preview_cell = cell_size / 2 > 1 ? cell_size / 2 : 1;
+    int preview_size = preview_cell * PIECE_SIZE;
+    int text_scale = cell_size >= 16 ? 2 : 1;
+    int line_height = 10 * text_scale;
+    int y = origin_y;
+    
+    target_text(font, layout, graphics_context,
+                "NEXT", panel_x, y, FONT_COLOR_YELLOW, text_scale);
+    y += line_height;
+    render_outline(layout, graphics_context, panel_x, y, preview_size, preview_size, BORDER_COLOR);
+    if (view->next_type != PIECE_EMPTY) {
+        blocktris_renderer_render_piece_at_position(view->next_type, 0, panel_x, y, preview_cell,
+                                                    blocktris_piece_get_color(view->next_type),
+                                                    layout, graphics_context);
+    }
+    y += preview_size + line_height;
+    
+    target_text(font, layout, graphics_context,
+                "HOLD", panel_x, y, FONT_COLOR_YELLOW, text_scale);
+    y += line_height;
+    render_outline(layout, graphics_context, panel_x, y, preview_size, preview_size, BORDER_COLOR);
+    if (view->hold_type != PIECE_EMPTY) {
+        blocktris_renderer_render_piece_at_position(view->hold_type, 0, panel_x, y, preview_cell,
+                                                    blocktris_piece_get_color(view->hold_type),
+                                                    layout, graphics_context);
+    }
+    y += preview_size + line_height;
+    
+    char text[32];
+    target_text(font, layout, graphics_context,
+                "SCORE", panel_x, y, FONT_COLOR_YELLOW, text_scale);
+    y += line_height;
+    snprintf(text, sizeof(text), "%d", view->score);
+    target_text(font, layout, graphics_context,
+                text, panel_x, y, FONT_COLOR_WHITE, text_scale);
+    y += line_height * 2;
+    
+    target_text(font, layout, graphics_context,
+                "LINES", panel_x, y, FONT_COLOR_YELLOW, text_scale);
+    y += line_height;
+    snprintf(text, sizeof(text), "%d", view->lines_cleared);
+    target_text(font, layout, graphics_context,
+                text, panel_x, y, FONT_COLOR_WHITE, text_scale);
 }
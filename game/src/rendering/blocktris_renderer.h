@@ -10,8 +10,11 @@
 #define BLOCKTRIS_RENDERER_H_
 
 #include "game.h"
+#include "game_layout.h"
+#include "sim_view.h"
 #include "graphics.h"
 #include "color.h"
+#include "soft_raster.h"
 
 /**
  * Initialize the BlockTris renderer
@@ -25,68 +28,103 @@ bool blocktris_renderer_init(const graphics_context_t *graphics_context);
  * Render the entire game
  *
  * @param game Pointer to game state
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_game(const game_t *game, const graphics_context_t *graphics_context);
+void blocktris_renderer_render_game(const game_t *game, const game_layout_t *layout,
+                                    const graphics_context_t *graphics_context);
 
 /**
  * Render the game board with border
  *
  * @param game Pointer to game state
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_board(const game_t *game, const graphics_context_t *graphics_context);
+void blocktris_renderer_render_board(const game_t *game, const game_layout_t *layout,
+                                     const graphics_context_t *graphics_context);
 
 /**
  * Render the game board border
  *
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_board_border(const graphics_context_t *graphics_context);
+void blocktris_renderer_render_board_border(const game_layout_t *layout,
+                                            const graphics_context_t *graphics_context);
 
 /**
  * Render the game board grid
  *
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_board_grid(const graphics_context_t *graphics_context);
+void blocktris_renderer_render_board_grid(const game_layout_t *layout,
+                                          const graphics_context_t *graphics_context);
 
 /**
  * Render placed pieces on the board
  *
  * @param board Pointer to game board
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_placed_pieces(const game_board_t *board, 
+void blocktris_renderer_render_placed_pieces(const game_board_t *board, const game_layout_t *layout, 
                                          const graphics_context_t *graphics_context);
 
 /**
  * Render the current falling piece
  *
+ * The piece is drawn game->piece_offset_y below its row, so it can glide
+ * between rows rather than jump a whole cell per gravity step.
+ *
  * @param game Pointer to game state
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_current_piece(const game_t *game, 
+void blocktris_renderer_render_current_piece(const game_t *game, const game_layout_t *layout, 
                                          const graphics_context_t *graphics_context);
 
 /**
  * Render the ghost piece (preview of where piece will land)
  *
  * @param game Pointer to game state
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_ghost_piece(const game_t *game, 
+void blocktris_renderer_render_ghost_piece(const game_t *game, const game_layout_t *layout, 
                                        const graphics_context_t *graphics_context);
 
 /**
  * Render the next piece preview
  *
  * @param game Pointer to game state
+ * @param layout Layout to draw with
+ * @param graphics_context Pointer to graphics context
+ */
+void blocktris_renderer_render_next_piece(const game_t *game, const game_layout_t *layout, 
+                                      const graphics_context_t *graphics_context);
+
+/**
+ * Render the hold box with the held piece (dimmed while hold is used up)
+ *
+ * @param game Pointer to game state
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_next_piece(const game_t *game, 
+void blocktris_renderer_render_hold_piece(const game_t *game, const game_layout_t *layout, 
                                       const graphics_context_t *graphics_context);
 
+/**
+ * Render the rest of the preview queue (the pieces after the next one)
+ *
+ * @param game Pointer to game state
+ * @param layout Layout to draw with
+ * @param graphics_context Pointer to graphics context
+ */
+void blocktris_renderer_render_piece_queue(const game_t *game, const game_layout_t *layout, 
+                                       const graphics_context_t *graphics_context);
+
 /**
  * Render a single piece at specified position
  *
@@ -96,10 +134,12 @@ void blocktris_renderer_render_next_piece(const game_t *game,
  * @param y Screen y coordinate
  * @param cell_size Size of each cell
  * @param color Color to render the piece
+ * @param layout Layout of the area drawn into
  * @param graphics_context Pointer to graphics context
  */
 void blocktris_renderer_render_piece_at_position(piece_type_t piece_type, int rotation,
                                              int x, int y, int cell_size, color_t color,
+                                             const game_layout_t *layout,
                                              const graphics_context_t *graphics_context);
 
 /**
@@ -110,37 +150,61 @@ void blocktris_renderer_render_piece_at_position(piece_type_t piece_type, int ro
  * @param size Size of the cell
  * @param fill_color Fill color
  * @param border_color Border color
+ * @param layout Layout of the area drawn into
  * @param graphics_context Pointer to graphics context
  */
 void blocktris_renderer_render_cell(int x, int y, int size, color_t fill_color, 
-                                color_t border_color, const graphics_context_t *graphics_context);
+                                color_t border_color, const game_layout_t *layout,
+                                const graphics_context_t *graphics_context);
 
 /**
  * Render game UI elements (score, level, lines)
  *
  * @param game Pointer to game state
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_ui(const game_t *game, const graphics_context_t *graphics_context);
+void blocktris_renderer_render_ui(const game_t *game, const game_layout_t *layout,
+                                  const graphics_context_t *graphics_context);
 
 /**
  * Render line clear effect
  *
+ * The cleared rows flash white and fade out, each swept across the board
+ * as one quad, cascading up from the bottom row (see line_clear_effect.h).
+ * All rows go out in a single batched draw.
+ *
  * @param game Pointer to game state
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_line_clear_effect(const game_t *game, 
+void blocktris_renderer_render_line_clear_effect(const game_t *game, const game_layout_t *layout, 
                                              const graphics_context_t *graphics_context);
 
 /**
  * Convert board coordinates to screen coordinates
  *
+ * @param layout Layout of the board
  * @param board_x Board x coordinate
  * @param board_y Board y coordinate
  * @param screen_x Pointer to output screen x coordinate
  * @param screen_y Pointer to output screen y coordinate
  */
-void blocktris_renderer_board_to_screen(int board_x, int board_y, int *screen_x, int *screen_y);
+void blocktris_renderer_board_to_screen(const game_layout_t *layout, int board_x, int board_y,
+                                        int *screen_x, int *screen_y);
+
+/**
+ * Convert fixed-point board coordinates (SUBCELL_ONE units per cell) to
+ * screen coordinates, for things drawn between cells
+ *
+ * @param layout Layout of the board
+ * @param board_x Board x coordinate in SUBCELL_ONE units
+ * @param board_y Board y coordinate in SUBCELL_ONE units
+ * @param screen_x Pointer to output screen x coordinate
+ * @param screen_y Pointer to output screen y coordinate
+ */
+void blocktris_renderer_board_to_screen_fixed(const game_layout_t *layout, int board_x, int board_y,
+                                              int *screen_x, int *screen_y);
 
 /**
  * Get color with alpha transparency
@@ -155,37 +219,66 @@ color_t blocktris_renderer_get_alpha_color(color_t base_color, int alpha);
  * Render background image
  *
  * @param game Pointer to game state
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_background(const game_t *game, const graphics_context_t *graphics_context);
+void blocktris_renderer_render_background(const game_t *game, const game_layout_t *layout,
+                                          const graphics_context_t *graphics_context);
 
 /**
  * Render semi-transparent background for playfield
  *
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_playfield_background(const graphics_context_t *graphics_context);
+void blocktris_renderer_render_playfield_background(const game_layout_t *layout,
+                                                    const graphics_context_t *graphics_context);
 
 /**
  * Render semi-transparent background for next piece box
  *
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_next_piece_background(const graphics_context_t *graphics_context);
+void blocktris_renderer_render_next_piece_background(const game_layout_t *layout,
+                                                     const graphics_context_t *graphics_context);
 
 /**
  * Render semi-transparent background for score box
  *
+ * @param layout Layout to draw with
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_score_background(const graphics_context_t *graphics_context);
+void blocktris_renderer_render_score_background(const game_layout_t *layout,
+                                                const graphics_context_t *graphics_context);
 
 /**
  * Render countdown display before game starts (3, 2)
  *
  * @param game Pointer to game state
+ * @param layout Layout to draw with
+ * @param graphics_context Pointer to graphics context
+ */
+void blocktris_renderer_render_countdown(const game_t *game, const game_layout_t *layout,
+                                         const graphics_context_t *graphics_context);
+
+/**
+ * Render a published simulation view (one side of a versus match)
+ *
+ * Draws the board with its border, the falling and ghost piece, the pending
+ * garbage meter on the left, and the next/hold pieces and score on the right.
+ *
+ * @param view Pointer to the view to draw
+ * @param font Arcade font for the labels
+ * @param origin_x Screen X of the board's top-left cell
+ * @param origin_y Screen Y of the board's top-left cell
+ * @param cell_size Size of a board cell in pixels
+ * @param layout Layout of the area drawn into
  * @param graphics_context Pointer to graphics context
  */
-void blocktris_renderer_render_countdown(const game_t *game, const graphics_context_t *graphics_context);
+void blocktris_renderer_render_sim_view(const sim_view_t *view, const arcade_font_t *font,
+                                        int origin_x, int origin_y, int cell_size,
+                                        const game_layout_t *layout,
+                                        const graphics_context_t *graphics_context);
 
 #endif // BLOCKTRIS_RENDERER_H_
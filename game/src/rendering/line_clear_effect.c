@@ -0,0 +1,63 @@
+/**
+ * @file line_clear_effect.c
+ * @brief Line-clear flash implementation
+ */
+
+#include "line_clear_effect.h"
+#include <stddef.h>
+
+int line_clear_effect_time(uint32_t elapsed_ms, uint32_t duration_ms) {
+    if (duration_ms == 0 || elapsed_ms >= duration_ms) {
+        return LINE_CLEAR_EFFECT_ONE;
+    }
+    
+    return (int)((uint64_t)elapsed_ms * LINE_CLEAR_EFFECT_ONE / duration_ms);
+}
+
+void line_clear_effect_build(line_clear_batch_t *batch, board_line_mask_t lines, int board_width, int board_height,
+                             int t, int origin_x, int origin_y, int cell_size) {
+    if (!batch) {
+        return;
+    }
+    
+    batch->quad_count = 0;
+    batch->alpha = 0;
+    if (t < 0 || t >= LINE_CLEAR_EFFECT_ONE || board_width <= 0 || cell_size <= 0) {
+        return;
+    }
+    
+    batch->alpha = 255 * (LINE_CLEAR_EFFECT_ONE - t) / LINE_CLEAR_EFFECT_ONE;
+    int board_screen_width = board_width * cell_size;
+    if (board_height > MAX_BOARD_HEIGHT) {
+        board_height = MAX_BOARD_HEIGHT;
+    }
+    
+    // Bottom row first; later rows start later, but all are across the board for the last step
+    int latest_start = LINE_CLEAR_EFFECT_ONE - LINE_CLEAR_EFFECT_SWEEP - LINE_CLEAR_EFFECT_CASCADE;
+    int row = 0;
+    for (int y = board_height - 1; y >= 0; y--) {
+        if (!((lines >> y) & 1)) {
+            continue;
+        }
+        
+        int start = row * LINE_CLEAR_EFFECT_CASCADE;
+        if (start > latest_start) {
+            start = latest_start;
+        }
+        row++;
+        
+        int progress = t - start;
+        if (progress <= 0) {
+            continue;
+        }
+        if (progress > LINE_CLEAR_EFFECT_SWEEP) {
+            progress = LINE_CLEAR_EFFECT_SWEEP;
+        }
+        
+        line_clear_quad_t *quad = &batch->quads[batch->quad_count++];
+        quad->x = origin_x;
+        quad->y = origin_y + y * cell_size;
+        quad->width = board_screen_width * progress / LINE_CLEAR_EFFECT_SWEEP;
+        quad->height = cell_size;
+    }
+}
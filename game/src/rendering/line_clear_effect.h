@@ -0,0 +1,86 @@
+/**
+ * @file line_clear_effect.h
+ * @brief Line-clear flash as one batch of row quads
+ *
+ * Every cleared row is a single white quad. The whole effect is a function
+ * of one normalized time parameter t (0 at the clear, LINE_CLEAR_EFFECT_ONE
+ * at the end of LINE_CLEAR_DELAY):
+ *
+ *   - alpha fades from opaque to clear over the effect, the same for every
+ *     row, so all the quads go out in one draw call with one colour
+ *   - each row's quad sweeps across the board from the left, taking half
+ *     the effect to cover it
+ *   - rows cascade from the bottom: each starts its sweep a step after the
+ *     row below, and however many rows there are, all of them cover the
+ *     board for the last step
+ *
+ * Building the batch is a few integer operations per row and nothing is
+ * kept between frames, so the effect costs the same draw call whether one
+ * line or five were cleared.
+ */
+
+#ifndef LINE_CLEAR_EFFECT_H_
+#define LINE_CLEAR_EFFECT_H_
+
+#include "game_board.h"
+#include "constants.h"
+#include <stdint.h>
+
+// Normalized time 1.0: the end of the effect
+#define LINE_CLEAR_EFFECT_ONE 256
+
+// Time a row takes to sweep across the board
+#define LINE_CLEAR_EFFECT_SWEEP (LINE_CLEAR_EFFECT_ONE / 2)
+
+// Delay between the sweeps of consecutive cleared rows
+#define LINE_CLEAR_EFFECT_CASCADE (LINE_CLEAR_EFFECT_ONE / 8)
+
+/**
+ * Screen rectangle of one cleared row
+ */
+typedef struct {
+    int x;
+    int y;
+    int width;
+    int height;
+} line_clear_quad_t;
+
+/**
+ * Quads of one frame of the effect, all drawn white at the same alpha
+ */
+typedef struct {
+    line_clear_quad_t quads[MAX_BOARD_HEIGHT];
+    int quad_count;
+    int alpha; // 0-255
+} line_clear_batch_t;
+
+typedef line_clear_batch_t *line_clear_batch_ptr;
+
+/**
+ * Get the normalized time of the effect
+ *
+ * @param elapsed_ms Time since the lines were cleared
+ * @param duration_ms Length of the effect
+ * @return 0 to LINE_CLEAR_EFFECT_ONE, clamped
+ */
+int line_clear_effect_time(uint32_t elapsed_ms, uint32_t duration_ms);
+
+/**
+ * Build the quads of one frame of the effect
+ *
+ * Rows whose sweep hasn't started yet, and every row once the effect is
+ * over, get no quad.
+ *
+ * @param batch Filled in with the quads and their alpha
+ * @param lines Cleared rows (bit y set = row y)
+ * @param board_width Board width in cells
+ * @param board_height Board height in cells
+ * @param t Normalized time, from line_clear_effect_time
+ * @param origin_x Screen position of the board's top left cell
+ * @param origin_y Screen position of the board's top left cell
+ * @param cell_size Cell size in pixels
+ */
+void line_clear_effect_build(line_clear_batch_t *batch, board_line_mask_t lines, int board_width, int board_height,
+                             int t, int origin_x, int origin_y, int cell_size);
+
+#endif // LINE_CLEAR_EFFECT_H_
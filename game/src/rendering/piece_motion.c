@@ -0,0 +1,86 @@
+/**
+ * @file piece_motion.c
+ * @brief Falling piece motion implementation
+ */
+
+#include "piece_motion.h"
+#include <stddef.h>
+
+int piece_motion_position(int row, int fall_ticks, int fall_interval, bool grounded) {
+    int position = row * SUBCELL_ONE;
+    if (grounded || fall_interval <= 1 || fall_ticks <= 0) {
+        return position;
+    }
+    
+    if (fall_ticks >= fall_interval) {
+        fall_ticks = fall_interval - 1;
+    }
+    return position + fall_ticks * SUBCELL_ONE / fall_interval;
+}
+
+void piece_motion_reset(piece_motion_t *motion) {
+    if (!motion) {
+        return;
+    }
+    
+    motion->valid = false;
+    motion->type = PIECE_EMPTY;
+    motion->rotation = 0;
+    motion->from_position = 0;
+    motion->to_position = 0;
+    motion->from_tick = 0;
+    motion->to_tick = 0;
+    motion->to_time = 0;
+}
+
+void piece_motion_update(piece_motion_t *motion, const blocktris_piece_t *piece, int position,
+                         uint32_t tick, timestamp_ms_t time) {
+    if (!motion) {
+        return;
+    }
+    if (!piece) {
+        piece_motion_reset(motion);
+        return;
+    }
+    
+    // The state already held
+    if (motion->valid && tick == motion->to_tick && position == motion->to_position) {
+        return;
+    }
+    
+    // Only a fall of up to one row on the same piece, in later ticks, is drawn in between
+    bool falling = motion->valid && piece->type == motion->type && piece->rotation == motion->rotation &&
+                   tick > motion->to_tick && position >= motion->to_position &&
+                   position - motion->to_position <= SUBCELL_ONE;
+    
+    motion->from_position = falling ? motion->to_position : position;
+    motion->from_tick = falling ? motion->to_tick : tick;
+    motion->to_position = position;
+    motion->to_tick = tick;
+    motion->to_time = time;
+    motion->type = piece->type;
+    motion->rotation = piece->rotation;
+    motion->valid = true;
+}
+
+int piece_motion_offset(const piece_motion_t *motion, int row, timestamp_ms_t now) {
+    if (!motion || !motion->valid) {
+        return 0;
+    }
+    
+    // Share of the ticks between the two states that has gone by since the latest one
+    int position = motion->to_position;
+    timestamp_ms_t span = (timestamp_ms_t)(motion->to_tick - motion->from_tick) * SIM_TICK_MS;
+    if (span > 0 && now < motion->to_time + span) {
+        timestamp_ms_t elapsed = now > motion->to_time ? now - motion->to_time : 0;
+        int distance = motion->to_position - motion->from_position;
+        position = motion->from_position + (int)((timestamp_ms_t)distance * elapsed / span);
+    }
+    
+    // Never drawn above its row, nor into the next one
+    int offset = position - row * SUBCELL_ONE;
+    if (offset < 0) {
+        return 0;
+    }
+    return offset < SUBCELL_ONE ? offset : SUBCELL_ONE - 1;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file piece_motion.h
+ * @brief Smooth on-screen motion of the falling piece
+ *
+ * The board logic moves a piece a whole row per gravity step. For drawing,
+ * its position is taken in fixed point instead (SUBCELL_ONE units per row):
+ * the row plus the fraction of the fall interval that has already elapsed,
+ * so it creeps towards the next row as gravity builds up and reaches it
+ * exactly when the step happens.
+ *
+ * That position still only changes once per simulation tick, which shows
+ * as judder on displays faster than SIM_TICK_RATE. So the piece is drawn
+ * between the last two states it was seen in, by how much of the tick
+ * after the latest one has gone by: one tick behind, but on every frame.
+ *
+ * Anything that isn't a fall (a new or held piece, a rotation, a hard drop
+ * or a move onto a ledge) snaps straight to the new position, as
+ * interpolating would slide the piece through the stack.
+ */
+
+#ifndef PIECE_MOTION_H_
+#define PIECE_MOTION_H_
+
+#include "blocktris_piece.h"
+#include "constants.h"
+#include "types.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Falling piece between its last two simulation states
+ */
+typedef struct {
+    bool valid;              // Cleared until a piece is seen
+    piece_type_t type;       // Piece the states belong to
+    int rotation;
+    int from_position;       // Fixed-point row at the previous state
+    int to_position;         // Fixed-point row at the latest state
+    uint32_t from_tick;
+    uint32_t to_tick;
+    timestamp_ms_t to_time;  // Real time the latest state's tick was due
+} piece_motion_t;
+
+typedef piece_motion_t *piece_motion_ptr;
+
+/**
+ * Get the fixed-point row of a falling piece
+ *
+ * @param row Row the piece is on
+ * @param fall_ticks Ticks since it last fell
+ * @param fall_interval Ticks between gravity steps
+ * @param grounded The piece can't fall: it stays on its row
+ * @return Position in SUBCELL_ONE units per row
+ */
+int piece_motion_position(int row, int fall_ticks, int fall_interval, bool grounded);
+
+/**
+ * Forget the piece, so the next state is drawn as it is
+ *
+ * @param motion Pointer to the piece motion
+ */
+void piece_motion_reset(piece_motion_t *motion);
+
+/**
+ * Take in the latest simulation state of the piece
+ *
+ * The same state may be passed in again every frame: only a new position
+ * or tick is taken as a new state.
+ *
+ * @param motion Pointer to the piece motion
+ * @param piece Falling piece, NULL if there is none
+ * @param position Its fixed-point row (piece_motion_position)
+ * @param tick Simulation tick of the state
+ * @param time Real time that tick was due
+ */
+void piece_motion_update(piece_motion_t *motion, const blocktris_piece_t *piece, int position,
+                         uint32_t tick, timestamp_ms_t time);
+
+/**
+ * Get how far below its row the piece is drawn at a given time
+ *
+ * @param motion Pointer to the piece motion
+ * @param row Row of the piece in the latest state
+ * @param now Current real time
+ * @return Offset in SUBCELL_ONE units per row, at least 0 and under SUBCELL_ONE
+ */
+int piece_motion_offset(const piece_motion_t *motion, int row, timestamp_ms_t now);
+
+#endif // PIECE_MOTION_H_
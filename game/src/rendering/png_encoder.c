@@ -0,0 +1,279 @@
+/**
+ * @file png_encoder.c
+ * @brief PNG encoder implementation
+ */
+
+#include "png_encoder.h"
+#include "utils.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const uint8_t PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+#define PNG_BYTES_PER_PIXEL 3
+#define PNG_FILTER_UP 2
+
+// Chunk length, type and CRC around the data
+#define PNG_CHUNK_OVERHEAD 12
+#define PNG_IHDR_SIZE 13
+
+// zlib header (2) and Adler-32 trailer (4) around the deflate data
+#define ZLIB_OVERHEAD 6
+
+#define DEFLATE_MIN_MATCH 3
+#define DEFLATE_MAX_MATCH 258
+#define DEFLATE_WINDOW 32768
+#define DEFLATE_END_OF_BLOCK 256
+
+// Bytes added to the Adler-32 sums before they must be reduced to stay within 32 bits
+#define ADLER_MODULUS 65521
+#define ADLER_CHUNK 5552
+
+// Length symbols 257..285: shortest length of each and its extra bits
+static const uint16_t LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+// Distance symbols 0..29
+static const uint16_t DISTANCE_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t DISTANCE_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/**
+ * Deflate bit stream: fields are packed from the least significant bit
+ */
+typedef struct {
+    uint8_t *out;
+    size_t capacity;
+    size_t size;
+    uint32_t bits;
+    int bit_count;
+    bool overflow;
+} bit_writer_t;
+
+static void put_bits(bit_writer_t *writer, uint32_t value, int count) {
+    writer->bits |= value << writer->bit_count;
+    writer->bit_count += count;
+    while (writer->bit_count >= 8) {
+        if (writer->size < writer->capacity) {
+            writer->out[writer->size++] = (uint8_t)writer->bits;
+        } else {
+            writer->overflow = true;
+        }
+        writer->bits >>= 8;
+        writer->bit_count -= 8;
+    }
+}
+
+/**
+ * Huffman codes go out most significant bit first
+ */
+static void put_code(bit_writer_t *writer, uint32_t code, int length) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < length; i++) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    put_bits(writer, reversed, length);
+}
+
+static void flush_bits(bit_writer_t *writer) {
+    if (writer->bit_count > 0) {
+        put_bits(writer, 0, 8 - writer->bit_count);
+    }
+}
+
+/**
+ * Fixed Huffman code of a literal/length symbol
+ */
+static void put_symbol(bit_writer_t *writer, int symbol) {
+    if (symbol < 144) {
+        put_code(writer, 0x30 + (uint32_t)symbol, 8);
+    } else if (symbol < 256) {
+        put_code(writer, 0x190 + (uint32_t)(symbol - 144), 9);
+    } else if (symbol < 280) {
+        put_code(writer, (uint32_t)(symbol - 256), 7);
+    } else {
+        put_code(writer, 0xC0 + (uint32_t)(symbol - 280), 8);
+    }
+}
+
+static void put_match(bit_writer_t *writer, int length, int distance) {
+    int index = 28;
+    while (LENGTH_BASE[index] > length) {
+        index--;
+    }
+    put_symbol(writer, 257 + index);
+    put_bits(writer, (uint32_t)(length - LENGTH_BASE[index]), LENGTH_EXTRA[index]);
+    
+    index = 29;
+    while (DISTANCE_BASE[index] > distance) {
+        index--;
+    }
+    put_code(writer, (uint32_t)index, 5);
+    put_bits(writer, (uint32_t)(distance - DISTANCE_BASE[index]), DISTANCE_EXTRA[index]);
+}
+
+/**
+ * Fill in a chunk's length and CRC around data already at out + 8
+ */
+static size_t finish_chunk(uint8_t *out, const char *type, size_t data_size) {
+    utils_write_u32_be(out, (uint32_t)data_size);
+    memcpy(out + 4, type, 4);
+    utils_write_u32_be(out + 8 + data_size, utils_crc32(0, out + 4, data_size + 4));
+    return data_size + PNG_CHUNK_OVERHEAD;
+}
+
+/**
+ * Apply the Up filter to one row; the first byte is the filter type
+ */
+static void filter_row(const uint32_t *row, const uint32_t *above, int width, uint8_t *out) {
+    out[0] = PNG_FILTER_UP;
+    const uint8_t *bytes = (const uint8_t *)row;
+    const uint8_t *above_bytes = (const uint8_t *)above;
+    for (int x = 0; x < width; x++) {
+        for (int c = 0; c < PNG_BYTES_PER_PIXEL; c++) {
+            uint8_t value = bytes[x * 4 + c];
+            out[1 + x * PNG_BYTES_PER_PIXEL + c] = above ? (uint8_t)(value - above_bytes[x * 4 + c]) : value;
+        }
+    }
+}
+
+/**
+ * Length of the match at cur[p] with the bytes distance back in the stream
+ * (prev is the row before cur, both stride bytes long)
+ */
+static int match_length(const uint8_t *prev, const uint8_t *cur, int stride, int p, int distance, int limit) {
+    int length = 0;
+    while (length < limit) {
+        int source = p + length - distance;
+        uint8_t expected = source >= 0 ? cur[source] : prev[stride + source];
+        if (cur[p + length] != expected) {
+            break;
+        }
+        length++;
+    }
+    return length;
+}
+
+size_t png_encoder_bound(int width, int height) {
+    if (width <= 0 || height <= 0 || width > (1 << 24) / PNG_BYTES_PER_PIXEL) {
+        return 0;
+    }
+    
+    // A match never costs more than 31 bits for 3 bytes, under 11 bits a byte
+    size_t raw = (size_t)height * ((size_t)width * PNG_BYTES_PER_PIXEL + 1);
+    size_t deflate = raw / 8 * 11 + 64;
+    return sizeof(PNG_SIGNATURE) + (PNG_CHUNK_OVERHEAD + PNG_IHDR_SIZE) +
+           (PNG_CHUNK_OVERHEAD + ZLIB_OVERHEAD + deflate) + PNG_CHUNK_OVERHEAD;
+}
+
+size_t png_encoder_encode(const uint32_t *pixels, int width, int height, int pitch, uint8_t *out, size_t capacity) {
+    size_t bound = png_encoder_bound(width, height);
+    if (!pixels || !out || bound == 0 || pitch < width ||
+        capacity < sizeof(PNG_SIGNATURE) + 2 * PNG_CHUNK_OVERHEAD + PNG_IHDR_SIZE + ZLIB_OVERHEAD + 16) {
+        return 0;
+    }
+    
+    int stride = width * PNG_BYTES_PER_PIXEL + 1;
+    uint8_t *rows = malloc((size_t)stride * 2);
+    if (!rows) {
+        return 0;
+    }
+    
+    size_t size = 0;
+    memcpy(out, PNG_SIGNATURE, sizeof(PNG_SIGNATURE));
+    size += sizeof(PNG_SIGNATURE);
+    
+    // IHDR: 8-bit RGB, deflate, adaptive filtering, no interlace
+    uint8_t *ihdr = out + size + 8;
+    utils_write_u32_be(ihdr, (uint32_t)width);
+    utils_write_u32_be(ihdr + 4, (uint32_t)height);
+    ihdr[8] = 8;
+    ihdr[9] = 2;
+    ihdr[10] = 0;
+    ihdr[11] = 0;
+    ihdr[12] = 0;
+    size += finish_chunk(out + size, "IHDR", PNG_IHDR_SIZE);
+    
+    // IDAT: a zlib stream holding one fixed-Huffman block; the IEND chunk must still fit after it
+    size_t idat = size;
+    bit_writer_t writer = { out + idat + 8, capacity - idat - 8 - 4 - PNG_CHUNK_OVERHEAD, 0, 0, 0, false };
+    put_bits(&writer, 0x78, 8);
+    put_bits(&writer, 0x01, 8);
+    put_bits(&writer, 1, 1); // Final block
+    put_bits(&writer, 1, 2); // Fixed Huffman codes
+    
+    uint32_t adler_a = 1;
+    uint32_t adler_b = 0;
+    uint8_t *prev = rows;
+    uint8_t *cur = rows + stride;
+    for (int y = 0; y < height; y++) {
+        const uint32_t *row = pixels + (size_t)y * (size_t)pitch;
+        filter_row(row, y > 0 ? row - pitch : NULL, width, cur);
+        
+        for (int start = 0; start < stride; start += ADLER_CHUNK) {
+            int end = start + ADLER_CHUNK < stride ? start + ADLER_CHUNK : stride;
+            for (int i = start; i < end; i++) {
+                adler_a += cur[i];
+                adler_b += adler_a;
+            }
+            adler_a %= ADLER_MODULUS;
+            adler_b %= ADLER_MODULUS;
+        }
+        
+        // Matches one byte back (runs), one pixel back (flat colour) or one row back, within the row
+        int candidates[3] = { 1, PNG_BYTES_PER_PIXEL, stride };
+        int p = 0;
+        while (p < stride) {
+            int limit = stride - p < DEFLATE_MAX_MATCH ? stride - p : DEFLATE_MAX_MATCH;
+            int best_length = 0;
+            int best_distance = 0;
+            for (int i = 0; i < 3; i++) {
+                int distance = candidates[i];
+                bool reachable = distance <= p || (y > 0 && distance <= stride && distance <= DEFLATE_WINDOW);
+                if (reachable && limit >= DEFLATE_MIN_MATCH) {
+                    int length = match_length(prev, cur, stride, p, distance, limit);
+                    if (length > best_length) {
+                        best_length = length;
+                        best_distance = distance;
+                    }
+                }
+            }
+            
+            if (best_length >= DEFLATE_MIN_MATCH) {
+                put_match(&writer, best_length, best_distance);
+                p += best_length;
+            } else {
+                put_symbol(&writer, cur[p]);
+                p++;
+            }
+        }
+        
+        uint8_t *swap = prev;
+        prev = cur;
+        cur = swap;
+    }
+    free(rows);
+    
+    put_symbol(&writer, DEFLATE_END_OF_BLOCK);
+    flush_bits(&writer);
+    if (writer.overflow) {
+        return 0;
+    }
+    utils_write_u32_be(out + idat + 8 + writer.size, (adler_b << 16) | adler_a);
+    size += finish_chunk(out + idat, "IDAT", writer.size + 4);
+    
+    size += finish_chunk(out + size, "IEND", 0);
+    return size;
+}
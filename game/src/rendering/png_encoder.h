@@ -0,0 +1,41 @@
+/**
+ * @file png_encoder.h
+ * @brief Minimal PNG encoder for rendered frames
+ *
+ * Writes 8-bit RGB images (alpha is dropped, as rendered frames are opaque)
+ * without any library. Every row uses the Up filter, which turns the flat
+ * areas of a game frame into runs of zeros, and is then compressed with a
+ * single fixed-Huffman deflate block whose matches look one byte, one pixel
+ * and one row back. That is a fraction of zlib's ratio on photos, but close
+ * to it on flat-coloured frames, and several times faster.
+ */
+
+#ifndef PNG_ENCODER_H_
+#define PNG_ENCODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Largest PNG png_encoder_encode can produce for an image size
+ *
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @return Size in bytes, 0 if the size is unusable
+ */
+size_t png_encoder_bound(int width, int height);
+
+/**
+ * Encode RGBA pixels (R, G, B, A in memory order) as a PNG
+ *
+ * @param pixels First row of the image
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @param pitch Pixels from one row to the next
+ * @param out Output buffer
+ * @param capacity Size of the output buffer (png_encoder_bound is always enough)
+ * @return Size of the PNG, 0 if it didn't fit or the arguments are invalid
+ */
+size_t png_encoder_encode(const uint32_t *pixels, int width, int height, int pitch, uint8_t *out, size_t capacity);
+
+#endif // PNG_ENCODER_H_
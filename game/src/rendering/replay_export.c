@@ -0,0 +1,327 @@
+/**
+ * @file replay_export.c
+ * @brief Replay frame exporter implementation
+ */
+
+// mkdir is POSIX, not C99
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "replay_export.h"
+#include "blocktris_renderer.h"
+#include "png_encoder.h"
+#include "sim_view.h"
+#include "soft_raster.h"
+#include "constants.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+// Frame slots per encoder: one being encoded while the next is rendered
+#define SLOTS_PER_ENCODER 2
+#define MAX_EXPORT_SLOTS (MAX_EXPORT_THREADS * SLOTS_PER_ENCODER)
+
+// Frame number that tells an encoder to stop
+#define STOP_FRAME UINT32_MAX
+
+/**
+ * One frame buffer handed from the renderer to an encoder
+ */
+typedef struct {
+    uint32_t *pixels;
+    uint32_t frame;
+    SDL_sem *ready; // Posted by the renderer once the frame is drawn
+    SDL_sem *free;  // Posted by the encoder once the frame is written
+} export_slot_t;
+
+typedef struct export_state_t export_state_t;
+
+/**
+ * Encoder thread and its output buffer
+ */
+typedef struct {
+    export_state_t *state;
+    int index;
+    SDL_Thread *thread;
+    uint8_t *png;    // PNG encoding buffer (REPLAY_EXPORT_PNG)
+    size_t png_size;
+} export_encoder_t;
+
+struct export_state_t {
+    const replay_export_options_t *options;
+    int width;
+    int height;
+    export_slot_t slots[MAX_EXPORT_SLOTS];
+    int slot_count;
+    export_encoder_t encoders[MAX_EXPORT_THREADS];
+    int encoder_count;
+    bool threaded;     // Encoders run on their own threads, else on the rendering thread
+    SDL_atomic_t failed;
+};
+
+void replay_export_options_init(replay_export_options_t *options) {
+    if (!options) {
+        return;
+    }
+    
+    options->format = REPLAY_EXPORT_RAW;
+    options->raw_out = stdout;
+    options->png_dir = NULL;
+    options->frame_rate = DEFAULT_REPLAY_EXPORT_FRAME_RATE;
+    options->cell_size = DEFAULT_REPLAY_EXPORT_CELL_SIZE;
+    options->threads = 0;
+}
+
+void replay_export_frame_size(const replay_t *replay, int cell_size, int *width, int *height) {
+    if (!replay || !width || !height) {
+        return;
+    }
+    
+    // Side panel as blocktris_renderer_render_sim_view lays it out: room for 8 digits,
+    // and two previews between five lines of text
+    int text_scale = cell_size >= 16 ? 2 : 1;
+    int line_height = 10 * text_scale;
+    int preview_size = (cell_size / 2 > 1 ? cell_size / 2 : 1) * PIECE_SIZE;
+    int panel_width = soft_canvas_text_width("00000000", text_scale);
+    panel_width = preview_size > panel_width ? preview_size : panel_width;
+    int panel_height = 8 * line_height + 2 * preview_size + SOFT_FONT_HEIGHT * text_scale;
+    
+    int board_height = replay->config.board_height * cell_size;
+    int content_height = board_height > panel_height ? board_height : panel_height;
+    *width = cell_size + replay->config.board_width * cell_size + cell_size + panel_width + cell_size;
+    *height = cell_size + content_height + cell_size;
+    
+    *width += *width & 1;
+    *height += *height & 1;
+}
+
+uint32_t replay_export_frame_count(const replay_t *replay, int frame_rate) {
+    if (!replay || frame_rate <= 0) {
+        return 0;
+    }
+    
+    uint64_t frames = ((uint64_t)replay->tick_count * (uint64_t)frame_rate + SIM_TICK_RATE - 1) / SIM_TICK_RATE;
+    return (uint32_t)frames + 1;
+}
+
+/**
+ * Write one frame out; runs on an encoder thread, or the rendering thread without them
+ */
+static bool encode_frame(export_encoder_t *encoder, const export_slot_t *slot) {
+    export_state_t *state = encoder->state;
+    const replay_export_options_t *options = state->options;
+    
+    if (options->format == REPLAY_EXPORT_RAW) {
+        size_t pixels = (size_t)state->width * (size_t)state->height;
+        return fwrite(slot->pixels, sizeof(uint32_t), pixels, options->raw_out) == pixels;
+    }
+    
+    char path[REPLAY_EXPORT_PATH_SIZE + 32];
+    snprintf(path, sizeof(path), "%s/frame-%06lu.png", options->png_dir, (unsigned long)slot->frame);
+    size_t size = png_encoder_encode(slot->pixels, state->width, state->height, state->width,
+                                     encoder->png, encoder->png_size);
+    FILE *file = size > 0 ? fopen(path, "wb") : NULL;
+    if (!file) {
+        return false;
+    }
+    
+    bool ok = fwrite(encoder->png, 1, size, file) == size;
+    ok &= fclose(file) == 0;
+    return ok;
+}
+
+static int encoder_main(void *data) {
+    export_encoder_t *encoder = (export_encoder_t *)data;
+    export_state_t *state = encoder->state;
+    
+    // Frame N is in slot N % slot_count, so this encoder visits its slots in turn
+    for (int slot_index = encoder->index;; slot_index = (slot_index + state->encoder_count) % state->slot_count) {
+        export_slot_t *slot = &state->slots[slot_index];
+        SDL_SemWait(slot->ready);
+        if (slot->frame == STOP_FRAME) {
+            break;
+        }
+        
+        // Once something failed the remaining frames are only handed back
+        if (!SDL_AtomicGet(&state->failed) && !encode_frame(encoder, slot)) {
+            SDL_AtomicSet(&state->failed, 1);
+        }
+        SDL_SemPost(slot->free);
+    }
+    
+    return 0;
+}
+
+/**
+ * Release whatever export_open set up (threads must already be stopped)
+ */
+static void export_close(export_state_t *state) {
+    for (int i = 0; i < state->slot_count; i++) {
+        export_slot_t *slot = &state->slots[i];
+        free(slot->pixels);
+        if (slot->ready) {
+            SDL_DestroySemaphore(slot->ready);
+        }
+        if (slot->free) {
+            SDL_DestroySemaphore(slot->free);
+        }
+    }
+    for (int i = 0; i < state->encoder_count; i++) {
+        free(state->encoders[i].png);
+    }
+}
+
+static void stop_encoders(export_state_t *state, uint32_t next_frame) {
+    // The next frame of each encoder's sequence tells it to stop
+    for (int i = 0; i < state->encoder_count; i++) {
+        export_encoder_t *encoder = &state->encoders[(next_frame + (uint32_t)i) % (uint32_t)state->encoder_count];
+        export_slot_t *slot = &state->slots[(next_frame + (uint32_t)i) % (uint32_t)state->slot_count];
+        if (encoder->thread) {
+            SDL_SemWait(slot->free);
+            slot->frame = STOP_FRAME;
+            SDL_SemPost(slot->ready);
+        }
+    }
+    for (int i = 0; i < state->encoder_count; i++) {
+        if (state->encoders[i].thread) {
+            SDL_WaitThread(state->encoders[i].thread, NULL);
+            state->encoders[i].thread = NULL;
+        }
+    }
+}
+
+static bool export_open(export_state_t *state, const replay_export_options_t *options) {
+    int encoders = options->threads;
+    if (options->format == REPLAY_EXPORT_RAW) {
+        encoders = 1;
+    } else if (encoders <= 0) {
+        encoders = SDL_GetCPUCount();
+    }
+    encoders = encoders < 1 ? 1 : (encoders > MAX_EXPORT_THREADS ? MAX_EXPORT_THREADS : encoders);
+    
+    state->encoder_count = encoders;
+    state->slot_count = encoders * SLOTS_PER_ENCODER;
+    size_t png_size = options->format == REPLAY_EXPORT_PNG ? png_encoder_bound(state->width, state->height) : 0;
+    
+    bool ok = true;
+    for (int i = 0; i < state->slot_count; i++) {
+        export_slot_t *slot = &state->slots[i];
+        slot->pixels = malloc((size_t)state->width * (size_t)state->height * sizeof(uint32_t));
+        slot->frame = 0;
+        slot->ready = SDL_CreateSemaphore(0);
+        slot->free = SDL_CreateSemaphore(1);
+        ok &= slot->pixels && slot->ready && slot->free;
+    }
+    for (int i = 0; i < state->encoder_count; i++) {
+        export_encoder_t *encoder = &state->encoders[i];
+        encoder->state = state;
+        encoder->index = i;
+        encoder->thread = NULL;
+        encoder->png_size = png_size;
+        encoder->png = png_size > 0 ? malloc(png_size) : NULL;
+        ok &= png_size == 0 || encoder->png;
+    }
+    if (!ok) {
+        export_close(state);
+        return false;
+    }
+    
+    // Without every thread the rendering thread simply encodes each frame itself
+    state->threaded = true;
+    for (int i = 0; i < state->encoder_count && state->threaded; i++) {
+        state->encoders[i].thread = SDL_CreateThread(encoder_main, "replay_export", &state->encoders[i]);
+        state->threaded = state->encoders[i].thread != NULL;
+    }
+    if (!state->threaded) {
+        stop_encoders(state, 0);
+    }
+    
+    return true;
+}
+
+bool replay_export_run(const replay_t *replay, const replay_export_options_t *options,
+                       replay_export_result_t *result) {
+    if (!replay || !options || options->frame_rate <= 0 || options->cell_size <= 0 ||
+        (replay->tick_count > 0 && !replay->inputs)) {
+        return false;
+    }
+    if (options->format == REPLAY_EXPORT_RAW ? !options->raw_out : !options->png_dir) {
+        return false;
+    }
+    if (options->format == REPLAY_EXPORT_PNG &&
+        (strlen(options->png_dir) >= REPLAY_EXPORT_PATH_SIZE || (mkdir(options->png_dir, 0755) != 0 && errno != EEXIST))) {
+        return false;
+    }
+    
+    static export_state_t state;
+    memset(&state, 0, sizeof(state));
+    state.options = options;
+    replay_export_frame_size(replay, options->cell_size, &state.width, &state.height);
+    if (!export_open(&state, options)) {
+        return false;
+    }
+    
+    static blocktris_sim_t sim;
+    static sim_view_buffer_t views;
+    static arcade_font_t font; // Unused: the canvas draws text with its own font
+    graphics_context_t graphics_context;
+    memset(&graphics_context, 0, sizeof(graphics_context));
+    game_layout_t layout; // Just the frame and its canvas: the view is placed by the cell size
+    memset(&layout, 0, sizeof(layout));
+    layout.width = state.width;
+    layout.height = state.height;
+    blocktris_sim_init(&sim, &replay->config, replay->seed);
+    sim_view_buffer_init(&views);
+    
+    uint32_t frame_count = replay_export_frame_count(replay, options->frame_rate);
+    uint32_t next_tick = 0;
+    uint32_t frame = 0;
+    for (; frame < frame_count && !SDL_AtomicGet(&state.failed); frame++) {
+        // Game time of this frame, rounded up to a tick
+        uint64_t frame_tick = ((uint64_t)frame * SIM_TICK_RATE + (uint64_t)options->frame_rate - 1) /
+                              (uint64_t)options->frame_rate;
+        while (next_tick < replay->tick_count && next_tick < frame_tick) {
+            blocktris_sim_step(&sim, replay->inputs[next_tick++]);
+        }
+        sim_view_buffer_publish(&views, &sim);
+        
+        export_slot_t *slot = &state.slots[frame % (uint32_t)state.slot_count];
+        if (state.threaded) {
+            SDL_SemWait(slot->free);
+        }
+        
+        soft_canvas_t canvas;
+        soft_canvas_init(&canvas, slot->pixels, state.width, state.height);
+        soft_canvas_clear(&canvas, soft_rgba(0, 0, 0, 255));
+        layout.canvas = &canvas;
+        blocktris_renderer_render_sim_view(sim_view_buffer_front(&views), &font, options->cell_size,
+                                           options->cell_size, options->cell_size, &layout, &graphics_context);
+        slot->frame = frame;
+        
+        if (state.threaded) {
+            SDL_SemPost(slot->ready);
+        } else if (!encode_frame(&state.encoders[frame % (uint32_t)state.encoder_count], slot)) {
+            SDL_AtomicSet(&state.failed, 1);
+        }
+    }
+    
+    if (state.threaded) {
+        stop_encoders(&state, frame);
+    }
+    sim_view_buffer_cleanup(&views);
+    export_close(&state);
+    
+    bool ok = !SDL_AtomicGet(&state.failed) && frame == frame_count;
+    if (ok && options->format == REPLAY_EXPORT_RAW) {
+        ok = fflush(options->raw_out) == 0;
+    }
+    if (result) {
+        result->width = state.width;
+        result->height = state.height;
+        result->frames = ok ? frame_count : 0;
+    }
+    return ok;
+}
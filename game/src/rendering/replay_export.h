@@ -0,0 +1,105 @@
+/**
+ * @file replay_export.h
+ * @brief Offline replay-to-video frame exporter
+ *
+ * Plays a replay through the simulation and renders it headless with the
+ * software rasterizer, as fast as the CPU allows rather than at 60 Hz.
+ * Frames are either streamed to a file as raw RGBA (width * height * 4
+ * bytes each, for piping into a video encoder) or written as a numbered
+ * PNG sequence.
+ *
+ * Rendering and encoding are pipelined: the calling thread renders frame
+ * N + 1 into a free slot while encoder threads write out the frames before
+ * it. Frame N always goes to encoder N % threads, and each encoder has two
+ * slots, so the renderer only waits when every encoder is behind. Raw
+ * output uses a single encoder so the frames reach the stream in order.
+ */
+
+#ifndef REPLAY_EXPORT_H_
+#define REPLAY_EXPORT_H_
+
+#include "replay_file.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define DEFAULT_REPLAY_EXPORT_FRAME_RATE 60
+#define MAX_REPLAY_EXPORT_FRAME_RATE 240
+#define DEFAULT_REPLAY_EXPORT_CELL_SIZE 24
+
+// Longest PNG directory, leaving room for the frame file names
+#define REPLAY_EXPORT_PATH_SIZE 256
+
+/**
+ * How frames are written
+ */
+typedef enum {
+    REPLAY_EXPORT_RAW, // Raw RGBA frames, one after the other, to raw_out
+    REPLAY_EXPORT_PNG  // png_dir/frame-000000.png, frame-000001.png, ...
+} replay_export_format_t;
+
+/**
+ * Export settings
+ */
+typedef struct {
+    replay_export_format_t format;
+    FILE *raw_out;       // REPLAY_EXPORT_RAW output
+    const char *png_dir; // REPLAY_EXPORT_PNG output directory, created if missing
+    int frame_rate;      // Frames per second of replay time
+    int cell_size;       // Board cell size in pixels
+    int threads;         // PNG encoder threads, 0 for one per CPU
+} replay_export_options_t;
+
+/**
+ * What an export produced
+ */
+typedef struct {
+    int width;       // Frame size in pixels
+    int height;
+    uint32_t frames; // Frames written
+} replay_export_result_t;
+
+/**
+ * Initialize options with the defaults (raw RGBA to stdout)
+ *
+ * @param options Pointer to the options to initialize
+ */
+void replay_export_options_init(replay_export_options_t *options);
+
+/**
+ * Get the size of the frames a replay is exported at
+ *
+ * Board, border and side panel with a one-cell margin, rounded up to even
+ * sizes as most video encoders need.
+ *
+ * @param replay Replay to export
+ * @param cell_size Board cell size in pixels
+ * @param width Set to the frame width
+ * @param height Set to the frame height
+ */
+void replay_export_frame_size(const replay_t *replay, int cell_size, int *width, int *height);
+
+/**
+ * Get the number of frames a replay is exported as
+ *
+ * The first frame shows the game before any input and the last one the
+ * state after the final tick.
+ *
+ * @param replay Replay to export
+ * @param frame_rate Frames per second of replay time
+ * @return Number of frames
+ */
+uint32_t replay_export_frame_count(const replay_t *replay, int frame_rate);
+
+/**
+ * Export every frame of a replay
+ *
+ * @param replay Replay to export
+ * @param options Output format and settings
+ * @param result Set to the frame size and frames written (optional)
+ * @return true if every frame was written
+ */
+bool replay_export_run(const replay_t *replay, const replay_export_options_t *options,
+                       replay_export_result_t *result);
+
+#endif // REPLAY_EXPORT_H_
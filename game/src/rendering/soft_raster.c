@@ -0,0 +1,433 @@
+/**
+ * @file soft_raster.c
+ * @brief Software rasterizer implementation
+ */
+
+#include "soft_raster.h"
+#include "utils.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+/**
+ * Built-in font: one byte per row, bit 4 the leftmost column
+ */
+typedef struct {
+    char character;
+    uint8_t rows[SOFT_FONT_HEIGHT];
+} soft_glyph_t;
+
+static const soft_glyph_t FONT[] = {
+    { '0', { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E } },
+    { '1', { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+    { '2', { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F } },
+    { '3', { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E } },
+    { '4', { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 } },
+    { '5', { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E } },
+    { '6', { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E } },
+    { '7', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 } },
+    { '8', { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E } },
+    { '9', { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C } },
+    { 'A', { 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 } },
+    { 'B', { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E } },
+    { 'C', { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E } },
+    { 'D', { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C } },
+    { 'E', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F } },
+    { 'F', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 } },
+    { 'G', { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F } },
+    { 'H', { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+    { 'I', { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+    { 'J', { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C } },
+    { 'K', { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 } },
+    { 'L', { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F } },
+    { 'M', { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 } },
+    { 'N', { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 } },
+    { 'O', { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+    { 'P', { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 } },
+    { 'Q', { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D } },
+    { 'R', { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 } },
+    { 'S', { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E } },
+    { 'T', { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 } },
+    { 'U', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+    { 'V', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 } },
+    { 'W', { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A } },
+    { 'X', { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 } },
+    { 'Y', { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 } },
+    { 'Z', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F } },
+    { '!', { 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 } },
+    { '.', { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C } },
+    { ':', { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 } },
+    { '-', { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 } },
+    { '/', { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 } },
+    { '%', { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 } },
+};
+
+uint32_t soft_rgba(int r, int g, int b, int a) {
+    uint8_t bytes[4] = { (uint8_t)r, (uint8_t)g, (uint8_t)b, (uint8_t)a };
+    uint32_t pixel;
+    memcpy(&pixel, bytes, sizeof(pixel));
+    return pixel;
+}
+
+bool soft_canvas_init(soft_canvas_t *canvas, uint32_t *pixels, int width, int height) {
+    if (!canvas || !pixels || width <= 0 || height <= 0) {
+        return false;
+    }
+    
+    canvas->pixels = pixels;
+    canvas->width = width;
+    canvas->height = height;
+    canvas->pitch = width;
+    return true;
+}
+
+static inline uint32_t *pixel_at(const soft_canvas_t *canvas, int x, int y) {
+    return canvas->pixels + (size_t)y * (size_t)canvas->pitch + (size_t)x;
+}
+
+/**
+ * Clip a rectangle to the canvas; false if nothing is left
+ */
+static bool clip_rect(const soft_canvas_t *canvas, int *x, int *y, int *width, int *height) {
+    int left = *x < 0 ? 0 : *x;
+    int top = *y < 0 ? 0 : *y;
+    int right = *x + *width > canvas->width ? canvas->width : *x + *width;
+    int bottom = *y + *height > canvas->height ? canvas->height : *y + *height;
+    if (left >= right || top >= bottom) {
+        return false;
+    }
+    
+    *x = left;
+    *y = top;
+    *width = right - left;
+    *height = bottom - top;
+    return true;
+}
+
+/**
+ * Fill a span of pixels with one value.
+ * Uses 32/16-byte vector stores when available, scalar stores otherwise.
+ */
+static inline void fill_span(uint32_t *out, int count, uint32_t pixel) {
+    int i = 0;
+
+#if defined(__AVX2__)
+    __m256i wide = _mm256_set1_epi32((int)pixel);
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256((__m256i *)(out + i), wide);
+    }
+#elif defined(__SSE2__)
+    __m128i wide = _mm_set1_epi32((int)pixel);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128((__m128i *)(out + i), wide);
+    }
+#endif
+    
+    // Scalar tail (or the whole span without vector support)
+    for (; i < count; i++) {
+        out[i] = pixel;
+    }
+}
+
+/**
+ * Blend one colour over a span of pixels, 4 at a time with SSE2.
+ * round(x / 255) is computed as (x + 128 + ((x + 128) >> 8)) >> 8 in both paths.
+ */
+static inline void blend_span(uint32_t *out, int count, uint32_t pixel, int alpha) {
+    int i = 0;
+
+#if defined(__SSE2__)
+    __m128i zero = _mm_setzero_si128();
+    __m128i source = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((int)pixel), zero),
+                                     _mm_set1_epi16((short)alpha));
+    __m128i keep = _mm_set1_epi16((short)(255 - alpha));
+    __m128i bias = _mm_set1_epi16(128);
+    for (; i + 4 <= count; i += 4) {
+        __m128i dst = _mm_loadu_si128((const __m128i *)(out + i));
+        __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), keep), source), bias);
+        __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), keep), source), bias);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128((__m128i *)(out + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    
+    // Scalar tail (or the whole span without vector support)
+    uint8_t source_bytes[4];
+    memcpy(source_bytes, &pixel, sizeof(source_bytes));
+    for (; i < count; i++) {
+        uint8_t bytes[4];
+        memcpy(bytes, &out[i], sizeof(bytes));
+        for (int c = 0; c < 4; c++) {
+            uint32_t value = (uint32_t)bytes[c] * (uint32_t)(255 - alpha) +
+                             (uint32_t)source_bytes[c] * (uint32_t)alpha + 128;
+            bytes[c] = (uint8_t)((value + (value >> 8)) >> 8);
+        }
+        memcpy(&out[i], bytes, sizeof(bytes));
+    }
+}
+
+void soft_canvas_clear(soft_canvas_t *canvas, uint32_t pixel) {
+    if (!canvas) {
+        return;
+    }
+    
+    soft_canvas_fill_rect(canvas, 0, 0, canvas->width, canvas->height, pixel);
+}
+
+void soft_canvas_fill_rect(soft_canvas_t *canvas, int x, int y, int width, int height, uint32_t pixel) {
+    if (!canvas || !clip_rect(canvas, &x, &y, &width, &height)) {
+        return;
+    }
+    
+    for (int row = y; row < y + height; row++) {
+        fill_span(pixel_at(canvas, x, row), width, pixel);
+    }
+}
+
+void soft_canvas_blend_rect(soft_canvas_t *canvas, int x, int y, int width, int height, uint32_t pixel,
+                            int alpha) {
+    if (!canvas || alpha <= 0 || !clip_rect(canvas, &x, &y, &width, &height)) {
+        return;
+    }
+    
+    if (alpha >= 255) {
+        soft_canvas_fill_rect(canvas, x, y, width, height, pixel);
+        return;
+    }
+    
+    for (int row = y; row < y + height; row++) {
+        blend_span(pixel_at(canvas, x, row), width, pixel, alpha);
+    }
+}
+
+void soft_canvas_draw_line(soft_canvas_t *canvas, int x0, int y0, int x1, int y1, uint32_t pixel) {
+    if (!canvas) {
+        return;
+    }
+    
+    // Horizontal and vertical lines, most of what the game draws, are rectangle fills
+    if (y0 == y1) {
+        int left = x0 < x1 ? x0 : x1;
+        soft_canvas_fill_rect(canvas, left, y0, (x0 < x1 ? x1 - x0 : x0 - x1) + 1, 1, pixel);
+        return;
+    }
+    if (x0 == x1) {
+        int top = y0 < y1 ? y0 : y1;
+        soft_canvas_fill_rect(canvas, x0, top, 1, (y0 < y1 ? y1 - y0 : y0 - y1) + 1, pixel);
+        return;
+    }
+    
+    // Bresenham, clipping each pixel
+    int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    int dy = y1 > y0 ? y0 - y1 : y1 - y0;
+    int step_x = x0 < x1 ? 1 : -1;
+    int step_y = y0 < y1 ? 1 : -1;
+    int error = dx + dy;
+    for (;;) {
+        if (x0 >= 0 && x0 < canvas->width && y0 >= 0 && y0 < canvas->height) {
+            *pixel_at(canvas, x0, y0) = pixel;
+        }
+        if (x0 == x1 && y0 == y1) {
+            return;
+        }
+        int twice = 2 * error;
+        if (twice >= dy) {
+            error += dy;
+            x0 += step_x;
+        }
+        if (twice <= dx) {
+            error += dx;
+            y0 += step_y;
+        }
+    }
+}
+
+void soft_canvas_draw_thick_line(soft_canvas_t *canvas, int x0, int y0, int x1, int y1, int thickness,
+                                 uint32_t pixel) {
+    if (!canvas || thickness <= 0) {
+        return;
+    }
+    
+    // Offset copies across the line's minor axis
+    bool mostly_horizontal = (x1 > x0 ? x1 - x0 : x0 - x1) >= (y1 > y0 ? y1 - y0 : y0 - y1);
+    int first = -(thickness - 1) / 2;
+    for (int i = first; i < first + thickness; i++) {
+        if (mostly_horizontal) {
+            soft_canvas_draw_line(canvas, x0, y0 + i, x1, y1 + i, pixel);
+        } else {
+            soft_canvas_draw_line(canvas, x0 + i, y0, x1 + i, y1, pixel);
+        }
+    }
+}
+
+/**
+ * Floor of num / den for den > 0
+ */
+static int64_t floor_div(int64_t num, int64_t den) {
+    int64_t quotient = num / den;
+    return (num % den != 0 && num < 0) ? quotient - 1 : quotient;
+}
+
+void soft_canvas_fill_polygon(soft_canvas_t *canvas, const soft_point_t *points, int count, uint32_t pixel) {
+    if (!canvas || !points || count < 3 || count > SOFT_RASTER_MAX_POLYGON_POINTS) {
+        return;
+    }
+    
+    int top = points[0].y;
+    int bottom = points[0].y;
+    for (int i = 1; i < count; i++) {
+        top = points[i].y < top ? points[i].y : top;
+        bottom = points[i].y > bottom ? points[i].y : bottom;
+    }
+    top = top < 0 ? 0 : top;
+    bottom = bottom > canvas->height ? canvas->height : bottom;
+    
+    for (int y = top; y < bottom; y++) {
+        // Where each edge crosses this row's pixel centres: the first pixel right of the crossing
+        int crossings[SOFT_RASTER_MAX_POLYGON_POINTS];
+        int found = 0;
+        for (int i = 0; i < count; i++) {
+            soft_point_t a = points[i];
+            soft_point_t b = points[(i + 1) % count];
+            if (a.y == b.y) {
+                continue;
+            }
+            if (a.y > b.y) {
+                soft_point_t t = a;
+                a = b;
+                b = t;
+            }
+            // Half-open in y, so a vertex shared by two edges counts once
+            if (2 * y + 1 < 2 * a.y || 2 * y + 1 >= 2 * b.y) {
+                continue;
+            }
+            
+            // First column whose centre x + 0.5 is at or right of the crossing
+            int64_t height = b.y - a.y;
+            int64_t num = 2 * (int64_t)a.x * height + (int64_t)(2 * y + 1 - 2 * a.y) * (b.x - a.x) - height;
+            crossings[found++] = (int)-floor_div(-num, 2 * height);
+        }
+        
+        // Sort the few crossings, then fill between pairs
+        for (int i = 1; i < found; i++) {
+            int value = crossings[i];
+            int j = i - 1;
+            for (; j >= 0 && crossings[j] > value; j--) {
+                crossings[j + 1] = crossings[j];
+            }
+            crossings[j + 1] = value;
+        }
+        for (int i = 0; i + 1 < found; i += 2) {
+            soft_canvas_fill_rect(canvas, crossings[i], y, crossings[i + 1] - crossings[i], 1, pixel);
+        }
+    }
+}
+
+static const uint8_t *find_glyph(char character) {
+    if (character >= 'a' && character <= 'z') {
+        character = (char)(character - 'a' + 'A');
+    }
+    for (size_t i = 0; i < sizeof(FONT) / sizeof(FONT[0]); i++) {
+        if (FONT[i].character == character) {
+            return FONT[i].rows;
+        }
+    }
+    return NULL;
+}
+
+void soft_canvas_draw_text(soft_canvas_t *canvas, const char *text, int x, int y, int scale, uint32_t pixel,
+                           int alpha) {
+    if (!canvas || !text || scale <= 0) {
+        return;
+    }
+    
+    for (; *text; text++, x += SOFT_FONT_ADVANCE * scale) {
+        const uint8_t *rows = find_glyph(*text);
+        if (!rows) {
+            continue; // Spaces and unknown characters just advance
+        }
+        
+        for (int row = 0; row < SOFT_FONT_HEIGHT; row++) {
+            for (int column = 0; column < SOFT_FONT_WIDTH; column++) {
+                if ((rows[row] >> (SOFT_FONT_WIDTH - 1 - column)) & 1) {
+                    soft_canvas_blend_rect(canvas, x + column * scale, y + row * scale, scale, scale, pixel, alpha);
+                }
+            }
+        }
+    }
+}
+
+int soft_canvas_text_width(const char *text, int scale) {
+    if (!text || !*text || scale <= 0) {
+        return 0;
+    }
+    
+    // No gap after the last character
+    return (int)strlen(text) * SOFT_FONT_ADVANCE * scale - (SOFT_FONT_ADVANCE - SOFT_FONT_WIDTH) * scale;
+}
+
+void soft_canvas_blit(soft_canvas_t *canvas, const soft_image_t *image, int x, int y, int width, int height) {
+    if (!canvas || !image || !image->pixels || image->width <= 0 || image->height <= 0 ||
+        width <= 0 || height <= 0) {
+        return;
+    }
+    
+    int clip_x = x;
+    int clip_y = y;
+    int clip_width = width;
+    int clip_height = height;
+    if (!clip_rect(canvas, &clip_x, &clip_y, &clip_width, &clip_height)) {
+        return;
+    }
+    
+    // Sample the source pixel under each target pixel's centre
+    for (int row = clip_y; row < clip_y + clip_height; row++) {
+        int source_y = (int)(((int64_t)(2 * (row - y) + 1) * image->height) / (2 * (int64_t)height));
+        const uint32_t *source = image->pixels + (size_t)source_y * (size_t)image->pitch;
+        uint32_t *out = pixel_at(canvas, clip_x, row);
+        for (int column = clip_x; column < clip_x + clip_width; column++) {
+            int source_x = (int)(((int64_t)(2 * (column - x) + 1) * image->width) / (2 * (int64_t)width));
+            *out++ = source[source_x];
+        }
+    }
+}
+
+uint64_t soft_canvas_hash(const soft_canvas_t *canvas) {
+    uint64_t hash = UTILS_FNV64_OFFSET_BASIS;
+    if (!canvas) {
+        return hash;
+    }
+    
+    for (int y = 0; y < canvas->height; y++) {
+        hash = utils_fnv1a_64(hash, pixel_at(canvas, 0, y), (size_t)canvas->width * sizeof(uint32_t));
+    }
+    return hash;
+}
+
+bool soft_canvas_write_ppm(const soft_canvas_t *canvas, const char *path) {
+    if (!canvas || !path) {
+        return false;
+    }
+    
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    
+    bool ok = fprintf(file, "P6\n%d %d\n255\n", canvas->width, canvas->height) > 0;
+    for (int y = 0; ok && y < canvas->height; y++) {
+        const uint8_t *bytes = (const uint8_t *)pixel_at(canvas, 0, y);
+        for (int x = 0; ok && x < canvas->width; x++, bytes += sizeof(uint32_t)) {
+            ok = fwrite(bytes, 1, 3, file) == 3;
+        }
+    }
+    ok &= fclose(file) == 0;
+    return ok;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file soft_raster.h
+ * @brief Software rasterizer drawing into an in-memory RGBA buffer
+ *
+ * Covers what the game renderer draws — lines, filled polygons, blended
+ * rectangles, text and sprites — without a window or a GPU, so frames can
+ * be rendered headless: for golden-image tests and replay thumbnails.
+ *
+ * Pixels are 4 bytes, R, G, B, A in memory order (the layout of
+ * SDL_PIXELFORMAT_RGBA32 and of the background cache), packed into a
+ * uint32_t by soft_rgba. Rectangle fills, which everything else is built
+ * on, write 8 (AVX2) or 4 (SSE2) pixels at a time; blending uses the same
+ * integer rounding in the vector and scalar paths, so images are
+ * bit-identical whichever the build uses.
+ *
+ * Text uses a built-in 5x7 arcade-style font, the same cell size as the
+ * game's bitmap font.
+ */
+
+#ifndef SOFT_RASTER_H_
+#define SOFT_RASTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Most vertices soft_canvas_fill_polygon handles
+#define SOFT_RASTER_MAX_POLYGON_POINTS 16
+
+// Font cell, and the distance from one character to the next, at scale 1
+#define SOFT_FONT_WIDTH 5
+#define SOFT_FONT_HEIGHT 7
+#define SOFT_FONT_ADVANCE 6
+
+/**
+ * Drawing target, over a caller-owned buffer
+ */
+typedef struct {
+    uint32_t *pixels;
+    int width;
+    int height;
+    int pitch; // Pixels from one row to the next
+} soft_canvas_t;
+
+typedef soft_canvas_t *soft_canvas_ptr;
+
+/**
+ * Read-only image for soft_canvas_blit
+ */
+typedef struct {
+    const uint32_t *pixels;
+    int width;
+    int height;
+    int pitch; // Pixels from one row to the next
+} soft_image_t;
+
+/**
+ * Polygon vertex (same layout as SDL_Point)
+ */
+typedef struct {
+    int x;
+    int y;
+} soft_point_t;
+
+/**
+ * Pack a colour into a pixel
+ *
+ * @param r Red (0..255)
+ * @param g Green (0..255)
+ * @param b Blue (0..255)
+ * @param a Alpha (0..255)
+ * @return The pixel
+ */
+uint32_t soft_rgba(int r, int g, int b, int a);
+
+/**
+ * Set up a canvas over a buffer of width * height pixels
+ *
+ * @param canvas Canvas to initialize
+ * @param pixels Buffer, owned by the caller
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @return false if the buffer or size is unusable
+ */
+bool soft_canvas_init(soft_canvas_t *canvas, uint32_t *pixels, int width, int height);
+
+/**
+ * Fill the whole canvas
+ *
+ * @param canvas Canvas to draw on
+ * @param pixel Fill pixel
+ */
+void soft_canvas_clear(soft_canvas_t *canvas, uint32_t pixel);
+
+/**
+ * Fill a rectangle, clipped to the canvas
+ *
+ * @param canvas Canvas to draw on
+ * @param x Left
+ * @param y Top
+ * @param width Width (nothing is drawn if not positive)
+ * @param height Height (nothing is drawn if not positive)
+ * @param pixel Fill pixel
+ */
+void soft_canvas_fill_rect(soft_canvas_t *canvas, int x, int y, int width, int height, uint32_t pixel);
+
+/**
+ * Blend a colour over a rectangle, clipped to the canvas
+ *
+ * Each channel becomes round((dst * (255 - alpha) + src * alpha) / 255).
+ *
+ * @param canvas Canvas to draw on
+ * @param x Left
+ * @param y Top
+ * @param width Width
+ * @param height Height
+ * @param pixel Colour blended in
+ * @param alpha Opacity of the colour (0..255)
+ */
+void soft_canvas_blend_rect(soft_canvas_t *canvas, int x, int y, int width, int height, uint32_t pixel,
+                            int alpha);
+
+/**
+ * Draw a one-pixel line, both ends included
+ *
+ * @param canvas Canvas to draw on
+ * @param x0 Start column
+ * @param y0 Start row
+ * @param x1 End column
+ * @param y1 End row
+ * @param pixel Line pixel
+ */
+void soft_canvas_draw_line(soft_canvas_t *canvas, int x0, int y0, int x1, int y1, uint32_t pixel);
+
+/**
+ * Draw a line thickness pixels wide, centred on the one-pixel line
+ *
+ * @param canvas Canvas to draw on
+ * @param x0 Start column
+ * @param y0 Start row
+ * @param x1 End column
+ * @param y1 End row
+ * @param thickness Width in pixels
+ * @param pixel Line pixel
+ */
+void soft_canvas_draw_thick_line(soft_canvas_t *canvas, int x0, int y0, int x1, int y1, int thickness,
+                                 uint32_t pixel);
+
+/**
+ * Fill a polygon: pixels whose centres are inside it (even-odd rule)
+ *
+ * @param canvas Canvas to draw on
+ * @param points Vertices in order
+ * @param count Number of vertices (3..SOFT_RASTER_MAX_POLYGON_POINTS)
+ * @param pixel Fill pixel
+ */
+void soft_canvas_fill_polygon(soft_canvas_t *canvas, const soft_point_t *points, int count, uint32_t pixel);
+
+/**
+ * Draw text in the built-in font; lowercase is drawn as uppercase
+ *
+ * @param canvas Canvas to draw on
+ * @param text Text to draw
+ * @param x Left
+ * @param y Top
+ * @param scale Size of a font pixel
+ * @param pixel Text colour
+ * @param alpha Opacity (0..255)
+ */
+void soft_canvas_draw_text(soft_canvas_t *canvas, const char *text, int x, int y, int scale, uint32_t pixel,
+                           int alpha);
+
+/**
+ * Width of text in the built-in font
+ *
+ * @param text Text to measure
+ * @param scale Size of a font pixel
+ * @return Width in pixels
+ */
+int soft_canvas_text_width(const char *text, int scale);
+
+/**
+ * Copy an image into a rectangle, scaled to it (nearest pixel)
+ *
+ * @param canvas Canvas to draw on
+ * @param image Image to copy
+ * @param x Left
+ * @param y Top
+ * @param width Width to scale to
+ * @param height Height to scale to
+ */
+void soft_canvas_blit(soft_canvas_t *canvas, const soft_image_t *image, int x, int y, int width, int height);
+
+/**
+ * Hash the canvas contents (FNV-1a over the pixel bytes, row by row)
+ *
+ * @param canvas Canvas to hash
+ * @return The hash
+ */
+uint64_t soft_canvas_hash(const soft_canvas_t *canvas);
+
+/**
+ * Write the canvas as a binary PPM image (alpha dropped)
+ *
+ * @param canvas Canvas to write
+ * @param path Output file
+ * @return true if written
+ */
+bool soft_canvas_write_ppm(const soft_canvas_t *canvas, const char *path);
+
+#endif // SOFT_RASTER_H_
@@ -0,0 +1,356 @@
+/**
+ * @file game_snapshot.c
+ * @brief Saved game implementation
+ */
+
+// open, fsync, mmap and rename are POSIX, not C99
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "game_snapshot.h"
+#include "constants.h"
+#include "utils.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const uint8_t SNAPSHOT_MAGIC[4] = { 'B', 'T', 'S', 'V' };
+
+// Longest save path, including the ".tmp" suffix of the file written first
+#define SNAPSHOT_PATH_SIZE 512
+
+/**
+ * Little-endian field cursor over a snapshot image
+ */
+typedef struct {
+    uint8_t *out;       // Encoding
+    const uint8_t *in;  // Decoding
+} snapshot_cursor_t;
+
+static void put_u8(snapshot_cursor_t *cursor, uint32_t value) {
+    *cursor->out++ = (uint8_t)value;
+}
+
+static void put_u16(snapshot_cursor_t *cursor, uint32_t value) {
+    put_u8(cursor, value);
+    put_u8(cursor, value >> 8);
+}
+
+static void put_u32(snapshot_cursor_t *cursor, uint32_t value) {
+    put_u16(cursor, value);
+    put_u16(cursor, value >> 16);
+}
+
+static void put_u64(snapshot_cursor_t *cursor, uint64_t value) {
+    put_u32(cursor, (uint32_t)value);
+    put_u32(cursor, (uint32_t)(value >> 32));
+}
+
+static uint32_t get_u8(snapshot_cursor_t *cursor) {
+    return *cursor->in++;
+}
+
+static uint32_t get_u16(snapshot_cursor_t *cursor) {
+    uint32_t low = get_u8(cursor);
+    return low | (get_u8(cursor) << 8);
+}
+
+static uint32_t get_u32(snapshot_cursor_t *cursor) {
+    uint32_t low = get_u16(cursor);
+    return low | (get_u16(cursor) << 16);
+}
+
+static uint64_t get_u64(snapshot_cursor_t *cursor) {
+    uint64_t low = get_u32(cursor);
+    return low | ((uint64_t)get_u32(cursor) << 32);
+}
+
+static bool is_piece_type(uint32_t value) {
+    return value < NUM_PIECE_TYPES;
+}
+
+/**
+ * Whether a row is on the board or within a piece's reach above or below it
+ */
+static bool is_near_board(int value, int size) {
+    return value >= -PIECE_SIZE && value <= size;
+}
+
+/**
+ * Whether a lock delay is one the rules could have left: settings the options
+ * allow, and progress within them
+ */
+static bool is_lock_delay_valid(const lock_delay_t *lock_delay, int height) {
+    return lock_delay->delay_ticks >= 0 && lock_delay->delay_ticks <= MS_TO_SIM_TICKS(MAX_LOCK_DELAY_MS) &&
+           lock_delay->reset_limit >= 0 && lock_delay->reset_limit <= MAX_LOCK_RESET_LIMIT &&
+           lock_delay->ticks >= 0 && lock_delay->ticks <= lock_delay->delay_ticks + 1 &&
+           lock_delay->resets >= 0 && lock_delay->resets <= lock_delay->reset_limit &&
+           (lock_delay->lowest_row == LOCK_DELAY_NO_ROW || is_near_board(lock_delay->lowest_row, height));
+}
+
+size_t game_snapshot_encode(const game_snapshot_t *snapshot, uint8_t *buffer, size_t capacity) {
+    if (!snapshot || !buffer || capacity < GAME_SNAPSHOT_FILE_SIZE) {
+        return 0;
+    }
+    
+    uint8_t *payload = buffer + GAME_SNAPSHOT_HEADER_SIZE;
+    snapshot_cursor_t cursor = { payload, NULL };
+    
+    // Board, on a fixed stride with empty cells past its size
+    const game_board_t *board = &snapshot->board;
+    put_u8(&cursor, (uint32_t)board->width);
+    put_u8(&cursor, (uint32_t)board->height);
+    memset(cursor.out, BOARD_CELL_EMPTY, MAX_BOARD_HEIGHT * MAX_BOARD_WIDTH);
+    for (int y = 0; y < board->height; y++) {
+        for (int x = 0; x < board->width; x++) {
+            cursor.out[y * MAX_BOARD_WIDTH + x] = game_board_get_cell(board, x, y);
+        }
+    }
+    cursor.out += MAX_BOARD_HEIGHT * MAX_BOARD_WIDTH;
+    
+    const blocktris_piece_t *piece = &snapshot->piece;
+    put_u8(&cursor, (uint32_t)piece->type);
+    put_u8(&cursor, (uint32_t)piece->rotation);
+    put_u16(&cursor, (uint16_t)piece->x);
+    put_u16(&cursor, (uint16_t)piece->y);
+    put_u8(&cursor, piece->active);
+    
+    put_u8(&cursor, (uint32_t)snapshot->hold_type);
+    put_u8(&cursor, snapshot->hold_used);
+    
+    const piece_queue_t *queue = &snapshot->queue;
+    for (int i = 0; i < PIECE_QUEUE_CAPACITY; i++) {
+        put_u8(&cursor, queue->types[i]);
+    }
+    put_u8(&cursor, queue->head);
+    put_u8(&cursor, queue->count);
+    put_u8(&cursor, queue->depth);
+    put_u64(&cursor, queue->seed);
+    put_u64(&cursor, queue->rng_state);
+    put_u32(&cursor, queue->generated);
+    
+    const lock_delay_t *lock_delay = &snapshot->lock_delay;
+    put_u32(&cursor, (uint32_t)lock_delay->delay_ticks);
+    put_u32(&cursor, (uint32_t)lock_delay->reset_limit);
+    put_u32(&cursor, (uint32_t)lock_delay->ticks);
+    put_u32(&cursor, (uint32_t)lock_delay->resets);
+    put_u32(&cursor, (uint32_t)lock_delay->lowest_row);
+    
+    put_u32(&cursor, (uint32_t)snapshot->score);
+    put_u32(&cursor, (uint32_t)snapshot->level);
+    put_u32(&cursor, (uint32_t)snapshot->lines_cleared);
+    put_u32(&cursor, (uint32_t)snapshot->fall_speed);
+    put_u32(&cursor, (uint32_t)snapshot->fall_ticks);
+    put_u32(&cursor, snapshot->sim_tick);
+    
+    put_u8(&cursor, snapshot->line_clear_active);
+    put_u64(&cursor, snapshot->lines_to_clear);
+    put_u8(&cursor, (uint32_t)snapshot->num_lines_to_clear);
+    put_u32(&cursor, snapshot->line_clear_start_tick);
+    put_u64(&cursor, snapshot->replay_hash);
+    
+    // Header last, once the payload checksum is known
+    cursor.out = buffer;
+    memcpy(cursor.out, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    cursor.out += sizeof(SNAPSHOT_MAGIC);
+    put_u16(&cursor, GAME_SNAPSHOT_VERSION);
+    put_u16(&cursor, GAME_SNAPSHOT_HEADER_SIZE);
+    put_u32(&cursor, GAME_SNAPSHOT_PAYLOAD_SIZE);
+    put_u32(&cursor, utils_crc32(0, payload, GAME_SNAPSHOT_PAYLOAD_SIZE));
+    
+    return GAME_SNAPSHOT_FILE_SIZE;
+}
+
+bool game_snapshot_decode(const uint8_t *data, size_t size, game_snapshot_t *snapshot) {
+    if (!data || !snapshot || size != GAME_SNAPSHOT_FILE_SIZE ||
+        memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        return false;
+    }
+    
+    snapshot_cursor_t cursor = { NULL, data + sizeof(SNAPSHOT_MAGIC) };
+    if (get_u16(&cursor) != GAME_SNAPSHOT_VERSION || get_u16(&cursor) != GAME_SNAPSHOT_HEADER_SIZE ||
+        get_u32(&cursor) != GAME_SNAPSHOT_PAYLOAD_SIZE ||
+        get_u32(&cursor) != utils_crc32(0, data + GAME_SNAPSHOT_HEADER_SIZE, GAME_SNAPSHOT_PAYLOAD_SIZE)) {
+        return false;
+    }
+    
+    // The checksum rules out damage, but not a file written by something else: check every field
+    int width = (int)get_u8(&cursor);
+    int height = (int)get_u8(&cursor);
+    if (width < MIN_BOARD_WIDTH || width > MAX_BOARD_WIDTH ||
+        height < MIN_BOARD_HEIGHT || height > MAX_BOARD_HEIGHT) {
+        return false;
+    }
+    
+    game_board_t *board = &snapshot->board;
+    game_board_init(board, width, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            board_cell_t cell = cursor.in[y * MAX_BOARD_WIDTH + x];
+            if (cell == BOARD_CELL_EMPTY) {
+                continue;
+            }
+            if (!is_piece_type(BOARD_CELL_TYPE(cell)) && BOARD_CELL_TYPE(cell) != BOARD_CELL_GARBAGE_TYPE) {
+                return false;
+            }
+            game_board_set_cell(board, x, y, BOARD_CELL_TYPE(cell), cell);
+        }
+    }
+    cursor.in += MAX_BOARD_HEIGHT * MAX_BOARD_WIDTH;
+    
+    blocktris_piece_t *piece = &snapshot->piece;
+    uint32_t piece_type = get_u8(&cursor);
+    uint32_t rotation = get_u8(&cursor);
+    if (!is_piece_type(piece_type) || rotation > 3) {
+        return false;
+    }
+    blocktris_piece_init(piece);
+    piece->type = (piece_type_t)piece_type;
+    piece->rotation = (int8_t)rotation;
+    piece->x = (int16_t)get_u16(&cursor);
+    piece->y = (int16_t)get_u16(&cursor);
+    piece->active = get_u8(&cursor) != 0;
+    if (!is_near_board(piece->x, width) || !is_near_board(piece->y, height) ||
+        (piece->active && !game_board_piece_fits(board, piece->type, piece->rotation, piece->x, piece->y))) {
+        return false;
+    }
+    
+    uint32_t hold_type = get_u8(&cursor);
+    if (!is_piece_type(hold_type) && hold_type != PIECE_EMPTY) {
+        return false;
+    }
+    snapshot->hold_type = (piece_type_t)hold_type;
+    snapshot->hold_used = get_u8(&cursor) != 0;
+    
+    piece_queue_t *queue = &snapshot->queue;
+    for (int i = 0; i < PIECE_QUEUE_CAPACITY; i++) {
+        queue->types[i] = (uint8_t)get_u8(&cursor);
+    }
+    queue->head = (uint8_t)get_u8(&cursor);
+    queue->count = (uint8_t)get_u8(&cursor);
+    queue->depth = (uint8_t)get_u8(&cursor);
+    queue->seed = get_u64(&cursor);
+    queue->rng_state = get_u64(&cursor);
+    queue->generated = get_u32(&cursor);
+    if (queue->head >= PIECE_QUEUE_CAPACITY || queue->count > PIECE_QUEUE_CAPACITY ||
+        queue->depth < PIECE_QUEUE_MIN_DEPTH || queue->depth > PIECE_QUEUE_MAX_DEPTH ||
+        queue->count < queue->depth || queue->rng_state == 0) {
+        return false;
+    }
+    for (int i = 0; i < queue->count; i++) {
+        if (!is_piece_type(queue->types[(queue->head + i) % PIECE_QUEUE_CAPACITY])) {
+            return false;
+        }
+    }
+    
+    lock_delay_t *lock_delay = &snapshot->lock_delay;
+    lock_delay->delay_ticks = (int)get_u32(&cursor);
+    lock_delay->reset_limit = (int)get_u32(&cursor);
+    lock_delay->ticks = (int)get_u32(&cursor);
+    lock_delay->resets = (int)get_u32(&cursor);
+    lock_delay->lowest_row = (int)get_u32(&cursor);
+    if (!is_lock_delay_valid(lock_delay, height)) {
+        return false;
+    }
+    
+    // The level follows from the lines, and the fall speed stays within what the levels give
+    snapshot->score = (int)get_u32(&cursor);
+    snapshot->level = (int)get_u32(&cursor);
+    snapshot->lines_cleared = (int)get_u32(&cursor);
+    snapshot->fall_speed = (int)get_u32(&cursor);
+    snapshot->fall_ticks = (int)get_u32(&cursor);
+    snapshot->sim_tick = get_u32(&cursor);
+    if (snapshot->score < 0 || snapshot->lines_cleared < 0 || snapshot->level != snapshot->lines_cleared / 10 + 1 ||
+        snapshot->fall_speed < FAST_FALL_SPEED || snapshot->fall_speed > INITIAL_FALL_SPEED ||
+        snapshot->fall_ticks < 0 || snapshot->fall_ticks > MS_TO_SIM_TICKS(snapshot->fall_speed)) {
+        return false;
+    }
+    
+    // Lines being cleared are rows of the board, as many as counted, and only while a clear is on
+    snapshot->line_clear_active = get_u8(&cursor) != 0;
+    snapshot->lines_to_clear = get_u64(&cursor);
+    snapshot->num_lines_to_clear = (int)get_u8(&cursor);
+    snapshot->line_clear_start_tick = get_u32(&cursor);
+    snapshot->replay_hash = get_u64(&cursor);
+    if ((snapshot->lines_to_clear >> (height - 1) >> 1) != 0 || // In two shifts: height may be the mask width
+        snapshot->num_lines_to_clear != game_board_count_lines(snapshot->lines_to_clear) ||
+        snapshot->line_clear_active != (snapshot->lines_to_clear != 0)) {
+        return false;
+    }
+    
+    return true;
+}
+
+bool game_snapshot_save(const char *path, const game_snapshot_t *snapshot) {
+    char temp_path[SNAPSHOT_PATH_SIZE];
+    if (!path || !snapshot || snprintf(temp_path, sizeof(temp_path), "%s.tmp", path) >= (int)sizeof(temp_path)) {
+        return false;
+    }
+    
+    uint8_t image[GAME_SNAPSHOT_FILE_SIZE];
+    size_t size = game_snapshot_encode(snapshot, image, sizeof(image));
+    
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    
+    size_t written = 0;
+    while (written < size) {
+        ssize_t result = write(fd, image + written, size - written);
+        if (result <= 0) {
+            break;
+        }
+        written += (size_t)result;
+    }
+    
+    // The data must be on disk before the rename makes it the save
+    bool ok = written == size && fsync(fd) == 0;
+    ok &= close(fd) == 0;
+    if (!ok || rename(temp_path, path) != 0) {
+        unlink(temp_path);
+        return false;
+    }
+    
+    return true;
+}
+
+bool game_snapshot_load(const char *path, game_snapshot_t *snapshot) {
+    if (!path || !snapshot) {
+        return false;
+    }
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size != GAME_SNAPSHOT_FILE_SIZE) {
+        close(fd);
+        return false;
+    }
+    
+    void *image = mmap(NULL, GAME_SNAPSHOT_FILE_SIZE, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid
+    if (image == MAP_FAILED) {
+        return false;
+    }
+    
+    bool ok = game_snapshot_decode((const uint8_t *)image, GAME_SNAPSHOT_FILE_SIZE, snapshot);
+    munmap(image, GAME_SNAPSHOT_FILE_SIZE);
+    
+    return ok;
+}
+
+void game_snapshot_remove(const char *path) {
+    if (!path) {
+        return;
+    }
+    
+    unlink(path);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file game_snapshot.h
+ * @brief Saved single-player game, resumed at the next start
+ *
+ * A snapshot holds everything the playing stage needs to carry on: board,
+ * falling and held pieces, preview queue with its RNG, lock delay, score,
+ * level, lines, timers, a line clear in progress and the replay hash the
+ * high-score table records. It is stored as a
+ * fixed-layout binary file so it can be copied between machines:
+ *
+ *   Header (GAME_SNAPSHOT_HEADER_SIZE bytes)
+ *     0  magic "BTSV"
+ *     4  version (u16)
+ *     6  header size (u16)
+ *     8  payload size (u32)
+ *     12 CRC-32 of the payload (u32, the zlib/PNG polynomial)
+ *   Payload (GAME_SNAPSHOT_PAYLOAD_SIZE bytes), fields in the order of
+ *   game_snapshot_encode, with the board cells on a MAX_BOARD_WIDTH stride
+ *   so the layout doesn't depend on the board size
+ *
+ * Every multi-byte field is little-endian. A file is accepted only if its
+ * magic, version, sizes and checksum all match, so a truncated, corrupted
+ * or older file is never half-loaded.
+ *
+ * Saves write a temporary file next to the target, flush it to disk and
+ * rename it over the target, so a crash mid-save leaves the previous save
+ * intact. Loads map the file and decode it in place.
+ */
+
+#ifndef GAME_SNAPSHOT_H_
+#define GAME_SNAPSHOT_H_
+
+#include "game_board.h"
+#include "blocktris_piece.h"
+#include "piece_queue.h"
+#include "lock_delay.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define GAME_SNAPSHOT_VERSION 4
+
+#define GAME_SNAPSHOT_HEADER_SIZE 16
+
+// board size (2) + cells + piece (7) + hold (2) + queue (39) + lock delay (20) + stats and timers (24)
+// + line clear (14) + replay hash (8)
+#define GAME_SNAPSHOT_PAYLOAD_SIZE (2 + MAX_BOARD_HEIGHT * MAX_BOARD_WIDTH + 7 + 2 + 39 + 20 + 24 + 14 + 8)
+
+#define GAME_SNAPSHOT_FILE_SIZE (GAME_SNAPSHOT_HEADER_SIZE + GAME_SNAPSHOT_PAYLOAD_SIZE)
+
+/**
+ * Single-player game state as saved
+ */
+typedef struct {
+    game_board_t board;
+    blocktris_piece_t piece;  // Falling piece (inactive while a line clear is in progress)
+    piece_type_t hold_type;   // PIECE_EMPTY while the hold slot is empty
+    bool hold_used;
+    piece_queue_t queue;
+    lock_delay_t lock_delay;
+    int score;
+    int level;
+    int lines_cleared;
+    int fall_speed;
+    int fall_ticks;
+    uint32_t sim_tick;
+    bool line_clear_active;
+    board_line_mask_t lines_to_clear;
+    int num_lines_to_clear;
+    uint32_t line_clear_start_tick;
+    uint64_t replay_hash;
+} game_snapshot_t;
+
+typedef game_snapshot_t *game_snapshot_ptr;
+
+/**
+ * Encode a snapshot into its file layout
+ *
+ * @param snapshot Snapshot to encode
+ * @param buffer Output, at least GAME_SNAPSHOT_FILE_SIZE bytes
+ * @param capacity Size of buffer
+ * @return Bytes written (GAME_SNAPSHOT_FILE_SIZE), 0 if the buffer is too small
+ */
+size_t game_snapshot_encode(const game_snapshot_t *snapshot, uint8_t *buffer, size_t capacity);
+
+/**
+ * Decode and validate a snapshot file image
+ *
+ * @param data File contents
+ * @param size Number of bytes
+ * @param snapshot Set to the decoded snapshot
+ * @return false if the bytes aren't a valid snapshot of this version
+ */
+bool game_snapshot_decode(const uint8_t *data, size_t size, game_snapshot_t *snapshot);
+
+/**
+ * Save a snapshot, replacing any previous one atomically
+ *
+ * @param path File to save to
+ * @param snapshot Snapshot to save
+ * @return true if the snapshot is on disk
+ */
+bool game_snapshot_save(const char *path, const game_snapshot_t *snapshot);
+
+/**
+ * Load a snapshot saved by game_snapshot_save
+ *
+ * @param path File to load from
+ * @param snapshot Set to the loaded snapshot
+ * @return false if there is no file or it isn't a valid snapshot
+ */
+bool game_snapshot_load(const char *path, game_snapshot_t *snapshot);
+
+/**
+ * Delete a saved snapshot, once its game is over
+ *
+ * @param path File to delete
+ */
+void game_snapshot_remove(const char *path);
+
+#endif // GAME_SNAPSHOT_H_
@@ -0,0 +1,353 @@
+/**
+ * @file high_scores.c
+ * @brief Leaderboard implementation
+ */
+
+// open, mmap, ftruncate, fsync and rename are POSIX, not C99
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "high_scores.h"
+#include "utils.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const uint8_t LOG_MAGIC[4] = { 'B', 'T', 'H', 'S' };
+
+/**
+ * Check of a record: FNV-1a over every byte but the check itself, folded to 16 bits
+ */
+static uint32_t record_check(const uint8_t *record) {
+    uint64_t hash = utils_fnv1a_64(UTILS_FNV64_OFFSET_BASIS, record, 14);
+    hash = utils_fnv1a_64(hash, record + 16, HIGH_SCORES_RECORD_SIZE - 16);
+    return (uint32_t)((hash ^ (hash >> 16) ^ (hash >> 32) ^ (hash >> 48)) & 0xFFFF);
+}
+
+static void encode_record(const high_score_t *entry, uint8_t *record) {
+    utils_write_u32_le(record, entry->score);
+    utils_write_u32_le(record + 4, entry->lines);
+    utils_write_u32_le(record + 8, entry->duration_ms);
+    utils_write_u16_le(record + 12, entry->level);
+    utils_write_u64_le(record + 16, entry->seed);
+    utils_write_u64_le(record + 24, entry->replay_hash);
+    utils_write_u16_le(record + 14, record_check(record));
+}
+
+static void encode_header(uint8_t *header) {
+    memcpy(header, LOG_MAGIC, sizeof(LOG_MAGIC));
+    utils_write_u16_le(header + 4, HIGH_SCORES_VERSION);
+    utils_write_u16_le(header + 6, HIGH_SCORES_RECORD_SIZE);
+}
+
+static void heap_swap(high_score_t *a, high_score_t *b) {
+    high_score_t t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static void heap_sift_down(high_scores_t *table, int i) {
+    for (;;) {
+        int lowest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < table->count && table->heap[left].score < table->heap[lowest].score) {
+            lowest = left;
+        }
+        if (right < table->count && table->heap[right].score < table->heap[lowest].score) {
+            lowest = right;
+        }
+        if (lowest == i) {
+            return;
+        }
+        heap_swap(&table->heap[i], &table->heap[lowest]);
+        i = lowest;
+    }
+}
+
+/**
+ * Put an entry in the heap if it makes the table; ties go to the entry already there
+ */
+static bool heap_insert(high_scores_t *table, const high_score_t *entry) {
+    if (table->count < table->capacity) {
+        int i = table->count++;
+        table->heap[i] = *entry;
+        while (i > 0 && table->heap[(i - 1) / 2].score > table->heap[i].score) {
+            heap_swap(&table->heap[(i - 1) / 2], &table->heap[i]);
+            i = (i - 1) / 2;
+        }
+        return true;
+    }
+    
+    if (entry->score <= table->heap[0].score) {
+        return false;
+    }
+    table->heap[0] = *entry;
+    heap_sift_down(table, 0);
+    return true;
+}
+
+static bool heap_accepts(const high_scores_t *table, uint32_t score) {
+    return table->count < table->capacity || score > table->heap[0].score;
+}
+
+void high_scores_open(high_scores_t *table, const char *path, int capacity) {
+    if (!table) {
+        return;
+    }
+    
+    if (capacity < 1) {
+        capacity = 1;
+    } else if (capacity > MAX_HIGH_SCORES_SIZE) {
+        capacity = MAX_HIGH_SCORES_SIZE;
+    }
+    
+    snprintf(table->path, sizeof(table->path), "%s", path ? path : "");
+    table->count = 0;
+    table->capacity = capacity;
+    table->loaded = false;
+    table->writable = false;
+    table->log_records = 0;
+}
+
+/**
+ * Check whether a log's header is one this version can add to
+ */
+static bool header_matches(const uint8_t *data) {
+    return memcmp(data, LOG_MAGIC, sizeof(LOG_MAGIC)) == 0 && utils_read_u16_le(data + 4) == HIGH_SCORES_VERSION &&
+           utils_read_u16_le(data + 6) == HIGH_SCORES_RECORD_SIZE;
+}
+
+static bool record_intact(const uint8_t *record) {
+    return utils_read_u16_le(record + 14) == record_check(record);
+}
+
+/**
+ * Write the table to a temporary file and rename it over the log, so a crash
+ * leaves either log whole
+ */
+static bool rewrite_table(const high_scores_t *table) {
+    char temp_path[HIGH_SCORES_PATH_SIZE + 4];
+    if (snprintf(temp_path, sizeof(temp_path), "%s.tmp", table->path) >= (int)sizeof(temp_path)) {
+        return false;
+    }
+    
+    uint8_t buffer[HIGH_SCORES_HEADER_SIZE + MAX_HIGH_SCORES_SIZE * HIGH_SCORES_RECORD_SIZE];
+    encode_header(buffer);
+    size_t size = HIGH_SCORES_HEADER_SIZE;
+    for (int i = 0; i < table->count; i++, size += HIGH_SCORES_RECORD_SIZE) {
+        encode_record(&table->heap[i], buffer + size);
+    }
+    
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    
+    bool ok = write(fd, buffer, size) == (ssize_t)size;
+    ok &= fsync(fd) == 0;
+    ok &= close(fd) == 0;
+    if (!ok || rename(temp_path, table->path) != 0) {
+        unlink(temp_path);
+        return false;
+    }
+    return true;
+}
+
+static bool log_full(const high_scores_t *table) {
+    return table->log_records > (uint32_t)(HIGH_SCORES_COMPACT_FACTOR * table->capacity);
+}
+
+/**
+ * Read the log into the heap, dropping damaged records and a torn one at its end,
+ * and compacting a log that has grown past its limit
+ */
+static void load(high_scores_t *table) {
+    table->loaded = true;
+    table->writable = true; // A missing or empty log is started afresh
+    
+    int fd = open(table->path, O_RDWR);
+    if (fd < 0) {
+        return;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        table->writable = false;
+        close(fd);
+        return;
+    }
+    if (info.st_size < HIGH_SCORES_HEADER_SIZE) {
+        // A header torn on the very first write: start over
+        if (info.st_size > 0 && ftruncate(fd, 0) != 0) {
+            table->writable = false;
+        }
+        close(fd);
+        return;
+    }
+    
+    size_t size = (size_t)info.st_size;
+    const uint8_t *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        table->writable = false;
+        close(fd);
+        return;
+    }
+    
+    if (!header_matches(data)) {
+        // Not a log this version can add to; leave it alone
+        table->writable = false;
+        munmap((void *)data, size);
+        close(fd);
+        return;
+    }
+    
+    size_t records = (size - HIGH_SCORES_HEADER_SIZE) / HIGH_SCORES_RECORD_SIZE;
+    const uint8_t *record = data + HIGH_SCORES_HEADER_SIZE;
+    size_t damaged = 0;
+    for (size_t i = 0; i < records; i++, record += HIGH_SCORES_RECORD_SIZE) {
+        if (!record_intact(record)) {
+            damaged++;
+            continue;
+        }
+        
+        // Most records can't make the table; only the ones that could are decoded
+        uint32_t score = utils_read_u32_le(record);
+        if (!heap_accepts(table, score)) {
+            continue;
+        }
+        
+        high_score_t entry;
+        entry.score = score;
+        entry.lines = utils_read_u32_le(record + 4);
+        entry.duration_ms = utils_read_u32_le(record + 8);
+        entry.level = (uint16_t)utils_read_u16_le(record + 12);
+        entry.seed = utils_read_u64_le(record + 16);
+        entry.replay_hash = utils_read_u64_le(record + 24);
+        heap_insert(table, &entry);
+    }
+    table->log_records = (uint32_t)(records - damaged);
+    
+    munmap((void *)data, size);
+    
+    // Damaged records are dropped from the log; otherwise appends must just start on a record boundary
+    size_t used = HIGH_SCORES_HEADER_SIZE + records * HIGH_SCORES_RECORD_SIZE;
+    if (damaged > 0 || log_full(table)) {
+        table->writable = rewrite_table(table);
+        table->log_records = table->writable ? (uint32_t)table->count : table->log_records;
+    } else if (used != size && ftruncate(fd, (off_t)used) != 0) {
+        table->writable = false;
+    }
+    close(fd);
+}
+
+static void ensure_loaded(high_scores_t *table) {
+    if (!table->loaded) {
+        load(table);
+    }
+}
+
+void high_scores_load(high_scores_t *table) {
+    if (table) {
+        ensure_loaded(table);
+    }
+}
+
+/**
+ * Append a record to a log or history file, writing the header first if the file is new
+ */
+static bool append(const char *path, const high_score_t *entry) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    
+    uint8_t buffer[HIGH_SCORES_HEADER_SIZE + HIGH_SCORES_RECORD_SIZE];
+    size_t size = 0;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size == 0) {
+        encode_header(buffer);
+        size = HIGH_SCORES_HEADER_SIZE;
+    }
+    encode_record(entry, buffer + size);
+    size += HIGH_SCORES_RECORD_SIZE;
+    
+    bool ok = write(fd, buffer, size) == (ssize_t)size;
+    close(fd);
+    return ok;
+}
+
+bool high_scores_add(high_scores_t *table, const high_score_t *entry) {
+    if (!table || !entry) {
+        return false;
+    }
+    
+    ensure_loaded(table);
+    char history_path[HIGH_SCORES_PATH_SIZE + sizeof(HIGH_SCORES_HISTORY_SUFFIX)];
+    snprintf(history_path, sizeof(history_path), "%s%s", table->path, HIGH_SCORES_HISTORY_SUFFIX);
+    append(history_path, entry);
+    
+    if (table->writable && append(table->path, entry)) {
+        table->log_records++;
+    }
+    
+    bool made_table = heap_insert(table, entry);
+    if (table->writable && log_full(table)) {
+        high_scores_compact(table);
+    }
+    return made_table;
+}
+
+bool high_scores_qualifies(high_scores_t *table, uint32_t score) {
+    if (!table) {
+        return false;
+    }
+    
+    ensure_loaded(table);
+    return heap_accepts(table, score);
+}
+
+int high_scores_top(high_scores_t *table, high_score_t *entries, int max) {
+    if (!table || !entries || max <= 0) {
+        return 0;
+    }
+    
+    ensure_loaded(table);
+    
+    // Pop a copy of the heap: lowest first, so fill from the back
+    high_scores_t sorted = *table;
+    int count = sorted.count;
+    high_score_t ordered[MAX_HIGH_SCORES_SIZE];
+    for (int i = count - 1; i >= 0; i--) {
+        ordered[i] = sorted.heap[0];
+        sorted.heap[0] = sorted.heap[--sorted.count];
+        heap_sift_down(&sorted, 0);
+    }
+    
+    int n = count < max ? count : max;
+    memcpy(entries, ordered, (size_t)n * sizeof(high_score_t));
+    return n;
+}
+
+bool high_scores_compact(high_scores_t *table) {
+    if (!table) {
+        return false;
+    }
+    
+    ensure_loaded(table);
+    if (!table->writable || !rewrite_table(table)) {
+        return false;
+    }
+    
+    table->log_records = (uint32_t)table->count;
+    return true;
+}
+
+uint64_t high_scores_hash_placement(uint64_t hash, int type, int rotation, int x, int y) {
+    uint8_t bytes[4] = { (uint8_t)type, (uint8_t)rotation, (uint8_t)x, (uint8_t)y };
+    return utils_fnv1a_64(hash, bytes, sizeof(bytes));
+}
@@ -0,0 +1,162 @@
+/**
+ * @file high_scores.h
+ * @brief Local leaderboard kept in an append-only log
+ *
+ * Every finished game is appended to the log as one fixed-size record, so
+ * saving a score is a single small write and a crash can at worst lose the
+ * record being written. The best scores are kept in memory in a min-heap
+ * of the table size: adding a game is O(log N) and a game that doesn't
+ * make the table is turned away by looking at the root.
+ *
+ * Once the log holds HIGH_SCORES_COMPACT_FACTOR times the table size, it
+ * is compacted: rewritten with just the table, through a temporary file
+ * renamed over it. So it stays a few kilobytes however many games are
+ * played, and reading it costs nothing measurable. It is read in one pass
+ * over the mapped file, only decoding records good enough for the table,
+ * by high_scores_load, which the game calls on the asset loader thread
+ * once the images are decoded (or else on the first add or query).
+ *
+ * The full history of games played goes to a second file next to the log
+ * (its path plus HIGH_SCORES_HISTORY_SUFFIX), in the same layout. It is
+ * only ever appended to; the game never reads or trims it.
+ *
+ * File layout, little-endian:
+ *
+ *   Header (HIGH_SCORES_HEADER_SIZE bytes): magic "BTHS", version (u16),
+ *   record size (u16)
+ *   Records (HIGH_SCORES_RECORD_SIZE bytes each): score (u32), lines (u32),
+ *   duration in ms (u32), level (u16), check (u16), seed (u64), replay
+ *   hash (u64)
+ *
+ * The check is a hash of the other fields; records that fail it (a torn
+ * or damaged write) are skipped, and the log is compacted without them.
+ */
+
+#ifndef HIGH_SCORES_H_
+#define HIGH_SCORES_H_
+
+#include "utils.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define HIGH_SCORES_VERSION 1
+#define HIGH_SCORES_HEADER_SIZE 8
+#define HIGH_SCORES_RECORD_SIZE 32
+
+// Entries shown on the game over screen, and the most a table can hold
+#define DEFAULT_HIGH_SCORES_SIZE 10
+#define MAX_HIGH_SCORES_SIZE 100
+
+// The log is compacted to the table once it holds this many times the table size
+#define HIGH_SCORES_COMPACT_FACTOR 8
+
+// Longest log path, including the terminator
+#define HIGH_SCORES_PATH_SIZE 256
+
+// Appended to the log path to name the history file
+#define HIGH_SCORES_HISTORY_SUFFIX ".history"
+
+/**
+ * One finished game
+ */
+typedef struct {
+    uint32_t score;
+    uint32_t lines;
+    uint32_t duration_ms; // Time played, pauses excluded
+    uint16_t level;
+    uint64_t seed;        // Seed of the piece sequence
+    uint64_t replay_hash; // Hash of every placement, identifying the game played
+} high_score_t;
+
+/**
+ * Leaderboard backed by a log file
+ */
+typedef struct {
+    char path[HIGH_SCORES_PATH_SIZE];
+    high_score_t heap[MAX_HIGH_SCORES_SIZE]; // Min-heap on score: the root is the lowest entry
+    int count;
+    int capacity;         // Table size
+    bool loaded;          // The log has been read
+    bool writable;        // The log is ours to append to (false if it belongs to another version)
+    uint32_t log_records; // Intact records in the log file (the history file isn't counted)
+} high_scores_t;
+
+typedef high_scores_t *high_scores_ptr;
+
+/**
+ * Set up a table for a log file, without reading it yet (high_scores_load)
+ *
+ * @param table Pointer to the table to initialize
+ * @param path Log file, created on the first add if missing
+ * @param capacity Table size (clamped to 1..MAX_HIGH_SCORES_SIZE)
+ */
+void high_scores_open(high_scores_t *table, const char *path, int capacity);
+
+/**
+ * Read the log into the table, if it hasn't been read yet
+ *
+ * Takes a pass over the log, which may need compacting, so call it off the
+ * main thread; nothing else may use the table meanwhile.
+ *
+ * @param table Pointer to the table
+ */
+void high_scores_load(high_scores_t *table);
+
+/**
+ * Record a finished game
+ *
+ * The game is appended to the history, and to the log whether or not it
+ * makes the table; a log grown past its limit is compacted.
+ *
+ * @param table Pointer to the table
+ * @param entry Game to record
+ * @return true if the game made the table
+ */
+bool high_scores_add(high_scores_t *table, const high_score_t *entry);
+
+/**
+ * Check whether a score would make the table, without recording it
+ *
+ * @param table Pointer to the table
+ * @param score Score to check
+ * @return true if the table has room or the score beats its lowest entry
+ */
+bool high_scores_qualifies(high_scores_t *table, uint32_t score);
+
+/**
+ * Get the table, best first
+ *
+ * @param table Pointer to the table
+ * @param entries Output, room for max entries
+ * @param max Most entries to return
+ * @return Number of entries written
+ */
+int high_scores_top(high_scores_t *table, high_score_t *entries, int max);
+
+/**
+ * Rewrite the log with just the table; the history file is left alone
+ *
+ * Done automatically when the log grows past HIGH_SCORES_COMPACT_FACTOR
+ * times the table size, or is read with damaged records in it.
+ *
+ * @param table Pointer to the table
+ * @return true if the log was rewritten
+ */
+bool high_scores_compact(high_scores_t *table);
+
+/**
+ * Hash a placement into a game's replay hash (FNV-1a)
+ *
+ * @param hash Hash so far, HIGH_SCORES_REPLAY_HASH_INIT for a new game
+ * @param type Piece type
+ * @param rotation Piece rotation
+ * @param x Piece column
+ * @param y Piece row
+ * @return Updated hash
+ */
+uint64_t high_scores_hash_placement(uint64_t hash, int type, int rotation, int x, int y);
+
+// Replay hash of a game with no placements yet (FNV-1a offset basis)
+#define HIGH_SCORES_REPLAY_HASH_INIT UTILS_FNV64_OFFSET_BASIS
+
+#endif // HIGH_SCORES_H_
@@ -0,0 +1,161 @@
+/**
+ * @file replay_file.c
+ * @brief Replay recording and file implementation
+ */
+
+#include "replay_file.h"
+#include "constants.h"
+#include "piece_queue.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const uint8_t REPLAY_MAGIC[4] = { 'B', 'T', 'R', 'P' };
+
+// Every bit a recorded input may have set
+#define REPLAY_INPUT_MASK (SIM_INPUT_LEFT | SIM_INPUT_RIGHT | SIM_INPUT_ROTATE_CW | SIM_INPUT_ROTATE_CCW | \
+                           SIM_INPUT_HARD_DROP | SIM_INPUT_HOLD | SIM_INPUT_SOFT_DROP)
+
+// Inputs allocated by the first append
+#define REPLAY_INITIAL_CAPACITY 4096
+
+// Longest replay path, including the ".tmp" suffix of the file written first
+#define REPLAY_PATH_SIZE 512
+
+void replay_init(replay_t *replay, const game_config_t *config, uint64_t seed) {
+    if (!replay) {
+        return;
+    }
+    
+    if (config) {
+        replay->config = *config;
+    } else {
+        game_config_init(&replay->config);
+    }
+    replay->seed = seed;
+    replay->inputs = NULL;
+    replay->tick_count = 0;
+    replay->capacity = 0;
+}
+
+bool replay_append(replay_t *replay, sim_input_t input) {
+    if (!replay || replay->tick_count >= REPLAY_MAX_TICKS) {
+        return false;
+    }
+    
+    if (replay->tick_count == replay->capacity) {
+        uint32_t capacity = replay->capacity ? replay->capacity * 2 : REPLAY_INITIAL_CAPACITY;
+        sim_input_t *inputs = realloc(replay->inputs, capacity * sizeof(sim_input_t));
+        if (!inputs) {
+            return false;
+        }
+        replay->inputs = inputs;
+        replay->capacity = capacity;
+    }
+    
+    replay->inputs[replay->tick_count++] = input;
+    return true;
+}
+
+void replay_free(replay_t *replay) {
+    if (!replay) {
+        return;
+    }
+    
+    free(replay->inputs);
+    replay->inputs = NULL;
+    replay->tick_count = 0;
+    replay->capacity = 0;
+}
+
+bool replay_save(const char *path, const replay_t *replay) {
+    char temp_path[REPLAY_PATH_SIZE];
+    if (!path || !replay || snprintf(temp_path, sizeof(temp_path), "%s.tmp", path) >= (int)sizeof(temp_path)) {
+        return false;
+    }
+    
+    uint8_t header[REPLAY_FILE_HEADER_SIZE] = { 0 };
+    memcpy(header, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    utils_write_u16_le(header + 4, REPLAY_FILE_VERSION);
+    utils_write_u16_le(header + 6, (uint32_t)replay->config.board_width);
+    utils_write_u16_le(header + 8, (uint32_t)replay->config.board_height);
+    utils_write_u16_le(header + 10, (uint32_t)replay->config.preview_depth);
+    utils_write_u16_le(header + 12, (uint32_t)replay->config.lock_delay_ms);
+    utils_write_u16_le(header + 14, (uint32_t)replay->config.lock_reset_limit);
+    utils_write_u64_le(header + 16, replay->seed);
+    utils_write_u32_le(header + 24, replay->tick_count);
+    
+    FILE *file = fopen(temp_path, "wb");
+    if (!file) {
+        return false;
+    }
+    
+    bool ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    if (ok && replay->tick_count > 0) {
+        ok = fwrite(replay->inputs, sizeof(sim_input_t), replay->tick_count, file) == replay->tick_count;
+    }
+    ok &= fclose(file) == 0;
+    if (!ok || rename(temp_path, path) != 0) {
+        remove(temp_path);
+        return false;
+    }
+    
+    return true;
+}
+
+static bool in_range(uint32_t value, int min_value, int max_value) {
+    return value >= (uint32_t)min_value && value <= (uint32_t)max_value;
+}
+
+bool replay_load(const char *path, replay_t *replay) {
+    if (!path || !replay) {
+        return false;
+    }
+    
+    replay_init(replay, NULL, 0);
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    
+    uint8_t header[REPLAY_FILE_HEADER_SIZE];
+    bool ok = fread(header, 1, sizeof(header), file) == sizeof(header) &&
+              memcmp(header, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) == 0 &&
+              utils_read_u16_le(header + 4) == REPLAY_FILE_VERSION &&
+              in_range(utils_read_u16_le(header + 6), MIN_BOARD_WIDTH, MAX_BOARD_WIDTH) &&
+              in_range(utils_read_u16_le(header + 8), MIN_BOARD_HEIGHT, MAX_BOARD_HEIGHT) &&
+              in_range(utils_read_u16_le(header + 10), PIECE_QUEUE_MIN_DEPTH, PIECE_QUEUE_MAX_DEPTH) &&
+              in_range(utils_read_u16_le(header + 12), 0, MAX_LOCK_DELAY_MS) &&
+              in_range(utils_read_u16_le(header + 14), 0, MAX_LOCK_RESET_LIMIT) &&
+              utils_read_u32_le(header + 24) <= REPLAY_MAX_TICKS;
+    
+    uint32_t tick_count = ok ? utils_read_u32_le(header + 24) : 0;
+    if (ok && tick_count > 0) {
+        replay->inputs = malloc(tick_count * sizeof(sim_input_t));
+        ok = replay->inputs &&
+             fread(replay->inputs, sizeof(sim_input_t), tick_count, file) == tick_count;
+        replay->capacity = replay->inputs ? tick_count : 0;
+    }
+    
+    // Anything past the inputs means the file isn't what its header says
+    ok = ok && fgetc(file) == EOF;
+    fclose(file);
+    
+    for (uint32_t i = 0; ok && i < tick_count; i++) {
+        ok = (replay->inputs[i] & ~REPLAY_INPUT_MASK) == 0;
+    }
+    if (!ok) {
+        replay_free(replay);
+        return false;
+    }
+    
+    replay->config.board_width = (int)utils_read_u16_le(header + 6);
+    replay->config.board_height = (int)utils_read_u16_le(header + 8);
+    replay->config.preview_depth = (int)utils_read_u16_le(header + 10);
+    replay->config.lock_delay_ms = (int)utils_read_u16_le(header + 12);
+    replay->config.lock_reset_limit = (int)utils_read_u16_le(header + 14);
+    replay->seed = utils_read_u64_le(header + 16);
+    replay->tick_count = tick_count;
+    return true;
+}
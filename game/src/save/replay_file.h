@@ -0,0 +1,99 @@
+/**
+ * @file replay_file.h
+ * @brief Recorded game: its settings, seed and the input of every tick
+ *
+ * The simulation is deterministic, so a replay needs no board states:
+ * stepping a blocktris_sim_t initialized from the replay's settings and seed
+ * with the recorded inputs plays the game again exactly.
+ *
+ * File layout, little-endian:
+ *
+ *   Header (REPLAY_FILE_HEADER_SIZE bytes)
+ *     0  magic "BTRP"
+ *     4  version (u16)
+ *     6  board width (u16)
+ *     8  board height (u16)
+ *     10 preview depth (u16)
+ *     12 lock delay in ms (u16)
+ *     14 lock delay resets (u16)
+ *     16 seed (u64)
+ *     24 tick count (u32)
+ *     28 reserved, zero (u32)
+ *   Inputs: one SIM_INPUT_* byte per tick
+ *
+ * A file is accepted only if the settings are in range, its size matches
+ * the tick count and no input has bits outside the SIM_INPUT_* flags.
+ */
+
+#ifndef REPLAY_FILE_H_
+#define REPLAY_FILE_H_
+
+#include "blocktris_sim.h"
+#include "game_config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define REPLAY_FILE_VERSION 1
+#define REPLAY_FILE_HEADER_SIZE 32
+
+// Longest game a replay holds: a day of ticks
+#define REPLAY_MAX_TICKS (SIM_TICK_RATE * 60 * 60 * 24)
+
+/**
+ * Replay in memory
+ */
+typedef struct {
+    game_config_t config; // Only the board size, preview depth and lock delay settings are used
+    uint64_t seed;
+    sim_input_t *inputs;  // One per tick, owned by the replay
+    uint32_t tick_count;
+    uint32_t capacity;
+} replay_t;
+
+typedef replay_t *replay_ptr;
+
+/**
+ * Start an empty replay of a game
+ *
+ * @param replay Pointer to the replay to initialize
+ * @param config Settings the game is played with
+ * @param seed Seed the simulation was initialized with
+ */
+void replay_init(replay_t *replay, const game_config_t *config, uint64_t seed);
+
+/**
+ * Record the input of the next tick
+ *
+ * @param replay Pointer to the replay
+ * @param input Input passed to blocktris_sim_step
+ * @return false if out of memory or REPLAY_MAX_TICKS is reached
+ */
+bool replay_append(replay_t *replay, sim_input_t input);
+
+/**
+ * Free the recorded inputs
+ *
+ * @param replay Pointer to the replay
+ */
+void replay_free(replay_t *replay);
+
+/**
+ * Write a replay file, through a temporary file renamed over the target
+ *
+ * @param path Output file
+ * @param replay Replay to write
+ * @return true if written
+ */
+bool replay_save(const char *path, const replay_t *replay);
+
+/**
+ * Read a replay file
+ *
+ * @param path File to read
+ * @param replay Replay to fill in (initialized by this call; free it with replay_free)
+ * @return false if the file is missing or invalid
+ */
+bool replay_load(const char *path, replay_t *replay);
+
+#endif // REPLAY_FILE_H_
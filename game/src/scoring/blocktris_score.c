@@ -7,68 +7,106 @@
 #include "constants.h"
 #include <stdio.h>
 
-void blocktris_score_add_line_clear(game_t *game, int lines_cleared) {
-    if (!game || lines_cleared < 1 || lines_cleared > 4) {
+// Base points indexed by number of lines cleared at once (0-5)
+static const int LINE_CLEAR_POINTS[] = {
+    0,
+    POINTS_SINGLE_LINE,
+    POINTS_DOUBLE_LINE,
+    POINTS_TRIPLE_LINE,
+    POINTS_TETRIS,
+    POINTS_PENTRIS
+};
+
+#define MAX_TABLE_LINES ((int)(sizeof(LINE_CLEAR_POINTS) / sizeof(LINE_CLEAR_POINTS[0])) - 1)
+
+/**
+ * Award points and list the event in the step's events
+ */
+static void award_points(blocktris_sim_t *sim, score_event_type_t type, int amount, int points) {
+    sim->score += points;
+    
+    sim_events_t *events = &sim->events;
+    if (events->num_scored >= SIM_MAX_SCORE_EVENTS) {
         return;
     }
     
-    int base_points = 0;
-    
-    switch (lines_cleared) {
-        case 1:
-            base_points = POINTS_SINGLE_LINE;
-            break;
-        case 2:
-            base_points = POINTS_DOUBLE_LINE;
-            break;
-        case 3:
-            base_points = POINTS_TRIPLE_LINE;
-            break;
-        case 4:
-            base_points = POINTS_TETRIS;
-            break;
+    score_event_t *event = &events->scored[events->num_scored++];
+    event->tick = sim->tick;
+    event->type = (uint8_t)type;
+    event->level = (uint8_t)(sim->level < UINT8_MAX ? sim->level : UINT8_MAX);
+    event->amount = (uint16_t)(amount < UINT16_MAX ? amount : UINT16_MAX);
+    event->points = points;
+}
+
+void blocktris_score_add_line_clear(blocktris_sim_t *sim, int lines_cleared) {
+    if (!sim || lines_cleared < 1) {
+        return;
     }
     
+    int base_points = blocktris_score_get_line_clear_points(lines_cleared);
+    
     // Apply level multiplier
-    int multiplier = blocktris_score_get_level_multiplier(game->level);
-    game->score += base_points * multiplier;
+    int multiplier = blocktris_score_get_level_multiplier(sim->level);
+    award_points(sim, SCORE_EVENT_LINE_CLEAR, lines_cleared, base_points * multiplier);
     
     // Update lines cleared count
-    game->lines_cleared += lines_cleared;
+    sim->lines_cleared += lines_cleared;
     
     // Update level
-    blocktris_score_update_level(game);
+    blocktris_score_update_level(sim);
 }
 
-void blocktris_score_add_soft_drop(game_t *game, int cells_dropped) {
-    if (!game || cells_dropped < 1) {
+int blocktris_score_get_line_clear_points(int lines_cleared) {
+    if (lines_cleared < 1) {
+        return 0;
+    }
+    
+    // Look up the table (clamped), then add the bonus for lines beyond it
+    int table_lines = lines_cleared < MAX_TABLE_LINES ? lines_cleared : MAX_TABLE_LINES;
+    int extra_lines = lines_cleared - table_lines;
+    
+    return LINE_CLEAR_POINTS[table_lines] + extra_lines * POINTS_PER_EXTRA_LINE;
+}
+
+void blocktris_score_add_soft_drop(blocktris_sim_t *sim, int cells_dropped) {
+    if (!sim || cells_dropped < 1) {
         return;
     }
     
-    game->score += cells_dropped * POINTS_SOFT_DROP;
+    award_points(sim, SCORE_EVENT_SOFT_DROP, cells_dropped, cells_dropped * POINTS_SOFT_DROP);
 }
 
-void blocktris_score_add_hard_drop(game_t *game, int cells_dropped) {
-    if (!game || cells_dropped < 1) {
+void blocktris_score_add_hard_drop(blocktris_sim_t *sim, int cells_dropped) {
+    if (!sim || cells_dropped < 1) {
         return;
     }
     
-    game->score += cells_dropped * POINTS_HARD_DROP;
+    award_points(sim, SCORE_EVENT_HARD_DROP, cells_dropped, cells_dropped * POINTS_HARD_DROP);
 }
 
-void blocktris_score_update_level(game_t *game) {
-    if (!game) {
+void blocktris_score_update_level(blocktris_sim_t *sim) {
+    if (!sim) {
         return;
     }
     
     // Level up every 10 lines
-    int new_level = (game->lines_cleared / 10) + 1;
+    int new_level = (sim->lines_cleared / 10) + 1;
     
-    if (new_level != game->level) {
-        game->level = new_level;
+    if (new_level != sim->level) {
+        sim->level = new_level;
         
         // Update fall speed
-        game->fall_speed = blocktris_score_calculate_fall_speed(game->level);
+        sim->fall_speed = blocktris_score_calculate_fall_speed(sim->level);
+    }
+}
+
+void blocktris_score_log_events(score_log_t *log, const sim_events_t *events) {
+    if (!log || !events) {
+        return;
+    }
+    
+    for (int i = 0; i < events->num_scored; i++) {
+        score_log_append(log, &events->scored[i]);
     }
 }
 
@@ -96,7 +134,7 @@ void blocktris_score_reset(game_t *game) {
     game->score = 0;
     game->level = 1;
     game->lines_cleared = 0;
-    game->fall_speed = INITIAL_FALL_SPEED;
+    score_log_reset(&game->score_log);
 }
 
 void blocktris_score_format_display(int score, char *buffer, size_t buffer_size) {
@@ -3,44 +3,63 @@
  * @brief BlockTris scoring system
  *
  * Handles score calculation, level progression, and statistics tracking
- * for the BlockTris game.
+ * for the BlockTris game. All points are awarded through this module, which
+ * lists each award in the simulation step's events; the owner of the
+ * simulation copies them into its score log.
  */
 
 #ifndef BLOCKTRIS_SCORE_H_
 #define BLOCKTRIS_SCORE_H_
 
 #include "game.h"
+#include "blocktris_sim.h"
 
 /**
- * Update score for line clears
+ * Update score, lines and level for line clears
  *
- * @param game Pointer to game state
- * @param lines_cleared Number of lines cleared (1-4)
+ * @param sim Pointer to the simulation
+ * @param lines_cleared Number of lines cleared (1 or more)
+ */
+void blocktris_score_add_line_clear(blocktris_sim_t *sim, int lines_cleared);
+
+/**
+ * Get the base points for clearing a number of lines at once
+ *
+ * @param lines_cleared Number of lines cleared
+ * @return Base points before the level multiplier (0 for no lines)
  */
-void blocktris_score_add_line_clear(game_t *game, int lines_cleared);
+int blocktris_score_get_line_clear_points(int lines_cleared);
 
 /**
  * Update score for soft drop
  *
- * @param game Pointer to game state
+ * @param sim Pointer to the simulation
  * @param cells_dropped Number of cells dropped
  */
-void blocktris_score_add_soft_drop(game_t *game, int cells_dropped);
+void blocktris_score_add_soft_drop(blocktris_sim_t *sim, int cells_dropped);
 
 /**
  * Update score for hard drop
  *
- * @param game Pointer to game state
+ * @param sim Pointer to the simulation
  * @param cells_dropped Number of cells dropped
  */
-void blocktris_score_add_hard_drop(game_t *game, int cells_dropped);
+void blocktris_score_add_hard_drop(blocktris_sim_t *sim, int cells_dropped);
 
 /**
- * Update level based on lines cleared
+ * Update level and fall speed based on lines cleared
  *
- * @param game Pointer to game state
+ * @param sim Pointer to the simulation
+ */
+void blocktris_score_update_level(blocktris_sim_t *sim);
+
+/**
+ * Append the points awarded by the last simulation step to a score log
+ *
+ * @param log Pointer to the score log
+ * @param events Events of the step
  */
-void blocktris_score_update_level(game_t *game);
+void blocktris_score_log_events(score_log_t *log, const sim_events_t *events);
 
 /**
  * Calculate fall speed based on level
@@ -59,7 +78,7 @@ int blocktris_score_calculate_fall_speed(int level);
 int blocktris_score_get_level_multiplier(int level);
 
 /**
- * Reset score and statistics
+ * Reset the score shown and the score log
  *
  * @param game Pointer to game state
  */
@@ -0,0 +1,45 @@
+/**
+ * @file score_log.c
+ * @brief Per-event score log implementation
+ */
+
+#include "score_log.h"
+#include <stddef.h>
+#include <string.h>
+
+void score_log_reset(score_log_t *log) {
+    if (!log) {
+        return;
+    }
+    
+    log->total_events = 0;
+    memset(log->points_by_type, 0, sizeof(log->points_by_type));
+}
+
+void score_log_append(score_log_t *log, const score_event_t *event) {
+    if (!log || !event || event->type >= NUM_SCORE_EVENT_TYPES) {
+        return;
+    }
+    
+    log->events[log->total_events & (SCORE_LOG_CAPACITY - 1)] = *event;
+    log->total_events++;
+    log->points_by_type[event->type] += event->points;
+}
+
+int score_log_count(const score_log_t *log) {
+    if (!log) {
+        return 0;
+    }
+    
+    return log->total_events < SCORE_LOG_CAPACITY ? (int)log->total_events : SCORE_LOG_CAPACITY;
+}
+
+const score_event_t *score_log_get(const score_log_t *log, int index) {
+    int count = score_log_count(log);
+    if (index < 0 || index >= count) {
+        return NULL;
+    }
+    
+    uint32_t first = log->total_events - (uint32_t)count;
+    return &log->events[(first + (uint32_t)index) & (SCORE_LOG_CAPACITY - 1)];
+}
@@ -0,0 +1,83 @@
+/**
+ * @file score_log.h
+ * @brief Per-event score log
+ *
+ * Every scoring event (soft drop, hard drop, line clear) is appended to a
+ * fixed-size ring buffer together with the simulation tick it happened on,
+ * and added to running totals per event type. Analytics can attribute
+ * points from the log without replaying the game.
+ */
+
+#ifndef BLOCKTRIS_SCORE_LOG_H_
+#define BLOCKTRIS_SCORE_LOG_H_
+
+#include <stdint.h>
+
+// Number of most recent events kept (power of two)
+#define SCORE_LOG_CAPACITY 256
+
+/**
+ * Kinds of scoring events
+ */
+typedef enum {
+    SCORE_EVENT_SOFT_DROP,
+    SCORE_EVENT_HARD_DROP,
+    SCORE_EVENT_LINE_CLEAR,
+    NUM_SCORE_EVENT_TYPES
+} score_event_type_t;
+
+/**
+ * A single scoring event
+ */
+typedef struct {
+    uint32_t tick;    // Simulation tick of the event
+    uint8_t type;     // score_event_type_t
+    uint8_t level;    // Level when the points were awarded
+    uint16_t amount;  // Cells dropped or lines cleared
+    int32_t points;   // Points awarded
+} score_event_t;
+
+/**
+ * Score log structure
+ */
+typedef struct {
+    score_event_t events[SCORE_LOG_CAPACITY];
+    uint32_t total_events; // Events logged since the last reset (older ones are overwritten)
+    int64_t points_by_type[NUM_SCORE_EVENT_TYPES];
+} score_log_t;
+
+typedef score_log_t *score_log_ptr;
+
+/**
+ * Clear the log
+ *
+ * @param log Pointer to the log
+ */
+void score_log_reset(score_log_t *log);
+
+/**
+ * Append an event to the log
+ *
+ * @param log Pointer to the log
+ * @param event Event to append
+ */
+void score_log_append(score_log_t *log, const score_event_t *event);
+
+/**
+ * Get the number of events still held in the log
+ *
+ * @param log Pointer to the log
+ * @return Number of events that can be read (at most SCORE_LOG_CAPACITY)
+ */
+int score_log_count(const score_log_t *log);
+
+/**
+ * Get a logged event, oldest first
+ *
+ * @param log Pointer to the log
+ * @param index 0 for the oldest event still held, score_log_count() - 1 for the newest
+ * @return Pointer to the event, NULL if index is out of range
+ */
+const score_event_t *score_log_get(const score_log_t *log, int index);
+
+#endif // BLOCKTRIS_SCORE_LOG_H_
@@ -0,0 +1,107 @@
+/**
+ * @file bot_session.c
+ * @brief Tournament game implementation
+ */
+
+#include "bot_session.h"
+
+// A placement never needs more steps than crossing the widest board while turning
+#define MAX_PLACEMENT_TICKS (MAX_BOARD_WIDTH + 4)
+
+void bot_session_init(bot_session_t *session, spectator_stream_t *stream) {
+    if (!session) {
+        return;
+    }
+    
+    session->started = false;
+    session->stream = stream;
+    if (stream) {
+        spectator_stream_init(stream, DEFAULT_SPECTATOR_KEYFRAME_INTERVAL);
+    }
+}
+
+void bot_session_start(bot_session_t *session, const game_config_t *config, uint64_t seed) {
+    if (!session || !config) {
+        return;
+    }
+    
+    blocktris_sim_init(&session->sim, config, seed);
+    session->started = true;
+    if (session->stream) {
+        spectator_stream_start(session->stream, &session->sim);
+    }
+}
+
+/**
+ * Step the game one tick, recording it for spectators
+ */
+static void step_session(bot_session_t *session, sim_input_t input) {
+    blocktris_sim_step(&session->sim, input);
+    if (session->stream) {
+        spectator_stream_record(session->stream, &session->sim);
+    }
+}
+
+/**
+ * Inputs taking the piece one step closer to the placement, 0 once it is there
+ */
+static sim_input_t placement_step(const blocktris_piece_t *piece, const bot_placement_t *placement) {
+    sim_input_t input = 0;
+    
+    int turns = (placement->rotation - piece->rotation + 4) % 4;
+    if (turns == 3) {
+        input |= SIM_INPUT_ROTATE_CCW;
+    } else if (turns != 0) {
+        input |= SIM_INPUT_ROTATE_CW;
+    }
+    
+    if (piece->x < placement->x) {
+        input |= SIM_INPUT_RIGHT;
+    } else if (piece->x > placement->x) {
+        input |= SIM_INPUT_LEFT;
+    }
+    
+    return input;
+}
+
+bot_place_result_t bot_session_place(bot_session_t *session, const bot_placement_t *placement) {
+    if (!session || !placement || !session->started) {
+        return BOT_PLACE_NOT_STARTED;
+    }
+    
+    blocktris_sim_t *sim = &session->sim;
+    if (sim->game_over) {
+        return BOT_PLACE_GAME_OVER;
+    }
+    
+    uint32_t pieces = sim->pieces_locked;
+    bot_place_result_t result = BOT_PLACE_OK;
+    
+    if (placement->hold) {
+        step_session(session, SIM_INPUT_HOLD);
+        if (sim->game_over) {
+            return BOT_PLACE_GAME_OVER;
+        }
+    }
+    
+    // One step per tick, so gravity and the lock delay treat a bot like anyone else
+    sim_input_t input = placement_step(&sim->piece, placement);
+    for (int i = 0; input != 0; i++) {
+        blocktris_piece_t before = sim->piece;
+        step_session(session, input);
+        if (sim->pieces_locked != pieces) {
+            return sim->game_over ? BOT_PLACE_GAME_OVER : BOT_PLACE_BLOCKED; // Locked on the way
+        }
+        
+        bool moved = sim->piece.x != before.x || sim->piece.rotation != before.rotation;
+        if (!moved || i >= MAX_PLACEMENT_TICKS) {
+            result = BOT_PLACE_BLOCKED;
+            break;
+        }
+        input = placement_step(&sim->piece, placement);
+    }
+    
+    step_session(session, SIM_INPUT_HARD_DROP);
+    
+    return result;
+}
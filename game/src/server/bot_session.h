@@ -0,0 +1,82 @@
+/**
+ * @file bot_session.h
+ * @brief One tournament game driven by piece placements instead of keys
+ *
+ * A bot doesn't play tick by tick: it picks where the current piece should
+ * go (an optional hold, a rotation and a column) and the session carries it
+ * out as a player would, turning and sliding the piece one step per
+ * simulation tick before hard dropping it. The session is plain data around
+ * a blocktris_sim_t, so the server can keep thousands of them in one array
+ * and step any of them on any thread. A session can also record its game
+ * into a spectator stream, after every tick it steps.
+ */
+
+#ifndef BLOCKTRIS_BOT_SESSION_H_
+#define BLOCKTRIS_BOT_SESSION_H_
+
+#include "blocktris_sim.h"
+#include "spectator_stream.h"
+#include "game_config.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Where a bot wants the current piece
+ */
+typedef struct {
+    bool hold;    // Swap with the hold slot first; the rest applies to the piece that comes out
+    int rotation; // Target rotation (0-3)
+    int x;        // Target column of the piece origin, as reported in the board state
+} bot_placement_t;
+
+/**
+ * Tournament game state
+ */
+typedef struct {
+    blocktris_sim_t sim;
+    bool started;
+    spectator_stream_t *stream; // Records the game for spectators, NULL if nobody can watch
+} bot_session_t;
+
+typedef bot_session_t *bot_session_ptr;
+
+/**
+ * Result of a placement
+ */
+typedef enum {
+    BOT_PLACE_OK,           // The piece landed where asked
+    BOT_PLACE_BLOCKED,      // The piece landed as close as it could get
+    BOT_PLACE_NOT_STARTED,  // No game has been started
+    BOT_PLACE_GAME_OVER     // The game has already ended
+} bot_place_result_t;
+
+/**
+ * Reset a session to the not-started state
+ *
+ * @param session Pointer to the session to initialize
+ * @param stream Stream to record the session's games into, NULL for none
+ */
+void bot_session_init(bot_session_t *session, spectator_stream_t *stream);
+
+/**
+ * Start a new game, replacing any game in progress
+ *
+ * @param session Pointer to the session
+ * @param config Board size and preview depth of the game
+ * @param seed Seed of the piece sequence and garbage holes
+ */
+void bot_session_start(bot_session_t *session, const game_config_t *config, uint64_t seed);
+
+/**
+ * Move the current piece to a placement and hard drop it
+ *
+ * The piece turns and slides one step per tick, so a placement that is
+ * blocked along the way drops the piece where it got stuck.
+ *
+ * @param session Pointer to the session
+ * @param placement Where to put the piece
+ * @return How the placement went
+ */
+bot_place_result_t bot_session_place(bot_session_t *session, const bot_placement_t *placement);
+
+#endif // BLOCKTRIS_BOT_SESSION_H_
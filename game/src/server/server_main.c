@@ -0,0 +1,74 @@
+/**
+ * @file server_main.c
+ * @brief Entry point of blocktris_server, the headless bot tournament server
+ */
+
+// sigaction and getrlimit are POSIX, not C99
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "tournament_server.h"
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+
+static tournament_server_t server;
+
+static void handle_stop_signal(int signal_number) {
+    (void)signal_number;
+    tournament_server_stop(&server);
+}
+
+/**
+ * Allow as many open sockets as the system lets us; the usual soft limit
+ * of 1024 would cap the server long before max_games
+ */
+static void raise_file_limit(int max_games) {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur == limit.rlim_max) {
+        return;
+    }
+    
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    
+    getrlimit(RLIMIT_NOFILE, &limit);
+    if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur < (rlim_t)max_games + 16) {
+        printf("Warning: only %lu file descriptors available for %d games\n",
+               (unsigned long)limit.rlim_cur, max_games);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    tournament_server_config_t config;
+    tournament_server_config_init(&config);
+    if (!tournament_server_config_parse_args(&config, argc, argv)) {
+        return 1;
+    }
+    
+    raise_file_limit(config.max_games);
+    
+    if (!tournament_server_open(&server, &config)) {
+        printf("Cannot listen on port %d\n", config.port);
+        return 1;
+    }
+    
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    
+    printf("BlockTris server on 127.0.0.1:%d - %d threads, up to %d games. Ctrl+C to stop\n",
+           tournament_server_port(&server), server.pool.thread_count, config.max_games);
+    fflush(stdout); // Often redirected to a log
+    tournament_server_run(&server);
+    
+    printf("Stopping with %d games open, %llu requests served\n",
+           tournament_server_active_games(&server), (unsigned long long)server.requests_served);
+    tournament_server_close(&server);
+    return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file server_protocol.c
+ * @brief Tournament server wire format implementation
+ */
+
+#include "server_protocol.h"
+#include "constants.h"
+#include "utils.h"
+
+#define LENGTH_PREFIX_SIZE 2
+
+// Frame bodies: type byte, then the fields listed in server_protocol.h
+#define START_SIZE 12 // type, seed (8), width, height, preview
+#define PLACE_SIZE 4  // type, flags, rotation, column
+#define STATE_HEADER_SIZE 23 // type, result, flags, width, height, piece (4), hold, score (4), lines (4), pieces (4), preview count
+
+#define PLACE_FLAG_HOLD 0x01
+
+static piece_type_t read_piece_type(uint8_t value) {
+    return value < NUM_PIECE_TYPES ? (piece_type_t)value : PIECE_EMPTY;
+}
+
+server_frame_status_t server_protocol_next_frame(const uint8_t *data, size_t size, size_t *frame_size) {
+    if (!data || !frame_size || size < LENGTH_PREFIX_SIZE) {
+        return SERVER_FRAME_INCOMPLETE;
+    }
+    
+    size_t length = utils_read_u16_be(data);
+    if (length == 0 || length > SERVER_FRAME_MAX_SIZE - LENGTH_PREFIX_SIZE) {
+        return SERVER_FRAME_MALFORMED;
+    }
+    if (size < LENGTH_PREFIX_SIZE + length) {
+        return SERVER_FRAME_INCOMPLETE;
+    }
+    
+    *frame_size = LENGTH_PREFIX_SIZE + length;
+    return SERVER_FRAME_READY;
+}
+
+bool server_protocol_read_request(const uint8_t *frame, size_t size, server_request_t *request) {
+    if (!frame || !request || size <= LENGTH_PREFIX_SIZE) {
+        return false;
+    }
+    
+    const uint8_t *body = frame + LENGTH_PREFIX_SIZE;
+    size_t length = size - LENGTH_PREFIX_SIZE;
+    
+    if (body[0] == SERVER_MSG_START && length == START_SIZE) {
+        request->type = SERVER_MSG_START;
+        request->seed = ((uint64_t)utils_read_u32_be(body + 1) << 32) | utils_read_u32_be(body + 5);
+        request->board_width = body[9];
+        request->board_height = body[10];
+        request->preview_depth = body[11];
+        return true;
+    }
+    
+    if (body[0] == SERVER_MSG_PLACE && length == PLACE_SIZE) {
+        request->type = SERVER_MSG_PLACE;
+        request->placement.hold = (body[1] & PLACE_FLAG_HOLD) != 0;
+        request->placement.rotation = body[2] & 3;
+        request->placement.x = (int8_t)body[3];
+        return true;
+    }
+    
+    return false;
+}
+
+size_t server_protocol_write_request(uint8_t *buffer, size_t capacity, const server_request_t *request) {
+    if (!buffer || !request) {
+        return 0;
+    }
+    
+    uint8_t *body = buffer + LENGTH_PREFIX_SIZE;
+    
+    if (request->type == SERVER_MSG_START) {
+        if (capacity < LENGTH_PREFIX_SIZE + START_SIZE) {
+            return 0;
+        }
+        body[0] = SERVER_MSG_START;
+        utils_write_u32_be(body + 1, (uint32_t)(request->seed >> 32));
+        utils_write_u32_be(body + 5, (uint32_t)request->seed);
+        body[9] = (uint8_t)request->board_width;
+        body[10] = (uint8_t)request->board_height;
+        body[11] = (uint8_t)request->preview_depth;
+        utils_write_u16_be(buffer, START_SIZE);
+        return LENGTH_PREFIX_SIZE + START_SIZE;
+    }
+    
+    if (request->type == SERVER_MSG_PLACE) {
+        if (capacity < LENGTH_PREFIX_SIZE + PLACE_SIZE) {
+            return 0;
+        }
+        body[0] = SERVER_MSG_PLACE;
+        body[1] = request->placement.hold ? PLACE_FLAG_HOLD : 0;
+        body[2] = (uint8_t)(request->placement.rotation & 3);
+        body[3] = (uint8_t)(int8_t)request->placement.x;
+        utils_write_u16_be(buffer, PLACE_SIZE);
+        return LENGTH_PREFIX_SIZE + PLACE_SIZE;
+    }
+    
+    return 0;
+}
+
+size_t server_protocol_write_state(uint8_t *buffer, size_t capacity, const bot_session_t *session,
+                                   bot_place_result_t result) {
+    if (!buffer || !session) {
+        return 0;
+    }
+    
+    const blocktris_sim_t *sim = &session->sim;
+    bool started = session->started;
+    int width = started ? sim->board.width : 0;
+    int height = started ? sim->board.height : 0;
+    int row_bytes = (width + 7) / 8;
+    int preview = started ? sim->queue.depth : 0;
+    
+    size_t length = STATE_HEADER_SIZE + (size_t)preview + (size_t)(height * row_bytes);
+    if (capacity < LENGTH_PREFIX_SIZE + length) {
+        return 0;
+    }
+    
+    uint8_t *body = buffer + LENGTH_PREFIX_SIZE;
+    uint8_t flags = 0;
+    if (started && sim->game_over) {
+        flags |= SERVER_STATE_GAME_OVER;
+    }
+    if (started && sim->hold_used) {
+        flags |= SERVER_STATE_HOLD_USED;
+    }
+    
+    body[0] = SERVER_MSG_STATE;
+    body[1] = (uint8_t)result;
+    body[2] = flags;
+    body[3] = (uint8_t)width;
+    body[4] = (uint8_t)height;
+    body[5] = (uint8_t)(started && sim->piece.active ? sim->piece.type : PIECE_EMPTY);
+    body[6] = (uint8_t)(started ? sim->piece.rotation : 0);
+    body[7] = (uint8_t)(int8_t)(started ? sim->piece.x : 0);
+    body[8] = (uint8_t)(int8_t)(started ? sim->piece.y : 0);
+    body[9] = (uint8_t)(started ? sim->hold_type : PIECE_EMPTY);
+    utils_write_u32_be(body + 10, started ? (uint32_t)sim->score : 0);
+    utils_write_u32_be(body + 14, started ? (uint32_t)sim->lines_cleared : 0);
+    utils_write_u32_be(body + 18, started ? sim->pieces_locked : 0);
+    body[22] = (uint8_t)preview;
+    
+    uint8_t *out = body + STATE_HEADER_SIZE;
+    for (int i = 0; i < preview; i++) {
+        *out++ = (uint8_t)piece_queue_peek(&sim->queue, i);
+    }
+    
+    // The bitboard already holds each row as a mask with column x in bit x
+    for (int y = 0; y < height; y++) {
+        board_row_t row = sim->board.rows[y];
+        for (int i = 0; i < row_bytes; i++) {
+            *out++ = (uint8_t)(row >> (i * 8));
+        }
+    }
+    
+    utils_write_u16_be(buffer, (uint32_t)length);
+    return LENGTH_PREFIX_SIZE + length;
+}
+
+bool server_protocol_read_state(const uint8_t *frame, size_t size, server_state_t *state) {
+    if (!frame || !state || size < LENGTH_PREFIX_SIZE + STATE_HEADER_SIZE) {
+        return false;
+    }
+    
+    const uint8_t *body = frame + LENGTH_PREFIX_SIZE;
+    int width = body[3];
+    int height = body[4];
+    int preview = body[22];
+    int row_bytes = (width + 7) / 8;
+    
+    if (body[0] != SERVER_MSG_STATE || body[1] > BOT_PLACE_GAME_OVER ||
+        width > MAX_BOARD_WIDTH || height > MAX_BOARD_HEIGHT || preview > PIECE_QUEUE_MAX_DEPTH ||
+        size != LENGTH_PREFIX_SIZE + STATE_HEADER_SIZE + (size_t)preview + (size_t)(height * row_bytes)) {
+        return false;
+    }
+    
+    state->result = (bot_place_result_t)body[1];
+    state->flags = body[2];
+    state->board_width = width;
+    state->board_height = height;
+    state->piece_type = read_piece_type(body[5]);
+    state->piece_rotation = body[6] & 3;
+    state->piece_x = (int8_t)body[7];
+    state->piece_y = (int8_t)body[8];
+    state->hold_type = read_piece_type(body[9]);
+    state->score = utils_read_u32_be(body + 10);
+    state->lines_cleared = utils_read_u32_be(body + 14);
+    state->pieces_placed = utils_read_u32_be(body + 18);
+    state->preview_count = preview;
+    
+    const uint8_t *in = body + STATE_HEADER_SIZE;
+    for (int i = 0; i < preview; i++) {
+        state->preview[i] = read_piece_type(*in++);
+    }
+    
+    for (int y = 0; y < height; y++) {
+        board_row_t row = 0;
+        for (int i = 0; i < row_bytes; i++) {
+            row |= (board_row_t)*in++ << (i * 8);
+        }
+        state->rows[y] = row;
+    }
+    
+    return true;
+}
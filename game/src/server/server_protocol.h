@@ -0,0 +1,143 @@
+/**
+ * @file server_protocol.h
+ * @brief Wire format between the tournament server and its bots
+ *
+ * Bots talk to the server over a TCP stream of frames. Each frame is a
+ * big-endian 16-bit length followed by that many bytes, the first of which
+ * is the message type. Every request gets exactly one STATE reply, in order:
+ *
+ *   START  (bot)    Start a new game: seed, board width, height and preview
+ *                   depth (0 picks the server's default).
+ *   PLACE  (bot)    Put the current piece somewhere: hold flag, rotation and
+ *                   column (see bot_placement_t).
+ *   STATE  (server) How the request went and the game afterwards: flags,
+ *                   board size, current piece, hold slot, preview, score,
+ *                   lines and pieces placed, then the board one row at a
+ *                   time, top row first, (width + 7) / 8 bytes per row with
+ *                   column x in bit x % 8 of byte x / 8.
+ *
+ * Multi-byte fields are big-endian.
+ */
+
+#ifndef BLOCKTRIS_SERVER_PROTOCOL_H_
+#define BLOCKTRIS_SERVER_PROTOCOL_H_
+
+#include "bot_session.h"
+#include "game_board.h"
+#include "piece_queue.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Largest frame either side sends, length prefix included (a full 64x64 STATE fits)
+#define SERVER_FRAME_MAX_SIZE 640
+
+/**
+ * Message types
+ */
+typedef enum {
+    SERVER_MSG_INVALID = 0,
+    SERVER_MSG_START = 1,
+    SERVER_MSG_PLACE = 2,
+    SERVER_MSG_STATE = 0x81
+} server_msg_type_t;
+
+/**
+ * Outcome of looking for a frame at the start of a buffer
+ */
+typedef enum {
+    SERVER_FRAME_INCOMPLETE, // More bytes needed
+    SERVER_FRAME_READY,      // A whole frame is there
+    SERVER_FRAME_MALFORMED   // The length can't be right; drop the connection
+} server_frame_status_t;
+
+// STATE flags
+#define SERVER_STATE_GAME_OVER 0x01
+#define SERVER_STATE_HOLD_USED 0x02
+
+/**
+ * A bot request
+ */
+typedef struct {
+    server_msg_type_t type;
+    uint64_t seed;             // START
+    int board_width;           // START, 0 for the default
+    int board_height;          // START, 0 for the default
+    int preview_depth;         // START, 0 for the default
+    bot_placement_t placement; // PLACE
+} server_request_t;
+
+/**
+ * Contents of a STATE reply, as a bot sees it
+ */
+typedef struct {
+    bot_place_result_t result;
+    uint8_t flags;             // SERVER_STATE_* bits
+    int board_width;           // 0 while no game has started
+    int board_height;
+    piece_type_t piece_type;
+    int piece_rotation;
+    int piece_x;
+    int piece_y;
+    piece_type_t hold_type;
+    int preview_count;
+    piece_type_t preview[PIECE_QUEUE_MAX_DEPTH];
+    uint32_t score;
+    uint32_t lines_cleared;
+    uint32_t pieces_placed;
+    board_row_t rows[MAX_BOARD_HEIGHT]; // Bit x set = column x filled
+} server_state_t;
+
+/**
+ * Find the frame at the start of a buffer
+ *
+ * @param data Received bytes
+ * @param size Number of bytes
+ * @param frame_size Set to the size of the frame, length prefix included, when ready
+ * @return Whether a frame is ready, incomplete or malformed
+ */
+server_frame_status_t server_protocol_next_frame(const uint8_t *data, size_t size, size_t *frame_size);
+
+/**
+ * Decode a request frame
+ *
+ * @param frame Frame returned by server_protocol_next_frame
+ * @param size Size of the frame
+ * @param request Filled in on success
+ * @return true if the frame is a well-formed START or PLACE
+ */
+bool server_protocol_read_request(const uint8_t *frame, size_t size, server_request_t *request);
+
+/**
+ * Encode a request frame (bot side)
+ *
+ * @param buffer Output buffer
+ * @param capacity Size of the buffer
+ * @param request START or PLACE request to send
+ * @return Bytes written, or 0 if the request is invalid or doesn't fit
+ */
+size_t server_protocol_write_request(uint8_t *buffer, size_t capacity, const server_request_t *request);
+
+/**
+ * Encode the STATE reply to a request
+ *
+ * @param buffer Output buffer
+ * @param capacity Size of the buffer
+ * @param session Game to describe
+ * @param result Outcome of the request
+ * @return Bytes written, or 0 if it doesn't fit
+ */
+size_t server_protocol_write_state(uint8_t *buffer, size_t capacity, const bot_session_t *session,
+                                   bot_place_result_t result);
+
+/**
+ * Decode a STATE frame (bot side)
+ *
+ * @param frame Frame returned by server_protocol_next_frame
+ * @param size Size of the frame
+ * @param state Filled in on success
+ * @return true if the frame is a well-formed STATE
+ */
+bool server_protocol_read_state(const uint8_t *frame, size_t size, server_state_t *state);
+
+#endif // BLOCKTRIS_SERVER_PROTOCOL_H_
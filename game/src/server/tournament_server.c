@@ -0,0 +1,482 @@
+/**
+ * @file tournament_server.c
+ * @brief Tournament server implementation (Linux: epoll and eventfd)
+ */
+
+// Sockets and fcntl are POSIX, not C99
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "tournament_server.h"
+#include "blocktris_piece.h"
+#include "constants.h"
+#include "utils.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define EPOLL_BATCH 256
+
+// Requests served per turn on a worker, so one chatty bot can't hold a thread
+#define MAX_REQUESTS_PER_JOB 64
+
+static bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+void tournament_server_config_init(tournament_server_config_t *config) {
+    if (!config) {
+        return;
+    }
+    
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    config->port = DEFAULT_SERVER_PORT;
+    config->threads = cpus > 0 ? (int)cpus : 1;
+    config->max_games = DEFAULT_SERVER_MAX_GAMES;
+    game_config_init(&config->defaults);
+    config->spectate = false;
+}
+
+bool tournament_server_config_parse_args(tournament_server_config_t *config, int argc, char *argv[]) {
+    if (!config || argc < 1) {
+        return false;
+    }
+    
+    // The game options are passed on in order, without the server's
+    char **game_argv = malloc((size_t)argc * sizeof(char *));
+    if (!game_argv) {
+        return false;
+    }
+    int game_argc = 0;
+    game_argv[game_argc++] = argv[0];
+    
+    bool valid = true;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        int port = config->port;
+        
+        if (strcmp(arg, "--port") == 0) {
+            valid &= utils_parse_int_option(arg, value, 0, MAX_NET_PORT, &port);
+            config->port = (uint16_t)port;
+            i++;
+        } else if (strcmp(arg, "--threads") == 0) {
+            valid &= utils_parse_int_option(arg, value, 1, WORKER_POOL_MAX_THREADS, &config->threads);
+            i++;
+        } else if (strcmp(arg, "--max-games") == 0) {
+            valid &= utils_parse_int_option(arg, value, 1, MAX_SERVER_GAMES, &config->max_games);
+            i++;
+        } else if (strcmp(arg, "--spectate") == 0) {
+            config->spectate = true;
+        } else {
+            game_argv[game_argc++] = argv[i];
+        }
+    }
+    
+    valid &= game_config_parse_args(&config->defaults, game_argc, game_argv);
+    free(game_argv);
+    
+    return valid;
+}
+
+/**
+ * Give a connection's slot back and forget its game
+ */
+static void close_connection(tournament_server_t *server, server_connection_t *connection) {
+    close(connection->fd); // Also takes it out of the epoll set
+    connection->open = false;
+    
+    pthread_mutex_lock(&server->slots_lock);
+    server->free_slots[server->free_count++] = (int)(connection - server->connections);
+    pthread_mutex_unlock(&server->slots_lock);
+}
+
+static void run_request(tournament_server_t *server, server_connection_t *connection,
+                        const server_request_t *request) {
+    bot_session_t *session = &connection->session;
+    bot_place_result_t result = BOT_PLACE_OK;
+    
+    if (request->type == SERVER_MSG_START) {
+        game_config_t config = server->config.defaults;
+        if (request->board_width != 0) {
+            config.board_width = request->board_width;
+        }
+        if (request->board_height != 0) {
+            config.board_height = request->board_height;
+        }
+        if (request->preview_depth != 0) {
+            config.preview_depth = request->preview_depth;
+        }
+        bot_session_start(session, &config, request->seed);
+    } else {
+        result = bot_session_place(session, &request->placement);
+    }
+    
+    connection->out_size += server_protocol_write_state(connection->out + connection->out_size,
+                                                        sizeof(connection->out) - connection->out_size,
+                                                        session, result);
+    __atomic_add_fetch(&server->requests_served, 1, __ATOMIC_RELAXED);
+}
+
+static size_t output_room(const server_connection_t *connection) {
+    return sizeof(connection->out) - connection->out_size;
+}
+
+static bool has_frame(const server_connection_t *connection) {
+    size_t frame_size;
+    return server_protocol_next_frame(connection->in, connection->in_size, &frame_size) == SERVER_FRAME_READY;
+}
+
+/**
+ * Answer buffered requests while there is room for the replies
+ *
+ * @return false if the bot sent something that isn't a request
+ */
+static bool run_requests(tournament_server_t *server, server_connection_t *connection, int *budget) {
+    size_t consumed = 0;
+    
+    while (*budget > 0 && output_room(connection) >= SERVER_FRAME_MAX_SIZE) {
+        size_t frame_size;
+        server_frame_status_t status = server_protocol_next_frame(connection->in + consumed,
+                                                                  connection->in_size - consumed, &frame_size);
+        if (status == SERVER_FRAME_INCOMPLETE) {
+            break;
+        }
+        
+        server_request_t request;
+        if (status == SERVER_FRAME_MALFORMED ||
+            !server_protocol_read_request(connection->in + consumed, frame_size, &request)) {
+            return false;
+        }
+        
+        run_request(server, connection, &request);
+        consumed += frame_size;
+        (*budget)--;
+    }
+    
+    connection->in_size -= consumed;
+    memmove(connection->in, connection->in + consumed, connection->in_size);
+    return true;
+}
+
+/**
+ * Write as much pending output as the socket takes
+ *
+ * @return false if the connection is gone
+ */
+static bool flush_output(server_connection_t *connection) {
+    while (connection->out_start < connection->out_size) {
+        ssize_t written = send(connection->fd, connection->out + connection->out_start,
+                               connection->out_size - connection->out_start, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        connection->out_start += (size_t)written;
+    }
+    
+    connection->out_start = 0;
+    connection->out_size = 0;
+    return true;
+}
+
+/**
+ * Read, answer and write until the socket runs dry or the turn is used up
+ *
+ * @return false if the connection should be closed
+ */
+static bool service_connection(tournament_server_t *server, server_connection_t *connection) {
+    int budget = MAX_REQUESTS_PER_JOB;
+    
+    for (;;) {
+        if (!run_requests(server, connection, &budget) || !flush_output(connection)) {
+            return false;
+        }
+        if (budget == 0 || output_room(connection) < SERVER_FRAME_MAX_SIZE) {
+            return true; // Come back once the bot has read its replies
+        }
+        
+        ssize_t received = recv(connection->fd, connection->in + connection->in_size,
+                                sizeof(connection->in) - connection->in_size, 0);
+        if (received > 0) {
+            connection->in_size += (size_t)received;
+        } else if (received < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK); // 0 = the bot hung up
+        }
+    }
+}
+
+static void connection_job(void *job, void *context) {
+    tournament_server_t *server = (tournament_server_t *)context;
+    server_connection_t *connection = (server_connection_t *)job;
+    
+    // The epoll round trip between turns already orders them in practice; the
+    // release/acquire pair makes the handover explicit (and visible to TSan)
+    __atomic_load_n(&connection->turns, __ATOMIC_ACQUIRE);
+    
+    if (!service_connection(server, connection)) {
+        close_connection(server, connection);
+        return;
+    }
+    
+    // Wait for more requests only if there is room to answer them; a socket
+    // that is writable wakes us right away to go on with buffered requests
+    struct epoll_event event;
+    event.events = EPOLLONESHOT;
+    event.data.ptr = connection;
+    if (output_room(connection) >= SERVER_FRAME_MAX_SIZE) {
+        event.events |= EPOLLIN;
+    }
+    if (connection->out_size > 0 || has_frame(connection)) {
+        event.events |= EPOLLOUT;
+    }
+    __atomic_store_n(&connection->turns, connection->turns + 1, __ATOMIC_RELEASE);
+    
+    if (epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, connection->fd, &event) != 0) {
+        close_connection(server, connection);
+    }
+}
+
+static void accept_connections(tournament_server_t *server) {
+    for (;;) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            return; // EAGAIN once the backlog is empty
+        }
+        
+        pthread_mutex_lock(&server->slots_lock);
+        int slot = server->free_count > 0 ? server->free_slots[--server->free_count] : -1;
+        pthread_mutex_unlock(&server->slots_lock);
+        
+        // Replies are small and bots wait for each one, so don't let Nagle hold them back
+        int no_delay = 1;
+        if (slot < 0 || !set_nonblocking(fd) ||
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay)) != 0) {
+            close(fd);
+            if (slot >= 0) {
+                pthread_mutex_lock(&server->slots_lock);
+                server->free_slots[server->free_count++] = slot;
+                pthread_mutex_unlock(&server->slots_lock);
+            }
+            continue;
+        }
+        
+        server_connection_t *connection = &server->connections[slot];
+        bot_session_init(&connection->session, server->streams ? &server->streams[slot] : NULL);
+        connection->fd = fd;
+        connection->open = true;
+        connection->in_size = 0;
+        connection->out_start = 0;
+        connection->out_size = 0;
+        __atomic_store_n(&connection->turns, connection->turns + 1, __ATOMIC_RELEASE);
+        
+        struct epoll_event event;
+        event.events = EPOLLIN | EPOLLONESHOT;
+        event.data.ptr = connection;
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close_connection(server, connection);
+        }
+    }
+}
+
+static int open_listen_socket(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    
+    int reuse = 1;
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // Bots run on the same machine
+    address.sin_port = htons(port);
+    
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+        bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+        listen(fd, SOMAXCONN) != 0 || !set_nonblocking(fd)) {
+        close(fd);
+        return -1;
+    }
+    
+    return fd;
+}
+
+bool tournament_server_open(tournament_server_t *server, const tournament_server_config_t *config) {
+    if (!server || !config || config->max_games < 1) {
+        return false;
+    }
+    
+    memset(server, 0, sizeof(*server));
+    server->config = *config;
+    server->listen_fd = -1;
+    server->epoll_fd = -1;
+    server->wake_fd = -1;
+    
+    // Fill the shape caches now; from here on the workers only read them
+    blocktris_piece_warm_cache();
+    
+    // Untouched slots cost no memory until a connection uses them
+    server->connections = calloc((size_t)config->max_games, sizeof(server_connection_t));
+    server->streams = config->spectate ? calloc((size_t)config->max_games, sizeof(spectator_stream_t)) : NULL;
+    server->free_slots = malloc((size_t)config->max_games * sizeof(int));
+    if (!server->connections || (config->spectate && !server->streams) || !server->free_slots ||
+        pthread_mutex_init(&server->slots_lock, NULL) != 0) {
+        free(server->connections);
+        free(server->streams);
+        free(server->free_slots);
+        return false;
+    }
+    
+    // Hand out low slots first
+    for (int i = 0; i < config->max_games; i++) {
+        server->free_slots[i] = config->max_games - 1 - i;
+    }
+    server->free_count = config->max_games;
+    
+    server->listen_fd = open_listen_socket(config->port);
+    server->epoll_fd = epoll_create1(0);
+    server->wake_fd = eventfd(0, EFD_NONBLOCK);
+    
+    struct epoll_event listen_event;
+    listen_event.events = EPOLLIN;
+    listen_event.data.ptr = NULL;
+    struct epoll_event wake_event;
+    wake_event.events = EPOLLIN;
+    wake_event.data.ptr = &server->wake_fd;
+    
+    // Each connection is queued at most once, so the queue never needs more than max_games
+    bool opened = server->listen_fd >= 0 && server->epoll_fd >= 0 && server->wake_fd >= 0 &&
+                  epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, server->listen_fd, &listen_event) == 0 &&
+                  epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, server->wake_fd, &wake_event) == 0 &&
+                  worker_pool_init(&server->pool, config->threads, (size_t)config->max_games,
+                                   connection_job, server);
+    if (!opened) {
+        if (server->listen_fd >= 0) {
+            close(server->listen_fd);
+        }
+        if (server->epoll_fd >= 0) {
+            close(server->epoll_fd);
+        }
+        if (server->wake_fd >= 0) {
+            close(server->wake_fd);
+        }
+        pthread_mutex_destroy(&server->slots_lock);
+        free(server->connections);
+        free(server->streams);
+        free(server->free_slots);
+        return false;
+    }
+    
+    return true;
+}
+
+uint16_t tournament_server_port(const tournament_server_t *server) {
+    if (!server || server->listen_fd < 0) {
+        return 0;
+    }
+    
+    struct sockaddr_in address;
+    socklen_t length = sizeof(address);
+    if (getsockname(server->listen_fd, (struct sockaddr *)&address, &length) != 0) {
+        return 0;
+    }
+    
+    return ntohs(address.sin_port);
+}
+
+void tournament_server_run(tournament_server_t *server) {
+    if (!server || server->epoll_fd < 0) {
+        return;
+    }
+    
+    struct epoll_event events[EPOLL_BATCH];
+    
+    for (;;) {
+        int count = epoll_wait(server->epoll_fd, events, EPOLL_BATCH, -1);
+        if (count < 0 && errno != EINTR) {
+            return;
+        }
+        
+        for (int i = 0; i < count; i++) {
+            void *source = events[i].data.ptr;
+            if (source == &server->wake_fd) {
+                return;
+            }
+            if (source == NULL) {
+                accept_connections(server);
+            } else if (!worker_pool_submit(&server->pool, source)) {
+                close_connection(server, (server_connection_t *)source);
+            }
+        }
+    }
+}
+
+void tournament_server_stop(tournament_server_t *server) {
+    if (!server || server->wake_fd < 0) {
+        return;
+    }
+    
+    // write() is async-signal-safe, so this works from a SIGINT handler
+    uint64_t one = 1;
+    ssize_t written = write(server->wake_fd, &one, sizeof(one));
+    (void)written;
+}
+
+int tournament_server_active_games(tournament_server_t *server) {
+    if (!server) {
+        return 0;
+    }
+    
+    pthread_mutex_lock(&server->slots_lock);
+    int active = server->config.max_games - server->free_count;
+    pthread_mutex_unlock(&server->slots_lock);
+    
+    return active;
+}
+
+void tournament_server_close(tournament_server_t *server) {
+    if (!server || server->epoll_fd < 0) {
+        return;
+    }
+    
+    // Let the workers finish their turns before pulling the sockets away
+    worker_pool_shutdown(&server->pool);
+    
+    for (int i = 0; i < server->config.max_games; i++) {
+        if (server->connections[i].open) {
+            close(server->connections[i].fd);
+            server->connections[i].open = false;
+        }
+    }
+    
+    close(server->listen_fd);
+    close(server->epoll_fd);
+    close(server->wake_fd);
+    server->listen_fd = -1;
+    server->epoll_fd = -1;
+    server->wake_fd = -1;
+    
+    pthread_mutex_destroy(&server->slots_lock);
+    free(server->connections);
+    free(server->streams);
+    free(server->free_slots);
+    server->connections = NULL;
+    server->streams = NULL;
+    server->free_slots = NULL;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file tournament_server.h
+ * @brief Headless server hosting one bot game per TCP connection
+ *
+ * One thread waits on epoll for new connections and readable or writable
+ * sockets. A ready connection is handed to the worker pool, which reads its
+ * requests, plays them on the connection's bot_session_t, writes the
+ * replies and re-arms the socket. Sockets are registered EPOLLONESHOT, so a
+ * connection is only ever serviced by one thread at a time and its state
+ * needs no lock.
+ *
+ * Connections live in an array sized by max_games and allocated once; a
+ * game costs a few kilobytes, so tens of thousands fit easily in memory.
+ * With spectating on, every slot also has a spectator stream that its game
+ * is recorded into, written by the worker serving the connection.
+ */
+
+#ifndef BLOCKTRIS_TOURNAMENT_SERVER_H_
+#define BLOCKTRIS_TOURNAMENT_SERVER_H_
+
+#include "bot_session.h"
+#include "server_protocol.h"
+#include "worker_pool.h"
+#include "game_config.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DEFAULT_SERVER_PORT 7878
+#define DEFAULT_SERVER_MAX_GAMES 16384
+#define MAX_SERVER_GAMES (1 << 20)
+
+/**
+ * Server settings
+ */
+typedef struct {
+    uint16_t port;          // TCP port on the loopback interface, 0 for any free port
+    int threads;            // Worker threads
+    int max_games;          // Connections served at once; more are refused
+    game_config_t defaults; // Settings of games started with 0 for the board size or preview
+    bool spectate;          // Record every game into a spectator stream
+} tournament_server_config_t;
+
+/**
+ * One bot connection and its game
+ */
+typedef struct {
+    bot_session_t session;
+    int fd;
+    bool open;               // false while the slot is free
+    uint32_t turns;          // Hands the connection from one thread to the next (see connection_job)
+    size_t in_size;
+    size_t out_start;        // Bytes of out already written
+    size_t out_size;
+    uint8_t in[SERVER_FRAME_MAX_SIZE];
+    uint8_t out[SERVER_FRAME_MAX_SIZE * 2];
+} server_connection_t;
+
+/**
+ * Tournament server state
+ */
+typedef struct {
+    tournament_server_config_t config;
+    int listen_fd;
+    int epoll_fd;
+    int wake_fd;                      // eventfd that interrupts the epoll wait to stop
+    server_connection_t *connections; // max_games slots
+    spectator_stream_t *streams;      // One per slot when spectating, NULL otherwise
+    int *free_slots;                  // Stack of free slot indices
+    int free_count;
+    pthread_mutex_t slots_lock;       // Guards free_slots; connections close on worker threads
+    worker_pool_t pool;
+    uint64_t requests_served;         // Updated atomically by the workers
+} tournament_server_t;
+
+typedef tournament_server_t *tournament_server_ptr;
+
+/**
+ * Fill in the default settings
+ *
+ * @param config Pointer to the settings to initialize
+ */
+void tournament_server_config_init(tournament_server_config_t *config);
+
+/**
+ * Parse command line options into the settings
+ *
+ * Supported options:
+ *   --port N       TCP port to listen on (0 picks a free one)
+ *   --threads N    Worker threads
+ *   --max-games N  Connections served at once
+ *   --spectate     Record every game into a spectator stream
+ *
+ * Everything else goes to game_config_parse_args and sets the defaults of
+ * new games (--board-width, --lock-delay, ...).
+ *
+ * @param config Pointer to the settings to update
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return true if all recognized options had valid values, false otherwise
+ */
+bool tournament_server_config_parse_args(tournament_server_config_t *config, int argc, char *argv[]);
+
+/**
+ * Allocate the connection slots, start listening and start the workers
+ *
+ * @param server Pointer to the server to initialize
+ * @param config Server settings
+ * @return true on success; on failure nothing is left to clean up
+ */
+bool tournament_server_open(tournament_server_t *server, const tournament_server_config_t *config);
+
+/**
+ * Get the port the server listens on (useful when opened with port 0)
+ *
+ * @param server Pointer to the server
+ * @return Port number, 0 on error
+ */
+uint16_t tournament_server_port(const tournament_server_t *server);
+
+/**
+ * Serve connections until tournament_server_stop is called
+ *
+ * @param server Pointer to an open server
+ */
+void tournament_server_run(tournament_server_t *server);
+
+/**
+ * Make tournament_server_run return; safe from any thread or a signal handler
+ *
+ * @param server Pointer to the server
+ */
+void tournament_server_stop(tournament_server_t *server);
+
+/**
+ * Get the number of games in progress
+ *
+ * @param server Pointer to the server
+ * @return Open connections
+ */
+int tournament_server_active_games(tournament_server_t *server);
+
+/**
+ * Close every connection and release the server
+ *
+ * Call after tournament_server_run has returned.
+ *
+ * @param server Pointer to the server
+ */
+void tournament_server_close(tournament_server_t *server);
+
+#endif // BLOCKTRIS_TOURNAMENT_SERVER_H_
@@ -0,0 +1,121 @@
+/**
+ * @file worker_pool.c
+ * @brief Worker pool implementation
+ */
+
+#include "worker_pool.h"
+#include <stdlib.h>
+
+static void *worker_main(void *data) {
+    worker_pool_t *pool = (worker_pool_t *)data;
+    
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->count == 0 && !pool->stopping) {
+            pthread_cond_wait(&pool->job_ready, &pool->lock);
+        }
+        if (pool->count == 0) {
+            break; // Stopping and nothing left to do
+        }
+        
+        void *job = pool->jobs[pool->head];
+        pool->head = (pool->head + 1) % pool->capacity;
+        pool->count--;
+        
+        pthread_mutex_unlock(&pool->lock);
+        pool->run(job, pool->context);
+        pthread_mutex_lock(&pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    
+    return NULL;
+}
+
+bool worker_pool_init(worker_pool_t *pool, int threads, size_t capacity, worker_pool_run_fn run, void *context) {
+    if (!pool || !run || capacity == 0) {
+        return false;
+    }
+    
+    if (threads < 1) {
+        threads = 1;
+    } else if (threads > WORKER_POOL_MAX_THREADS) {
+        threads = WORKER_POOL_MAX_THREADS;
+    }
+    
+    pool->jobs = malloc(capacity * sizeof(void *));
+    if (!pool->jobs) {
+        return false;
+    }
+    if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+        free(pool->jobs);
+        return false;
+    }
+    if (pthread_cond_init(&pool->job_ready, NULL) != 0) {
+        pthread_mutex_destroy(&pool->lock);
+        free(pool->jobs);
+        return false;
+    }
+    
+    pool->capacity = capacity;
+    pool->head = 0;
+    pool->count = 0;
+    pool->stopping = false;
+    pool->run = run;
+    pool->context = context;
+    pool->thread_count = 0;
+    
+    for (int i = 0; i < threads; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0) {
+            break;
+        }
+        pool->thread_count++;
+    }
+    
+    // Fewer threads than asked for still works; none at all doesn't
+    if (pool->thread_count == 0) {
+        pthread_cond_destroy(&pool->job_ready);
+        pthread_mutex_destroy(&pool->lock);
+        free(pool->jobs);
+        return false;
+    }
+    
+    return true;
+}
+
+bool worker_pool_submit(worker_pool_t *pool, void *job) {
+    if (!pool) {
+        return false;
+    }
+    
+    pthread_mutex_lock(&pool->lock);
+    bool accepted = !pool->stopping && pool->count < pool->capacity;
+    if (accepted) {
+        pool->jobs[(pool->head + pool->count) % pool->capacity] = job;
+        pool->count++;
+        pthread_cond_signal(&pool->job_ready);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    
+    return accepted;
+}
+
+void worker_pool_shutdown(worker_pool_t *pool) {
+    if (!pool || pool->thread_count == 0) {
+        return;
+    }
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->job_ready);
+    pthread_mutex_unlock(&pool->lock);
+    
+    for (int i = 0; i < pool->thread_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pool->thread_count = 0;
+    
+    pthread_cond_destroy(&pool->job_ready);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->jobs);
+    pool->jobs = NULL;
+}
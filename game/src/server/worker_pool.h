@@ -0,0 +1,75 @@
+/**
+ * @file worker_pool.h
+ * @brief Fixed set of threads running queued jobs
+ *
+ * Jobs are opaque pointers handed to one run function shared by the pool,
+ * taken in submission order by whichever thread is free. The queue is sized
+ * up front and never grows.
+ */
+
+#ifndef BLOCKTRIS_WORKER_POOL_H_
+#define BLOCKTRIS_WORKER_POOL_H_
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Upper bound on worker threads
+#define WORKER_POOL_MAX_THREADS 256
+
+/**
+ * Function run for each job
+ *
+ * @param job Pointer passed to worker_pool_submit
+ * @param context Pointer passed to worker_pool_init
+ */
+typedef void (*worker_pool_run_fn)(void *job, void *context);
+
+/**
+ * Worker pool state
+ */
+typedef struct {
+    pthread_t threads[WORKER_POOL_MAX_THREADS];
+    int thread_count;
+    pthread_mutex_t lock;
+    pthread_cond_t job_ready;
+    void **jobs;      // Ring buffer of pending jobs
+    size_t capacity;
+    size_t head;      // Index of the oldest pending job
+    size_t count;
+    bool stopping;
+    worker_pool_run_fn run;
+    void *context;
+} worker_pool_t;
+
+typedef worker_pool_t *worker_pool_ptr;
+
+/**
+ * Start the worker threads
+ *
+ * @param pool Pointer to the pool to initialize
+ * @param threads Number of threads (clamped to 1..WORKER_POOL_MAX_THREADS)
+ * @param capacity Most jobs pending at once
+ * @param run Function run for each job
+ * @param context Passed to every run
+ * @return true on success; on failure nothing is left to clean up
+ */
+bool worker_pool_init(worker_pool_t *pool, int threads, size_t capacity, worker_pool_run_fn run, void *context);
+
+/**
+ * Queue a job for the next free thread; safe to call from any thread
+ *
+ * @param pool Pointer to the pool
+ * @param job Pointer passed to the run function
+ * @return false if the queue is full or the pool is shutting down
+ */
+bool worker_pool_submit(worker_pool_t *pool, void *job);
+
+/**
+ * Finish the pending jobs and stop the threads
+ *
+ * @param pool Pointer to the pool
+ */
+void worker_pool_shutdown(worker_pool_t *pool);
+
+#endif // BLOCKTRIS_WORKER_POOL_H_
@@ -0,0 +1,314 @@
+/**
+ * @file blocktris_sim.c
+ * @brief Player simulation implementation
+ */
+
+#include "blocktris_sim.h"
+#include "blocktris_collision.h"
+#include "blocktris_score.h"
+#include "constants.h"
+#include "utils.h"
+#include <stddef.h>
+#include <string.h>
+
+// Garbage rows sent indexed by lines cleared at once (0-5); bigger clears send one row per line
+static const int GARBAGE_ROWS_SENT[] = {0, 0, 1, 2, 4, 5};
+
+#define MAX_GARBAGE_TABLE_LINES ((int)(sizeof(GARBAGE_ROWS_SENT) / sizeof(GARBAGE_ROWS_SENT[0])) - 1)
+
+/**
+ * Put a piece at the spawn position; the game ends if it doesn't fit
+ */
+static void enter_piece(blocktris_sim_t *sim, piece_type_t type) {
+    blocktris_piece_reset(&sim->piece, type, sim->board.width / 2 - 2, 0);
+    sim->fall_ticks = 0;
+    sim->fall_speed = blocktris_score_calculate_fall_speed(sim->level);
+    lock_delay_start_piece(&sim->lock_delay);
+    
+    if (!game_board_piece_fits(&sim->board, type, 0, sim->piece.x, sim->piece.y)) {
+        sim->piece.active = false;
+        sim->game_over = true;
+    }
+}
+
+static void spawn_next_piece(blocktris_sim_t *sim) {
+    sim->hold_used = false;
+    enter_piece(sim, piece_queue_pop(&sim->queue));
+}
+
+static void hold_piece(blocktris_sim_t *sim) {
+    if (sim->hold_used) {
+        return;
+    }
+    
+    piece_type_t held = sim->hold_type;
+    sim->hold_type = sim->piece.type;
+    sim->events.flags |= SIM_EVENT_HELD;
+    enter_piece(sim, held != PIECE_EMPTY ? held : piece_queue_pop(&sim->queue));
+    sim->hold_used = true;
+}
+
+static void move_piece(blocktris_sim_t *sim, int dx) {
+    blocktris_piece_t *piece = &sim->piece;
+    if (blocktris_collision_can_move_piece(&sim->board, piece->type, piece->rotation,
+                                           piece->x, piece->y, dx, 0)) {
+        blocktris_piece_move(piece, dx, 0);
+        lock_delay_on_move(&sim->lock_delay);
+    }
+}
+
+static void rotate_piece(blocktris_sim_t *sim, int direction) {
+    blocktris_piece_t *piece = &sim->piece;
+    int new_rotation = (piece->rotation + direction + 4) % 4;
+    int test_x = piece->x;
+    int test_y = piece->y;
+    
+    if (blocktris_collision_wall_kick_test(&sim->board, piece->type, piece->rotation, new_rotation,
+                                           &test_x, &test_y)) {
+        piece->rotation = (int8_t)new_rotation;
+        piece->x = (int16_t)test_x;
+        piece->y = (int16_t)test_y;
+        lock_delay_on_move(&sim->lock_delay);
+    }
+}
+
+static void insert_pending_garbage(blocktris_sim_t *sim) {
+    if (sim->garbage_pending <= 0) {
+        return;
+    }
+    
+    int hole_x = (int)((utils_next_random(&sim->garbage_rng) >> 32) % (uint64_t)sim->board.width);
+    if (game_board_add_garbage_rows(&sim->board, sim->garbage_pending, hole_x)) {
+        sim->game_over = true;
+    }
+    sim->events.flags |= SIM_EVENT_GARBAGE;
+    sim->events.garbage_rows = sim->garbage_pending;
+    sim->events.garbage_hole = hole_x;
+    sim->garbage_pending = 0;
+}
+
+/**
+ * End the game if the stack reached the top, otherwise spawn the next piece
+ */
+static void finish_lock(blocktris_sim_t *sim) {
+    if (game_board_is_game_over(&sim->board)) {
+        sim->game_over = true;
+    }
+    
+    if (sim->game_over) {
+        sim->piece.active = false;
+    } else {
+        spawn_next_piece(sim);
+    }
+}
+
+/**
+ * Lock the piece, clear lines and settle garbage, then spawn the next piece
+ * (once the lines are removed, when there is a line clear delay)
+ *
+ * @return Garbage rows to send
+ */
+static int lock_piece(blocktris_sim_t *sim) {
+    blocktris_piece_t *piece = &sim->piece;
+    game_board_place_piece(&sim->board, piece->type, piece->rotation, piece->x, piece->y);
+    sim->pieces_locked++;
+    
+    board_line_mask_t complete_lines = game_board_find_complete_lines(&sim->board);
+    sim->events.flags |= SIM_EVENT_LOCKED;
+    sim->events.locked = *piece;
+    int num_lines = game_board_count_lines(complete_lines);
+    int garbage = 0;
+    
+    if (num_lines > 0) {
+        blocktris_score_add_line_clear(sim, num_lines);
+        
+        // Cleared lines cancel incoming garbage before any is sent
+        garbage = blocktris_sim_garbage_for_lines(num_lines);
+        int cancelled = garbage < sim->garbage_pending ? garbage : sim->garbage_pending;
+        sim->garbage_pending -= cancelled;
+        garbage -= cancelled;
+        sim->garbage_sent += garbage;
+        
+        if (sim->line_clear_ticks > 0) {
+            // The lines stay up for the line clear delay, with no piece in play
+            sim->clearing = complete_lines;
+            sim->clear_start_tick = sim->tick;
+            piece->active = false;
+            return garbage;
+        }
+        game_board_clear_lines(&sim->board, complete_lines);
+        sim->events.flags |= SIM_EVENT_CLEARED;
+        sim->events.cleared = complete_lines;
+    } else {
+        insert_pending_garbage(sim);
+    }
+    
+    finish_lock(sim);
+    return garbage;
+}
+
+/**
+ * Remove the completed lines once the line clear delay is over
+ */
+static void update_line_clear(blocktris_sim_t *sim) {
+    if (sim->tick - sim->clear_start_tick < (uint32_t)sim->line_clear_ticks) {
+        return;
+    }
+    
+    game_board_clear_lines(&sim->board, sim->clearing);
+    sim->events.flags |= SIM_EVENT_CLEARED;
+    sim->events.cleared = sim->clearing;
+    sim->clearing = 0;
+    finish_lock(sim);
+}
+
+void blocktris_sim_init(blocktris_sim_t *sim, const game_config_t *config, uint64_t seed) {
+    if (!sim || !config) {
+        return;
+    }
+    
+    game_board_init(&sim->board, config->board_width, config->board_height);
+    piece_queue_init(&sim->queue, config->preview_depth, seed);
+    lock_delay_init(&sim->lock_delay, MS_TO_SIM_TICKS(config->lock_delay_ms), config->lock_reset_limit);
+    blocktris_piece_init(&sim->piece);
+    
+    sim->hold_type = PIECE_EMPTY;
+    sim->hold_used = false;
+    sim->soft_drop = false;
+    sim->line_clear_ticks = 0;
+    sim->clearing = 0;
+    sim->clear_start_tick = 0;
+    sim->tick = 0;
+    sim->pieces_locked = 0;
+    sim->score = 0;
+    sim->level = 1;
+    sim->lines_cleared = 0;
+    sim->garbage_pending = 0;
+    sim->garbage_sent = 0;
+    sim->garbage_rng = (seed ^ 0xD1B54A32D192ED03ULL) | 1;
+    sim->game_over = false;
+    sim->events.flags = 0;
+    sim->events.num_scored = 0;
+    
+    spawn_next_piece(sim);
+}
+
+void blocktris_sim_set_line_clear_delay(blocktris_sim_t *sim, int ticks) {
+    if (!sim) {
+        return;
+    }
+    
+    sim->line_clear_ticks = ticks > 0 ? ticks : 0;
+}
+
+void blocktris_sim_copy(blocktris_sim_t *dst, const blocktris_sim_t *src) {
+    if (!dst || !src || dst == src) {
+        return;
+    }
+    
+    memcpy(dst, src, offsetof(blocktris_sim_t, board));
+    game_board_copy(&dst->board, &src->board);
+}
+
+int blocktris_sim_step(blocktris_sim_t *sim, sim_input_t input) {
+    if (!sim) {
+        return 0;
+    }
+    
+    sim->events.flags = 0;
+    sim->events.num_scored = 0;
+    if (sim->game_over) {
+        return 0;
+    }
+    
+    sim->tick++;
+    blocktris_piece_t *piece = &sim->piece;
+    sim->soft_drop = (input & SIM_INPUT_SOFT_DROP) != 0;
+    
+    if (sim->clearing != 0) {
+        update_line_clear(sim);
+        return 0;
+    }
+    
+    // Actions, in a fixed order so the same inputs always give the same result
+    if (input & SIM_INPUT_HOLD) {
+        hold_piece(sim);
+        if (sim->game_over) {
+            return 0;
+        }
+    }
+    if (input & SIM_INPUT_LEFT) {
+        move_piece(sim, -1);
+    }
+    if (input & SIM_INPUT_RIGHT) {
+        move_piece(sim, 1);
+    }
+    if (input & SIM_INPUT_ROTATE_CW) {
+        rotate_piece(sim, 1);
+    }
+    if (input & SIM_INPUT_ROTATE_CCW) {
+        rotate_piece(sim, -1);
+    }
+    if (input & SIM_INPUT_HARD_DROP) {
+        int drop_y = blocktris_collision_find_drop_position(&sim->board, piece->type, piece->rotation,
+                                                            piece->x, piece->y);
+        blocktris_score_add_hard_drop(sim, drop_y - piece->y);
+        piece->y = (int16_t)drop_y;
+        return lock_piece(sim);
+    }
+    
+    bool grounded = !blocktris_collision_can_fall(&sim->board, piece->type, piece->rotation,
+                                                  piece->x, piece->y);
+    
+    // Gravity, then the lock delay once the piece has landed
+    if (grounded) {
+        sim->fall_ticks = 0;
+    } else if (++sim->fall_ticks >= blocktris_sim_fall_interval(sim)) {
+        blocktris_piece_move(piece, 0, 1);
+        sim->fall_ticks = 0;
+        if (sim->soft_drop) {
+            blocktris_score_add_soft_drop(sim, 1);
+        }
+        grounded = !blocktris_collision_can_fall(&sim->board, piece->type, piece->rotation,
+                                                 piece->x, piece->y);
+    }
+    
+    if (lock_delay_step(&sim->lock_delay, grounded, piece->y)) {
+        return lock_piece(sim);
+    }
+    
+    return 0;
+}
+
+int blocktris_sim_fall_interval(const blocktris_sim_t *sim) {
+    if (!sim) {
+        return 1;
+    }
+    
+    // Soft drop divides the fall interval, down to one row per tick
+    int interval = MS_TO_SIM_TICKS(sim->fall_speed);
+    if (sim->soft_drop) {
+        interval /= SOFT_DROP_GRAVITY_MULTIPLIER;
+    }
+    return interval < 1 ? 1 : interval;
+}
+
+void blocktris_sim_receive_garbage(blocktris_sim_t *sim, int rows) {
+    if (!sim || rows <= 0) {
+        return;
+    }
+    
+    sim->garbage_pending += rows;
+}
+
+int blocktris_sim_garbage_for_lines(int lines_cleared) {
+    if (lines_cleared < 1) {
+        return 0;
+    }
+    
+    if (lines_cleared > MAX_GARBAGE_TABLE_LINES) {
+        return lines_cleared;
+    }
+    
+    return GARBAGE_ROWS_SENT[lines_cleared];
+}
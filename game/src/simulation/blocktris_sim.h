@@ -0,0 +1,167 @@
+/**
+ * @file blocktris_sim.h
+ * @brief Self-contained player simulation stepped one tick at a time
+ *
+ * Holds one player's whole game as plain data (board, falling piece, preview
+ * queue, hold slot, lock delay, score and pending garbage) with no pointers
+ * into the game or SDL objects, so it can be copied, run on any thread and
+ * stepped side by side with another player. Each step advances one
+ * simulation tick from a set of input flags; the same seed and inputs always
+ * give the same game.
+ *
+ * These are the rules of every mode: the single-player game steps one of
+ * these too, with a line clear delay so completed lines can be shown
+ * flashing before they go.
+ */
+
+#ifndef BLOCKTRIS_SIM_H_
+#define BLOCKTRIS_SIM_H_
+
+#include "game_board.h"
+#include "blocktris_piece.h"
+#include "piece_queue.h"
+#include "lock_delay.h"
+#include "game_config.h"
+#include "score_log.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Input flags for one tick; actions are applied once per tick they are set in
+#define SIM_INPUT_LEFT 0x01
+#define SIM_INPUT_RIGHT 0x02
+#define SIM_INPUT_ROTATE_CW 0x04
+#define SIM_INPUT_ROTATE_CCW 0x08
+#define SIM_INPUT_HARD_DROP 0x10
+#define SIM_INPUT_HOLD 0x20
+#define SIM_INPUT_SOFT_DROP 0x40 // Held: speeds up gravity while set
+
+// Inputs that describe a held key rather than a single action
+#define SIM_INPUT_HELD_MASK SIM_INPUT_SOFT_DROP
+
+typedef uint8_t sim_input_t;
+
+// What a step did to the board, for observers such as the spectator stream
+#define SIM_EVENT_HELD 0x01    // The piece went to the hold slot and another entered
+#define SIM_EVENT_LOCKED 0x02  // A piece was placed on the board (and the next one entered, unless the game is
+                               // over or completed lines wait out the line clear delay)
+#define SIM_EVENT_GARBAGE 0x04 // Garbage rows were inserted under the stack
+#define SIM_EVENT_CLEARED 0x08 // Completed lines were removed (and the next one entered unless game over)
+
+// Most points awards one step can make (a drop, then the lines it clears)
+#define SIM_MAX_SCORE_EVENTS 2
+
+/**
+ * Board changes made by the last step, in the order they happened
+ */
+typedef struct {
+    uint8_t flags;             // SIM_EVENT_* bits
+    blocktris_piece_t locked;  // Piece placed on the board (SIM_EVENT_LOCKED)
+    board_line_mask_t cleared; // Lines removed (SIM_EVENT_CLEARED), at the lock or after the line clear delay
+    int garbage_rows;          // SIM_EVENT_GARBAGE
+    int garbage_hole;          // Open column of the garbage rows
+    score_event_t scored[SIM_MAX_SCORE_EVENTS]; // Points awarded, for the owner's score log
+    int num_scored;
+} sim_events_t;
+
+/**
+ * Player simulation state
+ */
+typedef struct {
+    piece_queue_t queue;
+    lock_delay_t lock_delay;
+    blocktris_piece_t piece;  // Falling piece (inactive once the game is over)
+    piece_type_t hold_type;   // PIECE_EMPTY while the hold slot is empty
+    bool hold_used;           // Hold already used by the current piece
+    uint32_t tick;            // Ticks stepped since init
+    uint32_t pieces_locked;   // Pieces locked since init
+    int fall_ticks;           // Ticks since the piece last fell
+    int fall_speed;           // Fall interval in milliseconds for the current level
+    bool soft_drop;           // Soft drop held on the last step
+    int line_clear_ticks;     // Ticks completed lines stay on the board (0 removes them on lock)
+    board_line_mask_t clearing; // Completed lines waiting out the line clear delay (0 if none)
+    uint32_t clear_start_tick;  // Tick the lines in clearing were completed on
+    int score;
+    int level;
+    int lines_cleared;
+    int garbage_pending;      // Garbage rows received, inserted when the next piece locks
+    int garbage_sent;         // Garbage rows sent over the whole game
+    uint64_t garbage_rng;     // Picks the hole column of incoming garbage
+    bool game_over;
+    sim_events_t events;      // What the last step did
+    game_board_t board;       // Last, so blocktris_sim_copy takes the fields before it as one block
+} blocktris_sim_t;
+
+typedef blocktris_sim_t *blocktris_sim_ptr;
+
+/**
+ * Initialize a simulation and spawn its first piece
+ *
+ * @param sim Pointer to the simulation to initialize
+ * @param config Board size, preview depth and lock delay settings
+ * @param seed Seed of the piece sequence and garbage holes
+ */
+void blocktris_sim_init(blocktris_sim_t *sim, const game_config_t *config, uint64_t seed);
+
+/**
+ * Keep completed lines on the board for a while before removing them
+ *
+ * No piece is in play meanwhile; the next one enters once the lines are
+ * gone. Versus games leave this at 0 and remove lines as soon as they
+ * complete.
+ *
+ * @param sim Pointer to the simulation
+ * @param ticks Ticks to keep the lines for
+ */
+void blocktris_sim_set_line_clear_delay(blocktris_sim_t *sim, int ticks);
+
+/**
+ * Copy a simulation, touching only the board rows and cells in use
+ *
+ * Much cheaper than a struct copy for boards smaller than the largest
+ * supported one, which matters when states are saved every tick.
+ *
+ * @param dst Pointer to the destination simulation
+ * @param src Pointer to the source simulation
+ */
+void blocktris_sim_copy(blocktris_sim_t *dst, const blocktris_sim_t *src);
+
+/**
+ * Advance the simulation by one tick
+ *
+ * Applies the tick's inputs, then gravity and the lock delay. When the piece
+ * locks, cleared lines first cancel pending garbage and the rest is returned
+ * to be sent; a lock that clears nothing inserts the pending garbage. Points
+ * are awarded through the scoring module and listed in the step's events.
+ * Inputs are ignored while completed lines wait out the line clear delay.
+ *
+ * @param sim Pointer to the simulation
+ * @param input SIM_INPUT_* flags for this tick
+ * @return Garbage rows to send to the opponent (0 if none)
+ */
+int blocktris_sim_step(blocktris_sim_t *sim, sim_input_t input);
+
+/**
+ * Get the number of ticks between gravity steps of the falling piece
+ *
+ * @param sim Pointer to the simulation
+ * @return Fall interval for the current level, shortened while soft drop is held
+ */
+int blocktris_sim_fall_interval(const blocktris_sim_t *sim);
+
+/**
+ * Queue garbage rows, inserted under the stack when the next piece locks
+ *
+ * @param sim Pointer to the simulation
+ * @param rows Number of garbage rows
+ */
+void blocktris_sim_receive_garbage(blocktris_sim_t *sim, int rows);
+
+/**
+ * Get the number of garbage rows sent for a line clear
+ *
+ * @param lines_cleared Lines cleared by one piece
+ * @return Garbage rows sent before cancelling pending garbage
+ */
+int blocktris_sim_garbage_for_lines(int lines_cleared);
+
+#endif // BLOCKTRIS_SIM_H_
@@ -0,0 +1,81 @@
+/**
+ * @file garbage_queue.c
+ * @brief Lock-free garbage queue implementation
+ */
+
+#include "garbage_queue.h"
+#include <stddef.h>
+
+// The project builds with GCC (or Clang), whose atomic builtins give us
+// acquire/release ordering without C11 <stdatomic.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define QUEUE_LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define QUEUE_STORE_RELEASE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#else
+#error "garbage_queue.c requires GCC or Clang atomic builtins"
+#endif
+
+#define QUEUE_INDEX_MASK (GARBAGE_QUEUE_CAPACITY - 1)
+
+void garbage_queue_init(garbage_queue_t *queue) {
+    if (!queue) {
+        return;
+    }
+    
+    queue->head = 0;
+    queue->tail = 0;
+}
+
+bool garbage_queue_push(garbage_queue_t *queue, const garbage_message_t *message) {
+    if (!queue || !message) {
+        return false;
+    }
+    
+    // The producer owns tail; head is read to see how much room is left
+    uint32_t tail = queue->tail;
+    uint32_t head = QUEUE_LOAD_ACQUIRE(&queue->head);
+    if (tail - head >= GARBAGE_QUEUE_CAPACITY) {
+        return false;
+    }
+    
+    // Write the slot before publishing it
+    queue->messages[tail & QUEUE_INDEX_MASK] = *message;
+    QUEUE_STORE_RELEASE(&queue->tail, tail + 1);
+    
+    return true;
+}
+
+bool garbage_queue_peek(garbage_queue_t *queue, garbage_message_t *message) {
+    if (!queue || !message) {
+        return false;
+    }
+    
+    // The consumer owns head; tail is read to see what has been published
+    uint32_t head = queue->head;
+    if (head == QUEUE_LOAD_ACQUIRE(&queue->tail)) {
+        return false;
+    }
+    
+    *message = queue->messages[head & QUEUE_INDEX_MASK];
+    return true;
+}
+
+bool garbage_queue_pop(garbage_queue_t *queue, garbage_message_t *message) {
+    if (!queue) {
+        return false;
+    }
+    
+    uint32_t head = queue->head;
+    if (head == QUEUE_LOAD_ACQUIRE(&queue->tail)) {
+        return false;
+    }
+    
+    if (message) {
+        *message = queue->messages[head & QUEUE_INDEX_MASK];
+    }
+    
+    // Hand the slot back to the producer after reading it
+    QUEUE_STORE_RELEASE(&queue->head, head + 1);
+    
+    return true;
+}
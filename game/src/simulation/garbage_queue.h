@@ -0,0 +1,79 @@
+/**
+ * @file garbage_queue.h
+ * @brief Lock-free single-producer/single-consumer queue of garbage attacks
+ *
+ * Carries the garbage one player sends to the other in versus mode. The
+ * sending simulation pushes and the receiving simulation pops, each from its
+ * own thread, without locks: the producer only writes `tail`, the consumer
+ * only writes `head`, and each publishes its index with a release store that
+ * the other side reads with an acquire load.
+ */
+
+#ifndef GARBAGE_QUEUE_H_
+#define GARBAGE_QUEUE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Queue slots (power of two)
+#define GARBAGE_QUEUE_CAPACITY 32
+
+// Keeps the producer and consumer indices on separate cache lines
+#define GARBAGE_QUEUE_CACHE_LINE 64
+
+/**
+ * Garbage sent by one line clear
+ */
+typedef struct {
+    uint32_t apply_tick; // Receiver tick from which the garbage is pending
+    uint8_t rows;        // Number of garbage rows
+} garbage_message_t;
+
+/**
+ * Garbage queue structure
+ */
+typedef struct {
+    garbage_message_t messages[GARBAGE_QUEUE_CAPACITY];
+    uint32_t head; // Next message to read, written by the consumer only
+    char head_padding[GARBAGE_QUEUE_CACHE_LINE - sizeof(uint32_t)];
+    uint32_t tail; // Next slot to write, written by the producer only
+    char tail_padding[GARBAGE_QUEUE_CACHE_LINE - sizeof(uint32_t)];
+} garbage_queue_t;
+
+typedef garbage_queue_t *garbage_queue_ptr;
+
+/**
+ * Initialize an empty queue (not thread-safe, call before both sides start)
+ *
+ * @param queue Pointer to the queue to initialize
+ */
+void garbage_queue_init(garbage_queue_t *queue);
+
+/**
+ * Append a message (producer side)
+ *
+ * @param queue Pointer to the queue
+ * @param message Message to append
+ * @return true if the message was queued, false if the queue is full
+ */
+bool garbage_queue_push(garbage_queue_t *queue, const garbage_message_t *message);
+
+/**
+ * Look at the oldest message without removing it (consumer side)
+ *
+ * @param queue Pointer to the queue
+ * @param message Receives the oldest message
+ * @return true if a message was available, false if the queue is empty
+ */
+bool garbage_queue_peek(garbage_queue_t *queue, garbage_message_t *message);
+
+/**
+ * Remove the oldest message (consumer side)
+ *
+ * @param queue Pointer to the queue
+ * @param message Receives the removed message (may be NULL)
+ * @return true if a message was removed, false if the queue is empty
+ */
+bool garbage_queue_pop(garbage_queue_t *queue, garbage_message_t *message);
+
+#endif // GARBAGE_QUEUE_H_
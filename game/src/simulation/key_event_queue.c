@@ -0,0 +1,76 @@
+/**
+ * @file key_event_queue.c
+ * @brief Lock-free key event queue implementation
+ */
+
+#include "key_event_queue.h"
+#include <stddef.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define QUEUE_LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define QUEUE_STORE_RELEASE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#else
+#error "key_event_queue.c requires GCC or Clang atomic builtins"
+#endif
+
+#define KEY_EVENT_QUEUE_MASK (KEY_EVENT_QUEUE_SIZE - 1)
+
+void key_event_queue_init(key_event_queue_t *queue) {
+    if (!queue) {
+        return;
+    }
+    
+    queue->head = 0;
+    queue->tail = 0;
+}
+
+bool key_event_queue_push(key_event_queue_t *queue, int scancode, bool down) {
+    if (!queue || scancode < 0 || scancode > UINT16_MAX) {
+        return false;
+    }
+    
+    unsigned int head = queue->head;
+    if (head - QUEUE_LOAD_ACQUIRE(&queue->tail) >= KEY_EVENT_QUEUE_SIZE) {
+        return false;
+    }
+    
+    key_event_t *event = &queue->events[head & KEY_EVENT_QUEUE_MASK];
+    event->scancode = (uint16_t)scancode;
+    event->down = down ? 1 : 0;
+    QUEUE_STORE_RELEASE(&queue->head, head + 1);
+    return true;
+}
+
+int key_event_queue_apply_tick(key_event_queue_t *queue, uint8_t *keys, int key_count) {
+    if (!queue || !keys) {
+        return 0;
+    }
+    
+    unsigned int tail = queue->tail;
+    unsigned int head = QUEUE_LOAD_ACQUIRE(&queue->head);
+    uint16_t changed[KEY_EVENT_TICK_KEYS];
+    int num_changed = 0;
+    int taken = 0;
+    
+    while (tail != head) {
+        const key_event_t *event = &queue->events[tail & KEY_EVENT_QUEUE_MASK];
+        if (event->scancode < key_count && (keys[event->scancode] != 0) != (event->down != 0)) {
+            // A key changes at most once a tick; its next transition waits for the next one
+            bool seen = false;
+            for (int i = 0; i < num_changed && !seen; i++) {
+                seen = changed[i] == event->scancode;
+            }
+            if (seen || num_changed == KEY_EVENT_TICK_KEYS) {
+                break;
+            }
+            
+            changed[num_changed++] = event->scancode;
+            keys[event->scancode] = event->down;
+        }
+        tail++;
+        taken++;
+    }
+    
+    QUEUE_STORE_RELEASE(&queue->tail, tail);
+    return taken;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file key_event_queue.h
+ * @brief Lock-free queue of key presses and releases between one writer and
+ * one reader thread
+ *
+ * The writer pushes every key transition as it happens; the reader replays
+ * them into a key state array of its own one tick at a time. A tick takes at
+ * most one transition of each key, so a press and release that came in
+ * together are still seen as a press for one tick and a release the next.
+ */
+
+#ifndef KEY_EVENT_QUEUE_H_
+#define KEY_EVENT_QUEUE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Transitions the queue holds before pushes are dropped (a power of two)
+#define KEY_EVENT_QUEUE_SIZE 256
+
+// Keys that can change in a single tick, beyond which the rest wait for the next
+#define KEY_EVENT_TICK_KEYS 16
+
+/**
+ * Key press or release
+ */
+typedef struct {
+    uint16_t scancode;
+    uint8_t down; // 1 for a press, 0 for a release
+} key_event_t;
+
+/**
+ * Ring of key transitions
+ */
+typedef struct {
+    key_event_t events[KEY_EVENT_QUEUE_SIZE];
+    unsigned int head; // Transitions pushed so far (written by the writer thread)
+    unsigned int tail; // Transitions replayed so far (written by the reader thread)
+} key_event_queue_t;
+
+typedef key_event_queue_t *key_event_queue_ptr;
+
+/**
+ * Initialize the queue, empty; neither thread may use it meanwhile
+ *
+ * @param queue Pointer to the queue to initialize
+ */
+void key_event_queue_init(key_event_queue_t *queue);
+
+/**
+ * Queue a key transition (writer thread)
+ *
+ * @param queue Pointer to the queue
+ * @param scancode Key that changed
+ * @param down true if it was pressed, false if released
+ * @return false if the queue is full and the transition was dropped
+ */
+bool key_event_queue_push(key_event_queue_t *queue, int scancode, bool down);
+
+/**
+ * Replay the queued transitions that belong to the next tick into a key
+ * state array (reader thread); transitions to keys outside the array are skipped
+ *
+ * @param queue Pointer to the queue
+ * @param keys Key states, nonzero while a key is down
+ * @param key_count Number of keys in the array
+ * @return Number of transitions taken from the queue
+ */
+int key_event_queue_apply_tick(key_event_queue_t *queue, uint8_t *keys, int key_count);
+
+#endif // KEY_EVENT_QUEUE_H_
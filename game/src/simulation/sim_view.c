@@ -0,0 +1,81 @@
+/**
+ * @file sim_view.c
+ * @brief Double-buffered render view implementation
+ */
+
+#include "sim_view.h"
+#include "blocktris_collision.h"
+#include <stddef.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VIEW_LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define VIEW_STORE_RELEASE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#else
+#error "sim_view.c requires GCC or Clang atomic builtins"
+#endif
+
+void sim_view_buffer_init(sim_view_buffer_t *buffer) {
+    if (!buffer) {
+        return;
+    }
+    
+    board_snapshot_store_init(&buffer->store);
+    buffer->views[0].board = NULL;
+    buffer->views[1].board = NULL;
+    buffer->front = 0;
+}
+
+void sim_view_buffer_cleanup(sim_view_buffer_t *buffer) {
+    if (!buffer) {
+        return;
+    }
+    
+    for (int i = 0; i < 2; i++) {
+        board_snapshot_release(&buffer->store, buffer->views[i].board);
+        buffer->views[i].board = NULL;
+    }
+    
+    board_snapshot_store_cleanup(&buffer->store);
+}
+
+void sim_view_buffer_publish(sim_view_buffer_t *buffer, blocktris_sim_t *sim) {
+    if (!buffer || !sim) {
+        return;
+    }
+    
+    int front = buffer->front; // Only this thread writes it
+    sim_view_t *back = &buffer->views[1 - front];
+    
+    // The new board shares every row that didn't change with the front view
+    board_snapshot_t *board = board_snapshot_take(&buffer->store, &sim->board, buffer->views[front].board);
+    if (!board) {
+        return; // Keep showing the front view
+    }
+    board_snapshot_release(&buffer->store, back->board);
+    back->board = board;
+    
+    const blocktris_piece_t *piece = &sim->piece;
+    back->piece = *piece;
+    back->ghost_y = piece->active ?
+        blocktris_collision_find_drop_position(&sim->board, piece->type, piece->rotation, piece->x, piece->y) :
+        piece->y;
+    back->next_type = piece_queue_peek(&sim->queue, 0);
+    back->hold_type = sim->hold_type;
+    back->score = sim->score;
+    back->lines_cleared = sim->lines_cleared;
+    back->garbage_pending = sim->garbage_pending;
+    back->tick = sim->tick;
+    back->game_over = sim->game_over;
+    
+    // Publish the finished view
+    VIEW_STORE_RELEASE(&buffer->front, 1 - front);
+}
+
+const sim_view_t *sim_view_buffer_front(const sim_view_buffer_t *buffer) {
+    if (!buffer) {
+        return NULL;
+    }
+    
+    const sim_view_t *view = &buffer->views[VIEW_LOAD_ACQUIRE(&buffer->front)];
+    return view->board ? view : NULL;
+}
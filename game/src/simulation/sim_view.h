@@ -0,0 +1,78 @@
+/**
+ * @file sim_view.h
+ * @brief Double-buffered render views of a simulation
+ *
+ * The simulation thread publishes what the renderer needs (a copy-on-write
+ * board snapshot plus the piece, queue and score) into the back view and
+ * flips it to the front; the render thread only ever reads the front view.
+ * Publishing is wait-free for both sides provided the simulation publishes
+ * at most once per rendered frame, so the view being written is never the
+ * one still being drawn.
+ */
+
+#ifndef SIM_VIEW_H_
+#define SIM_VIEW_H_
+
+#include "blocktris_sim.h"
+#include "board_snapshot.h"
+
+/**
+ * What the renderer sees of a simulation
+ */
+typedef struct {
+    board_snapshot_t *board; // NULL until the first publish
+    blocktris_piece_t piece;
+    int ghost_y;             // Row the piece would land on
+    piece_type_t next_type;
+    piece_type_t hold_type;
+    int score;
+    int lines_cleared;
+    int garbage_pending;
+    uint32_t tick;
+    bool game_over;
+} sim_view_t;
+
+/**
+ * Front and back views of one simulation
+ */
+typedef struct {
+    sim_view_t views[2];
+    board_snapshot_store_t store; // Used by the publishing thread only
+    int front;                    // Index of the published view
+} sim_view_buffer_t;
+
+typedef sim_view_buffer_t *sim_view_buffer_ptr;
+
+/**
+ * Initialize an empty view buffer
+ *
+ * @param buffer Pointer to the buffer to initialize
+ */
+void sim_view_buffer_init(sim_view_buffer_t *buffer);
+
+/**
+ * Release the snapshots and free the snapshot store
+ *
+ * @param buffer Pointer to the buffer
+ */
+void sim_view_buffer_cleanup(sim_view_buffer_t *buffer);
+
+/**
+ * Publish the current state of a simulation (simulation thread)
+ *
+ * Only the board rows changed since the previous publish are copied.
+ *
+ * @param buffer Pointer to the buffer
+ * @param sim Pointer to the simulation (its dirty rows are cleared)
+ */
+void sim_view_buffer_publish(sim_view_buffer_t *buffer, blocktris_sim_t *sim);
+
+/**
+ * Get the most recently published view (render thread)
+ *
+ * @param buffer Pointer to the buffer
+ * @return Front view, or NULL if nothing was published yet
+ */
+const sim_view_t *sim_view_buffer_front(const sim_view_buffer_t *buffer);
+
+#endif // SIM_VIEW_H_
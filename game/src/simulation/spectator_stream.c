@@ -0,0 +1,393 @@
+/**
+ * @file spectator_stream.c
+ * @brief Spectator stream implementation
+ */
+
+#include "spectator_stream.h"
+#include "constants.h"
+#include "utils.h"
+#include <string.h>
+
+typedef enum {
+    SPECTATOR_MSG_KEYFRAME = 0x01,
+    SPECTATOR_MSG_SPAWN = 0x02,
+    SPECTATOR_MSG_HOLD = 0x03,
+    SPECTATOR_MSG_PLACE = 0x04,
+    SPECTATOR_MSG_CLEAR = 0x05,
+    SPECTATOR_MSG_GARBAGE = 0x06,
+    SPECTATOR_MSG_SCORE = 0x07,
+    SPECTATOR_MSG_GAME_OVER = 0x08
+} spectator_msg_t;
+
+// Message sizes, type byte included
+#define KEYFRAME_HEADER_SIZE 20 // type, width, height, piece, hold, flags, score (4), lines (4), level, pieces (4)
+#define SPAWN_SIZE 2            // type, piece
+#define HOLD_SIZE 1
+#define PLACE_SIZE 5            // type, piece, rotation, x, y
+#define CLEAR_SIZE 3            // type, first row, row mask
+#define GARBAGE_SIZE 3          // type, rows, open column
+#define SCORE_SIZE 10           // type, score (4), lines (4), level
+#define GAME_OVER_SIZE 1
+
+#define KEYFRAME_FLAG_GAME_OVER 0x01
+
+// Rows a CLEAR mask can cover
+#define CLEAR_MASK_ROWS 8
+
+static int lowest_row(board_line_mask_t lines) {
+    int y = 0;
+    while (!(lines & 1)) {
+        lines >>= 1;
+        y++;
+    }
+    return y;
+}
+
+static uint8_t *reserve(spectator_stream_t *stream, size_t size) {
+    uint8_t *out = stream->data + stream->size;
+    stream->size += size;
+    stream->bytes_written += size;
+    return out;
+}
+
+static void write_spawn(spectator_stream_t *stream, piece_type_t type) {
+    uint8_t *out = reserve(stream, SPAWN_SIZE);
+    out[0] = SPECTATOR_MSG_SPAWN;
+    out[1] = (uint8_t)type;
+}
+
+/**
+ * Replace the stream with a keyframe of the game
+ */
+static void write_keyframe(spectator_stream_t *stream, const blocktris_sim_t *sim) {
+    const game_board_t *board = &sim->board;
+    int row_bytes = (board->width + 7) / 8;
+    
+    stream->size = 0;
+    stream->latest_start = 0;
+    stream->keyframe_pieces = sim->pieces_locked;
+    
+    uint8_t *out = reserve(stream, KEYFRAME_HEADER_SIZE);
+    out[0] = SPECTATOR_MSG_KEYFRAME;
+    out[1] = (uint8_t)board->width;
+    out[2] = (uint8_t)board->height;
+    out[3] = (uint8_t)(sim->piece.active ? sim->piece.type : PIECE_EMPTY);
+    out[4] = (uint8_t)sim->hold_type;
+    out[5] = sim->game_over ? KEYFRAME_FLAG_GAME_OVER : 0;
+    utils_write_u32_be(out + 6, (uint32_t)sim->score);
+    utils_write_u32_be(out + 10, (uint32_t)sim->lines_cleared);
+    out[14] = (uint8_t)sim->level;
+    utils_write_u32_be(out + 15, sim->pieces_locked);
+    
+    out = reserve(stream, (size_t)(row_bytes * board->height));
+    for (int y = 0; y < board->height; y++) {
+        board_row_t row = board->rows[y];
+        for (int i = 0; i < row_bytes; i++) {
+            *out++ = (uint8_t)(row >> (8 * i));
+        }
+    }
+    
+    for (int y = 0; y < board->height; y++) {
+        for (int x = 0; x < board->width; x++) {
+            if (board->rows[y] & ((board_row_t)1 << x)) {
+                *reserve(stream, 1) = game_board_get_cell(board, x, y);
+            }
+        }
+    }
+    
+    stream->game_over_sent = sim->game_over;
+}
+
+void spectator_stream_init(spectator_stream_t *stream, int keyframe_interval) {
+    if (!stream) {
+        return;
+    }
+    
+    if (keyframe_interval < 1) {
+        keyframe_interval = 1;
+    } else if (keyframe_interval > MAX_SPECTATOR_KEYFRAME_INTERVAL) {
+        keyframe_interval = MAX_SPECTATOR_KEYFRAME_INTERVAL;
+    }
+    
+    stream->size = 0;
+    stream->latest_start = 0;
+    stream->keyframe_interval = keyframe_interval;
+    stream->keyframe_pieces = 0;
+    stream->game_over_sent = false;
+    stream->bytes_written = 0;
+}
+
+void spectator_stream_start(spectator_stream_t *stream, const blocktris_sim_t *sim) {
+    if (!stream || !sim) {
+        return;
+    }
+    
+    write_keyframe(stream, sim);
+}
+
+void spectator_stream_record(spectator_stream_t *stream, const blocktris_sim_t *sim) {
+    if (!stream || !sim) {
+        return;
+    }
+    
+    const sim_events_t *events = &sim->events;
+    stream->latest_start = stream->size;
+    
+    // A clear wider than a mask can't come from one piece; resync rather than lose it
+    bool locked = (events->flags & SIM_EVENT_LOCKED) != 0;
+    bool cleared = (events->flags & SIM_EVENT_CLEARED) != 0;
+    if (cleared && (events->cleared >> lowest_row(events->cleared)) >> CLEAR_MASK_ROWS != 0) {
+        write_keyframe(stream, sim);
+        return;
+    }
+    
+    if (events->flags & SIM_EVENT_HELD) {
+        *reserve(stream, HOLD_SIZE) = SPECTATOR_MSG_HOLD;
+        // The piece that entered from the hold slot may have locked in the same step
+        write_spawn(stream, locked ? events->locked.type : sim->piece.type);
+    }
+    
+    // With a line clear delay the lines go, and the next piece enters, steps after the placement
+    uint8_t *out;
+    if (locked) {
+        const blocktris_piece_t *piece = &events->locked;
+        out = reserve(stream, PLACE_SIZE);
+        out[0] = SPECTATOR_MSG_PLACE;
+        out[1] = (uint8_t)piece->type;
+        out[2] = (uint8_t)piece->rotation;
+        out[3] = (uint8_t)(int8_t)piece->x;
+        out[4] = (uint8_t)(int8_t)piece->y;
+    }
+    if (cleared) {
+        int first = lowest_row(events->cleared);
+        out = reserve(stream, CLEAR_SIZE);
+        out[0] = SPECTATOR_MSG_CLEAR;
+        out[1] = (uint8_t)first;
+        out[2] = (uint8_t)(events->cleared >> first);
+    }
+    if (events->flags & SIM_EVENT_GARBAGE) {
+        out = reserve(stream, GARBAGE_SIZE);
+        out[0] = SPECTATOR_MSG_GARBAGE;
+        out[1] = (uint8_t)events->garbage_rows;
+        out[2] = (uint8_t)events->garbage_hole;
+    }
+    if ((locked || cleared) && sim->piece.active) {
+        write_spawn(stream, sim->piece.type);
+    }
+    if (locked) {
+        out = reserve(stream, SCORE_SIZE);
+        out[0] = SPECTATOR_MSG_SCORE;
+        utils_write_u32_be(out + 1, (uint32_t)sim->score);
+        utils_write_u32_be(out + 5, (uint32_t)sim->lines_cleared);
+        out[9] = (uint8_t)sim->level;
+    }
+    
+    if (sim->game_over && !stream->game_over_sent) {
+        *reserve(stream, GAME_OVER_SIZE) = SPECTATOR_MSG_GAME_OVER;
+        stream->game_over_sent = true;
+    }
+    
+    // A keyframe replaces everything before it, so followers can apply it in place of this step
+    if (!sim->game_over &&
+        (sim->pieces_locked - stream->keyframe_pieces >= (uint32_t)stream->keyframe_interval ||
+         stream->size + SPECTATOR_STEP_MAX_SIZE > SPECTATOR_STREAM_CAPACITY)) {
+        write_keyframe(stream, sim);
+    }
+}
+
+const uint8_t *spectator_stream_latest(const spectator_stream_t *stream, size_t *size) {
+    if (!stream || !size) {
+        return NULL;
+    }
+    
+    *size = stream->size - stream->latest_start;
+    return stream->data + stream->latest_start;
+}
+
+const uint8_t *spectator_stream_catch_up(const spectator_stream_t *stream, size_t *size) {
+    if (!stream || !size) {
+        return NULL;
+    }
+    
+    *size = stream->size;
+    return stream->data;
+}
+
+void spectator_replica_init(spectator_replica_t *replica) {
+    if (!replica) {
+        return;
+    }
+    
+    memset(replica, 0, sizeof(*replica));
+    replica->sim.hold_type = PIECE_EMPTY;
+    replica->synced = false;
+}
+
+static piece_type_t read_piece_type(uint8_t value) {
+    return value < NUM_PIECE_TYPES ? (piece_type_t)value : PIECE_EMPTY;
+}
+
+static void enter_piece(blocktris_sim_t *sim, piece_type_t type) {
+    blocktris_piece_reset(&sim->piece, type, sim->board.width / 2 - 2, 0);
+    sim->piece.active = type != PIECE_EMPTY && !sim->game_over;
+}
+
+/**
+ * Apply a keyframe
+ *
+ * @return Bytes read, 0 if malformed
+ */
+static size_t apply_keyframe(blocktris_sim_t *sim, const uint8_t *data, size_t size) {
+    if (size < KEYFRAME_HEADER_SIZE) {
+        return 0;
+    }
+    
+    int width = data[1];
+    int height = data[2];
+    game_board_init(&sim->board, width, height);
+    if (sim->board.width != width || sim->board.height != height) {
+        return 0;
+    }
+    
+    int row_bytes = (width + 7) / 8;
+    size_t offset = KEYFRAME_HEADER_SIZE;
+    if (size - offset < (size_t)(row_bytes * height)) {
+        return 0;
+    }
+    
+    // Cells follow the occupancy, filled squares only, in row order
+    size_t cell = offset + (size_t)(row_bytes * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (!(data[offset + (size_t)(y * row_bytes + x / 8)] & (1 << (x % 8)))) {
+                continue;
+            }
+            if (cell >= size) {
+                return 0;
+            }
+            board_cell_t value = data[cell++];
+            game_board_set_cell(&sim->board, x, y, BOARD_CELL_TYPE(value), value);
+        }
+    }
+    
+    sim->game_over = (data[5] & KEYFRAME_FLAG_GAME_OVER) != 0;
+    sim->hold_type = read_piece_type(data[4]);
+    sim->score = (int)utils_read_u32_be(data + 6);
+    sim->lines_cleared = (int)utils_read_u32_be(data + 10);
+    sim->level = data[14];
+    sim->pieces_locked = utils_read_u32_be(data + 15);
+    enter_piece(sim, read_piece_type(data[3]));
+    
+    return cell;
+}
+
+/**
+ * Size of a delta message from its type byte, 0 if unknown
+ */
+static size_t delta_size(uint8_t type) {
+    switch (type) {
+        case SPECTATOR_MSG_SPAWN:
+            return SPAWN_SIZE;
+        case SPECTATOR_MSG_HOLD:
+            return HOLD_SIZE;
+        case SPECTATOR_MSG_PLACE:
+            return PLACE_SIZE;
+        case SPECTATOR_MSG_CLEAR:
+            return CLEAR_SIZE;
+        case SPECTATOR_MSG_GARBAGE:
+            return GARBAGE_SIZE;
+        case SPECTATOR_MSG_SCORE:
+            return SCORE_SIZE;
+        case SPECTATOR_MSG_GAME_OVER:
+            return GAME_OVER_SIZE;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Apply one delta message of delta_size bytes
+ *
+ * @return false if malformed
+ */
+static bool apply_delta(blocktris_sim_t *sim, const uint8_t *data) {
+    switch (data[0]) {
+        case SPECTATOR_MSG_SPAWN:
+            enter_piece(sim, read_piece_type(data[1]));
+            return true;
+        
+        case SPECTATOR_MSG_HOLD:
+            sim->hold_type = sim->piece.type;
+            return true;
+        
+        case SPECTATOR_MSG_PLACE:
+            if (data[1] >= NUM_PIECE_TYPES || data[2] > 3) {
+                return false;
+            }
+            game_board_place_piece(&sim->board, (piece_type_t)data[1], data[2], (int8_t)data[3], (int8_t)data[4]);
+            sim->pieces_locked++;
+            sim->piece.active = false;
+            return true;
+        
+        case SPECTATOR_MSG_CLEAR:
+            if (data[1] >= sim->board.height) {
+                return false;
+            }
+            game_board_clear_lines(&sim->board, (board_line_mask_t)data[2] << data[1]);
+            return true;
+        
+        case SPECTATOR_MSG_GARBAGE:
+            if (game_board_add_garbage_rows(&sim->board, data[1], data[2])) {
+                sim->game_over = true;
+            }
+            return true;
+        
+        case SPECTATOR_MSG_SCORE:
+            sim->score = (int)utils_read_u32_be(data + 1);
+            sim->lines_cleared = (int)utils_read_u32_be(data + 5);
+            sim->level = data[9];
+            return true;
+        
+        case SPECTATOR_MSG_GAME_OVER:
+            sim->game_over = true;
+            sim->piece.active = false;
+            return true;
+        
+        default:
+            return false;
+    }
+}
+
+bool spectator_replica_apply(spectator_replica_t *replica, const uint8_t *data, size_t size) {
+    if (!replica || (!data && size > 0)) {
+        return false;
+    }
+    
+    size_t offset = 0;
+    while (offset < size) {
+        const uint8_t *message = data + offset;
+        size_t left = size - offset;
+        size_t used;
+        
+        if (message[0] == SPECTATOR_MSG_KEYFRAME) {
+            used = apply_keyframe(&replica->sim, message, left);
+            replica->synced = used != 0;
+        } else {
+            used = delta_size(message[0]);
+            if (used > left) {
+                used = 0;
+            } else if (used != 0 && replica->synced && !apply_delta(&replica->sim, message)) {
+                used = 0;
+            }
+            // Without a keyframe yet there is no board to apply deltas to; they are skipped
+        }
+        
+        if (used == 0) {
+            replica->synced = false;
+            return false;
+        }
+        offset += used;
+    }
+    
+    return true;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file spectator_stream.h
+ * @brief Compact delta stream of a game for spectators
+ *
+ * A game being watched records its stream after every simulation step. The
+ * stream doesn't send the board; it sends what the step did to it, read
+ * from the step's events:
+ *
+ *   SPAWN     A piece entered at the spawn position: type
+ *   HOLD      The current piece went to the hold slot (a SPAWN follows)
+ *   PLACE     A piece was placed on the board: type, rotation, x, y
+ *   CLEAR     Lines removed, by a placement or once the line clear delay
+ *             is over: first row, then a mask of the rows from there (a
+ *             piece spans at most PIECE_SIZE rows)
+ *   GARBAGE   Garbage rows inserted under the stack: count, open column
+ *   SCORE     Score, lines and level after a placement
+ *   GAME_OVER The game ended
+ *   KEYFRAME  The whole game: board size, pieces, score, then each row's
+ *             occupancy ((width + 7) / 8 bytes, column x in bit x % 8 of
+ *             byte x / 8) and the packed cell of every filled square
+ *
+ * A replica applies PLACE, CLEAR and GARBAGE with the same board calls the
+ * simulation made, so it rebuilds the board exactly. A typical piece costs
+ * 17 bytes (SPAWN, PLACE and SCORE). A keyframe is written every
+ * keyframe_interval pieces, and the stream keeps the bytes since the last
+ * one, so a spectator who joins late catches up from there.
+ *
+ * Each message is a type byte and a fixed payload; multi-byte fields are
+ * big-endian.
+ */
+
+#ifndef SPECTATOR_STREAM_H_
+#define SPECTATOR_STREAM_H_
+
+#include "blocktris_sim.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define DEFAULT_SPECTATOR_KEYFRAME_INTERVAL 16
+#define MAX_SPECTATOR_KEYFRAME_INTERVAL 64
+
+// Largest keyframe: 20-byte header, then every row's occupancy and every cell filled
+#define SPECTATOR_KEYFRAME_MAX_SIZE (20 + MAX_BOARD_HEIGHT * (MAX_BOARD_WIDTH / 8 + MAX_BOARD_WIDTH))
+
+// Most bytes one step adds: hold, two spawns, place, clear, garbage, score, game over
+#define SPECTATOR_STEP_MAX_SIZE 32
+
+// One keyframe and the steps of the longest interval (a piece locks or is held once per step at most)
+#define SPECTATOR_STREAM_CAPACITY \
+    (SPECTATOR_KEYFRAME_MAX_SIZE + MAX_SPECTATOR_KEYFRAME_INTERVAL * 2 * SPECTATOR_STEP_MAX_SIZE)
+
+/**
+ * Stream of one game, written by the thread stepping it
+ */
+typedef struct {
+    uint8_t data[SPECTATOR_STREAM_CAPACITY]; // Messages since the last keyframe
+    size_t size;
+    size_t latest_start;       // Start of the bytes written by the last record
+    int keyframe_interval;     // Pieces between keyframes
+    uint32_t keyframe_pieces;  // pieces_locked when the last keyframe was written
+    bool game_over_sent;
+    uint64_t bytes_written;    // Over the whole game, keyframes included
+} spectator_stream_t;
+
+typedef spectator_stream_t *spectator_stream_ptr;
+
+/**
+ * Game rebuilt from a stream
+ *
+ * The simulation fields a renderer reads (board, piece, hold, score, lines,
+ * level, game over) are kept up to date, so sim_view_buffer_publish can
+ * show it like any player. The falling piece stays at its spawn position
+ * and the preview queue is empty; the stream doesn't carry either.
+ */
+typedef struct {
+    blocktris_sim_t sim;
+    bool synced; // A keyframe has been applied; messages before the first one are skipped
+} spectator_replica_t;
+
+typedef spectator_replica_t *spectator_replica_ptr;
+
+/**
+ * Initialize an empty stream
+ *
+ * @param stream Pointer to the stream to initialize
+ * @param keyframe_interval Pieces between keyframes (clamped to 1..MAX_SPECTATOR_KEYFRAME_INTERVAL)
+ */
+void spectator_stream_init(spectator_stream_t *stream, int keyframe_interval);
+
+/**
+ * Begin the stream with a keyframe of a game (after init or to resync)
+ *
+ * @param stream Pointer to the stream
+ * @param sim Game being watched
+ */
+void spectator_stream_start(spectator_stream_t *stream, const blocktris_sim_t *sim);
+
+/**
+ * Record what the game's last step did
+ *
+ * Call after every blocktris_sim_step of the game.
+ *
+ * @param stream Pointer to the stream
+ * @param sim Game being watched
+ */
+void spectator_stream_record(spectator_stream_t *stream, const blocktris_sim_t *sim);
+
+/**
+ * Get the bytes written by the last start or record, for spectators already following
+ *
+ * @param stream Pointer to the stream
+ * @param size Set to the number of bytes (0 if the step changed nothing)
+ * @return Pointer to the bytes, valid until the next record
+ */
+const uint8_t *spectator_stream_latest(const spectator_stream_t *stream, size_t *size);
+
+/**
+ * Get the bytes since the last keyframe, for a spectator joining now
+ *
+ * @param stream Pointer to the stream
+ * @param size Set to the number of bytes
+ * @return Pointer to the bytes, valid until the next record
+ */
+const uint8_t *spectator_stream_catch_up(const spectator_stream_t *stream, size_t *size);
+
+/**
+ * Initialize a replica that waits for a keyframe
+ *
+ * @param replica Pointer to the replica to initialize
+ */
+void spectator_replica_init(spectator_replica_t *replica);
+
+/**
+ * Apply stream bytes to a replica
+ *
+ * The bytes must hold whole messages, as returned by spectator_stream_latest
+ * or spectator_stream_catch_up.
+ *
+ * @param replica Pointer to the replica
+ * @param data Stream bytes
+ * @param size Number of bytes
+ * @return false if the bytes are malformed (the replica then waits for the next keyframe)
+ */
+bool spectator_replica_apply(spectator_replica_t *replica, const uint8_t *data, size_t size);
+
+#endif // SPECTATOR_STREAM_H_
@@ -0,0 +1,57 @@
+/**
+ * @file triple_buffer.c
+ * @brief Lock-free triple buffer implementation
+ */
+
+#include "triple_buffer.h"
+#include <stddef.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BUFFER_LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define BUFFER_EXCHANGE_ACQ_REL(ptr, value) __atomic_exchange_n((ptr), (value), __ATOMIC_ACQ_REL)
+#else
+#error "triple_buffer.c requires GCC or Clang atomic builtins"
+#endif
+
+// Set in shared while it holds a slot the reader hasn't taken yet
+#define TRIPLE_BUFFER_FRESH 0x4
+#define TRIPLE_BUFFER_SLOT_MASK 0x3
+
+void triple_buffer_init(triple_buffer_t *buffer) {
+    if (!buffer) {
+        return;
+    }
+    
+    buffer->back = 0;
+    buffer->shared = 1;
+    buffer->front = 2;
+}
+
+int triple_buffer_back(const triple_buffer_t *buffer) {
+    return buffer ? buffer->back : 0;
+}
+
+void triple_buffer_publish(triple_buffer_t *buffer) {
+    if (!buffer) {
+        return;
+    }
+    
+    // Release the finished slot; whatever was in between, read or not, is written next
+    int previous = BUFFER_EXCHANGE_ACQ_REL(&buffer->shared, buffer->back | TRIPLE_BUFFER_FRESH);
+    buffer->back = previous & TRIPLE_BUFFER_SLOT_MASK;
+}
+
+bool triple_buffer_acquire(triple_buffer_t *buffer) {
+    if (!buffer || !(BUFFER_LOAD_ACQUIRE(&buffer->shared) & TRIPLE_BUFFER_FRESH)) {
+        return false;
+    }
+    
+    // Only the writer sets the flag again, so the swap always picks up a published slot
+    int previous = BUFFER_EXCHANGE_ACQ_REL(&buffer->shared, buffer->front);
+    buffer->front = previous & TRIPLE_BUFFER_SLOT_MASK;
+    return true;
+}
+
+int triple_buffer_front(const triple_buffer_t *buffer) {
+    return buffer ? buffer->front : 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file triple_buffer.h
+ * @brief Lock-free triple buffer between one writer and one reader thread
+ *
+ * The caller keeps three slots of whatever it hands over; the buffer only
+ * tracks which slot each side owns. The writer fills its back slot and
+ * publishes it, swapping it with the shared slot; the reader takes the
+ * shared slot in exchange for the one it was reading whenever something new
+ * was published since. Neither side ever waits for the other, the writer
+ * may publish any number of times between two reads (only the latest is
+ * seen), and a slot is never written while it is being read.
+ */
+
+#ifndef TRIPLE_BUFFER_H_
+#define TRIPLE_BUFFER_H_
+
+#include <stdbool.h>
+
+#define TRIPLE_BUFFER_SLOTS 3
+
+/**
+ * Slot ownership of a triple buffer
+ */
+typedef struct {
+    int back;   // Slot being written (writer thread only)
+    int front;  // Slot being read (reader thread only)
+    int shared; // Slot in between, with TRIPLE_BUFFER_FRESH set while it holds an unread publish
+} triple_buffer_t;
+
+typedef triple_buffer_t *triple_buffer_ptr;
+
+/**
+ * Initialize the buffer, with nothing published yet
+ *
+ * @param buffer Pointer to the buffer to initialize
+ */
+void triple_buffer_init(triple_buffer_t *buffer);
+
+/**
+ * Get the slot the writer fills next (writer thread)
+ *
+ * @param buffer Pointer to the buffer
+ * @return Slot index, 0 to TRIPLE_BUFFER_SLOTS - 1
+ */
+int triple_buffer_back(const triple_buffer_t *buffer);
+
+/**
+ * Hand the back slot to the reader and take another one to write (writer thread)
+ *
+ * @param buffer Pointer to the buffer
+ */
+void triple_buffer_publish(triple_buffer_t *buffer);
+
+/**
+ * Switch to the latest published slot, if there is a new one (reader thread)
+ *
+ * @param buffer Pointer to the buffer
+ * @return true if the front slot changed
+ */
+bool triple_buffer_acquire(triple_buffer_t *buffer);
+
+/**
+ * Get the slot the reader holds, unchanged until the next acquire (reader thread)
+ *
+ * @param buffer Pointer to the buffer
+ * @return Slot index, 0 to TRIPLE_BUFFER_SLOTS - 1
+ */
+int triple_buffer_front(const triple_buffer_t *buffer);
+
+#endif // TRIPLE_BUFFER_H_
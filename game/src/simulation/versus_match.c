@@ -0,0 +1,126 @@
+/**
+ * @file versus_match.c
+ * @brief Two-player versus match implementation
+ */
+
+#include "versus_match.h"
+#include "constants.h"
+#include "utils.h"
+#include <stddef.h>
+
+static uint32_t hash_int(uint32_t hash, int64_t value) {
+    // Hash a fixed little-endian layout rather than the host's bytes
+    uint8_t bytes[8];
+    utils_write_u64_le(bytes, (uint64_t)value);
+    return utils_fnv1a_32(hash, bytes, sizeof(bytes));
+}
+
+void versus_match_init(versus_match_t *match, const game_config_t *config, uint64_t seed) {
+    if (!match || !config) {
+        return;
+    }
+    
+    // Shared piece tables must be complete before the players step on their own threads
+    blocktris_piece_warm_cache();
+    
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        blocktris_sim_init(&match->players[i].sim, config, seed);
+        garbage_queue_init(&match->players[i].inbox);
+    }
+}
+
+void versus_match_copy(versus_match_t *dst, const versus_match_t *src) {
+    if (!dst || !src || dst == src) {
+        return;
+    }
+    
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        blocktris_sim_copy(&dst->players[i].sim, &src->players[i].sim);
+        dst->players[i].inbox = src->players[i].inbox;
+    }
+}
+
+void versus_match_step_player(versus_match_t *match, int player, sim_input_t input) {
+    if (!match || player < 0 || player >= VERSUS_PLAYERS) {
+        return;
+    }
+    
+    versus_player_t *self = &match->players[player];
+    versus_player_t *opponent = &match->players[1 - player];
+    uint32_t tick = self->sim.tick + 1;
+    
+    // Garbage due by this tick becomes pending; later messages stay queued
+    garbage_message_t message;
+    while (garbage_queue_peek(&self->inbox, &message) && message.apply_tick <= tick) {
+        garbage_queue_pop(&self->inbox, NULL);
+        blocktris_sim_receive_garbage(&self->sim, message.rows);
+    }
+    
+    int rows = blocktris_sim_step(&self->sim, input);
+    if (rows > 0) {
+        message.apply_tick = tick + GARBAGE_DELAY_TICKS;
+        message.rows = (uint8_t)(rows < UINT8_MAX ? rows : UINT8_MAX);
+        
+        // A full inbox means the opponent stopped stepping (game over), so the garbage has nowhere to go
+        garbage_queue_push(&opponent->inbox, &message);
+    }
+}
+
+int versus_match_winner(const versus_match_t *match) {
+    if (!match) {
+        return VERSUS_NO_WINNER;
+    }
+    
+    bool first_out = match->players[0].sim.game_over;
+    bool second_out = match->players[1].sim.game_over;
+    
+    if (first_out && second_out) {
+        return VERSUS_DRAW;
+    }
+    if (first_out) {
+        return 1;
+    }
+    if (second_out) {
+        return 0;
+    }
+    
+    return VERSUS_NO_WINNER;
+}
+
+uint32_t versus_match_checksum(const versus_match_t *match) {
+    if (!match) {
+        return 0;
+    }
+    
+    uint32_t hash = UTILS_FNV32_OFFSET_BASIS;
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        const blocktris_sim_t *sim = &match->players[i].sim;
+        const blocktris_piece_t *piece = &sim->piece;
+        
+        // Cells are one byte each, so only the used part of the board is hashed
+        hash = utils_fnv1a_32(hash, sim->board.cells, (size_t)sim->board.width * (size_t)sim->board.height);
+        hash = hash_int(hash, piece->type);
+        hash = hash_int(hash, piece->x);
+        hash = hash_int(hash, piece->y);
+        hash = hash_int(hash, piece->rotation);
+        hash = hash_int(hash, piece->active);
+        hash = hash_int(hash, sim->hold_type);
+        hash = hash_int(hash, sim->tick);
+        hash = hash_int(hash, sim->score);
+        hash = hash_int(hash, sim->lines_cleared);
+        hash = hash_int(hash, sim->garbage_pending);
+        hash = hash_int(hash, (int64_t)sim->queue.rng_state);
+        hash = hash_int(hash, (int64_t)sim->garbage_rng);
+        hash = hash_int(hash, sim->game_over);
+        
+        // Garbage still in flight changes the future of the match too
+        const garbage_queue_t *inbox = &match->players[i].inbox;
+        for (uint32_t index = inbox->head; index != inbox->tail; index++) {
+            const garbage_message_t *message = &inbox->messages[index & (GARBAGE_QUEUE_CAPACITY - 1)];
+            hash = hash_int(hash, message->apply_tick);
+            hash = hash_int(hash, message->rows);
+        }
+    }
+    
+    return hash;
+}
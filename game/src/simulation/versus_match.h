@@ -0,0 +1,91 @@
+/**
+ * @file versus_match.h
+ * @brief Two-player versus match exchanging garbage between simulations
+ *
+ * Each player owns a simulation and an inbox of garbage sent by the other
+ * player. A player's step only touches its own simulation, reads its own
+ * inbox and writes the opponent's inbox, so the two players can be stepped
+ * on separate threads. Garbage becomes pending on the receiver
+ * GARBAGE_DELAY_TICKS after the sending tick, which keeps the match
+ * deterministic as long as both players are stepped in batches of at most
+ * MAX_SIM_TICKS_PER_FRAME ticks with both batches finished before the next
+ * ones start.
+ */
+
+#ifndef VERSUS_MATCH_H_
+#define VERSUS_MATCH_H_
+
+#include "blocktris_sim.h"
+#include "garbage_queue.h"
+
+#define VERSUS_PLAYERS 2
+
+// Winner values besides a player index
+#define VERSUS_NO_WINNER (-1)
+#define VERSUS_DRAW (-2)
+
+/**
+ * One side of the match
+ */
+typedef struct {
+    blocktris_sim_t sim;
+    garbage_queue_t inbox; // Garbage sent by the opponent
+} versus_player_t;
+
+/**
+ * Versus match state
+ */
+typedef struct {
+    versus_player_t players[VERSUS_PLAYERS];
+} versus_match_t;
+
+typedef versus_match_t *versus_match_ptr;
+
+/**
+ * Start a match; both players get the same piece sequence
+ *
+ * @param match Pointer to the match to initialize
+ * @param config Board size, preview depth and lock delay settings
+ * @param seed Seed shared by both players
+ */
+void versus_match_init(versus_match_t *match, const game_config_t *config, uint64_t seed);
+
+/**
+ * Copy a match, touching only the board rows and cells in use
+ *
+ * @param dst Pointer to the destination match
+ * @param src Pointer to the source match
+ */
+void versus_match_copy(versus_match_t *dst, const versus_match_t *src);
+
+/**
+ * Advance one player by one tick, taking in due garbage and sending any produced
+ *
+ * Safe to call for both players at the same time from different threads.
+ *
+ * @param match Pointer to the match
+ * @param player Player index (0 or 1)
+ * @param input SIM_INPUT_* flags for this tick
+ */
+void versus_match_step_player(versus_match_t *match, int player, sim_input_t input);
+
+/**
+ * Get the result of the match (only while no player is being stepped)
+ *
+ * @param match Pointer to the match
+ * @return Index of the winning player, VERSUS_DRAW, or VERSUS_NO_WINNER while both still play
+ */
+int versus_match_winner(const versus_match_t *match);
+
+/**
+ * Hash the game state of both players (only while no player is being stepped)
+ *
+ * Two matches stepped with the same seed, config and inputs give the same
+ * checksum, which lets networked peers and tests detect a desync.
+ *
+ * @param match Pointer to the match
+ * @return 32-bit FNV-1a hash of the boards, pieces, scores and pending garbage
+ */
+uint32_t versus_match_checksum(const versus_match_t *match);
+
+#endif // VERSUS_MATCH_H_
@@ -11,18 +11,20 @@
 #include "frame.h"
 #include "color.h"
 #include "clock.h"
-#include <stdlib.h>
 
-stage_ptr create_game_over_stage_instance(void) {
-    stage_ptr stage = malloc(sizeof(stage_t));
+stage_ptr create_game_over_stage_instance(stage_arena_ptr arena) {
+    stage_ptr stage = stage_arena_alloc(arena, sizeof(stage_t));
     if (!stage) {
         return NULL;
     }
     
     stage->state = NULL;
+    stage->arena = arena;
+    stage->resources = NULL;
     stage->init = game_over_stage_init;
     stage->update = game_over_stage_update;
     stage->cleanup = game_over_stage_cleanup;
+    stage->destroy = NULL;
     stage->name = "Game Over Stage";
     
     return stage;
@@ -33,7 +35,7 @@ void game_over_stage_init(stage_t *stage, game_ptr game) {
         return;
     }
     
-    game_over_stage_state_t *state = malloc(sizeof(game_over_stage_state_t));
+    game_over_stage_state_t *state = stage_arena_alloc(stage->arena, sizeof(game_over_stage_state_t));
     if (!state) {
         return;
     }
@@ -43,6 +45,17 @@ void game_over_stage_init(stage_t *stage, game_ptr game) {
     state->quit_requested = false;
     state->stage_start_time = get_clock_ticks_ms();
     
+    // The game was logged when it ended; find it in the table
+    state->high_score_count = high_scores_top(game_high_scores(game), state->high_scores, DEFAULT_HIGH_SCORES_SIZE);
+    state->player_rank = -1;
+    for (int i = 0; i < state->high_score_count; i++) {
+        if (state->high_scores[i].replay_hash == game->replay_hash &&
+            state->high_scores[i].score == (uint32_t)game->score) {
+            state->player_rank = i;
+            break;
+        }
+    }
+    
     stage->state = state;
     
     // Set game screen
@@ -79,8 +92,8 @@ game_stage_action_t game_over_stage_update(stage_t *stage) {
     clear_frame(&game->graphics_context);
     
     // First render the final game state
-    blocktris_renderer_render_board(game, &game->graphics_context);
-    blocktris_renderer_render_placed_pieces(&game->board, &game->graphics_context);
+    blocktris_renderer_render_board(game, &game->layout, &game->graphics_context);
+    blocktris_renderer_render_placed_pieces(&game->board, &game->layout, &game->graphics_context);
     
     // Calculate animation progress
     timestamp_ms_t current_time = get_clock_ticks_ms();
@@ -98,10 +111,10 @@ game_stage_action_t game_over_stage_update(stage_t *stage) {
     int text_height = 7 * scale;
     
     // Start below screen, animate to center
-    int start_y = LOGICAL_HEIGHT + text_height; // Start below visible area
-    int end_y = (LOGICAL_HEIGHT - text_height) / 2; // Center of screen
+    int start_y = game->layout.height + text_height; // Start below visible area
+    int end_y = (game->layout.height - text_height) / 2; // Center of screen
     int current_y = start_y - (int)((start_y - end_y) * progress);
-    int text_x = (LOGICAL_WIDTH - text_width) / 2; // Centered horizontally
+    int text_x = (game->layout.width - text_width) / 2; // Centered horizontally
     
     // Draw "GAME OVER" text with red color
     render_arcade_text_scaled(&game->arcade_font, &game->graphics_context,
@@ -114,7 +127,7 @@ game_stage_action_t game_over_stage_update(stage_t *stage) {
         int restart_scale = 3;
         int restart_width = get_arcade_text_width_scaled(&game->arcade_font, restart_text, restart_scale);
         int restart_height = 7 * restart_scale;
-        int restart_x = (LOGICAL_WIDTH - restart_width) / 2;
+        int restart_x = (game->layout.width - restart_width) / 2;
         int restart_y = current_y + text_height + 40; // Below "GAME OVER"
         
         // Flash every 500ms
@@ -129,11 +142,33 @@ game_stage_action_t game_over_stage_update(stage_t *stage) {
         snprintf(score_text, sizeof(score_text), "FINAL SCORE: %d", game->score);
         int score_scale = 2;
         int score_width = get_arcade_text_width_scaled(&game->arcade_font, score_text, score_scale);
-        int score_x = (LOGICAL_WIDTH - score_width) / 2;
+        int score_x = (game->layout.width - score_width) / 2;
         int score_y = restart_y + restart_height + 30;
         
         render_arcade_text_scaled(&game->arcade_font, &game->graphics_context,
                                  score_text, score_x, score_y, FONT_COLOR_WHITE, score_scale);
+        
+        // High-score table, with the game just played highlighted
+        int row_y = score_y + 7 * score_scale + 30;
+        for (int i = 0; i < state->high_score_count && i < GAME_OVER_HIGH_SCORES_SHOWN; i++) {
+            const high_score_t *entry = &state->high_scores[i];
+            char row_text[64];
+            snprintf(row_text, sizeof(row_text), "%d  %08u  LEVEL %u", i + 1, (unsigned)entry->score,
+                     (unsigned)entry->level);
+            int row_x = (game->layout.width -
+                         get_arcade_text_width_scaled(&game->arcade_font, row_text, score_scale)) / 2;
+            render_arcade_text_scaled(&game->arcade_font, &game->graphics_context, row_text, row_x, row_y,
+                                      i == state->player_rank ? FONT_COLOR_YELLOW : FONT_COLOR_WHITE, score_scale);
+            row_y += 7 * score_scale + 10;
+        }
+        if (state->player_rank >= GAME_OVER_HIGH_SCORES_SHOWN) {
+            char rank_text[32];
+            snprintf(rank_text, sizeof(rank_text), "YOU PLACED %d", state->player_rank + 1);
+            int rank_x = (game->layout.width -
+                          get_arcade_text_width_scaled(&game->arcade_font, rank_text, score_scale)) / 2;
+            render_arcade_text_scaled(&game->arcade_font, &game->graphics_context, rank_text, rank_x, row_y,
+                                      FONT_COLOR_YELLOW, score_scale);
+        }
     }
     
     render_frame(&game->graphics_context);
@@ -147,7 +182,7 @@ void game_over_stage_cleanup(stage_t *stage) {
     }
     
     if (stage->state) {
-        free(stage->state);
+        stage_arena_reset(stage->arena);
         stage->state = NULL;
     }
 }
@@ -9,6 +9,10 @@
 #define BLOCKTRIS_GAME_OVER_STAGE_H_
 
 #include "stage.h"
+#include "high_scores.h"
+
+// High-score table rows shown under the final score
+#define GAME_OVER_HIGH_SCORES_SHOWN 5
 
 /**
  * Game over stage state
@@ -18,6 +22,9 @@ typedef struct {
     bool restart_requested;
     bool quit_requested;
     timestamp_ms_t stage_start_time;
+    high_score_t high_scores[DEFAULT_HIGH_SCORES_SIZE]; // Best first
+    int high_score_count;
+    int player_rank; // Index of the game just played in high_scores, -1 if it didn't make the table
 } game_over_stage_state_t;
 
 typedef game_over_stage_state_t *game_over_stage_state_ptr;
@@ -11,18 +11,20 @@
 #include "keyboard.h"
 #include "clock.h"
 #include "events.h"
-#include <stdlib.h>
 
-stage_ptr create_intro_stage_instance(void) {
-    stage_ptr stage = malloc(sizeof(stage_t));
+stage_ptr create_intro_stage_instance(stage_arena_ptr arena) {
+    stage_ptr stage = stage_arena_alloc(arena, sizeof(stage_t));
     if (!stage) {
         return NULL;
     }
     
     stage->state = NULL;
+    stage->arena = arena;
+    stage->resources = NULL;
     stage->init = intro_stage_init;
     stage->update = intro_stage_update;
     stage->cleanup = intro_stage_cleanup;
+    stage->destroy = NULL;
     stage->name = "Intro Stage";
     
     return stage;
@@ -33,7 +35,7 @@ void intro_stage_init(stage_t *stage, game_ptr game) {
         return;
     }
     
-    intro_stage_state_t *state = malloc(sizeof(intro_stage_state_t));
+    intro_stage_state_t *state = stage_arena_alloc(stage->arena, sizeof(intro_stage_state_t));
     if (!state) {
         return;
     }
@@ -83,7 +85,7 @@ game_stage_action_t intro_stage_update(stage_t *stage) {
     
     // Render "BLOCKTRIS" title - occupies 80% of window width
     const char* title_text = "BLOCKTRIS";
-    int target_title_width = (int)(LOGICAL_WIDTH * 0.8);
+    int target_title_width = (int)(game->layout.width * 0.8);
     
     // Calculate scale needed to achieve 80% width
     int base_title_width = get_arcade_text_width_scaled(&game->arcade_font, title_text, 1);
@@ -91,15 +93,15 @@ game_stage_action_t intro_stage_update(stage_t *stage) {
     if (title_scale < 1) title_scale = 1; // Minimum scale
     
     int actual_title_width = get_arcade_text_width_scaled(&game->arcade_font, title_text, title_scale);
-    int title_x = (LOGICAL_WIDTH - actual_title_width) / 2;
-    int title_y = LOGICAL_HEIGHT / 4;
+    int title_x = (game->layout.width - actual_title_width) / 2;
+    int title_y = game->layout.height / 4;
     
     render_arcade_text_scaled(&game->arcade_font, &game->graphics_context, 
                               title_text, title_x, title_y, FONT_COLOR_CYAN, title_scale);
     
     // Render flashing "PRESS SPACE TO START" text - occupies 90% of window width
     const char* start_text = "PRESS SPACE TO START";
-    int target_start_width = (int)(LOGICAL_WIDTH * 0.9);
+    int target_start_width = (int)(game->layout.width * 0.9);
     
     // Calculate scale needed to achieve 90% width
     int base_start_width = get_arcade_text_width_scaled(&game->arcade_font, start_text, 1);
@@ -108,8 +110,8 @@ game_stage_action_t intro_stage_update(stage_t *stage) {
     
     int actual_start_width = get_arcade_text_width_scaled(&game->arcade_font, start_text, start_scale);
     int start_height = 7 * start_scale;
-    int start_x = (LOGICAL_WIDTH - actual_start_width) / 2; // Horizontal center
-    int start_y = (LOGICAL_HEIGHT - start_height) / 2; // Vertical center
+    int start_x = (game->layout.width - actual_start_width) / 2; // Horizontal center
+    int start_y = (game->layout.height - start_height) / 2; // Vertical center
     
     // Flash the start text every 500ms
     bool show_start_text = (elapsed / 500) % 2 == 0;
@@ -129,6 +131,6 @@ void intro_stage_cleanup(stage_t *stage) {
         return;
     }
     
-    free(stage->state);
+    stage_arena_reset(stage->arena);
     stage->state = NULL;
 }
@@ -12,18 +12,20 @@
 #include "clock.h"
 #include "arcade_font.h"
 #include "geometry.h"
-#include <stdlib.h>
 
-stage_ptr create_menu_stage_instance(void) {
-    stage_ptr stage = malloc(sizeof(stage_t));
+stage_ptr create_menu_stage_instance(stage_arena_ptr arena) {
+    stage_ptr stage = stage_arena_alloc(arena, sizeof(stage_t));
     if (!stage) {
         return NULL;
     }
     
     stage->state = NULL;
+    stage->arena = arena;
+    stage->resources = NULL;
     stage->init = menu_stage_init;
     stage->update = menu_stage_update;
     stage->cleanup = menu_stage_cleanup;
+    stage->destroy = NULL;
     stage->name = "Menu Stage";
     
     return stage;
@@ -34,7 +36,7 @@ void menu_stage_init(stage_t *stage, game_ptr game) {
         return;
     }
     
-    menu_stage_state_t *state = malloc(sizeof(menu_stage_state_t));
+    menu_stage_state_t *state = stage_arena_alloc(stage->arena, sizeof(menu_stage_state_t));
     if (!state) {
         return;
     }
@@ -74,6 +76,12 @@ game_stage_action_t menu_stage_update(stage_t *stage) {
         return PROGRESS;
     }
     
+    // Check for a two-player versus match, online when started with --host or --join
+    if (game->keyboard_state.keys[SDL_SCANCODE_V]) {
+        game->current_screen = game->config.net_role == NET_ROLE_NONE ? SCREEN_VERSUS : SCREEN_ONLINE;
+        return PROGRESS;
+    }
+    
     // Render menu
     clear_frame(&game->graphics_context);
     
@@ -81,8 +89,8 @@ game_stage_action_t menu_stage_update(stage_t *stage) {
     const char* title_text = "BLOCKTRIS";
     int title_scale = 6;
     int title_width = get_arcade_text_width_scaled(&game->arcade_font, title_text, title_scale);
-    int title_x = (LOGICAL_WIDTH - title_width) / 2;
-    int title_y = LOGICAL_HEIGHT / 3;
+    int title_x = (game->layout.width - title_width) / 2;
+    int title_y = MENU_TITLE_Y(&game->layout);
     
     render_arcade_text_scaled(&game->arcade_font, &game->graphics_context, 
                               title_text, title_x, title_y, FONT_COLOR_CYAN, title_scale);
@@ -96,7 +104,7 @@ game_stage_action_t menu_stage_update(stage_t *stage) {
         const char* start_text = "PRESS SPACE TO START";
         int start_scale = 3;
         int start_width = get_arcade_text_width_scaled(&game->arcade_font, start_text, start_scale);
-        int start_x = (LOGICAL_WIDTH - start_width) / 2;
+        int start_x = (game->layout.width - start_width) / 2;
         int title_height = 7 * title_scale; // Arcade font char height is 7 pixels
         int start_y = title_y + title_height + 40;
         
@@ -104,6 +112,15 @@ game_stage_action_t menu_stage_update(stage_t *stage) {
                                   start_text, start_x, start_y, FONT_COLOR_YELLOW, start_scale);
     }
     
+    // Render the versus hint below the blinking text
+    const char* versus_text = game->config.net_role == NET_ROLE_NONE ?
+                              "PRESS V FOR 2 PLAYER VERSUS" : "PRESS V FOR ONLINE VERSUS";
+    int versus_scale = 2;
+    int versus_width = get_arcade_text_width_scaled(&game->arcade_font, versus_text, versus_scale);
+    render_arcade_text_scaled(&game->arcade_font, &game->graphics_context,
+                              versus_text, (game->layout.width - versus_width) / 2,
+                              MENU_START_Y(&game->layout), FONT_COLOR_WHITE, versus_scale);
+    
     render_frame(&game->graphics_context);
     
     return PROGRESS;
@@ -115,7 +132,7 @@ void menu_stage_cleanup(stage_t *stage) {
     }
     
     if (stage->state) {
-        free(stage->state);
+        stage_arena_reset(stage->arena);
         stage->state = NULL;
     }
 }
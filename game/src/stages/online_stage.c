@@ -0,0 +1,253 @@
+/**
+ * @file online_stage.c
+ * @brief BlockTris online versus stage implementation
+ */
+
+#include "online_stage.h"
+#include "keyboard.h"
+#include "events.h"
+#include "blocktris_renderer.h"
+#include "clock.h"
+#include "constants.h"
+#include "frame.h"
+#include <stdlib.h>
+
+// The local player plays with the arrow keys, like in the single-player game
+#define ONLINE_KEY_MAP (&VERSUS_KEY_MAPS[1])
+
+static const char *const HOST_LABELS[VERSUS_PLAYERS] = { "YOU", "RIVAL" };
+static const char *const JOIN_LABELS[VERSUS_PLAYERS] = { "RIVAL", "YOU" };
+
+/**
+ * Allocate the network side of the stage, closed, NULL if it can't be
+ */
+static online_connection_t *create_connection(void) {
+    online_connection_t *connection = malloc(sizeof(online_connection_t));
+    if (connection) {
+        connection->socket.fd = -1;
+        connection->socket.has_peer = false;
+    }
+    return connection;
+}
+
+stage_ptr create_online_stage_instance(stage_arena_ptr arena) {
+    stage_ptr stage = stage_arena_alloc(arena, sizeof(stage_t));
+    if (!stage) {
+        return NULL;
+    }
+    
+    stage->state = NULL;
+    stage->arena = arena;
+    stage->resources = create_connection();
+    stage->init = online_stage_init;
+    stage->update = online_stage_update;
+    stage->cleanup = online_stage_cleanup;
+    stage->destroy = online_stage_destroy;
+    stage->name = "Online Stage";
+    
+    return stage;
+}
+
+/**
+ * Open the socket and start the HELLO exchange
+ *
+ * @return NULL on success, otherwise the message to show
+ */
+static const char *open_connection(online_stage_state_t *state) {
+    const game_config_t *config = &state->game->config;
+    online_connection_t *connection = state->connection;
+    if (!connection) {
+        return "OUT OF MEMORY";
+    }
+    
+    bool hosting = config->net_role == NET_ROLE_HOST;
+    if (!udp_socket_open(&connection->socket, hosting ? (uint16_t)config->net_port : 0)) {
+        return "CANNOT OPEN PORT";
+    }
+    if (!hosting && !udp_socket_set_peer(&connection->socket, config->net_host, (uint16_t)config->net_port)) {
+        return "UNKNOWN HOST";
+    }
+    
+    timestamp_ms_t now = get_clock_ticks_ms();
+    net_conditions_t conditions;
+    conditions.loss_percent = config->net_loss_percent;
+    conditions.latency_ms = config->net_latency_ms;
+    conditions.jitter_ms = config->net_jitter_ms;
+    conditions.seed = (uint64_t)now;
+    
+    net_link_init_udp(&connection->link, &connection->socket, &conditions);
+    rollback_session_init(&connection->session, &connection->link,
+                          hosting ? NET_HOST_PLAYER : NET_JOIN_PLAYER,
+                          config, game_piece_seed(state->game), (uint32_t)now);
+    
+    return NULL;
+}
+
+/**
+ * Run the ticks of real time that passed since the last frame
+ */
+static void run_ticks(online_stage_state_t *state) {
+    rollback_session_t *session = &state->connection->session;
+    
+    timestamp_ms_t current_time = get_clock_ticks_ms();
+    state->tick_accumulator_ms += current_time - state->last_tick_time;
+    state->last_tick_time = current_time;
+    
+    int ticks = (int)(state->tick_accumulator_ms / SIM_TICK_MS);
+    state->tick_accumulator_ms -= (timestamp_ms_t)ticks * SIM_TICK_MS;
+    if (ticks > MAX_SIM_TICKS_PER_FRAME) {
+        ticks = MAX_SIM_TICKS_PER_FRAME;
+    }
+    
+    // Running ahead of the peer only leads to more rollbacks over there, so give up a tick
+    if (ticks > 0 && rollback_session_should_wait(session)) {
+        ticks--;
+    }
+    
+    for (int i = 0; i < ticks; i++) {
+        sim_input_t input = state->input.pending;
+        if (!rollback_session_advance(session, input)) {
+            break; // Stalled until the peer's inputs arrive
+        }
+        
+        // Actions fire on the first tick only; held inputs apply to all of them
+        state->input.pending &= SIM_INPUT_HELD_MASK;
+    }
+}
+
+void online_stage_init(stage_t *stage, game_ptr game) {
+    if (!stage || !game) {
+        return;
+    }
+    
+    online_stage_state_t *state = stage_arena_alloc(stage->arena, sizeof(online_stage_state_t));
+    if (!state) {
+        return;
+    }
+    
+    state->game = game;
+    state->connection = stage->resources;
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        sim_view_buffer_init(&state->views[i]);
+    }
+    versus_input_reset(&state->input); // Ignore keys still down from the menu
+    state->last_tick_time = get_clock_ticks_ms();
+    state->tick_accumulator_ms = 0;
+    state->match_started = false;
+    state->winner = VERSUS_NO_WINNER;
+    
+    state->error = open_connection(state);
+    
+    stage->state = state;
+    game->current_screen = SCREEN_ONLINE;
+}
+
+game_stage_action_t online_stage_update(stage_t *stage) {
+    if (!stage || !stage->state) {
+        return QUIT;
+    }
+    
+    online_stage_state_t *state = (online_stage_state_t *)stage->state;
+    game_ptr game = state->game;
+    
+    // Handle SDL events
+    handle_events(&game->event_system);
+    
+    // Update keyboard state
+    game->keyboard_state.keys = SDL_GetKeyboardState(NULL);
+    
+    // Check for quit
+    if (is_esc_key_pressed(&game->keyboard_state)) {
+        return QUIT;
+    }
+    
+    const char *message = state->error;
+    rollback_session_t *session = state->connection ? &state->connection->session : NULL;
+    
+    if (!message) {
+        // Keep exchanging packets after the match ends so the peer gets our last inputs
+        rollback_session_update(session, (uint32_t)get_clock_ticks_ms());
+        
+        if (session->status == NET_SESSION_RUNNING && !state->match_started) {
+            // The boards may be sized by the host's settings rather than ours
+            versus_layout_calculate(&state->layout, &game->layout, session->config.board_width,
+                                    session->config.board_height);
+            state->last_tick_time = get_clock_ticks_ms();
+            state->tick_accumulator_ms = 0;
+            state->match_started = true;
+        }
+        
+        if (session->status == NET_SESSION_RUNNING) {
+            // A predicted game over may still be rolled back
+            if (state->winner == VERSUS_NO_WINNER && rollback_session_is_confirmed(session)) {
+                state->winner = versus_match_winner(&session->match);
+            }
+            
+            if (state->winner == VERSUS_NO_WINNER) {
+                versus_input_sample(&state->input, ONLINE_KEY_MAP, game->keyboard_state.keys);
+                run_ticks(state);
+            }
+            
+            for (int i = 0; i < VERSUS_PLAYERS; i++) {
+                sim_view_buffer_publish(&state->views[i], &session->match.players[i].sim);
+            }
+        }
+        
+        if (session->status == NET_SESSION_CONNECTING) {
+            message = session->local_player == NET_HOST_PLAYER ? "WAITING FOR PLAYER" : "CONNECTING";
+        } else if (session->status == NET_SESSION_DISCONNECTED) {
+            message = "CONNECTION LOST";
+        } else if (state->winner != VERSUS_NO_WINNER) {
+            message = state->winner == VERSUS_DRAW ? "DRAW" :
+                      state->winner == session->local_player ? "YOU WIN" : "YOU LOSE";
+        }
+    }
+    
+    // Render the boards once the match has started, with any message on top, fitted to the window
+    clear_frame(&game->graphics_context);
+    blocktris_renderer_render_background(game, &game->layout, &game->graphics_context);
+    
+    if (state->match_started) {
+        versus_layout_calculate(&state->layout, &game->layout, state->layout.board_width,
+                                state->layout.board_height);
+        versus_render_boards(game, &state->layout, state->views,
+                             session->local_player == NET_HOST_PLAYER ? HOST_LABELS : JOIN_LABELS);
+    }
+    if (message) {
+        versus_render_message(game, message);
+    }
+    
+    render_frame(&game->graphics_context);
+    
+    return PROGRESS;
+}
+
+void online_stage_cleanup(stage_t *stage) {
+    if (!stage) {
+        return;
+    }
+    
+    if (stage->state) {
+        online_stage_state_t *state = (online_stage_state_t *)stage->state;
+        if (state->connection) {
+            udp_socket_close(&state->connection->socket);
+        }
+        for (int i = 0; i < VERSUS_PLAYERS; i++) {
+            sim_view_buffer_cleanup(&state->views[i]);
+        }
+        
+        stage_arena_reset(stage->arena);
+        stage->state = NULL;
+    }
+}
+
+void online_stage_destroy(stage_t *stage) {
+    if (!stage || !stage->resources) {
+        return;
+    }
+    
+    online_connection_t *connection = (online_connection_t *)stage->resources;
+    udp_socket_close(&connection->socket);
+    free(connection);
+    stage->resources = NULL;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file online_stage.h
+ * @brief BlockTris online versus stage
+ *
+ * Plays a versus match against another computer started with --host or
+ * --join. The local player uses the arrow keys; only input flags cross the
+ * network, and the rollback session runs both simulations on the main
+ * thread, so the stage publishes both views itself every frame.
+ */
+
+#ifndef BLOCKTRIS_ONLINE_STAGE_H_
+#define BLOCKTRIS_ONLINE_STAGE_H_
+
+#include "stage.h"
+#include "versus_stage.h"
+#include "rollback_session.h"
+#include "udp_socket.h"
+#include "net_link.h"
+
+/**
+ * Network side of the stage, allocated on the heap once, when the stage is
+ * created, and reused by every match: the session keeps NET_ROLLBACK_WINDOW
+ * saved matches, far more than a stage arena holds
+ */
+typedef struct {
+    udp_socket_t socket;
+    net_link_t link;
+    rollback_session_t session;
+} online_connection_t;
+
+/**
+ * Online stage state
+ */
+typedef struct {
+    game_ptr game; // Reference to game context
+    online_connection_t *connection; // The stage's connection, NULL if it couldn't be allocated
+    sim_view_buffer_t views[VERSUS_PLAYERS];
+    versus_input_t input;
+    timestamp_ms_t last_tick_time;      // Real time simulation ticks were last run up to
+    timestamp_ms_t tick_accumulator_ms; // Real time not yet consumed by simulation ticks
+    bool match_started; // Layout and views follow the host's settings
+    int winner;         // VERSUS_NO_WINNER until the result is confirmed by both inputs
+    versus_layout_t layout;
+    const char *error;  // Why the connection couldn't be set up, NULL if it was
+} online_stage_state_t;
+
+typedef online_stage_state_t *online_stage_state_ptr;
+
+/**
+ * Initialize online stage
+ */
+void online_stage_init(stage_t *stage, game_ptr game);
+
+/**
+ * Update online stage
+ */
+game_stage_action_t online_stage_update(stage_t *stage);
+
+/**
+ * Cleanup online stage
+ */
+void online_stage_cleanup(stage_t *stage);
+
+/**
+ * Release the connection the stage keeps across entries
+ */
+void online_stage_destroy(stage_t *stage);
+
+#endif // BLOCKTRIS_ONLINE_STAGE_H_
@@ -8,47 +8,266 @@
 #include "events.h"
 #include "blocktris_renderer.h"
 #include "blocktris_collision.h"
+#include "blocktris_score.h"
 #include "clock.h"
 #include "constants.h"
 #include "frame.h"
 #include <stdlib.h>
+#include <string.h>
 
-stage_ptr create_playing_stage_instance(void) {
-    stage_ptr stage = malloc(sizeof(stage_t));
+/**
+ * Allocate the simulation thread's state, NULL if it can't be: the stage
+ * then steps the game itself
+ */
+static playing_sim_t *create_playing_sim(void) {
+    playing_sim_t *sim = calloc(1, sizeof(playing_sim_t));
+    if (!sim) {
+        return NULL;
+    }
+    
+    sim->wake = SDL_CreateSemaphore(0);
+    if (!sim->wake) {
+        free(sim);
+        return NULL;
+    }
+    
+    triple_buffer_init(&sim->frame_buffer);
+    key_event_queue_init(&sim->key_events);
+    return sim;
+}
+
+stage_ptr create_playing_stage_instance(stage_arena_ptr arena) {
+    stage_ptr stage = stage_arena_alloc(arena, sizeof(stage_t));
     if (!stage) {
         return NULL;
     }
     
     stage->state = NULL;
+    stage->arena = arena;
+    stage->resources = create_playing_sim();
     stage->init = playing_stage_init;
     stage->update = playing_stage_update;
     stage->cleanup = playing_stage_cleanup;
+    stage->destroy = playing_stage_destroy;
     stage->name = "Playing Stage";
     
     return stage;
 }
 
+/**
+ * Fixed-point row of the falling piece, including how far gravity has built up
+ */
+static int piece_position(const blocktris_sim_t *sim, const blocktris_piece_t *piece) {
+    bool grounded = !blocktris_collision_can_fall(&sim->board, piece->type, piece->rotation,
+                                                  piece->x, piece->y);
+    return piece_motion_position(piece->y, sim->fall_ticks, blocktris_sim_fall_interval(sim), grounded);
+}
+
+/**
+ * Bring the simulation thread's keyboard state up to the tick about to run;
+ * any other keyboard state is SDL's own, already current
+ */
+static void take_tick_keys(playing_stage_state_t *state, const keyboard_state_t *keyboard) {
+    playing_sim_t *sim = state->sim;
+    if (sim && keyboard->keys == sim->keys) {
+        key_event_queue_apply_tick(&sim->key_events, sim->keys, SDL_NUM_SCANCODES);
+    }
+}
+
+/**
+ * Real time the last simulation tick run was due
+ */
+static timestamp_ms_t last_tick_due(const playing_stage_state_t *state) {
+    return state->last_tick_time - state->tick_accumulator_ms;
+}
+
+/**
+ * Capture the game into a frame, with what the renderer needs to move the piece smoothly
+ */
+static bool capture_frame(playing_stage_state_t *state, playing_frame_t *frame) {
+    if (!game_capture_snapshot(state->game, &frame->game)) {
+        return false;
+    }
+    
+    frame->piece_position = piece_position(&state->game->sim, &frame->game.piece);
+    frame->tick_time = last_tick_due(state);
+    return true;
+}
+
+static int sim_thread_main(void *data) {
+    playing_stage_state_t *state = (playing_stage_state_t *)data;
+    playing_sim_t *sim = state->sim;
+    keyboard_state_t keyboard;
+    memset(&keyboard, 0, sizeof(keyboard));
+    keyboard.keys = sim->keys;
+    
+    while (SDL_AtomicGet(&sim->running)) {
+        bool playing = playing_stage_advance(state, &keyboard);
+        
+        // Publish every step; the renderer only ever picks up the latest
+        if (capture_frame(state, &sim->frames[triple_buffer_back(&sim->frame_buffer)])) {
+            triple_buffer_publish(&sim->frame_buffer);
+        }
+        if (!playing) {
+            SDL_AtomicSet(&sim->game_over, 1);
+            break;
+        }
+        
+        // Sleep until the next tick is due
+        SDL_SemWaitTimeout(sim->wake, SIM_TICK_MS);
+    }
+    
+    return 0;
+}
+
+/**
+ * Queue each key press and release SDL delivers for the simulation thread
+ * (an SDL event watch, run while the main thread polls events)
+ */
+static int queue_key_event(void *data, SDL_Event *event) {
+    playing_sim_t *sim = (playing_sim_t *)data;
+    if ((event->type == SDL_KEYDOWN && !event->key.repeat) || event->type == SDL_KEYUP) {
+        key_event_queue_push(&sim->key_events, event->key.keysym.scancode, event->type == SDL_KEYDOWN);
+    }
+    return 1;
+}
+
+/**
+ * Hand the game to the simulation thread (the stage must own it)
+ */
+static void start_sim(playing_stage_state_t *state) {
+    playing_sim_t *sim = state->sim;
+    if (!sim || sim->thread) {
+        return;
+    }
+    
+    // The view starts out as the game as it is now, with nothing else published
+    game_ptr game = state->game;
+    triple_buffer_init(&sim->frame_buffer);
+    playing_frame_t *frame = &sim->frames[triple_buffer_front(&sim->frame_buffer)];
+    if (!capture_frame(state, frame)) {
+        return;
+    }
+    sim->view.config = game->config;
+    sim->view.arcade_font = game->arcade_font;
+    sim->view.show_countdown = false;
+    game_apply_snapshot(&sim->view, &frame->game);
+    
+    state->last_tick_time = get_clock_ticks_ms();
+    SDL_AtomicSet(&sim->running, 1);
+    SDL_AtomicSet(&sim->game_over, 0);
+    
+    // The thread starts from the keyboard as it is now, then follows every key press and release
+    int key_count = 0;
+    const Uint8 *keys = SDL_GetKeyboardState(&key_count);
+    if (key_count > SDL_NUM_SCANCODES) {
+        key_count = SDL_NUM_SCANCODES;
+    }
+    memset(sim->keys, 0, sizeof(sim->keys));
+    memcpy(sim->keys, keys, (size_t)key_count);
+    key_event_queue_init(&sim->key_events);
+    SDL_AddEventWatch(queue_key_event, sim);
+    
+    sim->thread = SDL_CreateThread(sim_thread_main, "playing_sim", state);
+    if (!sim->thread) {
+        // Without a thread the stage simply steps the game itself from now on
+        SDL_DelEventWatch(queue_key_event, sim);
+        state->sim = NULL;
+    }
+}
+
+/**
+ * Take the game back from the simulation thread
+ */
+static void stop_sim(playing_stage_state_t *state) {
+    playing_sim_t *sim = state->sim;
+    if (!sim || !sim->thread) {
+        return;
+    }
+    
+    SDL_AtomicSet(&sim->running, 0);
+    SDL_SemPost(sim->wake);
+    SDL_WaitThread(sim->thread, NULL);
+    sim->thread = NULL;
+    SDL_DelEventWatch(queue_key_event, sim);
+}
+
+/**
+ * Game to draw: the mirror of the latest published state while the thread
+ * runs, the game itself otherwise, with the falling piece placed for now
+ */
+static const game_t *scene_to_render(playing_stage_state_t *state) {
+    playing_sim_t *sim = state->sim;
+    game_ptr scene = state->game;
+    
+    if (sim && sim->thread) {
+        if (triple_buffer_acquire(&sim->frame_buffer)) {
+            const playing_frame_t *frame = &sim->frames[triple_buffer_front(&sim->frame_buffer)];
+            game_apply_snapshot(&sim->view, &frame->game);
+            piece_motion_update(&state->piece_motion, &frame->game.piece, frame->piece_position,
+                                frame->game.sim_tick, frame->tick_time);
+        }
+        
+        // The background is uploaded by the asset loader whenever it's ready
+        sim->view.background_texture = state->game->background_texture;
+        scene = &sim->view;
+    } else {
+        const blocktris_piece_t *piece = &scene->current_piece;
+        piece_motion_update(&state->piece_motion, piece, piece->active ? piece_position(&scene->sim, piece) : 0,
+                            scene->sim_tick, last_tick_due(state));
+    }
+    
+    const blocktris_piece_t *piece = &scene->current_piece;
+    scene->piece_offset_y = piece->active ?
+                            piece_motion_offset(&state->piece_motion, piece->y, get_clock_ticks_ms()) : 0;
+    return scene;
+}
+
+/**
+ * Log the finished game and move on to the game over screen (the stage must own the game)
+ */
+static game_stage_action_t finish_game(playing_stage_state_t *state) {
+    game_ptr game = state->game;
+    
+    // A finished game is logged for the high scores, and not resumed
+    game_record_high_score(game);
+    game_snapshot_remove(game->config.save_path);
+    state->game_over_requested = true;
+    game->current_screen = SCREEN_GAME_OVER;
+    return PROGRESS;
+}
+
 void playing_stage_init(stage_t *stage, game_ptr game) {
     if (!stage || !game) {
         return;
     }
     
-    playing_stage_state_t *state = malloc(sizeof(playing_stage_state_t));
+    playing_stage_state_t *state = stage_arena_alloc(stage->arena, sizeof(playing_stage_state_t));
     if (!state) {
         return;
     }
     
     state->game = game;
     state->game_over_requested = false;
-    state->last_fall_time = get_clock_ticks_ms();
+    state->pause_held = true; // A key still down from the menu doesn't pause
+    
+    // The simulation thread is started once a piece is in play
+    state->sim = stage->resources;
+    state->last_tick_time = get_clock_ticks_ms();
+    state->tick_accumulator_ms = 0;
+    piece_motion_reset(&state->piece_motion);
     
     // Initialize controller
     blocktris_controller_init(&state->controller);
     
     stage->state = state;
     
-    // Reset game state for new game
-    game_reset(game);
+    // Carry on with a restored game (paused until S is pressed), or start a new one
+    if (game->resume_pending) {
+        game->resume_pending = false;
+    } else {
+        game_reset(game);
+    }
     game->current_screen = SCREEN_PLAYING;
     
     // Don't spawn first piece immediately - wait for big "3" to finish
@@ -68,15 +287,26 @@ game_stage_action_t playing_stage_update(stage_t *stage) {
     // Update keyboard state
     game->keyboard_state.keys = SDL_GetKeyboardState(NULL);
     
-    // Check for quit
+    // Check for quit, saving the game to resume at the next start
     if (is_esc_key_pressed(&game->keyboard_state)) {
+        stop_sim(state);
+        game_save_snapshot(game);
         return QUIT;
     }
     
-    // Check for pause
-    if (is_s_key_pressed(&game->keyboard_state)) {
+    // Check for pause, once per press, saving the game in case it isn't picked
+    // up again; the game is taken back from the thread first, which restarts
+    // once unpaused
+    bool pause_pressed = is_s_key_pressed(&game->keyboard_state);
+    bool pause_toggled = pause_pressed && !state->pause_held;
+    state->pause_held = pause_pressed;
+    if (pause_toggled) {
+        stop_sim(state);
         game->paused = !game->paused;
         game->current_screen = game->paused ? SCREEN_PAUSED : SCREEN_PLAYING;
+        if (game->paused) {
+            game_save_snapshot(game);
+        }
     }
     
     // Handle countdown display if active
@@ -86,22 +316,22 @@ game_stage_action_t playing_stage_update(stage_t *stage) {
     
     // Only update game logic if not paused and countdown is not showing
     if (!game->paused && !game->show_countdown) {
-        // Update controller
-        blocktris_controller_update(&state->controller, game, &game->keyboard_state);
-        
-        // Update game logic
-        playing_stage_update_game_logic(state);
-        
-        // Check for game over
-        if (game_board_is_game_over(&game->board)) {
-            state->game_over_requested = true;
-            game->current_screen = SCREEN_GAME_OVER;
-            return PROGRESS;
+        start_sim(state);
+        if (state->sim && state->sim->thread) {
+            if (SDL_AtomicGet(&state->sim->game_over)) {
+                stop_sim(state);
+                return finish_game(state);
+            }
+        } else if (!playing_stage_advance(state, &game->keyboard_state)) {
+            return finish_game(state);
         }
+    } else {
+        // The simulation clock stands still while paused or counting down
+        state->last_tick_time = get_clock_ticks_ms();
     }
     
-    // Render game
-    blocktris_renderer_render_game(game, &game->graphics_context);
+    // Render the latest state of the game
+    blocktris_renderer_render_game(scene_to_render(state), &game->layout, &game->graphics_context);
     
     // If paused, draw pause indicator
     if (game->paused) {
@@ -122,100 +352,74 @@ void playing_stage_cleanup(stage_t *stage) {
     }
     
     if (stage->state) {
-        free(stage->state);
+        playing_stage_state_t *state = (playing_stage_state_t *)stage->state;
+        stop_sim(state);
+        
+        stage_arena_reset(stage->arena);
         stage->state = NULL;
     }
 }
 
-void playing_stage_update_game_logic(playing_stage_state_t *state) {
-    if (!state) {
+void playing_stage_destroy(stage_t *stage) {
+    if (!stage || !stage->resources) {
         return;
     }
     
-    // Update line clear effect
-    playing_stage_update_line_clear_effect(state);
-    
-    // Don't update falling pieces during line clear effect
-    if (state->game->line_clear_active) {
-        return;
-    }
-    
-    // Handle piece falling
-    playing_stage_handle_piece_fall(state);
+    playing_sim_t *sim = (playing_sim_t *)stage->resources;
+    SDL_DestroySemaphore(sim->wake);
+    free(sim);
+    stage->resources = NULL;
 }
 
-void playing_stage_handle_piece_fall(playing_stage_state_t *state) {
-    if (!state || state->game->current_piece_type == PIECE_EMPTY) {
-        return;
+bool playing_stage_advance(playing_stage_state_t *state, keyboard_state_t *keyboard) {
+    if (!state || !keyboard) {
+        return false;
     }
     
-    timestamp_ms_t current_time = get_clock_ticks_ms();
+    // Update game logic
+    playing_stage_update_game_logic(state, keyboard);
     
-    // Check if piece should fall
-    if (current_time - state->last_fall_time >= (timestamp_ms_t)state->game->fall_speed) {
-        if (blocktris_collision_can_fall(&state->game->board, 
-                                     state->game->current_piece_type,
-                                     state->game->current_piece_rotation,
-                                     state->game->current_piece_x,
-                                     state->game->current_piece_y)) {
-            // Piece can fall
-            state->game->current_piece_y++;
-            state->last_fall_time = current_time;
-        } else {
-            // Piece has landed
-            playing_stage_handle_piece_placement(state);
-        }
-    }
+    return !state->game->sim.game_over;
 }
 
-void playing_stage_spawn_new_piece(playing_stage_state_t *state) {
-    if (!state) {
+void playing_stage_update_game_logic(playing_stage_state_t *state, keyboard_state_t *keyboard) {
+    if (!state || !keyboard) {
         return;
     }
     
-    game_ptr game = state->game;
-    
-    // If we have a next piece, use it, otherwise generate random
-    if (game->next_piece_type != PIECE_EMPTY) {
-        game->current_piece_type = game->next_piece_type;
-    } else {
-        game->current_piece_type = blocktris_piece_random_type();
-    }
-    
-    // Generate next piece
-    game->next_piece_type = blocktris_piece_random_type();
-    
-    // Reset piece position and rotation
-    game->current_piece_x = BOARD_WIDTH / 2 - 2;
-    game->current_piece_y = 0;
-    game->current_piece_rotation = 0;
-    
-    // Reset fall speed if it was modified by soft drop
-    game->fall_speed = INITIAL_FALL_SPEED - (game->level - 1) * SPEED_INCREASE_PER_LEVEL;
-    if (game->fall_speed < FAST_FALL_SPEED) {
-        game->fall_speed = FAST_FALL_SPEED;
+    // Convert the real time since the last frame into fixed simulation ticks
+    timestamp_ms_t current_time = get_clock_ticks_ms();
+    state->tick_accumulator_ms += current_time - state->last_tick_time;
+    state->last_tick_time = current_time;
+    
+    int ticks = 0;
+    while (state->tick_accumulator_ms >= SIM_TICK_MS && !state->game->sim.game_over) {
+        state->tick_accumulator_ms -= SIM_TICK_MS;
+        if (ticks++ < MAX_SIM_TICKS_PER_FRAME) {
+            take_tick_keys(state, keyboard);
+            playing_stage_step(state, blocktris_controller_update(&state->controller, keyboard));
+        }
     }
 }
 
-void playing_stage_handle_piece_placement(playing_stage_state_t *state) {
+void playing_stage_step(playing_stage_state_t *state, sim_input_t input) {
     if (!state) {
         return;
     }
     
     game_ptr game = state->game;
+    blocktris_sim_step(&game->sim, input);
+    
+    // Log the points awarded, and hash every placement to identify the game
+    const sim_events_t *events = &game->sim.events;
+    blocktris_score_log_events(&game->score_log, events);
+    if (events->flags & SIM_EVENT_LOCKED) {
+        const blocktris_piece_t *piece = &events->locked;
+        game->replay_hash = high_scores_hash_placement(game->replay_hash, piece->type, piece->rotation,
+                                                       piece->x, piece->y);
+    }
     
-    // Place piece on board
-    game_board_place_piece(&game->board, 
-                          game->current_piece_type,
-                          game->current_piece_rotation,
-                          game->current_piece_x,
-                          game->current_piece_y);
-    
-    // Check for line clearing
-    playing_stage_handle_line_clearing(state);
-    
-    // Spawn new piece
-    playing_stage_spawn_new_piece(state);
+    game_show_sim(game);
 }
 
 void playing_stage_update_countdown(playing_stage_state_t *state) {
@@ -230,79 +434,8 @@ void playing_stage_update_countdown(playing_stage_state_t *state) {
     const int total_countdown_duration_ms = 2000;
     
     if (elapsed >= total_countdown_duration_ms) {
-        // Countdown finished - hide countdown and start the game
+        // Countdown finished - hide countdown and show the first piece
         state->game->show_countdown = false;
-        playing_stage_spawn_new_piece(state);
+        game_show_sim(state->game);
     }
 }
-
-void playing_stage_handle_line_clearing(playing_stage_state_t *state) {
-    if (!state) {
-        return;
-    }
-    
-    game_ptr game = state->game;
-    
-    // Find complete lines
-    int complete_lines[4];
-    int num_lines = game_board_find_complete_lines(&game->board, complete_lines);
-    
-    if (num_lines > 0) {
-        // Set up line clear effect
-        game->line_clear_active = true;
-        game->line_clear_start_time = get_clock_ticks_ms();
-        game->num_lines_to_clear = num_lines;
-        
-        for (int i = 0; i < num_lines; i++) {
-            game->lines_to_clear[i] = complete_lines[i];
-        }
-        
-        // Update score based on number of lines
-        int points = 0;
-        switch (num_lines) {
-            case 1:
-                points = POINTS_SINGLE_LINE;
-                break;
-            case 2:
-                points = POINTS_DOUBLE_LINE;
-                break;
-            case 3:
-                points = POINTS_TRIPLE_LINE;
-                break;
-            case 4:
-                points = POINTS_TETRIS;
-                break;
-        }
-        game->score += points * game->level;
-        
-        // Update lines cleared count
-        game->lines_cleared += num_lines;
-        
-        // Update level (every 10 lines)
-        game->level = (game->lines_cleared / 10) + 1;
-    }
-}
-
-void playing_stage_update_line_clear_effect(playing_stage_state_t *state) {
-    if (!state || !state->game->line_clear_active) {
-        return;
-    }
-    
-    timestamp_ms_t current_time = get_clock_ticks_ms();
-    timestamp_ms_t elapsed = current_time - state->game->line_clear_start_time;
-    
-    if (elapsed >= LINE_CLEAR_DELAY) {
-        // Clear the lines and end effect
-        game_board_clear_lines(&state->game->board, 
-                              state->game->lines_to_clear, 
-                              state->game->num_lines_to_clear);
-        
-        // Reset line clear state
-        state->game->line_clear_active = false;
-        state->game->num_lines_to_clear = 0;
-        for (int i = 0; i < 4; i++) {
-            state->game->lines_to_clear[i] = -1;
-        }
-    }
-}
-
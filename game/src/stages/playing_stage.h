@@ -3,6 +3,19 @@
  * @brief BlockTris playing stage
  *
  * Handles the main game play where the actual BlockTris game runs.
+ *
+ * The rules are those of blocktris_sim, stepped on the game's simulation.
+ * While a game is in play, input, gravity and locking run on a simulation
+ * thread of their own, so a slow present never delays them. Every key press
+ * and release reaches the thread through a lock-free queue as SDL delivers
+ * it, and the thread replays them a tick at a time; the main thread draws
+ * the latest game state the thread published through a lock-free triple
+ * buffer. The thread only runs while the game is live: pausing, quitting and
+ * game over stop it before the game is touched, so saving and the countdown
+ * work on the game directly.
+ *
+ * Either way the falling piece is drawn between the last two states it was
+ * in, so it moves smoothly at any frame rate (see piece_motion.h).
  */
 
 #ifndef BLOCKTRIS_PLAYING_STAGE_H_
@@ -10,14 +23,50 @@
 
 #include "stage.h"
 #include "blocktris_controller.h"
+#include "game_snapshot.h"
+#include "triple_buffer.h"
+#include "key_event_queue.h"
+#include "piece_motion.h"
+
+/**
+ * Game state published by the simulation thread
+ */
+typedef struct {
+    game_snapshot_t game;
+    int piece_position;       // Fixed-point row of the falling piece (piece_motion_position)
+    timestamp_ms_t tick_time; // Real time the state's last tick was due
+} playing_frame_t;
+
+/**
+ * Simulation thread of the playing stage, allocated on the heap once, when
+ * the stage is created, and reused by every game: the published states and
+ * the mirror game drawn from them are far more than a stage arena holds
+ */
+typedef struct {
+    SDL_Thread *thread;     // NULL while the stage steps the game itself
+    SDL_sem *wake;          // Posted to stop the thread
+    SDL_atomic_t running;   // Cleared to stop the thread
+    SDL_atomic_t game_over; // Set by the thread once the stack tops out
+    key_event_queue_t key_events;  // Key presses and releases, main thread to simulation
+    Uint8 keys[SDL_NUM_SCANCODES]; // Keyboard state as of the last tick (simulation thread only)
+    playing_frame_t frames[TRIPLE_BUFFER_SLOTS]; // Game states, simulation to main thread
+    triple_buffer_t frame_buffer;
+    game_t view; // Mirror of the game, set from the latest frame and drawn instead of it
+} playing_sim_t;
+
+typedef playing_sim_t *playing_sim_ptr;
 
 /**
  * Playing stage state
  */
 typedef struct {
     game_ptr game; // Reference to game context
+    playing_sim_t *sim; // The stage's simulation thread, NULL if it can't run: the stage then steps the game itself
     blocktris_controller_t controller;
-    timestamp_ms_t last_fall_time;
+    timestamp_ms_t last_tick_time;      // Real time simulation ticks were last run up to
+    timestamp_ms_t tick_accumulator_ms; // Real time not yet consumed by simulation ticks
+    piece_motion_t piece_motion;        // Falling piece between the last two states drawn
+    bool pause_held;                    // S was down last frame; pause toggles once per press
     bool game_over_requested;
 } playing_stage_state_t;
 
@@ -39,34 +88,38 @@ game_stage_action_t playing_stage_update(stage_t *stage);
 void playing_stage_cleanup(stage_t *stage);
 
 /**
- * Update game logic (piece falling, line clearing, etc.)
- */
-void playing_stage_update_game_logic(playing_stage_state_t *state);
-
-/**
- * Handle piece falling
- */
-void playing_stage_handle_piece_fall(playing_stage_state_t *state);
-
-/**
- * Spawn a new piece
+ * Release the simulation thread's state the stage keeps across entries
  */
-void playing_stage_spawn_new_piece(playing_stage_state_t *state);
+void playing_stage_destroy(stage_t *stage);
 
 /**
- * Handle piece placement when it can't fall further
+ * Process input and run the simulation up to the current time; runs on the
+ * simulation thread while it exists
+ *
+ * @param state Playing stage state
+ * @param keyboard Keyboard state to take the input from
+ * @return false once the game is over
  */
-void playing_stage_handle_piece_placement(playing_stage_state_t *state);
+bool playing_stage_advance(playing_stage_state_t *state, keyboard_state_t *keyboard);
 
 /**
- * Check and handle line clearing
+ * Run as many simulation ticks as real time has elapsed, each with the
+ * input the controller takes from the keyboard state; on the simulation
+ * thread, the keyboard state takes the queued key presses and releases
+ * of each tick before it runs
+ *
+ * @param state Playing stage state
+ * @param keyboard Keyboard state to take the input from
  */
-void playing_stage_handle_line_clearing(playing_stage_state_t *state);
+void playing_stage_update_game_logic(playing_stage_state_t *state, keyboard_state_t *keyboard);
 
 /**
- * Update line clear effect
+ * Advance the game's simulation by one tick, logging its points and placements
+ *
+ * @param state Playing stage state
+ * @param input SIM_INPUT_* flags for the tick
  */
-void playing_stage_update_line_clear_effect(playing_stage_state_t *state);
+void playing_stage_step(playing_stage_state_t *state, sim_input_t input);
 
 /**
  * Update countdown display before game starts (3, 2)
@@ -4,7 +4,6 @@
  */
 
 #include "stage.h"
-#include <stdlib.h>
 
 void destroy_stage(stage_ptr stage) {
     if (!stage) {
@@ -14,6 +13,14 @@ void destroy_stage(stage_ptr stage) {
     if (stage->cleanup) {
         stage->cleanup(stage);
     }
+    if (stage->destroy) {
+        stage->destroy(stage);
+    }
+    stage->resources = NULL;
     
-    free(stage);
+    // Drop the stage itself too; its arena is reused as a whole
+    stage_arena_ptr arena = stage->arena;
+    if (arena) {
+        stage_arena_init(arena, arena->memory, arena->capacity);
+    }
 }
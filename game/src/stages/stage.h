@@ -11,29 +11,35 @@
 #define BLOCKTRIS_STAGE_H_
 
 #include "game.h"
+#include "stage_arena.h"
 
 // game_ptr is defined in game.h
 
 struct stage_t {
-    void *state; // Stage-specific state
+    void *state; // Stage-specific state, allocated from the stage arena
+    stage_arena_ptr arena; // Arena holding the stage and its state
+    void *resources; // Heap memory the stage reuses on every entry, NULL if none
 
     void (*init)(stage_t *stage, game_ptr game);
     game_stage_action_t (*update)(stage_t *stage);
     void (*cleanup)(stage_t *stage);
+    void (*destroy)(stage_t *stage); // Releases the resources, NULL if there are none
 
     const char *name; // For debugging
 };
 
 typedef stage_t *stage_ptr;
 
-// Factory functions for creating stages
-stage_ptr create_intro_stage_instance(void);
-stage_ptr create_menu_stage_instance(void);
-stage_ptr create_playing_stage_instance(void);
-stage_ptr create_game_over_stage_instance(void);
-stage_ptr create_paused_stage_instance(void);
+// Factory functions for creating stages inside their arena
+stage_ptr create_intro_stage_instance(stage_arena_ptr arena);
+stage_ptr create_menu_stage_instance(stage_arena_ptr arena);
+stage_ptr create_playing_stage_instance(stage_arena_ptr arena);
+stage_ptr create_game_over_stage_instance(stage_arena_ptr arena);
+stage_ptr create_paused_stage_instance(stage_arena_ptr arena);
+stage_ptr create_versus_stage_instance(stage_arena_ptr arena);
+stage_ptr create_online_stage_instance(stage_arena_ptr arena);
 
-// Common stage operations
+// Common stage operations (the stage memory itself belongs to its arena)
 void destroy_stage(stage_ptr stage);
 
 #endif // BLOCKTRIS_STAGE_H_
@@ -0,0 +1,50 @@
+/**
+ * @file stage_arena.c
+ * @brief Fixed-size bump allocator for stage state implementation
+ */
+
+#include "stage_arena.h"
+
+#define ALIGN_UP(size) (((size) + STAGE_ARENA_ALIGNMENT - 1) & ~(size_t)(STAGE_ARENA_ALIGNMENT - 1))
+
+void stage_arena_init(stage_arena_ptr arena, void *memory, size_t capacity) {
+    if (!arena) {
+        return;
+    }
+    
+    arena->memory = memory;
+    arena->capacity = memory ? capacity : 0;
+    arena->used = 0;
+    arena->reset_mark = 0;
+}
+
+void *stage_arena_alloc(stage_arena_ptr arena, size_t size) {
+    if (!arena || size == 0) {
+        return NULL;
+    }
+    
+    size_t aligned_size = ALIGN_UP(size);
+    if (aligned_size < size || aligned_size > arena->capacity - arena->used) {
+        return NULL;
+    }
+    
+    void *ptr = arena->memory + arena->used;
+    arena->used += aligned_size;
+    return ptr;
+}
+
+void stage_arena_keep(stage_arena_ptr arena) {
+    if (!arena) {
+        return;
+    }
+    
+    arena->reset_mark = arena->used;
+}
+
+void stage_arena_reset(stage_arena_ptr arena) {
+    if (!arena) {
+        return;
+    }
+    
+    arena->used = arena->reset_mark;
+}
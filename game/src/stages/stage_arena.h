@@ -0,0 +1,67 @@
+/**
+ * @file stage_arena.h
+ * @brief Fixed-size bump allocator for stage state
+ *
+ * Each stage gets an arena carved out of a block the stage director
+ * reserves once at startup. A stage allocates its state from the arena on
+ * init and cleanup simply resets it, so screen transitions never touch the
+ * heap.
+ */
+
+#ifndef BLOCKTRIS_STAGE_ARENA_H_
+#define BLOCKTRIS_STAGE_ARENA_H_
+
+#include <stddef.h>
+
+/**
+ * Bytes reserved for each stage (stage_t plus its state)
+ */
+#define STAGE_ARENA_SIZE 1024
+
+/**
+ * Alignment of every arena allocation
+ */
+#define STAGE_ARENA_ALIGNMENT 16
+
+typedef struct {
+    unsigned char *memory;
+    size_t capacity;
+    size_t used;
+    size_t reset_mark; // Allocations below this offset survive stage_arena_reset
+} stage_arena_t;
+
+typedef stage_arena_t *stage_arena_ptr;
+
+/**
+ * Initialize an arena over a block of memory
+ *
+ * @param arena Arena to initialize
+ * @param memory Block aligned to STAGE_ARENA_ALIGNMENT (not owned by the arena)
+ * @param capacity Size of the block in bytes
+ */
+void stage_arena_init(stage_arena_ptr arena, void *memory, size_t capacity);
+
+/**
+ * Allocate from the arena
+ *
+ * @param arena Arena to allocate from
+ * @param size Number of bytes
+ * @return Pointer aligned to STAGE_ARENA_ALIGNMENT, or NULL if the arena is full
+ */
+void *stage_arena_alloc(stage_arena_ptr arena, size_t size);
+
+/**
+ * Keep everything allocated so far across resets
+ *
+ * @param arena Arena to update
+ */
+void stage_arena_keep(stage_arena_ptr arena);
+
+/**
+ * Release every allocation made since the last stage_arena_keep
+ *
+ * @param arena Arena to reset
+ */
+void stage_arena_reset(stage_arena_ptr arena);
+
+#endif // BLOCKTRIS_STAGE_ARENA_H_
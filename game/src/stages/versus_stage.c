@@ -0,0 +1,386 @@
+/**
+ * @file versus_stage.c
+ * @brief BlockTris local two-player versus stage implementation
+ */
+
+#include "versus_stage.h"
+#include "keyboard.h"
+#include "events.h"
+#include "blocktris_renderer.h"
+#include "clock.h"
+#include "constants.h"
+#include "frame.h"
+
+const versus_key_map_t VERSUS_KEY_MAPS[VERSUS_PLAYERS] = {
+    { SDL_SCANCODE_A, SDL_SCANCODE_D, SDL_SCANCODE_W, SDL_SCANCODE_S, SDL_SCANCODE_SPACE, SDL_SCANCODE_LSHIFT },
+    { SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT, SDL_SCANCODE_UP, SDL_SCANCODE_DOWN, SDL_SCANCODE_RCTRL, SDL_SCANCODE_RSHIFT }
+};
+
+static const char *const PLAYER_LABELS[VERSUS_PLAYERS] = { "P1", "P2" };
+
+stage_ptr create_versus_stage_instance(stage_arena_ptr arena) {
+    stage_ptr stage = stage_arena_alloc(arena, sizeof(stage_t));
+    if (!stage) {
+        return NULL;
+    }
+    
+    stage->state = NULL;
+    stage->arena = arena;
+    stage->resources = NULL;
+    stage->init = versus_stage_init;
+    stage->update = versus_stage_update;
+    stage->cleanup = versus_stage_cleanup;
+    stage->destroy = NULL;
+    stage->name = "Versus Stage";
+    
+    return stage;
+}
+
+/**
+ * Step one player through the current batch and publish the result
+ */
+static void run_batch(versus_worker_t *worker) {
+    for (int i = 0; i < worker->ticks; i++) {
+        sim_input_t input = i == 0 ? worker->input : (sim_input_t)(worker->input & SIM_INPUT_HELD_MASK);
+        versus_match_step_player(worker->match, worker->player, input);
+    }
+    
+    sim_view_buffer_publish(worker->views, &worker->match->players[worker->player].sim);
+}
+
+static int worker_main(void *data) {
+    versus_worker_t *worker = (versus_worker_t *)data;
+    
+    // The semaphores order the batch fields written by the main thread before each wake-up
+    for (;;) {
+        SDL_SemWait(worker->work_ready);
+        if (worker->quit) {
+            break;
+        }
+        
+        run_batch(worker);
+        SDL_SemPost(worker->work_done);
+    }
+    
+    return 0;
+}
+
+static void start_workers(versus_stage_state_t *state) {
+    static const char *thread_names[VERSUS_PLAYERS] = { "versus_p1", "versus_p2" };
+    
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        versus_worker_t *worker = &state->workers[i];
+        worker->match = &state->match;
+        worker->views = &state->views[i];
+        worker->player = i;
+        worker->ticks = 0;
+        worker->input = 0;
+        worker->quit = false;
+        worker->thread = NULL;
+        worker->work_ready = SDL_CreateSemaphore(0);
+        worker->work_done = SDL_CreateSemaphore(0);
+        
+        // Without a thread the stage simply runs the batch itself
+        if (worker->work_ready && worker->work_done) {
+            worker->thread = SDL_CreateThread(worker_main, thread_names[i], worker);
+        }
+    }
+}
+
+static void wait_for_batch(versus_stage_state_t *state) {
+    if (!state->batch_running) {
+        return;
+    }
+    
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        if (state->workers[i].thread) {
+            SDL_SemWait(state->workers[i].work_done);
+        }
+    }
+    state->batch_running = false;
+}
+
+static void stop_workers(versus_stage_state_t *state) {
+    wait_for_batch(state);
+    
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        versus_worker_t *worker = &state->workers[i];
+        if (worker->thread) {
+            worker->quit = true;
+            SDL_SemPost(worker->work_ready);
+            SDL_WaitThread(worker->thread, NULL);
+            worker->thread = NULL;
+        }
+        if (worker->work_ready) {
+            SDL_DestroySemaphore(worker->work_ready);
+            worker->work_ready = NULL;
+        }
+        if (worker->work_done) {
+            SDL_DestroySemaphore(worker->work_done);
+            worker->work_done = NULL;
+        }
+    }
+}
+
+/**
+ * Hand a batch of ticks to both players; runs on the workers when they exist
+ */
+static void start_batch(versus_stage_state_t *state, int ticks) {
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        versus_worker_t *worker = &state->workers[i];
+        worker->ticks = ticks;
+        worker->input = state->inputs[i].pending;
+        state->inputs[i].pending = 0;
+        
+        if (worker->thread) {
+            SDL_SemPost(worker->work_ready);
+        } else {
+            run_batch(worker);
+        }
+    }
+    state->batch_running = true;
+}
+
+/**
+ * Start a new match and publish its first views (workers must be idle)
+ */
+static void start_match(versus_stage_state_t *state) {
+    game_ptr game = state->game;
+    
+    versus_match_init(&state->match, &game->config, game_piece_seed(game));
+    versus_layout_calculate(&state->layout, &game->layout, state->match.players[0].sim.board.width,
+                            state->match.players[0].sim.board.height);
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        sim_view_buffer_publish(&state->views[i], &state->match.players[i].sim);
+        state->inputs[i].pending = 0;
+    }
+    
+    state->winner = VERSUS_NO_WINNER;
+    state->last_tick_time = get_clock_ticks_ms();
+    state->tick_accumulator_ms = 0;
+}
+
+void versus_input_reset(versus_input_t *input) {
+    if (!input) {
+        return;
+    }
+    
+    input->left_held = false;
+    input->right_held = false;
+    input->rotate_held = true;
+    input->hard_drop_held = true;
+    input->hold_held = true;
+    input->last_move_time = 0;
+    input->pending = 0;
+}
+
+void versus_input_sample(versus_input_t *input, const versus_key_map_t *keys, const Uint8 *key_states) {
+    if (!input || !keys || !key_states) {
+        return;
+    }
+    
+    timestamp_ms_t current_time = get_clock_ticks_ms();
+    bool can_repeat = current_time - input->last_move_time >= MOVE_REPEAT_DELAY;
+    
+    bool left = key_states[keys->left];
+    bool right = key_states[keys->right];
+    if (left && (!input->left_held || can_repeat)) {
+        input->pending |= SIM_INPUT_LEFT;
+        input->last_move_time = current_time;
+    }
+    if (right && (!input->right_held || can_repeat)) {
+        input->pending |= SIM_INPUT_RIGHT;
+        input->last_move_time = current_time;
+    }
+    input->left_held = left;
+    input->right_held = right;
+    
+    bool rotate = key_states[keys->rotate];
+    bool hard_drop = key_states[keys->hard_drop];
+    bool hold = key_states[keys->hold];
+    if (rotate && !input->rotate_held) {
+        input->pending |= SIM_INPUT_ROTATE_CW;
+    }
+    if (hard_drop && !input->hard_drop_held) {
+        input->pending |= SIM_INPUT_HARD_DROP;
+    }
+    if (hold && !input->hold_held) {
+        input->pending |= SIM_INPUT_HOLD;
+    }
+    input->rotate_held = rotate;
+    input->hard_drop_held = hard_drop;
+    input->hold_held = hold;
+    
+    // Soft drop follows the key state
+    if (key_states[keys->soft_drop]) {
+        input->pending |= SIM_INPUT_SOFT_DROP;
+    } else {
+        input->pending &= (sim_input_t)~SIM_INPUT_SOFT_DROP;
+    }
+}
+
+void versus_layout_calculate(versus_layout_t *layout, const game_layout_t *window, int board_width, int board_height) {
+    if (!layout || !window) {
+        return;
+    }
+    
+    int half_width = window->width / VERSUS_PLAYERS;
+    int columns = board_width + 7; // Meter, board and the next/hold/score panel
+    int rows = board_height + 3;   // Board plus room for the player labels
+    
+    int cell = window->cell_size;
+    if (half_width / columns < cell) {
+        cell = half_width / columns;
+    }
+    if (window->height / rows < cell) {
+        cell = window->height / rows;
+    }
+    if (cell < 2) {
+        cell = 2;
+    }
+    
+    layout->board_width = board_width;
+    layout->board_height = board_height;
+    layout->cell_size = cell;
+    layout->board_y = (window->height - board_height * cell) / 2 + cell;
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        layout->board_x[i] = half_width * i + (half_width - columns * cell) / 2 + cell;
+    }
+}
+
+void versus_render_boards(game_ptr game, const versus_layout_t *layout,
+                          const sim_view_buffer_t views[VERSUS_PLAYERS],
+                          const char *const labels[VERSUS_PLAYERS]) {
+    if (!game || !layout || !views || !labels) {
+        return;
+    }
+    
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        render_arcade_text_scaled(&game->arcade_font, &game->graphics_context, labels[i],
+                                  layout->board_x[i], layout->board_y - layout->cell_size * 2,
+                                  FONT_COLOR_CYAN, 2);
+        blocktris_renderer_render_sim_view(sim_view_buffer_front(&views[i]), &game->arcade_font,
+                                           layout->board_x[i], layout->board_y, layout->cell_size,
+                                           &game->layout, &game->graphics_context);
+    }
+}
+
+void versus_render_message(game_ptr game, const char *text) {
+    if (!game || !text) {
+        return;
+    }
+    
+    int scale = 4;
+    int width = get_arcade_text_width_scaled(&game->arcade_font, text, scale);
+    render_arcade_text_scaled(&game->arcade_font, &game->graphics_context, text,
+                              (game->layout.width - width) / 2, game->layout.height / 2,
+                              FONT_COLOR_YELLOW, scale);
+}
+
+void versus_stage_init(stage_t *stage, game_ptr game) {
+    if (!stage || !game) {
+        return;
+    }
+    
+    versus_stage_state_t *state = stage_arena_alloc(stage->arena, sizeof(versus_stage_state_t));
+    if (!state) {
+        return;
+    }
+    
+    state->game = game;
+    state->batch_running = false;
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        sim_view_buffer_init(&state->views[i]);
+        versus_input_reset(&state->inputs[i]); // Ignore keys still down from the menu
+    }
+    
+    start_match(state);
+    start_workers(state);
+    
+    stage->state = state;
+    game->current_screen = SCREEN_VERSUS;
+}
+
+game_stage_action_t versus_stage_update(stage_t *stage) {
+    if (!stage || !stage->state) {
+        return QUIT;
+    }
+    
+    versus_stage_state_t *state = (versus_stage_state_t *)stage->state;
+    game_ptr game = state->game;
+    
+    // Handle SDL events
+    handle_events(&game->event_system);
+    
+    // Update keyboard state
+    game->keyboard_state.keys = SDL_GetKeyboardState(NULL);
+    
+    // Check for quit
+    if (is_esc_key_pressed(&game->keyboard_state)) {
+        return QUIT;
+    }
+    
+    // The previous batch must be done before the match is read or stepped again
+    wait_for_batch(state);
+    
+    if (state->winner == VERSUS_NO_WINNER) {
+        state->winner = versus_match_winner(&state->match);
+    }
+    
+    if (state->winner == VERSUS_NO_WINNER) {
+        for (int i = 0; i < VERSUS_PLAYERS; i++) {
+            versus_input_sample(&state->inputs[i], &VERSUS_KEY_MAPS[i], game->keyboard_state.keys);
+        }
+        
+        // Convert the real time since the last frame into fixed simulation ticks
+        timestamp_ms_t current_time = get_clock_ticks_ms();
+        state->tick_accumulator_ms += current_time - state->last_tick_time;
+        state->last_tick_time = current_time;
+        
+        int ticks = (int)(state->tick_accumulator_ms / SIM_TICK_MS);
+        state->tick_accumulator_ms -= (timestamp_ms_t)ticks * SIM_TICK_MS;
+        if (ticks > MAX_SIM_TICKS_PER_FRAME) {
+            ticks = MAX_SIM_TICKS_PER_FRAME;
+        }
+        
+        // Both players step the same ticks while this frame is drawn
+        if (ticks > 0) {
+            start_batch(state, ticks);
+        }
+    } else if (is_space_key_pressed(&game->keyboard_state) || is_return_key_pressed(&game->keyboard_state)) {
+        start_match(state);
+    }
+    
+    // Render the last published views, fitted to the window as it is now
+    versus_layout_calculate(&state->layout, &game->layout, state->layout.board_width, state->layout.board_height);
+    clear_frame(&game->graphics_context);
+    blocktris_renderer_render_background(game, &game->layout, &game->graphics_context);
+    
+    versus_render_boards(game, &state->layout, state->views, PLAYER_LABELS);
+    
+    if (state->winner != VERSUS_NO_WINNER) {
+        versus_render_message(game, state->winner == VERSUS_DRAW ? "DRAW" :
+                                    state->winner == 0 ? "P1 WINS" : "P2 WINS");
+    }
+    
+    render_frame(&game->graphics_context);
+    
+    return PROGRESS;
+}
+
+void versus_stage_cleanup(stage_t *stage) {
+    if (!stage) {
+        return;
+    }
+    
+    if (stage->state) {
+        versus_stage_state_t *state = (versus_stage_state_t *)stage->state;
+        stop_workers(state);
+        for (int i = 0; i < VERSUS_PLAYERS; i++) {
+            sim_view_buffer_cleanup(&state->views[i]);
+        }
+        
+        stage_arena_reset(stage->arena);
+        stage->state = NULL;
+    }
+}
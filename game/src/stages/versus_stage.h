@@ -0,0 +1,163 @@
+/**
+ * @file versus_stage.h
+ * @brief BlockTris local two-player versus stage
+ *
+ * Two players share the keyboard and play side by side on their own boards;
+ * lines cleared by one player push garbage rows under the other player's
+ * stack. Each player's simulation is stepped on its own worker thread, one
+ * batch of ticks per frame, and publishes a render view when the batch is
+ * done. The stage draws the last published views while the workers run the
+ * next batch.
+ */
+
+#ifndef BLOCKTRIS_VERSUS_STAGE_H_
+#define BLOCKTRIS_VERSUS_STAGE_H_
+
+#include "stage.h"
+#include "versus_match.h"
+#include "sim_view.h"
+
+/**
+ * Arena size for the versus stage (two full simulations)
+ */
+#define VERSUS_STAGE_ARENA_SIZE (16 * 1024)
+
+/**
+ * Worker stepping one player's simulation
+ */
+typedef struct {
+    versus_match_t *match;
+    sim_view_buffer_t *views;
+    int player;
+    int ticks;          // Ticks in the current batch
+    sim_input_t input;  // Actions for the first tick of the batch (held inputs apply to all)
+    bool quit;          // Set before the last wake-up to stop the thread
+    SDL_Thread *thread; // NULL when batches run on the main thread instead
+    SDL_sem *work_ready;
+    SDL_sem *work_done;
+} versus_worker_t;
+
+/**
+ * Keys of one player (SDL scancodes)
+ */
+typedef struct {
+    int left;
+    int right;
+    int rotate;
+    int soft_drop;
+    int hard_drop;
+    int hold;
+} versus_key_map_t;
+
+// Player 1 plays on the left with WASD, player 2 on the right with the arrows
+extern const versus_key_map_t VERSUS_KEY_MAPS[VERSUS_PLAYERS];
+
+/**
+ * Keyboard input of one player
+ */
+typedef struct {
+    bool left_held;
+    bool right_held;
+    bool rotate_held;
+    bool hard_drop_held;
+    bool hold_held;
+    timestamp_ms_t last_move_time;
+    sim_input_t pending; // Actions not yet handed to a batch
+} versus_input_t;
+
+/**
+ * Screen positions of the two boards
+ */
+typedef struct {
+    int board_width;  // Boards laid out, in cells
+    int board_height;
+    int cell_size; // Board cell size, smaller than single-player to fit two boards
+    int board_x[VERSUS_PLAYERS];
+    int board_y;
+} versus_layout_t;
+
+/**
+ * Versus stage state
+ */
+typedef struct {
+    game_ptr game; // Reference to game context
+    versus_match_t match;
+    sim_view_buffer_t views[VERSUS_PLAYERS];
+    versus_worker_t workers[VERSUS_PLAYERS];
+    versus_input_t inputs[VERSUS_PLAYERS];
+    timestamp_ms_t last_tick_time;      // Real time simulation ticks were last run up to
+    timestamp_ms_t tick_accumulator_ms; // Real time not yet consumed by simulation ticks
+    bool batch_running; // Workers are stepping a batch
+    int winner;         // VERSUS_NO_WINNER while the match is on
+    versus_layout_t layout;
+} versus_stage_state_t;
+
+typedef versus_stage_state_t *versus_stage_state_ptr;
+
+/**
+ * Reset a player's input, treating action keys as held so keys still down
+ * from the previous screen don't fire
+ *
+ * @param input Pointer to the input to reset
+ */
+void versus_input_reset(versus_input_t *input);
+
+/**
+ * Turn a player's keys into sim actions, accumulated in input->pending:
+ * moves repeat while held, the other actions fire once per press
+ *
+ * @param input Pointer to the player's input
+ * @param keys The player's keys
+ * @param key_states SDL keyboard state
+ */
+void versus_input_sample(versus_input_t *input, const versus_key_map_t *keys, const Uint8 *key_states);
+
+/**
+ * Fit both boards side by side, each with its garbage meter and side panel
+ *
+ * The cells are never larger than the window layout's, and the boards are
+ * laid out again whenever the window's layout changes.
+ *
+ * @param layout Pointer to the layout to calculate
+ * @param window Window layout to fit the boards in
+ * @param board_width Board width in cells
+ * @param board_height Board height in cells
+ */
+void versus_layout_calculate(versus_layout_t *layout, const game_layout_t *window, int board_width, int board_height);
+
+/**
+ * Draw both players' last published views with their labels
+ *
+ * @param game Game context
+ * @param layout Board positions
+ * @param views View buffer of each player
+ * @param labels Label drawn above each board
+ */
+void versus_render_boards(game_ptr game, const versus_layout_t *layout,
+                          const sim_view_buffer_t views[VERSUS_PLAYERS],
+                          const char *const labels[VERSUS_PLAYERS]);
+
+/**
+ * Draw a large message across the middle of the screen
+ *
+ * @param game Game context
+ * @param text Message text
+ */
+void versus_render_message(game_ptr game, const char *text);
+
+/**
+ * Initialize versus stage
+ */
+void versus_stage_init(stage_t *stage, game_ptr game);
+
+/**
+ * Update versus stage
+ */
+game_stage_action_t versus_stage_update(stage_t *stage);
+
+/**
+ * Cleanup versus stage
+ */
+void versus_stage_cleanup(stage_t *stage);
+
+#endif // BLOCKTRIS_VERSUS_STAGE_H_
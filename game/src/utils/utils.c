@@ -0,0 +1,56 @@
+/**
+ * @file utils.c
+ * @brief Shared helpers implementation
+ */
+
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FNV32_PRIME 16777619u
+#define FNV64_PRIME 0x100000001B3ULL
+
+uint32_t utils_crc32(uint32_t crc, const void *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+uint32_t utils_fnv1a_32(uint32_t hash, const void *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV32_PRIME;
+    }
+    return hash;
+}
+
+uint64_t utils_fnv1a_64(uint64_t hash, const void *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV64_PRIME;
+    }
+    return hash;
+}
+
+bool utils_parse_int_option(const char *name, const char *value, int min_value, int max_value, int *out) {
+    if (!value) {
+        printf("Missing value for %s\n", name);
+        return false;
+    }
+    
+    char *end = NULL;
+    long parsed = strtol(value, &end, 10);
+    if (end == value || *end != '\0' || parsed < min_value || parsed > max_value) {
+        printf("Invalid value for %s: %s (expected %d-%d)\n", name, value, min_value, max_value);
+        return false;
+    }
+    
+    *out = (int)parsed;
+    return true;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file utils.h
+ * @brief Small helpers shared across the game: byte order, checksums,
+ * hashing, option parsing and random numbers
+ *
+ * Files are little-endian and network packets and server frames
+ * big-endian, so both byte orders are here. The byte-order helpers and the
+ * random step are inline, as they sit in encoding and simulation loops.
+ */
+
+#ifndef BLOCKTRIS_UTILS_H_
+#define BLOCKTRIS_UTILS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// FNV-1a offset bases, the hash of no bytes
+#define UTILS_FNV32_OFFSET_BASIS 2166136261u
+#define UTILS_FNV64_OFFSET_BASIS 0xCBF29CE484222325ULL
+
+static inline void utils_write_u16_le(uint8_t *out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static inline void utils_write_u32_le(uint8_t *out, uint32_t value) {
+    utils_write_u16_le(out, value);
+    utils_write_u16_le(out + 2, value >> 16);
+}
+
+static inline void utils_write_u64_le(uint8_t *out, uint64_t value) {
+    utils_write_u32_le(out, (uint32_t)value);
+    utils_write_u32_le(out + 4, (uint32_t)(value >> 32));
+}
+
+static inline uint32_t utils_read_u16_le(const uint8_t *in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8);
+}
+
+static inline uint32_t utils_read_u32_le(const uint8_t *in) {
+    return utils_read_u16_le(in) | (utils_read_u16_le(in + 2) << 16);
+}
+
+static inline uint64_t utils_read_u64_le(const uint8_t *in) {
+    return (uint64_t)utils_read_u32_le(in) | ((uint64_t)utils_read_u32_le(in + 4) << 32);
+}
+
+static inline void utils_write_u16_be(uint8_t *out, uint32_t value) {
+    out[0] = (uint8_t)(value >> 8);
+    out[1] = (uint8_t)value;
+}
+
+static inline void utils_write_u32_be(uint8_t *out, uint32_t value) {
+    utils_write_u16_be(out, value >> 16);
+    utils_write_u16_be(out + 2, value);
+}
+
+static inline uint32_t utils_read_u16_be(const uint8_t *in) {
+    return ((uint32_t)in[0] << 8) | in[1];
+}
+
+static inline uint32_t utils_read_u32_be(const uint8_t *in) {
+    return (utils_read_u16_be(in) << 16) | utils_read_u16_be(in + 2);
+}
+
+/**
+ * xorshift64* step
+ *
+ * @param state Generator state, never zero
+ * @return Next 64-bit random value; the high bits are the best
+ */
+static inline uint64_t utils_next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * CRC-32 (reflected, polynomial 0xEDB88320), as used by zlib and PNG
+ *
+ * @param crc CRC of the bytes before, 0 to start
+ * @param data Bytes to add
+ * @param size Number of bytes
+ * @return CRC of everything so far
+ */
+uint32_t utils_crc32(uint32_t crc, const void *data, size_t size);
+
+/**
+ * 32-bit FNV-1a hash
+ *
+ * @param hash Hash of the bytes before, UTILS_FNV32_OFFSET_BASIS to start
+ * @param data Bytes to add
+ * @param size Number of bytes
+ * @return Hash of everything so far
+ */
+uint32_t utils_fnv1a_32(uint32_t hash, const void *data, size_t size);
+
+/**
+ * 64-bit FNV-1a hash
+ *
+ * @param hash Hash of the bytes before, UTILS_FNV64_OFFSET_BASIS to start
+ * @param data Bytes to add
+ * @param size Number of bytes
+ * @return Hash of everything so far
+ */
+uint64_t utils_fnv1a_64(uint64_t hash, const void *data, size_t size);
+
+/**
+ * Parse an integer command line option value within [min_value, max_value],
+ * printing why it was rejected
+ *
+ * @param name Option name, for the message
+ * @param value Option value, NULL if it was missing
+ * @param min_value Lowest value accepted
+ * @param max_value Highest value accepted
+ * @param out Parsed value, left alone on failure
+ * @return true if the value was valid
+ */
+bool utils_parse_int_option(const char *name, const char *value, int min_value, int max_value, int *out);
+
+#endif // BLOCKTRIS_UTILS_H_
@@ -0,0 +1,18 @@
+/**
+ * @file test_fixtures.c
+ * @brief Shared test setup implementation
+ */
+
+#include "test_fixtures.h"
+
+void test_make_config(game_config_t *config, int width, int height) {
+    game_config_init(config);
+    config->board_width = width;
+    config->board_height = height;
+}
+
+void test_make_instant_lock_config(game_config_t *config, int width, int height) {
+    test_make_config(config, width, height);
+    config->lock_delay_ms = 0;
+    config->lock_reset_limit = 0;
+}
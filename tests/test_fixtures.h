@@ -0,0 +1,23 @@
+/**
+ * @file test_fixtures.h
+ * @brief Setup shared by the test suites
+ */
+
+#ifndef TEST_FIXTURES_H
+#define TEST_FIXTURES_H
+
+#include "../game/src/main/game_config.h"
+
+/**
+ * Set up a game configuration for a test: the game's defaults, on a board
+ * of the given size
+ */
+void test_make_config(game_config_t *config, int width, int height);
+
+/**
+ * Set up a game configuration like test_make_config, with pieces locking
+ * as soon as they land
+ */
+void test_make_instant_lock_config(game_config_t *config, int width, int height);
+
+#endif // TEST_FIXTURES_H
@@ -4,18 +4,98 @@
  */
 
 #include "test_framework.h"
+#include "unit/test_utils.h"
 #include "unit/test_rotation.h"
 #include "unit/test_window_dimensions.h"
+#include "unit/test_game_board.h"
+#include "unit/test_stage_arena.h"
+#include "unit/test_piece_queue.h"
+#include "unit/test_lock_delay.h"
+#include "unit/test_score_log.h"
+#include "unit/test_sim.h"
+#include "unit/test_versus.h"
+#include "unit/test_netplay.h"
+#include "unit/test_server.h"
+#include "unit/test_spectator.h"
+#include "unit/test_snapshot.h"
+#include "unit/test_high_scores.h"
+#include "unit/test_background_cache.h"
+#include "unit/test_soft_raster.h"
+#include "unit/test_replay.h"
+#include "unit/test_line_clear_effect.h"
+#include "unit/test_triple_buffer.h"
+#include "unit/test_key_event_queue.h"
+#include "unit/test_piece_motion.h"
 
 int main(void) {
     test_init();
     
+    // Run shared helper tests
+    run_utils_tests();
+    
     // Run rotation tests
     run_rotation_tests();
     
     // Run window dimension tests
     run_window_dimension_tests();
     
+    // Run game board tests
+    run_game_board_tests();
+    
+    // Run stage arena tests
+    run_stage_arena_tests();
+    
+    // Run piece queue tests
+    run_piece_queue_tests();
+    
+    // Run lock delay tests
+    run_lock_delay_tests();
+    
+    // Run score log tests
+    run_score_log_tests();
+    
+    // Run simulation tests
+    run_sim_tests();
+    
+    // Run versus tests
+    run_versus_tests();
+    
+    // Run netplay tests
+    run_netplay_tests();
+    
+    // Run tournament server tests
+    run_server_tests();
+    
+    // Run spectator stream tests
+    run_spectator_tests();
+    
+    // Run saved game tests
+    run_snapshot_tests();
+    
+    // Run high-score table tests
+    run_high_scores_tests();
+    
+    // Run background cache tests
+    run_background_cache_tests();
+    
+    // Run software rasterizer tests
+    run_soft_raster_tests();
+    
+    // Run replay tests
+    run_replay_tests();
+    
+    // Run line-clear effect tests
+    run_line_clear_effect_tests();
+    
+    // Run triple buffer tests
+    run_triple_buffer_tests();
+    
+    // Run key event queue tests
+    run_key_event_queue_tests();
+    
+    // Run piece motion tests
+    run_piece_motion_tests();
+    
     test_summary();
     
     // Return non-zero if any tests failed (for CI/build systems)
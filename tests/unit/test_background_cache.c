@@ -0,0 +1,168 @@
+/**
+ * @file test_background_cache.c
+ * @brief Tests for the background cache: box-filtered shrinking, bilinear
+ * growing, and cache files that only load for the same image and size
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/rendering/background_cache.h"
+#include "test_background_cache.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_CACHE_DIR "test_background_cache"
+#define TEST_IMAGE_PATH "test_background_cache.img"
+
+#define PX BACKGROUND_CACHE_PIXEL_SIZE
+
+static void fill(uint8_t *pixels, int count, uint8_t value) {
+    memset(pixels, value, (size_t)count * PX);
+}
+
+static bool all_channels(const uint8_t *pixel, uint8_t value) {
+    for (int c = 0; c < PX; c++) {
+        if (pixel[c] != value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void write_file(const char *path, const char *contents) {
+    FILE *file = fopen(path, "wb");
+    if (file) {
+        fputs(contents, file);
+        fclose(file);
+    }
+}
+
+// Test that shrinking averages every source pixel under a target pixel
+void test_background_cache_shrink_averages(void) {
+    // 4x2 image: the left 2x2 block holds 0, 100, 200, 100; the right one is all 50
+    static const uint8_t values[8] = { 0, 100, 50, 50, 200, 100, 50, 50 };
+    uint8_t src[8 * PX];
+    for (int i = 0; i < 8; i++) {
+        fill(src + i * PX, 1, values[i]);
+    }
+    
+    uint8_t dst[2 * PX];
+    background_cache_resample(src, 4, 2, 4 * PX, dst, 2, 1, 2 * PX);
+    TEST_ASSERT(all_channels(dst, 100), "A target pixel is the mean of its footprint");
+    TEST_ASSERT(all_channels(dst + PX, 50), "A flat footprint stays flat");
+    
+    // A large, uneven shrink covers the whole source: a flat image stays flat everywhere
+    static uint8_t large[640 * 360 * PX];
+    static uint8_t small[71 * 37 * PX];
+    fill(large, 640 * 360, 77);
+    background_cache_resample(large, 640, 360, 640 * PX, small, 71, 37, 71 * PX);
+    bool flat = true;
+    for (int i = 0; i < 71 * 37; i++) {
+        flat &= all_channels(small + i * PX, 77);
+    }
+    TEST_ASSERT(flat, "Shrinking by an uneven factor keeps a flat image flat");
+}
+
+// Test that growing interpolates between neighbours and keeps the edges
+void test_background_cache_grow_interpolates(void) {
+    uint8_t src[2 * PX];
+    fill(src, 1, 0);
+    fill(src + PX, 1, 255);
+    
+    uint8_t dst[4 * PX];
+    background_cache_resample(src, 2, 1, 2 * PX, dst, 4, 1, 4 * PX);
+    TEST_ASSERT(all_channels(dst, 0) && all_channels(dst + 3 * PX, 255), "The edges keep the edge pixels");
+    TEST_ASSERT(all_channels(dst + PX, 64) && all_channels(dst + 2 * PX, 191),
+                "Inner pixels are weighted by distance");
+    
+    // Channels are resampled independently
+    uint8_t pixel[PX] = { 10, 20, 30, 40 };
+    uint8_t grown[3 * 3 * PX];
+    background_cache_resample(pixel, 1, 1, PX, grown, 3, 3, 3 * PX);
+    TEST_ASSERT(memcmp(grown + 4 * PX, pixel, PX) == 0 && memcmp(grown + 8 * PX, pixel, PX) == 0,
+                "Each channel keeps its own value");
+}
+
+// Test that cached pixels load back, into packed or padded rows
+void test_background_cache_round_trip(void) {
+    enum { WIDTH = 5, HEIGHT = 3, PITCH = WIDTH * PX + 12 };
+    uint8_t pixels[HEIGHT * PITCH];
+    for (int i = 0; i < (int)sizeof(pixels); i++) {
+        pixels[i] = (uint8_t)(i * 7);
+    }
+    
+    char path[BACKGROUND_CACHE_PATH_SIZE];
+    uint64_t hash = 0x0123456789ABCDEFULL;
+    TEST_ASSERT(background_cache_path(path, sizeof(path), TEST_CACHE_DIR, hash, WIDTH, HEIGHT),
+                "The cache path fits");
+    TEST_ASSERT(strstr(path, "0123456789abcdef-5x3") != NULL, "The path names the image hash and size");
+    TEST_ASSERT(background_cache_save(TEST_CACHE_DIR, path, hash, WIDTH, HEIGHT, pixels, PITCH),
+                "The cache directory is created and the file written");
+    
+    uint8_t padded[HEIGHT * PITCH];
+    memset(padded, 0, sizeof(padded));
+    TEST_ASSERT(background_cache_load(path, hash, WIDTH, HEIGHT, padded, PITCH), "The file loads into padded rows");
+    bool same = true;
+    for (int y = 0; y < HEIGHT; y++) {
+        same &= memcmp(padded + y * PITCH, pixels + y * PITCH, WIDTH * PX) == 0;
+    }
+    TEST_ASSERT(same, "Every pixel comes back");
+    
+    uint8_t packed[HEIGHT * WIDTH * PX];
+    TEST_ASSERT(background_cache_load(path, hash, WIDTH, HEIGHT, packed, WIDTH * PX) &&
+                memcmp(packed + WIDTH * PX, pixels + PITCH, WIDTH * PX) == 0,
+                "The file loads into packed rows");
+    
+    remove(path);
+    remove(TEST_CACHE_DIR);
+}
+
+// Test that a cache file is only used for the image and size it was made for
+void test_background_cache_rejects_stale_files(void) {
+    uint64_t first = 0;
+    uint64_t second = 0;
+    uint64_t again = 0;
+    write_file(TEST_IMAGE_PATH, "background v1");
+    background_cache_hash_file(TEST_IMAGE_PATH, &first);
+    background_cache_hash_file(TEST_IMAGE_PATH, &again);
+    write_file(TEST_IMAGE_PATH, "background v2");
+    background_cache_hash_file(TEST_IMAGE_PATH, &second);
+    TEST_ASSERT(first == again && first != second, "The hash follows the image file's contents");
+    remove(TEST_IMAGE_PATH);
+    TEST_ASSERT(!background_cache_hash_file(TEST_IMAGE_PATH, &first), "A missing image has no hash");
+    
+    uint8_t pixels[4 * 4 * PX];
+    fill(pixels, 16, 9);
+    char path[BACKGROUND_CACHE_PATH_SIZE];
+    background_cache_path(path, sizeof(path), TEST_CACHE_DIR, second, 4, 4);
+    background_cache_save(TEST_CACHE_DIR, path, second, 4, 4, pixels, 4 * PX);
+    
+    TEST_ASSERT(!background_cache_load(path, first, 4, 4, pixels, 4 * PX), "Another image's hash is refused");
+    TEST_ASSERT(!background_cache_load(path, second, 4, 3, pixels, 4 * PX), "Another size is refused");
+    
+    // Cut the file short, as a crash mid-write would
+    FILE *file = fopen(path, "r+b");
+    uint8_t header[BACKGROUND_CACHE_HEADER_SIZE];
+    size_t read = file ? fread(header, 1, sizeof(header), file) : 0;
+    if (file) {
+        fclose(file);
+    }
+    file = fopen(path, "wb");
+    if (file) {
+        fwrite(header, 1, read, file);
+        fclose(file);
+    }
+    TEST_ASSERT(!background_cache_load(path, second, 4, 4, pixels, 4 * PX), "A truncated file is refused");
+    
+    remove(path);
+    remove(TEST_CACHE_DIR);
+}
+
+// Main background cache test runner
+void run_background_cache_tests(void) {
+    printf("\n=== Background Cache Tests ===\n\n");
+    
+    RUN_TEST(test_background_cache_shrink_averages);
+    RUN_TEST(test_background_cache_grow_interpolates);
+    RUN_TEST(test_background_cache_round_trip);
+    RUN_TEST(test_background_cache_rejects_stale_files);
+}
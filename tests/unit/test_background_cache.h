@@ -0,0 +1,18 @@
+/**
+ * @file test_background_cache.h
+ * @brief Header for background cache tests (resampling and the disk cache)
+ */
+
+#ifndef TEST_BACKGROUND_CACHE_H
+#define TEST_BACKGROUND_CACHE_H
+
+// Test function declarations
+void test_background_cache_shrink_averages(void);
+void test_background_cache_grow_interpolates(void);
+void test_background_cache_round_trip(void);
+void test_background_cache_rejects_stale_files(void);
+
+// Main test runner function
+void run_background_cache_tests(void);
+
+#endif // TEST_BACKGROUND_CACHE_H
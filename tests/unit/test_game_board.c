@@ -0,0 +1,283 @@
+/**
+ * @file test_game_board.c
+ * @brief Tests for the game board bitboard and its kernels
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/entities/game_board.h"
+#include "../../game/src/entities/blocktris_piece.h"
+#include "../../game/src/entities/board_snapshot.h"
+#include "test_game_board.h"
+#include <stdlib.h>
+
+// Common widths (10, 12, 16) and odd ones up to the widest board
+static const int test_widths[] = { 10, 12, 16, 7, 33, 64 };
+static const int num_test_widths = sizeof(test_widths) / sizeof(test_widths[0]);
+
+// Reference collision test that walks the piece cells one by one
+static bool piece_fits_cell_scan(const game_board_t *board, piece_type_t type, int rotation,
+                                 int piece_x, int piece_y) {
+    for (int py = 0; py < PIECE_SIZE; py++) {
+        for (int px = 0; px < PIECE_SIZE; px++) {
+            if (blocktris_piece_is_cell_filled(type, rotation, px, py) &&
+                game_board_is_cell_filled(board, piece_x + px, piece_y + py)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Fill roughly a third of the bottom half of the board
+static void fill_random_cells(game_board_t *board, unsigned int seed) {
+    srand(seed);
+    for (int y = board->height / 2; y < board->height; y++) {
+        for (int x = 0; x < board->width; x++) {
+            if (rand() % 3 == 0) {
+                game_board_set_cell(board, x, y, PIECE_T, BOARD_CELL_LOCKED);
+            }
+        }
+    }
+}
+
+// Test that boards take their dimensions at runtime and clamp them
+void test_board_runtime_dimensions(void) {
+    static game_board_t board;
+    
+    game_board_init(&board, 16, 40);
+    TEST_ASSERT_EQUAL(16, board.width, "Board width set at runtime");
+    TEST_ASSERT_EQUAL(40, board.height, "Board height set at runtime");
+    TEST_ASSERT(game_board_is_position_valid(&board, 15, 39), "Bottom-right cell is valid");
+    TEST_ASSERT(!game_board_is_position_valid(&board, 16, 0), "Column past width is invalid");
+    
+    game_board_init(&board, MAX_BOARD_WIDTH + 10, 1);
+    TEST_ASSERT_EQUAL(MAX_BOARD_WIDTH, board.width, "Board width clamped to MAX_BOARD_WIDTH");
+    TEST_ASSERT_EQUAL(MIN_BOARD_HEIGHT, board.height, "Board height clamped to MIN_BOARD_HEIGHT");
+}
+
+// Test that the occupancy bitboard follows cell updates
+void test_board_bitboard_matches_cells(void) {
+    static game_board_t board;
+    
+    for (int i = 0; i < num_test_widths; i++) {
+        int width = test_widths[i];
+        game_board_init(&board, width, DEFAULT_BOARD_HEIGHT);
+        
+        game_board_set_cell(&board, 0, 5, PIECE_I, BOARD_CELL_LOCKED);
+        game_board_set_cell(&board, width - 1, 5, PIECE_I, BOARD_CELL_LOCKED);
+        game_board_clear_cell(&board, 0, 5);
+        
+        char test_msg[120];
+        snprintf(test_msg, sizeof(test_msg), "Width %d: bitboard row tracks set/clear", width);
+        TEST_ASSERT(board.rows[5] == ((board_row_t)1 << (width - 1)), test_msg);
+        
+        snprintf(test_msg, sizeof(test_msg), "Width %d: out-of-bounds cells read as filled", width);
+        TEST_ASSERT(game_board_is_cell_filled(&board, width, 5) &&
+                    game_board_is_cell_filled(&board, -1, 5), test_msg);
+    }
+}
+
+// Test that the bitboard collision kernels agree with a cell-by-cell scan
+void test_board_piece_fits_matches_cell_scan(void) {
+    static game_board_t board;
+    
+    for (int i = 0; i < num_test_widths; i++) {
+        int width = test_widths[i];
+        game_board_init(&board, width, DEFAULT_BOARD_HEIGHT);
+        fill_random_cells(&board, (unsigned int)width);
+        
+        int mismatches = 0;
+        for (int type = PIECE_I; type < NUM_PIECE_TYPES; type++) {
+            for (int rotation = 0; rotation < 4; rotation++) {
+                for (int y = -PIECE_SIZE; y < board.height + 1; y++) {
+                    for (int x = -PIECE_SIZE; x < width + 1; x++) {
+                        bool fast = game_board_piece_fits(&board, (piece_type_t)type, rotation, x, y);
+                        bool slow = piece_fits_cell_scan(&board, (piece_type_t)type, rotation, x, y);
+                        mismatches += (fast != slow);
+                    }
+                }
+            }
+        }
+        
+        char test_msg[120];
+        snprintf(test_msg, sizeof(test_msg), "Width %d: bitboard collision matches cell scan", width);
+        TEST_ASSERT_EQUAL(0, mismatches, test_msg);
+    }
+}
+
+// Test complete line detection and clearing on the bitboard
+void test_board_complete_lines(void) {
+    static game_board_t board;
+    
+    for (int i = 0; i < num_test_widths; i++) {
+        int width = test_widths[i];
+        game_board_init(&board, width, DEFAULT_BOARD_HEIGHT);
+        
+        int bottom = board.height - 1;
+        for (int x = 0; x < width; x++) {
+            game_board_set_cell(&board, x, bottom, PIECE_L, BOARD_CELL_LOCKED);
+        }
+        game_board_set_cell(&board, 1, bottom - 1, PIECE_X, BOARD_CELL_LOCKED);
+        
+        board_line_mask_t lines = game_board_find_complete_lines(&board);
+        
+        char test_msg[120];
+        snprintf(test_msg, sizeof(test_msg), "Width %d: complete bottom line found", width);
+        TEST_ASSERT(lines == ((board_line_mask_t)1 << bottom), test_msg);
+        
+        game_board_clear_lines(&board, lines);
+        snprintf(test_msg, sizeof(test_msg), "Width %d: partial line drops to the bottom", width);
+        TEST_ASSERT(board.rows[bottom] == ((board_row_t)1 << 1) &&
+                    game_board_get_cell_type(&board, 1, bottom) == PIECE_X &&
+                    board.rows[bottom - 1] == 0, test_msg);
+    }
+}
+
+// Test that several non-adjacent lines are cleared in one compaction pass
+void test_board_clear_multiple_lines(void) {
+    static game_board_t board;
+    
+    for (int i = 0; i < num_test_widths; i++) {
+        int width = test_widths[i];
+        game_board_init(&board, width, DEFAULT_BOARD_HEIGHT);
+        
+        // Full rows at bottom, bottom-1 and bottom-3; markers in bottom-2 and bottom-4
+        int bottom = board.height - 1;
+        for (int x = 0; x < width; x++) {
+            game_board_set_cell(&board, x, bottom, PIECE_L, BOARD_CELL_LOCKED);
+            game_board_set_cell(&board, x, bottom - 1, PIECE_L, BOARD_CELL_LOCKED);
+            game_board_set_cell(&board, x, bottom - 3, PIECE_L, BOARD_CELL_LOCKED);
+        }
+        game_board_set_cell(&board, 0, bottom - 2, PIECE_X, BOARD_CELL_LOCKED);
+        game_board_set_cell(&board, 2, bottom - 4, PIECE_U, BOARD_CELL_LOCKED);
+        
+        board_line_mask_t lines = game_board_find_complete_lines(&board);
+        int num_lines = game_board_count_lines(lines);
+        game_board_clear_lines(&board, lines);
+        
+        char test_msg[120];
+        snprintf(test_msg, sizeof(test_msg), "Width %d: three lines cleared, markers compacted", width);
+        TEST_ASSERT(num_lines == 3 &&
+                    board.rows[bottom] == 1 && game_board_get_cell_type(&board, 0, bottom) == PIECE_X &&
+                    board.rows[bottom - 1] == 4 && game_board_get_cell_type(&board, 2, bottom - 1) == PIECE_U &&
+                    board.rows[bottom - 2] == 0 && game_board_get_cell(&board, 0, bottom - 2) == BOARD_CELL_EMPTY, test_msg);
+    }
+}
+
+// Test that clears of more than four lines are detected and cleared together
+void test_board_clear_more_than_four_lines(void) {
+    static game_board_t board;
+    
+    game_board_init(&board, DEFAULT_BOARD_WIDTH, MAX_BOARD_HEIGHT);
+    
+    // Fill the bottom 7 rows except one gap in the 4th row from the bottom
+    int bottom = board.height - 1;
+    for (int y = bottom - 6; y <= bottom; y++) {
+        for (int x = 0; x < board.width; x++) {
+            if (!(y == bottom - 3 && x == 5)) {
+                game_board_set_cell(&board, x, y, PIECE_I, BOARD_CELL_LOCKED);
+            }
+        }
+    }
+    
+    board_line_mask_t lines = game_board_find_complete_lines(&board);
+    TEST_ASSERT_EQUAL(6, game_board_count_lines(lines), "Six complete lines found in one pass");
+    TEST_ASSERT(((lines >> bottom) & 1) && !((lines >> (bottom - 3)) & 1) && ((lines >> (bottom - 6)) & 1),
+                "Line mask spans the full board height");
+    
+    game_board_clear_lines(&board, lines);
+    TEST_ASSERT(board.rows[bottom] == (board.full_row & ~((board_row_t)1 << 5)) &&
+                board.rows[bottom - 1] == 0,
+                "Six lines cleared, the incomplete row lands at the bottom");
+}
+
+// Test the packed one-byte cell layout and partial board copies
+void test_board_packed_cells(void) {
+    static game_board_t board;
+    static game_board_t copy;
+    
+    TEST_ASSERT_EQUAL(1, (int)sizeof(board_cell_t), "Board cells are packed into one byte");
+    
+    game_board_init(&board, DEFAULT_BOARD_WIDTH, DEFAULT_BOARD_HEIGHT);
+    game_board_set_cell(&board, 3, 7, PIECE_Z_MIRROR, BOARD_CELL_LOCKED);
+    game_board_set_cell(&board, 4, 7, PIECE_EMPTY, BOARD_CELL_GARBAGE);
+    
+    board_cell_t cell = game_board_get_cell(&board, 3, 7);
+    TEST_ASSERT(BOARD_CELL_TYPE(cell) == PIECE_Z_MIRROR && (cell & BOARD_CELL_LOCKED),
+                "Packed cell keeps piece type and locked flag");
+    TEST_ASSERT(game_board_get_cell_color(&board, 3, 7) == blocktris_piece_get_color(PIECE_Z_MIRROR),
+                "Cell color resolved from the piece palette");
+    TEST_ASSERT(game_board_is_cell_filled(&board, 4, 7) && game_board_get_cell_type(&board, 4, 7) == PIECE_EMPTY,
+                "Garbage cell is filled without a piece type");
+    
+    game_board_init(&copy, MAX_BOARD_WIDTH, MAX_BOARD_HEIGHT);
+    game_board_set_cell(&copy, 60, 60, PIECE_I, BOARD_CELL_LOCKED);
+    game_board_copy(&copy, &board);
+    TEST_ASSERT(copy.width == board.width && copy.height == board.height &&
+                game_board_get_cell(&copy, 3, 7) == cell && copy.rows[7] == board.rows[7],
+                "Board copy reproduces dimensions and cells");
+    TEST_ASSERT(copy.rows[DEFAULT_BOARD_HEIGHT] == 0, "Board copy clears the padding rows");
+}
+
+// Test that snapshots only allocate the rows touched since their base
+void test_board_snapshot_copy_on_write(void) {
+    static game_board_t board;
+    static game_board_t restored;
+    board_snapshot_store_t store;
+    
+    board_snapshot_store_init(&store);
+    game_board_init(&board, DEFAULT_BOARD_WIDTH, DEFAULT_BOARD_HEIGHT);
+    game_board_set_cell(&board, 0, DEFAULT_BOARD_HEIGHT - 1, PIECE_T, BOARD_CELL_LOCKED);
+    
+    board_snapshot_t *first = board_snapshot_take(&store, &board, NULL);
+    TEST_ASSERT(first != NULL, "First snapshot taken");
+    TEST_ASSERT_EQUAL(1, (int)store.chunks_in_use, "Only the non-empty row gets its own chunk");
+    TEST_ASSERT(board.dirty_rows == 0, "Taking a snapshot clears the dirty rows");
+    
+    game_board_place_piece(&board, PIECE_I, 0, 3, 5);
+    board_line_mask_t touched = board.dirty_rows;
+    board_snapshot_t *second = board_snapshot_take(&store, &board, first);
+    bool shared = true;
+    for (int y = 0; y < board.height; y++) {
+        if (!((touched >> y) & 1) && second->rows[y] != first->rows[y]) {
+            shared = false;
+        }
+    }
+    TEST_ASSERT(touched != 0 && shared, "Untouched rows are shared with the base snapshot");
+    TEST_ASSERT_EQUAL(1 + game_board_count_lines(touched), (int)store.chunks_in_use,
+                      "New chunks only for the rows touched by the placement");
+    
+    board_snapshot_restore(first, &restored);
+    TEST_ASSERT(restored.width == board.width && restored.height == board.height,
+                "Restore takes the snapshot dimensions");
+    bool matches = true;
+    for (int y = 0; y < restored.height; y++) {
+        if (restored.rows[y] != first->rows[y]->bits) {
+            matches = false;
+        }
+    }
+    TEST_ASSERT(matches && restored.rows[DEFAULT_BOARD_HEIGHT - 1] == 1 && restored.dirty_rows == 0,
+                "Restored board matches the first snapshot");
+    
+    board_snapshot_release(&store, first);
+    TEST_ASSERT_EQUAL(1 + game_board_count_lines(touched), (int)store.chunks_in_use,
+                      "Chunks shared with a live snapshot survive release");
+    board_snapshot_release(&store, second);
+    TEST_ASSERT_EQUAL(0, (int)store.chunks_in_use, "Releasing every snapshot recycles all chunks");
+    
+    board_snapshot_store_cleanup(&store);
+}
+
+// Main game board test runner
+void run_game_board_tests(void) {
+    printf("\n=== Game Board Bitboard Tests ===\n\n");
+    
+    RUN_TEST(test_board_runtime_dimensions);
+    RUN_TEST(test_board_bitboard_matches_cells);
+    RUN_TEST(test_board_piece_fits_matches_cell_scan);
+    RUN_TEST(test_board_complete_lines);
+    RUN_TEST(test_board_clear_multiple_lines);
+    RUN_TEST(test_board_clear_more_than_four_lines);
+    RUN_TEST(test_board_packed_cells);
+    RUN_TEST(test_board_snapshot_copy_on_write);
+}
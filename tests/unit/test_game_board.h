@@ -0,0 +1,22 @@
+/**
+ * @file test_game_board.h
+ * @brief Header for game board bitboard tests
+ */
+
+#ifndef TEST_GAME_BOARD_H
+#define TEST_GAME_BOARD_H
+
+// Test function declarations
+void test_board_runtime_dimensions(void);
+void test_board_bitboard_matches_cells(void);
+void test_board_piece_fits_matches_cell_scan(void);
+void test_board_complete_lines(void);
+void test_board_clear_multiple_lines(void);
+void test_board_clear_more_than_four_lines(void);
+void test_board_packed_cells(void);
+void test_board_snapshot_copy_on_write(void);
+
+// Main test runner function
+void run_game_board_tests(void);
+
+#endif // TEST_GAME_BOARD_H
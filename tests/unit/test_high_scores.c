@@ -0,0 +1,249 @@
+/**
+ * @file test_high_scores.c
+ * @brief Tests for the high-score table: ranking, the log surviving reopens
+ * and damage, a long log being read ahead of use, and the log staying small
+ * while the history keeps every game
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/save/high_scores.h"
+#include "test_high_scores.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_SCORES_PATH "test_high_scores.log"
+#define TEST_HISTORY_PATH TEST_SCORES_PATH HIGH_SCORES_HISTORY_SUFFIX
+
+// Records written to the long log
+#define LARGE_LOG_RECORDS 200000
+
+static high_score_t make_entry(uint32_t score) {
+    high_score_t entry;
+    entry.score = score;
+    entry.lines = score / 100;
+    entry.duration_ms = score * 3;
+    entry.level = (uint16_t)(score / 1000);
+    entry.seed = 0xA5A5000000000000ULL | score;
+    entry.replay_hash = high_scores_hash_placement(HIGH_SCORES_REPLAY_HASH_INIT, (int)(score % 7), 0, 3, 18);
+    return entry;
+}
+
+static long file_size(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return -1;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+static void append_bytes(const char *path, const void *bytes, size_t size) {
+    FILE *file = fopen(path, "ab");
+    if (file) {
+        fwrite(bytes, 1, size, file);
+        fclose(file);
+    }
+}
+
+// Test that the table keeps the best scores in order and that ties don't push out an entry
+void test_high_scores_ranking(void) {
+    remove(TEST_SCORES_PATH);
+    remove(TEST_HISTORY_PATH);
+    
+    static high_scores_t table;
+    high_scores_open(&table, TEST_SCORES_PATH, 3);
+    TEST_ASSERT(!table.loaded, "Opening a table doesn't read the log");
+    
+    uint32_t scores[] = { 50, 70, 60 };
+    for (int i = 0; i < 3; i++) {
+        high_score_t entry = make_entry(scores[i]);
+        TEST_ASSERT(high_scores_add(&table, &entry), "A table with room takes any game");
+    }
+    
+    high_score_t low = make_entry(40);
+    high_score_t best = make_entry(80);
+    high_score_t tie = make_entry(60);
+    TEST_ASSERT(!high_scores_add(&table, &low), "A game below the table doesn't make it");
+    TEST_ASSERT(high_scores_add(&table, &best), "A better game makes a full table");
+    TEST_ASSERT(!high_scores_add(&table, &tie), "A tie with the lowest entry leaves it in place");
+    TEST_ASSERT(high_scores_qualifies(&table, 61) && !high_scores_qualifies(&table, 60),
+                "Qualifying means beating the lowest entry");
+    
+    high_score_t top[MAX_HIGH_SCORES_SIZE];
+    int count = high_scores_top(&table, top, MAX_HIGH_SCORES_SIZE);
+    TEST_ASSERT_EQUAL(3, count, "The table holds its size");
+    TEST_ASSERT(top[0].score == 80 && top[1].score == 70 && top[2].score == 60, "The table comes best first");
+    TEST_ASSERT_EQUAL(2, high_scores_top(&table, top, 2), "The top can be cut short");
+    TEST_ASSERT_EQUAL(6, (int)table.log_records, "Every game is logged, table or not");
+    
+    remove(TEST_SCORES_PATH);
+    remove(TEST_HISTORY_PATH);
+}
+
+// Test that the log survives a reopen, a damaged record and a torn write
+void test_high_scores_log_persists(void) {
+    remove(TEST_SCORES_PATH);
+    remove(TEST_HISTORY_PATH);
+    
+    static high_scores_t table;
+    high_scores_open(&table, TEST_SCORES_PATH, DEFAULT_HIGH_SCORES_SIZE);
+    for (uint32_t score = 100; score <= 300; score += 100) {
+        high_score_t entry = make_entry(score);
+        high_scores_add(&table, &entry);
+    }
+    TEST_ASSERT_EQUAL(HIGH_SCORES_HEADER_SIZE + 3 * HIGH_SCORES_RECORD_SIZE, (int)file_size(TEST_SCORES_PATH),
+                      "One header and a record per game");
+    
+    // A record whose check no longer matches, then half a record
+    uint8_t damaged[HIGH_SCORES_RECORD_SIZE] = { 0 };
+    damaged[0] = 0xFF;
+    damaged[3] = 0x7F;
+    append_bytes(TEST_SCORES_PATH, damaged, sizeof(damaged));
+    append_bytes(TEST_SCORES_PATH, damaged, HIGH_SCORES_RECORD_SIZE / 2);
+    
+    high_scores_open(&table, TEST_SCORES_PATH, DEFAULT_HIGH_SCORES_SIZE);
+    high_score_t top[DEFAULT_HIGH_SCORES_SIZE];
+    int count = high_scores_top(&table, top, DEFAULT_HIGH_SCORES_SIZE);
+    TEST_ASSERT_EQUAL(3, count, "The damaged record is skipped");
+    TEST_ASSERT_EQUAL(3, (int)table.log_records, "Only intact records are counted");
+    TEST_ASSERT(top[0].score == 300 && top[0].lines == 3 && top[0].duration_ms == 900 &&
+                top[0].seed == make_entry(300).seed && top[0].replay_hash == make_entry(300).replay_hash,
+                "Every field comes back from the log");
+    TEST_ASSERT_EQUAL(HIGH_SCORES_HEADER_SIZE + 3 * HIGH_SCORES_RECORD_SIZE, (int)file_size(TEST_SCORES_PATH),
+                      "The damaged record and the torn tail are compacted away");
+    
+    high_score_t entry = make_entry(250);
+    high_scores_add(&table, &entry);
+    high_scores_open(&table, TEST_SCORES_PATH, DEFAULT_HIGH_SCORES_SIZE);
+    count = high_scores_top(&table, top, DEFAULT_HIGH_SCORES_SIZE);
+    TEST_ASSERT(count == 4 && top[1].score == 250, "A game logged after the damage reads back");
+    
+    remove(TEST_SCORES_PATH);
+    remove(TEST_HISTORY_PATH);
+}
+
+// Test that a long log is read ahead of use, gives the right table, and is compacted to it
+void test_high_scores_large_log(void) {
+    remove(TEST_SCORES_PATH);
+    remove(TEST_HISTORY_PATH);
+    
+    // Log one poor game and a handful of good ones, to copy their records
+    static high_scores_t table;
+    high_scores_open(&table, TEST_SCORES_PATH, MAX_HIGH_SCORES_SIZE);
+    high_score_t poor = make_entry(10);
+    high_scores_add(&table, &poor);
+    for (uint32_t score = 1000; score <= 5000; score += 1000) {
+        high_score_t entry = make_entry(score);
+        high_scores_add(&table, &entry);
+    }
+    
+    uint8_t small_log[HIGH_SCORES_HEADER_SIZE + 6 * HIGH_SCORES_RECORD_SIZE];
+    FILE *file = fopen(TEST_SCORES_PATH, "rb");
+    size_t read = file ? fread(small_log, 1, sizeof(small_log), file) : 0;
+    if (file) {
+        fclose(file);
+    }
+    TEST_ASSERT_EQUAL((int)sizeof(small_log), (int)read, "The small log is written");
+    
+    // Bury the good games under many poor ones
+    size_t size = HIGH_SCORES_HEADER_SIZE + (size_t)(LARGE_LOG_RECORDS + 5) * HIGH_SCORES_RECORD_SIZE;
+    uint8_t *large_log = malloc(size);
+    if (!large_log) {
+        TEST_ASSERT(false, "The large log is allocated");
+        return;
+    }
+    const uint8_t *poor_record = small_log + HIGH_SCORES_HEADER_SIZE;
+    uint8_t *out = large_log;
+    memcpy(out, small_log, HIGH_SCORES_HEADER_SIZE);
+    out += HIGH_SCORES_HEADER_SIZE;
+    for (int i = 0; i < LARGE_LOG_RECORDS / 2; i++, out += HIGH_SCORES_RECORD_SIZE) {
+        memcpy(out, poor_record, HIGH_SCORES_RECORD_SIZE);
+    }
+    memcpy(out, poor_record + HIGH_SCORES_RECORD_SIZE, 5 * HIGH_SCORES_RECORD_SIZE);
+    out += 5 * HIGH_SCORES_RECORD_SIZE;
+    for (int i = 0; i < LARGE_LOG_RECORDS / 2; i++, out += HIGH_SCORES_RECORD_SIZE) {
+        memcpy(out, poor_record, HIGH_SCORES_RECORD_SIZE);
+    }
+    
+    // Damage one poor record in the middle of the history
+    large_log[HIGH_SCORES_HEADER_SIZE + (LARGE_LOG_RECORDS / 4) * HIGH_SCORES_RECORD_SIZE + 4] ^= 0xFF;
+    
+    file = fopen(TEST_SCORES_PATH, "wb");
+    if (file) {
+        fwrite(large_log, 1, size, file);
+        fclose(file);
+    }
+    free(large_log);
+    
+    high_scores_open(&table, TEST_SCORES_PATH, 5);
+    TEST_ASSERT(!table.loaded, "The long log isn't read at open");
+    high_scores_load(&table);
+    TEST_ASSERT(table.loaded, "Loading reads the log ahead of use");
+    
+    high_score_t top[5];
+    int count = high_scores_top(&table, top, 5);
+    TEST_ASSERT(count == 5 && top[0].score == 5000 && top[4].score == 1000,
+                "The good games are found among the poor ones");
+    TEST_ASSERT_EQUAL(5, (int)table.log_records, "The long log is compacted to the table");
+    TEST_ASSERT_EQUAL(HIGH_SCORES_HEADER_SIZE + 5 * HIGH_SCORES_RECORD_SIZE, (int)file_size(TEST_SCORES_PATH),
+                      "The compacted log holds just the table");
+    
+    high_score_t entry = make_entry(20);
+    high_scores_add(&table, &entry);
+    TEST_ASSERT_EQUAL(6, (int)table.log_records, "A game is appended to the compacted log");
+    TEST_ASSERT(high_scores_compact(&table), "The log can be compacted on demand");
+    TEST_ASSERT_EQUAL(5, (int)table.log_records, "Compacting drops the game that missed the table");
+    
+    high_scores_open(&table, TEST_SCORES_PATH, 5);
+    count = high_scores_top(&table, top, 5);
+    TEST_ASSERT(count == 5 && top[0].score == 5000 && top[4].score == 1000, "The compacted log reads the same");
+    
+    remove(TEST_SCORES_PATH);
+    remove(TEST_HISTORY_PATH);
+}
+
+// Test that the log is compacted as it grows while the history keeps every game
+void test_high_scores_history(void) {
+    remove(TEST_SCORES_PATH);
+    remove(TEST_HISTORY_PATH);
+    
+    static high_scores_t table;
+    high_scores_open(&table, TEST_SCORES_PATH, 3);
+    int games = HIGH_SCORES_COMPACT_FACTOR * 3 * 4;
+    uint32_t most_records = 0;
+    for (int i = 1; i <= games; i++) {
+        high_score_t entry = make_entry((uint32_t)(i * 37 % 101));
+        high_scores_add(&table, &entry);
+        most_records = table.log_records > most_records ? table.log_records : most_records;
+    }
+    
+    TEST_ASSERT_EQUAL(HIGH_SCORES_COMPACT_FACTOR * 3, (int)most_records, "The log never outgrows its limit");
+    TEST_ASSERT(file_size(TEST_SCORES_PATH) <= HIGH_SCORES_HEADER_SIZE +
+                (long)most_records * HIGH_SCORES_RECORD_SIZE, "The log file stays as small as its count");
+    TEST_ASSERT_EQUAL(HIGH_SCORES_HEADER_SIZE + games * HIGH_SCORES_RECORD_SIZE,
+                      (int)file_size(TEST_HISTORY_PATH), "The history keeps every game");
+    
+    high_score_t top[3];
+    high_score_t reopened[3];
+    int count = high_scores_top(&table, top, 3);
+    high_scores_open(&table, TEST_SCORES_PATH, 3);
+    TEST_ASSERT(count == 3 && high_scores_top(&table, reopened, 3) == 3 &&
+                memcmp(top, reopened, sizeof(top)) == 0, "The compacted log reads back the same table");
+    TEST_ASSERT(top[0].score == 100 && top[1].score == 99 && top[2].score == 98, "The best games survive compaction");
+    
+    remove(TEST_SCORES_PATH);
+    remove(TEST_HISTORY_PATH);
+}
+
+// Main high-score table test runner
+void run_high_scores_tests(void) {
+    printf("\n=== High Score Tests ===\n\n");
+    
+    RUN_TEST(test_high_scores_ranking);
+    RUN_TEST(test_high_scores_log_persists);
+    RUN_TEST(test_high_scores_large_log);
+    RUN_TEST(test_high_scores_history);
+}
@@ -0,0 +1,18 @@
+/**
+ * @file test_high_scores.h
+ * @brief Header for high-score table tests (ranking, log persistence, lazy loading and compaction)
+ */
+
+#ifndef TEST_HIGH_SCORES_H
+#define TEST_HIGH_SCORES_H
+
+// Test function declarations
+void test_high_scores_ranking(void);
+void test_high_scores_log_persists(void);
+void test_high_scores_large_log(void);
+void test_high_scores_history(void);
+
+// Main test runner function
+void run_high_scores_tests(void);
+
+#endif // TEST_HIGH_SCORES_H
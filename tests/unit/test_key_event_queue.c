@@ -0,0 +1,103 @@
+/**
+ * @file test_key_event_queue.c
+ * @brief Tests for the key event queue: one transition of a key per tick,
+ * dropped pushes once full, and a writer and reader thread losing nothing
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/simulation/key_event_queue.h"
+#include "test_key_event_queue.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_KEYS 8
+#define KEY_LEFT 1
+#define KEY_DROP 2
+
+// Presses and releases pushed by the writer thread
+#define THREAD_TRANSITIONS 200000
+
+// Test that a tap shorter than a tick still shows up as a press for one tick
+void test_key_event_queue_one_change_per_tick(void) {
+    static key_event_queue_t queue;
+    uint8_t keys[TEST_KEYS] = { 0 };
+    key_event_queue_init(&queue);
+    
+    TEST_ASSERT_EQUAL(0, key_event_queue_apply_tick(&queue, keys, TEST_KEYS), "Nothing to replay at first");
+    
+    key_event_queue_push(&queue, KEY_DROP, true);
+    key_event_queue_push(&queue, KEY_LEFT, true);
+    key_event_queue_push(&queue, KEY_DROP, false);
+    key_event_queue_push(&queue, KEY_LEFT, true);
+    key_event_queue_push(&queue, TEST_KEYS + 1, true);
+    
+    TEST_ASSERT_EQUAL(2, key_event_queue_apply_tick(&queue, keys, TEST_KEYS), "The first tick stops at a repeat key");
+    TEST_ASSERT(keys[KEY_DROP] && keys[KEY_LEFT], "Both presses are seen on the first tick");
+    
+    TEST_ASSERT_EQUAL(3, key_event_queue_apply_tick(&queue, keys, TEST_KEYS), "The rest is taken the next tick");
+    TEST_ASSERT(!keys[KEY_DROP], "The release is seen a tick after the press");
+    TEST_ASSERT(keys[KEY_LEFT], "A press of a key already down changes nothing");
+    TEST_ASSERT_EQUAL(0, key_event_queue_apply_tick(&queue, keys, TEST_KEYS), "The queue ends up empty");
+}
+
+// Test that pushes are dropped once the queue is full, and accepted again once replayed
+void test_key_event_queue_full(void) {
+    static key_event_queue_t queue;
+    uint8_t keys[TEST_KEYS] = { 0 };
+    key_event_queue_init(&queue);
+    
+    bool pushed = true;
+    for (int i = 0; i < KEY_EVENT_QUEUE_SIZE; i++) {
+        pushed &= key_event_queue_push(&queue, KEY_LEFT, i % 2 == 0);
+    }
+    TEST_ASSERT(pushed, "The queue holds KEY_EVENT_QUEUE_SIZE transitions");
+    TEST_ASSERT(!key_event_queue_push(&queue, KEY_DROP, true), "A push to a full queue is dropped");
+    
+    TEST_ASSERT_EQUAL(1, key_event_queue_apply_tick(&queue, keys, TEST_KEYS), "A tick takes one transition of a key");
+    TEST_ASSERT(key_event_queue_push(&queue, KEY_DROP, true), "A replayed transition frees its place");
+}
+
+static void *writer_main(void *data) {
+    key_event_queue_t *queue = (key_event_queue_t *)data;
+    for (int i = 0; i < THREAD_TRANSITIONS; i++) {
+        while (!key_event_queue_push(queue, KEY_LEFT, i % 2 == 0)) {
+        }
+    }
+    return NULL;
+}
+
+// Test a writer and a reader running flat out: every transition is replayed, one per tick
+void test_key_event_queue_threads(void) {
+    static key_event_queue_t queue;
+    uint8_t keys[TEST_KEYS] = { 0 };
+    key_event_queue_init(&queue);
+    
+    pthread_t writer;
+    TEST_ASSERT(pthread_create(&writer, NULL, writer_main, &queue) == 0, "Writer thread starts");
+    
+    int replayed = 0;
+    bool alternating = true;
+    while (replayed < THREAD_TRANSITIONS) {
+        int taken = key_event_queue_apply_tick(&queue, keys, TEST_KEYS);
+        if (taken == 0) {
+            continue;
+        }
+        
+        alternating &= taken == 1 && keys[KEY_LEFT] == (replayed % 2 == 0);
+        replayed += taken;
+    }
+    pthread_join(writer, NULL);
+    
+    TEST_ASSERT(alternating, "Every press and release is seen, in order, a tick apart");
+    TEST_ASSERT_EQUAL(THREAD_TRANSITIONS, replayed, "Nothing is lost or replayed twice");
+}
+
+// Main key event queue test runner
+void run_key_event_queue_tests(void) {
+    printf("\n=== Key Event Queue Tests ===\n\n");
+    
+    RUN_TEST(test_key_event_queue_one_change_per_tick);
+    RUN_TEST(test_key_event_queue_full);
+    RUN_TEST(test_key_event_queue_threads);
+}
@@ -0,0 +1,17 @@
+/**
+ * @file test_key_event_queue.h
+ * @brief Header for key event queue tests
+ */
+
+#ifndef TEST_KEY_EVENT_QUEUE_H
+#define TEST_KEY_EVENT_QUEUE_H
+
+// Test function declarations
+void test_key_event_queue_one_change_per_tick(void);
+void test_key_event_queue_full(void);
+void test_key_event_queue_threads(void);
+
+// Main test runner function
+void run_key_event_queue_tests(void);
+
+#endif // TEST_KEY_EVENT_QUEUE_H
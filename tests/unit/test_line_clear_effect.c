@@ -0,0 +1,105 @@
+/**
+ * @file test_line_clear_effect.c
+ * @brief Tests for the line-clear flash: normalized time, the cascading
+ * sweep of the row quads, and drawing it headless
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/rendering/line_clear_effect.h"
+#include "../../game/src/rendering/blocktris_renderer.h"
+#include "test_line_clear_effect.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ONE LINE_CLEAR_EFFECT_ONE
+
+// Test that elapsed time maps onto 0..ONE and stays there
+void test_line_clear_effect_time(void) {
+    TEST_ASSERT_EQUAL(0, line_clear_effect_time(0, 300), "The effect starts at 0");
+    TEST_ASSERT_EQUAL(ONE / 2, line_clear_effect_time(150, 300), "Half the delay is half the effect");
+    TEST_ASSERT_EQUAL(ONE, line_clear_effect_time(300, 300), "The effect ends with the delay");
+    TEST_ASSERT_EQUAL(ONE, line_clear_effect_time(5000, 300), "Time past the end is clamped");
+    TEST_ASSERT_EQUAL(ONE, line_clear_effect_time(0, 0), "An effect without a duration is over");
+}
+
+// Test that rows sweep in from the bottom one after the other, at a shared alpha
+void test_line_clear_effect_cascade(void) {
+    line_clear_batch_t batch;
+    board_line_mask_t lines = (1ULL << 17) | (1ULL << 18) | (1ULL << 19);
+    
+    line_clear_effect_build(&batch, lines, 10, 20, 0, 100, 50, 20);
+    TEST_ASSERT_EQUAL(0, batch.quad_count, "Nothing is drawn before the sweep starts");
+    TEST_ASSERT_EQUAL(255, batch.alpha, "The flash starts opaque");
+    
+    line_clear_effect_build(&batch, lines, 10, 20, LINE_CLEAR_EFFECT_SWEEP / 2, 100, 50, 20);
+    TEST_ASSERT_EQUAL(2, batch.quad_count, "Rows whose turn hasn't come are skipped");
+    TEST_ASSERT(batch.quads[0].y == 50 + 19 * 20 && batch.quads[1].y == 50 + 18 * 20,
+                "The bottom row goes first");
+    TEST_ASSERT_EQUAL(100, batch.quads[0].width, "The bottom row is half swept");
+    TEST_ASSERT(batch.quads[1].width < batch.quads[0].width, "The row above trails it");
+    TEST_ASSERT(batch.quads[0].x == 100 && batch.quads[0].height == 20, "Quads start at the left edge, a cell high");
+    
+    line_clear_effect_build(&batch, lines, 10, 20, ONE - 1, 100, 50, 20);
+    TEST_ASSERT_EQUAL(3, batch.quad_count, "Every row is drawn by the end");
+    TEST_ASSERT(batch.quads[0].width == 200 && batch.quads[2].width == 200, "Every row is fully swept by the end");
+    TEST_ASSERT(batch.alpha < 8, "The flash has faded by the end");
+    
+    line_clear_effect_build(&batch, lines, 10, 20, ONE, 100, 50, 20);
+    TEST_ASSERT_EQUAL(0, batch.quad_count, "Nothing is drawn once the effect is over");
+    
+    // Even a clear of every row finishes its last sweep in time
+    line_clear_effect_build(&batch, ~0ULL, 10, MAX_BOARD_HEIGHT, ONE - 1, 0, 0, 4);
+    TEST_ASSERT_EQUAL(MAX_BOARD_HEIGHT, batch.quad_count, "Every cleared row gets a quad");
+    TEST_ASSERT_EQUAL(40, batch.quads[MAX_BOARD_HEIGHT - 1].width, "The top row is fully swept by the end");
+}
+
+// Test the flash drawn over cleared rows on a canvas, and only over them
+void test_line_clear_effect_render(void) {
+    static game_t game;
+    static uint32_t pixels[1024 * 1024];
+    memset(&game, 0, sizeof(game));
+    
+    game_config_init(&game.config);
+    int width = game.config.board_width;
+    int height = game.config.board_height;
+    game_layout_t layout;
+    game_layout_calculate(&layout, width, height, 400, 450);
+    game_board_init(&game.board, width, height);
+    
+    game.line_clear_active = true;
+    game.lines_to_clear = 1ULL << (height - 1);
+    game.sim_tick = MS_TO_SIM_TICKS(LINE_CLEAR_DELAY / 2);
+    game.line_clear_start_tick = 0;
+    
+    soft_canvas_t canvas;
+    soft_canvas_init(&canvas, pixels, layout.width, layout.height);
+    uint32_t black = soft_rgba(0, 0, 0, 255);
+    soft_canvas_clear(&canvas, black);
+    graphics_context_t graphics_context;
+    memset(&graphics_context, 0, sizeof(graphics_context));
+    
+    layout.canvas = &canvas;
+    layout.canvas_background = NULL;
+    blocktris_renderer_render_line_clear_effect(&game, &layout, &graphics_context);
+    
+    int screen_x, screen_y;
+    blocktris_renderer_board_to_screen(&layout, 0, height - 1, &screen_x, &screen_y);
+    const uint8_t *flash = (const uint8_t *)(pixels + (screen_y + 1) * canvas.pitch + screen_x + layout.field_width - 2);
+    TEST_ASSERT(flash[0] > 0 && flash[0] < 255 && flash[0] == flash[1] && flash[1] == flash[2],
+                "The cleared row is blended with white");
+    TEST_ASSERT(pixels[(screen_y - 1) * canvas.pitch + screen_x] == black, "The row above is untouched");
+    
+    game.sim_tick = MS_TO_SIM_TICKS(LINE_CLEAR_DELAY);
+    soft_canvas_clear(&canvas, black);
+    blocktris_renderer_render_line_clear_effect(&game, &layout, &graphics_context);
+    TEST_ASSERT(pixels[(screen_y + 1) * canvas.pitch + screen_x] == black, "Nothing is drawn once the delay is over");
+}
+
+// Main line-clear effect test runner
+void run_line_clear_effect_tests(void) {
+    printf("\n=== Line Clear Effect Tests ===\n\n");
+    
+    RUN_TEST(test_line_clear_effect_time);
+    RUN_TEST(test_line_clear_effect_cascade);
+    RUN_TEST(test_line_clear_effect_render);
+}
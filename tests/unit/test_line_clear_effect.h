@@ -0,0 +1,17 @@
+/**
+ * @file test_line_clear_effect.h
+ * @brief Header for line-clear flash tests
+ */
+
+#ifndef TEST_LINE_CLEAR_EFFECT_H
+#define TEST_LINE_CLEAR_EFFECT_H
+
+// Test function declarations
+void test_line_clear_effect_time(void);
+void test_line_clear_effect_cascade(void);
+void test_line_clear_effect_render(void);
+
+// Main test runner function
+void run_line_clear_effect_tests(void);
+
+#endif // TEST_LINE_CLEAR_EFFECT_H
@@ -0,0 +1,108 @@
+/**
+ * @file test_lock_delay.c
+ * @brief Tests for the lock delay, move reset and the lowest-row rule
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/entities/lock_delay.h"
+#include "test_lock_delay.h"
+
+#define GROUND_ROW 10
+
+// Step a piece grounded on GROUND_ROW until it locks, returning the number of ticks taken
+static int ticks_until_lock(lock_delay_t *lock, int max_ticks) {
+    for (int tick = 1; tick <= max_ticks; tick++) {
+        if (lock_delay_step(lock, true, GROUND_ROW)) {
+            return tick;
+        }
+    }
+    return -1;
+}
+
+// Test that only grounded ticks count towards locking
+void test_lock_delay_counts_grounded_ticks(void) {
+    lock_delay_t lock;
+    
+    lock_delay_init(&lock, 0, 15);
+    TEST_ASSERT(lock_delay_step(&lock, true, GROUND_ROW), "Zero delay locks on the first grounded tick");
+    
+    lock_delay_init(&lock, 5, 15);
+    for (int i = 0; i < 100; i++) {
+        lock_delay_step(&lock, false, i % GROUND_ROW);
+    }
+    TEST_ASSERT_EQUAL(6, ticks_until_lock(&lock, 100), "Airborne ticks don't count towards the delay");
+    
+    lock_delay_start_piece(&lock);
+    lock_delay_step(&lock, true, GROUND_ROW - 1);
+    lock_delay_step(&lock, true, GROUND_ROW - 1);
+    lock_delay_step(&lock, false, GROUND_ROW);
+    TEST_ASSERT_EQUAL(6, ticks_until_lock(&lock, 100), "Falling to a new lowest row restarts the delay");
+}
+
+// Test that moves restart the delay only up to the reset limit
+void test_lock_delay_move_reset_cap(void) {
+    lock_delay_t lock;
+    
+    lock_delay_init(&lock, 10, 3);
+    lock_delay_on_move(&lock);
+    TEST_ASSERT_EQUAL(0, lock.resets, "Moving an airborne piece uses no reset");
+    
+    // Each move just before locking restarts the delay
+    for (int i = 0; i < 3; i++) {
+        for (int tick = 0; tick < 10; tick++) {
+            TEST_ASSERT(!lock_delay_step(&lock, true, GROUND_ROW), "Piece doesn't lock before the delay runs out");
+        }
+        lock_delay_on_move(&lock);
+    }
+    TEST_ASSERT_EQUAL(3, lock.resets, "Every move on the ground used a reset");
+    
+    lock_delay_step(&lock, true, GROUND_ROW);
+    lock_delay_on_move(&lock);
+    TEST_ASSERT_EQUAL(3, lock.resets, "Resets stop at the limit");
+    TEST_ASSERT_EQUAL(10, ticks_until_lock(&lock, 100), "Delay keeps running once resets are used up");
+    
+    lock_delay_start_piece(&lock);
+    TEST_ASSERT_EQUAL(0, lock.resets, "New piece gets its resets back");
+}
+
+// Test that kicking a grounded piece upwards over and over can't keep it from locking
+void test_lock_delay_kick_up_stall(void) {
+    lock_delay_t lock;
+    lock_delay_init(&lock, 5, 2);
+    
+    // Rest for most of the delay, rotate into a kick one row up, fall back next tick, repeat
+    int ticks = 0;
+    bool locked = false;
+    while (!locked && ticks < 1000) {
+        for (int i = 0; i < 4 && !locked; i++) {
+            locked = lock_delay_step(&lock, true, GROUND_ROW);
+            ticks++;
+        }
+        if (!locked) {
+            lock_delay_on_move(&lock);
+            lock_delay_step(&lock, false, GROUND_ROW - 1);
+            ticks++;
+        }
+    }
+    TEST_ASSERT(locked, "The piece locks");
+    TEST_ASSERT(ticks <= 3 * 5 + 2 * 4, "Kicks up use resets and get none back");
+    
+    // A piece that falls below where it was gets its delay and resets back
+    lock_delay_start_piece(&lock);
+    lock_delay_step(&lock, true, GROUND_ROW);
+    lock_delay_on_move(&lock);
+    lock_delay_step(&lock, true, GROUND_ROW);
+    lock_delay_on_move(&lock);
+    TEST_ASSERT_EQUAL(2, lock.resets, "Resets used on the ground");
+    lock_delay_step(&lock, false, GROUND_ROW + 1);
+    TEST_ASSERT_EQUAL(0, lock.resets, "A new lowest row gives the resets back");
+}
+
+// Main lock delay test runner
+void run_lock_delay_tests(void) {
+    printf("\n=== Lock Delay Tests ===\n\n");
+    
+    RUN_TEST(test_lock_delay_counts_grounded_ticks);
+    RUN_TEST(test_lock_delay_move_reset_cap);
+    RUN_TEST(test_lock_delay_kick_up_stall);
+}
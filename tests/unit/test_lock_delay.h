@@ -0,0 +1,17 @@
+/**
+ * @file test_lock_delay.h
+ * @brief Header for lock delay tests
+ */
+
+#ifndef TEST_LOCK_DELAY_H
+#define TEST_LOCK_DELAY_H
+
+// Test function declarations
+void test_lock_delay_counts_grounded_ticks(void);
+void test_lock_delay_move_reset_cap(void);
+void test_lock_delay_kick_up_stall(void);
+
+// Main test runner function
+void run_lock_delay_tests(void);
+
+#endif // TEST_LOCK_DELAY_H
@@ -0,0 +1,373 @@
+/**
+ * @file test_netplay.c
+ * @brief Tests for online versus: packet encoding, rollback convergence under
+ * simulated loss and latency, and a match between two processes over loopback
+ */
+
+// fork, pipes and nanosleep are POSIX, not C99
+#define _POSIX_C_SOURCE 200809L
+
+#include "../test_framework.h"
+#include "../test_fixtures.h"
+#include "../../game/src/net/net_packet.h"
+#include "../../game/src/net/net_link.h"
+#include "../../game/src/net/rollback_session.h"
+#include "../../game/src/simulation/sim_view.h"
+#include "../../game/src/main/constants.h"
+#include "../../game/src/utils/utils.h"
+#include "test_netplay.h"
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MATCH_TICKS 1500
+#define LOOPBACK_TICKS 600
+#define MAX_TEST_MS 600000 // Virtual time limit of one match
+
+/**
+ * One side of a test match: the session plus the inputs its player pressed
+ */
+typedef struct {
+    rollback_session_t *session;
+    uint64_t rng_state;
+    uint32_t next_tick_ms; // Virtual time of the next tick, 0 until the match starts
+    bool soft_drop;        // Soft drop key held
+    sim_input_t played[MATCH_TICKS + NET_INPUT_DELAY_TICKS]; // Local input of each tick
+} test_peer_t;
+
+// A narrow board so lines come quickly, with a lock delay a rollback can land in
+static void make_netplay_config(game_config_t *config) {
+    test_make_config(config, 8, 24);
+    config->lock_delay_ms = 100;
+}
+
+// Roughly human: an action every few ticks, with soft drop held in stretches
+static sim_input_t random_input(test_peer_t *peer) {
+    uint32_t r = (uint32_t)(utils_next_random(&peer->rng_state) >> 32);
+    static const sim_input_t actions[] = {
+        SIM_INPUT_LEFT, SIM_INPUT_RIGHT, SIM_INPUT_ROTATE_CW, SIM_INPUT_ROTATE_CCW,
+        SIM_INPUT_HOLD, SIM_INPUT_HARD_DROP
+    };
+    
+    if ((r >> 16) % 64 == 0) {
+        peer->soft_drop = !peer->soft_drop;
+    }
+    
+    sim_input_t input = peer->soft_drop ? SIM_INPUT_SOFT_DROP : 0;
+    if (r % 16 == 0) {
+        input |= actions[(r >> 4) % (sizeof(actions) / sizeof(actions[0]))];
+    }
+    return input;
+}
+
+static void init_peer(test_peer_t *peer, rollback_session_t *session, uint64_t seed) {
+    peer->session = session;
+    peer->rng_state = seed | 1;
+    peer->next_tick_ms = 0;
+    peer->soft_drop = false;
+    memset(peer->played, 0, sizeof(peer->played));
+}
+
+/**
+ * Give a peer one millisecond of virtual time: exchange packets, then run a
+ * tick whenever one is due, like the online stage does every frame
+ */
+static void step_peer(test_peer_t *peer, uint32_t now_ms, uint32_t ticks) {
+    rollback_session_t *session = peer->session;
+    rollback_session_update(session, now_ms);
+    
+    if (session->status != NET_SESSION_RUNNING || session->tick >= ticks) {
+        return;
+    }
+    if (peer->next_tick_ms == 0) {
+        peer->next_tick_ms = now_ms;
+    }
+    if ((int32_t)(now_ms - peer->next_tick_ms) < 0) {
+        return;
+    }
+    peer->next_tick_ms += SIM_TICK_MS;
+    
+    if (rollback_session_should_wait(session)) {
+        return;
+    }
+    
+    uint32_t input_tick = session->local_end;
+    sim_input_t input = random_input(peer);
+    if (rollback_session_advance(session, input)) {
+        peer->played[input_tick] = input;
+    }
+}
+
+static bool peer_done(const test_peer_t *peer, uint32_t ticks) {
+    return peer->session->tick >= ticks && rollback_session_is_confirmed(peer->session);
+}
+
+// Test that INPUT and HELLO packets survive encoding and that malformed ones are rejected
+void test_net_packet_round_trip(void) {
+    net_input_packet_t packet;
+    packet.ack_tick = 70000;
+    packet.first_tick = 123456;
+    packet.advantage = -3;
+    packet.count = 100;
+    for (int i = 0; i < packet.count; i++) {
+        packet.inputs[i] = (sim_input_t)(i < 40 ? 0 : i < 60 ? SIM_INPUT_SOFT_DROP : (i % 10 == 0 ? SIM_INPUT_LEFT : 0));
+    }
+    
+    uint8_t buffer[NET_PACKET_MAX_SIZE];
+    size_t size = net_packet_write_inputs(buffer, sizeof(buffer), &packet);
+    TEST_ASSERT(size > 0 && size < 64, "Run-length encoding keeps 100 ticks of input small");
+    TEST_ASSERT_EQUAL(NET_PACKET_INPUT, net_packet_type(buffer, size), "Packet type is readable");
+    
+    net_input_packet_t decoded;
+    TEST_ASSERT(net_packet_read_inputs(buffer, size, &decoded), "Encoded inputs decode");
+    TEST_ASSERT(decoded.ack_tick == packet.ack_tick && decoded.first_tick == packet.first_tick,
+                "Ticks survive the round trip");
+    TEST_ASSERT_EQUAL(-3, decoded.advantage, "Negative advantage survives the round trip");
+    TEST_ASSERT_EQUAL(packet.count, decoded.count, "All ticks decoded");
+    TEST_ASSERT(memcmp(packet.inputs, decoded.inputs, (size_t)packet.count) == 0, "Inputs survive the round trip");
+    TEST_ASSERT(!net_packet_read_inputs(buffer, size - 1, &decoded), "Truncated packet is rejected");
+    
+    // A buffer too small for every run still gives a valid, shorter packet
+    size_t short_size = net_packet_write_inputs(buffer, 20, &packet);
+    TEST_ASSERT(short_size <= 20 && net_packet_read_inputs(buffer, short_size, &decoded), "Short packet decodes");
+    TEST_ASSERT(decoded.count > 0 && decoded.count < packet.count, "Short packet carries fewer ticks");
+    
+    net_hello_t hello;
+    hello.reply = true;
+    hello.seed = 0x0123456789ABCDEFULL;
+    make_netplay_config(&hello.config);
+    size = net_packet_write_hello(buffer, sizeof(buffer), &hello);
+    
+    net_hello_t read_back;
+    game_config_init(&read_back.config);
+    TEST_ASSERT(net_packet_read_hello(buffer, size, &read_back), "Hello decodes");
+    TEST_ASSERT(read_back.reply && read_back.seed == hello.seed, "Seed and reply flag survive the round trip");
+    TEST_ASSERT_EQUAL(8, read_back.config.board_width, "Board width survives the round trip");
+    TEST_ASSERT_EQUAL(100, read_back.config.lock_delay_ms, "Lock delay survives the round trip");
+    
+    buffer[12] = MAX_BOARD_WIDTH + 1;
+    TEST_ASSERT(!net_packet_read_hello(buffer, size, &read_back), "Out-of-range settings are rejected");
+    buffer[0] = 0;
+    TEST_ASSERT_EQUAL(NET_PACKET_INVALID, net_packet_type(buffer, size), "Foreign datagram is ignored");
+}
+
+// Test that a session stops predicting once the remote player is a whole window behind
+void test_rollback_stalls_without_remote_input(void) {
+    static rollback_session_t host;
+    static rollback_session_t join;
+    static net_link_t links[2];
+    game_config_t config;
+    make_netplay_config(&config);
+    
+    net_link_init_pair(&links[0], &links[1], NULL);
+    rollback_session_init(&host, &links[0], NET_HOST_PLAYER, &config, 7, 0);
+    rollback_session_init(&join, &links[1], NET_JOIN_PLAYER, &config, 0, 0);
+    
+    rollback_session_update(&join, 0); // Hello
+    rollback_session_update(&host, 0); // Reply
+    rollback_session_update(&join, 0);
+    TEST_ASSERT(host.status == NET_SESSION_RUNNING && join.status == NET_SESSION_RUNNING, "Hello exchange starts both");
+    TEST_ASSERT(join.seed == 7, "Joiner adopts the host's seed");
+    
+    int ran = 0;
+    while (ran < 100 && rollback_session_advance(&host, 0)) {
+        ran++;
+    }
+    TEST_ASSERT_EQUAL(NET_ROLLBACK_WINDOW + NET_INPUT_DELAY_TICKS, ran, "Host stalls a window past the last remote input");
+    TEST_ASSERT(!rollback_session_is_confirmed(&host), "Predicted ticks are not confirmed");
+    
+    rollback_session_update(&host, NET_SEND_INTERVAL_MS);
+    rollback_session_update(&join, NET_SEND_INTERVAL_MS);
+    TEST_ASSERT(join.remote_end == host.local_end, "Joiner receives every host input in one packet");
+}
+
+// Test that both peers end up with the same match as an offline replay of their inputs
+void test_rollback_converges_under_loss(void) {
+    static rollback_session_t sessions[VERSUS_PLAYERS];
+    static net_link_t links[VERSUS_PLAYERS];
+    static test_peer_t peers[VERSUS_PLAYERS];
+    game_config_t config;
+    make_netplay_config(&config);
+    
+    // Lossy, slow and jittery enough to reorder packets
+    net_conditions_t conditions = { 20, 40, 30, 12345 };
+    net_link_init_pair(&links[0], &links[1], &conditions);
+    rollback_session_init(&sessions[0], &links[0], NET_HOST_PLAYER, &config, 2024, 1);
+    rollback_session_init(&sessions[1], &links[1], NET_JOIN_PLAYER, &config, 0, 1);
+    init_peer(&peers[0], &sessions[0], 11);
+    init_peer(&peers[1], &sessions[1], 22);
+    
+    uint32_t now = 1;
+    while (now < MAX_TEST_MS && !(peer_done(&peers[0], MATCH_TICKS) && peer_done(&peers[1], MATCH_TICKS))) {
+        step_peer(&peers[1], now, MATCH_TICKS);
+        step_peer(&peers[0], now, MATCH_TICKS);
+        now++;
+    }
+    
+    TEST_ASSERT(peer_done(&peers[0], MATCH_TICKS) && peer_done(&peers[1], MATCH_TICKS), "Both peers confirm the match");
+    TEST_ASSERT(sessions[0].rollbacks > 0 && sessions[1].rollbacks > 0, "Late inputs caused rollbacks");
+    TEST_ASSERT(links[0].packets_dropped > 0, "Packets were lost on the way");
+    
+    uint32_t checksum = versus_match_checksum(&sessions[0].match);
+    TEST_ASSERT(checksum == versus_match_checksum(&sessions[1].match), "Both peers agree on the match");
+    
+    // The same inputs stepped without any network give the same match
+    static versus_match_t reference;
+    versus_match_init(&reference, &config, 2024);
+    for (uint32_t t = 0; t < MATCH_TICKS; t++) {
+        versus_match_step_player(&reference, 0, peers[0].played[t]);
+        versus_match_step_player(&reference, 1, peers[1].played[t]);
+    }
+    TEST_ASSERT(checksum == versus_match_checksum(&reference), "Rolled-back match equals the offline replay");
+    
+    // Real time of the match, the HELLO exchange included
+    uint32_t bytes_per_second = (uint32_t)((uint64_t)links[0].bytes_sent * 1000 / now);
+    TEST_ASSERT(bytes_per_second < 1024, "Host sends under 1 KB/s including UDP/IP headers");
+    bytes_per_second = (uint32_t)((uint64_t)links[1].bytes_sent * 1000 / now);
+    TEST_ASSERT(bytes_per_second < 1024, "Joiner sends under 1 KB/s including UDP/IP headers");
+}
+
+/**
+ * Check that a published view shows exactly the board of its simulation
+ */
+static bool view_shows_board(const sim_view_t *view, const game_board_t *board) {
+    static game_board_t shown;
+    board_snapshot_restore(view->board, &shown);
+    return shown.width == board->width && shown.height == board->height &&
+           memcmp(shown.rows, board->rows, (size_t)board->height * sizeof(board_row_t)) == 0 &&
+           memcmp(shown.cells, board->cells, (size_t)board->width * board->height * sizeof(board_cell_t)) == 0;
+}
+
+// Test that views published every tick, as the online stage does, stay right across rollbacks
+void test_rollback_views_follow_resimulation(void) {
+    static rollback_session_t sessions[VERSUS_PLAYERS];
+    static net_link_t links[VERSUS_PLAYERS];
+    static test_peer_t peers[VERSUS_PLAYERS];
+    static sim_view_buffer_t views[VERSUS_PLAYERS];
+    game_config_t config;
+    make_netplay_config(&config);
+    
+    net_conditions_t conditions = { 0, 50, 20, 777 };
+    net_link_init_pair(&links[0], &links[1], &conditions);
+    rollback_session_init(&sessions[0], &links[0], NET_HOST_PLAYER, &config, 99, 1);
+    rollback_session_init(&sessions[1], &links[1], NET_JOIN_PLAYER, &config, 0, 1);
+    init_peer(&peers[0], &sessions[0], 33);
+    init_peer(&peers[1], &sessions[1], 44);
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        sim_view_buffer_init(&views[i]);
+    }
+    
+    // The host's views of both players, checked after every publish
+    int mismatches = 0;
+    uint32_t now = 1;
+    while (now < MAX_TEST_MS && !(peer_done(&peers[0], MATCH_TICKS) && peer_done(&peers[1], MATCH_TICKS))) {
+        step_peer(&peers[1], now, MATCH_TICKS);
+        step_peer(&peers[0], now, MATCH_TICKS);
+        for (int i = 0; i < VERSUS_PLAYERS; i++) {
+            blocktris_sim_t *sim = &sessions[0].match.players[i].sim;
+            sim_view_buffer_publish(&views[i], sim);
+            mismatches += view_shows_board(sim_view_buffer_front(&views[i]), &sim->board) ? 0 : 1;
+        }
+        now++;
+    }
+    
+    TEST_ASSERT(sessions[0].rollbacks > 0, "Late inputs caused rollbacks");
+    TEST_ASSERT_EQUAL(0, mismatches, "Every published view matches the resimulated board");
+    
+    for (int i = 0; i < VERSUS_PLAYERS; i++) {
+        sim_view_buffer_cleanup(&views[i]);
+    }
+}
+
+/**
+ * Play one side of a loopback match in its own process
+ *
+ * @return The match checksum, or 0 if the match didn't finish
+ */
+static uint32_t play_loopback_side(rollback_session_t *session, test_peer_t *peer) {
+    const struct timespec pause = { 0, 100000 }; // Let the other process run
+    uint32_t now = 1;
+    uint32_t done_at = 0;
+    
+    // Keep answering for a while after finishing so the other side gets our last inputs
+    while (now < MAX_TEST_MS && (done_at == 0 || now - done_at < 1000)) {
+        step_peer(peer, now, LOOPBACK_TICKS);
+        if (done_at == 0 && peer_done(peer, LOOPBACK_TICKS)) {
+            done_at = now;
+        }
+        
+        nanosleep(&pause, NULL);
+        now++;
+    }
+    
+    return done_at ? versus_match_checksum(&session->match) : 0;
+}
+
+// Test a match between two processes over UDP on loopback, with simulated loss and latency
+void test_rollback_two_processes_loopback(void) {
+    static rollback_session_t session;
+    static net_link_t link;
+    static test_peer_t peer;
+    static udp_socket_t sock;
+    game_config_t config;
+    make_netplay_config(&config);
+    
+    net_conditions_t conditions = { 10, 20, 10, 777 };
+    TEST_ASSERT(udp_socket_open(&sock, 0), "Host socket opens on a free port");
+    uint16_t port = udp_socket_local_port(&sock);
+    
+    int result_pipe[2];
+    TEST_ASSERT(pipe(result_pipe) == 0, "Result pipe opens");
+    
+    fflush(stdout);
+    pid_t child = fork();
+    if (child == 0) {
+        // Joiner process: report the checksum through the pipe
+        udp_socket_close(&sock);
+        close(result_pipe[0]);
+        
+        uint32_t checksum = 0;
+        if (udp_socket_open(&sock, 0) && udp_socket_set_peer(&sock, "127.0.0.1", port)) {
+            conditions.seed = 888;
+            net_link_init_udp(&link, &sock, &conditions);
+            rollback_session_init(&session, &link, NET_JOIN_PLAYER, &config, 0, 1);
+            init_peer(&peer, &session, 33);
+            checksum = play_loopback_side(&session, &peer);
+        }
+        
+        ssize_t written = write(result_pipe[1], &checksum, sizeof(checksum));
+        _exit(written == (ssize_t)sizeof(checksum) && checksum != 0 ? 0 : 1);
+    }
+    TEST_ASSERT(child > 0, "Joiner process starts");
+    close(result_pipe[1]);
+    
+    net_link_init_udp(&link, &sock, &conditions);
+    rollback_session_init(&session, &link, NET_HOST_PLAYER, &config, 4242, 1);
+    init_peer(&peer, &session, 44);
+    uint32_t host_checksum = play_loopback_side(&session, &peer);
+    
+    uint32_t join_checksum = 0;
+    ssize_t bytes = read(result_pipe[0], &join_checksum, sizeof(join_checksum));
+    int status = 1;
+    waitpid(child, &status, 0);
+    close(result_pipe[0]);
+    udp_socket_close(&sock);
+    
+    TEST_ASSERT(host_checksum != 0, "Host finishes the match");
+    TEST_ASSERT(bytes == (ssize_t)sizeof(join_checksum) && WIFEXITED(status) && WEXITSTATUS(status) == 0,
+                "Joiner finishes the match");
+    TEST_ASSERT(host_checksum == join_checksum, "Both processes agree on the match");
+}
+
+// Main netplay test runner
+void run_netplay_tests(void) {
+    printf("\n=== Netplay Tests ===\n\n");
+    
+    RUN_TEST(test_net_packet_round_trip);
+    RUN_TEST(test_rollback_stalls_without_remote_input);
+    RUN_TEST(test_rollback_converges_under_loss);
+    RUN_TEST(test_rollback_views_follow_resimulation);
+    RUN_TEST(test_rollback_two_processes_loopback);
+}
@@ -0,0 +1,19 @@
+/**
+ * @file test_netplay.h
+ * @brief Header for online versus tests (packets, rollback, loopback match)
+ */
+
+#ifndef TEST_NETPLAY_H
+#define TEST_NETPLAY_H
+
+// Test function declarations
+void test_net_packet_round_trip(void);
+void test_rollback_stalls_without_remote_input(void);
+void test_rollback_converges_under_loss(void);
+void test_rollback_views_follow_resimulation(void);
+void test_rollback_two_processes_loopback(void);
+
+// Main test runner function
+void run_netplay_tests(void);
+
+#endif // TEST_NETPLAY_H
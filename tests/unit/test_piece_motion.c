@@ -0,0 +1,110 @@
+/**
+ * @file test_piece_motion.c
+ * @brief Tests for smooth piece motion: the fixed-point fall position, drawing
+ * between simulation states, snapping on anything but a fall, and fixed-point
+ * board coordinates on screen
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/rendering/piece_motion.h"
+#include "../../game/src/rendering/blocktris_renderer.h"
+#include "test_piece_motion.h"
+#include <stdio.h>
+
+#define ONE SUBCELL_ONE
+
+static blocktris_piece_t make_piece(piece_type_t type, int x, int y, int rotation) {
+    blocktris_piece_t piece;
+    piece.type = type;
+    piece.x = (int16_t)x;
+    piece.y = (int16_t)y;
+    piece.rotation = (int8_t)rotation;
+    piece.active = true;
+    return piece;
+}
+
+// Test that the position creeps towards the next row as gravity builds up
+void test_piece_motion_position(void) {
+    TEST_ASSERT_EQUAL(5 * ONE, piece_motion_position(5, 0, 50, false), "A piece that just fell is on its row");
+    TEST_ASSERT_EQUAL(5 * ONE + ONE / 2, piece_motion_position(5, 25, 50, false), "Half the interval is half a row");
+    TEST_ASSERT_EQUAL(5 * ONE, piece_motion_position(5, 25, 50, true), "A grounded piece stays on its row");
+    TEST_ASSERT(piece_motion_position(5, 80, 50, false) < 6 * ONE, "The next row is only reached by falling");
+    TEST_ASSERT_EQUAL(5 * ONE, piece_motion_position(5, 0, 1, false), "A piece falling every tick moves a row at a time");
+}
+
+// Test that the piece is drawn between its last two states by real time
+void test_piece_motion_interpolation(void) {
+    piece_motion_t motion;
+    piece_motion_reset(&motion);
+    blocktris_piece_t piece = make_piece(PIECE_T, 4, 3, 0);
+    
+    TEST_ASSERT_EQUAL(0, piece_motion_offset(&motion, 3, 1000), "Nothing is offset before a piece is seen");
+    
+    piece_motion_update(&motion, &piece, 3 * ONE, 100, 1000);
+    TEST_ASSERT_EQUAL(0, piece_motion_offset(&motion, 3, 1005), "The first state is drawn as it is");
+    
+    // Two ticks on, gravity has built up a quarter row
+    piece_motion_update(&motion, &piece, 3 * ONE + ONE / 4, 102, 1000 + 2 * SIM_TICK_MS);
+    TEST_ASSERT_EQUAL(0, piece_motion_offset(&motion, 3, 1000 + 2 * SIM_TICK_MS), "Drawn from the previous state");
+    TEST_ASSERT_EQUAL(ONE / 8, piece_motion_offset(&motion, 3, 1000 + 3 * SIM_TICK_MS), "Half way between the states");
+    TEST_ASSERT_EQUAL(ONE / 4, piece_motion_offset(&motion, 3, 1000 + 9 * SIM_TICK_MS), "The latest state once it's due");
+    
+    // The same state passed in again changes nothing
+    piece_motion_update(&motion, &piece, 3 * ONE + ONE / 4, 102, 5000);
+    TEST_ASSERT_EQUAL(ONE / 8, piece_motion_offset(&motion, 3, 1000 + 3 * SIM_TICK_MS), "A repeated state is ignored");
+    
+    // Falling a row carries on smoothly from just above it
+    piece.y = 4;
+    piece_motion_update(&motion, &piece, 4 * ONE, 103, 1000 + 3 * SIM_TICK_MS);
+    TEST_ASSERT_EQUAL(0, piece_motion_offset(&motion, 4, 1000 + 3 * SIM_TICK_MS), "Never drawn above its row");
+    TEST_ASSERT_EQUAL(0, piece_motion_offset(&motion, 4, 1000 + 4 * SIM_TICK_MS), "Lands on the row with the state");
+}
+
+// Test that anything but a fall snaps to the new state
+void test_piece_motion_snap(void) {
+    piece_motion_t motion;
+    piece_motion_reset(&motion);
+    blocktris_piece_t piece = make_piece(PIECE_L, 4, 10, 0);
+    
+    piece_motion_update(&motion, &piece, 10 * ONE + ONE / 2, 10, 100);
+    piece.y = 18;
+    piece_motion_update(&motion, &piece, 18 * ONE, 11, 100 + SIM_TICK_MS);
+    TEST_ASSERT_EQUAL(0, piece_motion_offset(&motion, 18, 100 + SIM_TICK_MS), "A hard drop snaps");
+    
+    piece_motion_update(&motion, &piece, 18 * ONE + ONE / 2, 12, 100 + 2 * SIM_TICK_MS);
+    piece.rotation = 1;
+    piece_motion_update(&motion, &piece, 18 * ONE + ONE / 2 + 1, 13, 100 + 3 * SIM_TICK_MS);
+    TEST_ASSERT_EQUAL(ONE / 2 + 1, piece_motion_offset(&motion, 18, 100 + 3 * SIM_TICK_MS), "A rotation snaps");
+    
+    blocktris_piece_t next = make_piece(PIECE_L, 4, 0, 1);
+    piece_motion_update(&motion, &next, ONE / 4, 14, 100 + 4 * SIM_TICK_MS);
+    TEST_ASSERT_EQUAL(ONE / 4, piece_motion_offset(&motion, 0, 100 + 4 * SIM_TICK_MS), "A new piece snaps");
+    
+    piece_motion_update(&motion, NULL, 0, 15, 100 + 5 * SIM_TICK_MS);
+    TEST_ASSERT(!motion.valid, "No piece forgets the motion");
+}
+
+// Test fixed-point board coordinates against whole cells
+void test_piece_motion_board_to_screen(void) {
+    game_layout_t layout;
+    game_layout_calculate(&layout, DEFAULT_BOARD_WIDTH, DEFAULT_BOARD_HEIGHT, 760, 972);
+    
+    int x, y, fixed_x, fixed_y;
+    blocktris_renderer_board_to_screen(&layout, 3, 7, &x, &y);
+    blocktris_renderer_board_to_screen_fixed(&layout, 3 * ONE, 7 * ONE, &fixed_x, &fixed_y);
+    TEST_ASSERT(x == fixed_x && y == fixed_y, "Whole cells land where they always did");
+    
+    blocktris_renderer_board_to_screen_fixed(&layout, 3 * ONE, 7 * ONE + ONE / 2, &fixed_x, &fixed_y);
+    TEST_ASSERT_EQUAL(y + (layout.cell_size + 1) / 2, fixed_y, "Half a cell down is half a cell of pixels, rounded");
+    TEST_ASSERT_EQUAL(x, fixed_x, "Moving down doesn't move across");
+}
+
+// Main piece motion test runner
+void run_piece_motion_tests(void) {
+    printf("\n=== Piece Motion Tests ===\n\n");
+    
+    RUN_TEST(test_piece_motion_position);
+    RUN_TEST(test_piece_motion_interpolation);
+    RUN_TEST(test_piece_motion_snap);
+    RUN_TEST(test_piece_motion_board_to_screen);
+}
@@ -0,0 +1,18 @@
+/**
+ * @file test_piece_motion.h
+ * @brief Header for smooth piece motion tests
+ */
+
+#ifndef TEST_PIECE_MOTION_H
+#define TEST_PIECE_MOTION_H
+
+// Test function declarations
+void test_piece_motion_position(void);
+void test_piece_motion_interpolation(void);
+void test_piece_motion_snap(void);
+void test_piece_motion_board_to_screen(void);
+
+// Main test runner function
+void run_piece_motion_tests(void);
+
+#endif // TEST_PIECE_MOTION_H
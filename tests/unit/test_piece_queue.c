@@ -0,0 +1,83 @@
+/**
+ * @file test_piece_queue.c
+ * @brief Tests for the piece preview queue
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/entities/piece_queue.h"
+#include "test_piece_queue.h"
+
+// Test that the depth is clamped and the queue never runs shorter than it
+void test_piece_queue_depth(void) {
+    piece_queue_t queue;
+    
+    piece_queue_init(&queue, 0, 1);
+    TEST_ASSERT_EQUAL(PIECE_QUEUE_MIN_DEPTH, queue.depth, "Depth clamped to the minimum");
+    piece_queue_init(&queue, 99, 1);
+    TEST_ASSERT_EQUAL(PIECE_QUEUE_MAX_DEPTH, queue.depth, "Depth clamped to the maximum");
+    
+    bool always_full = true;
+    for (int i = 0; i < 1000; i++) {
+        piece_queue_pop(&queue);
+        if (piece_queue_lookahead(&queue) < queue.depth ||
+            piece_queue_peek(&queue, queue.depth - 1) == PIECE_EMPTY) {
+            always_full = false;
+        }
+    }
+    TEST_ASSERT(always_full, "Every preview slot is filled after each pop");
+    TEST_ASSERT(piece_queue_peek(&queue, piece_queue_lookahead(&queue)) == PIECE_EMPTY,
+                "Peeking past the generated pieces returns PIECE_EMPTY");
+}
+
+// Test that peeked pieces come out of the queue in order
+void test_piece_queue_peek_matches_pop(void) {
+    piece_queue_t queue;
+    piece_type_t expected[PIECE_QUEUE_CAPACITY];
+    
+    piece_queue_init(&queue, 5, 42);
+    int lookahead = piece_queue_lookahead(&queue);
+    for (int i = 0; i < lookahead; i++) {
+        expected[i] = piece_queue_peek(&queue, i);
+    }
+    
+    bool matches = true;
+    for (int i = 0; i < lookahead; i++) {
+        piece_type_t type = piece_queue_pop(&queue);
+        if (type != expected[i] || type >= NUM_PIECE_TYPES) {
+            matches = false;
+        }
+    }
+    TEST_ASSERT(matches, "Popped pieces match the earlier lookahead");
+}
+
+// Test that a seed always produces the same sequence
+void test_piece_queue_seeded_sequence(void) {
+    piece_queue_t first, second, other;
+    
+    piece_queue_init(&first, 3, 1234);
+    piece_queue_init(&second, 7, 1234);
+    piece_queue_init(&other, 3, 4321);
+    
+    bool same = true;
+    bool different = false;
+    for (int i = 0; i < 200; i++) {
+        piece_type_t type = piece_queue_pop(&first);
+        if (type != piece_queue_pop(&second)) {
+            same = false;
+        }
+        if (type != piece_queue_pop(&other)) {
+            different = true;
+        }
+    }
+    TEST_ASSERT(same, "Same seed gives the same sequence regardless of depth");
+    TEST_ASSERT(different, "Different seeds give different sequences");
+}
+
+// Main piece queue test runner
+void run_piece_queue_tests(void) {
+    printf("\n=== Piece Queue Tests ===\n\n");
+    
+    RUN_TEST(test_piece_queue_depth);
+    RUN_TEST(test_piece_queue_peek_matches_pop);
+    RUN_TEST(test_piece_queue_seeded_sequence);
+}
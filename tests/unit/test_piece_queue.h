@@ -0,0 +1,17 @@
+/**
+ * @file test_piece_queue.h
+ * @brief Header for piece preview queue tests
+ */
+
+#ifndef TEST_PIECE_QUEUE_H
+#define TEST_PIECE_QUEUE_H
+
+// Test function declarations
+void test_piece_queue_depth(void);
+void test_piece_queue_peek_matches_pop(void);
+void test_piece_queue_seeded_sequence(void);
+
+// Main test runner function
+void run_piece_queue_tests(void);
+
+#endif // TEST_PIECE_QUEUE_H
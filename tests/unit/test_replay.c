@@ -0,0 +1,296 @@
+/**
+ * @file test_replay.c
+ * @brief Tests for replay files, the PNG encoder and exporting a replay's
+ * frames as raw RGBA or a PNG sequence
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/save/replay_file.h"
+#include "../../game/src/rendering/png_encoder.h"
+#include "../../game/src/rendering/replay_export.h"
+#include "test_replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_REPLAY_PATH "test_replay.btrp"
+#define TEST_EXPORT_DIR "test_replay_frames"
+
+// Small, slow export so the tests write little: 3 seconds at 10 fps with 8 pixel cells
+#define TEST_REPLAY_TICKS 300
+#define TEST_FRAME_RATE 10
+#define TEST_CELL_SIZE 8
+
+static void make_replay(replay_t *replay) {
+    game_config_t config;
+    game_config_init(&config);
+    config.board_width = 8;
+    config.board_height = 16;
+    replay_init(replay, &config, 0x5EEDULL);
+    
+    for (int tick = 0; tick < TEST_REPLAY_TICKS; tick++) {
+        sim_input_t input = 0;
+        if (tick % 40 == 39) {
+            input = SIM_INPUT_HARD_DROP;
+        } else if (tick % 40 < 3) {
+            input = tick % 80 < 40 ? SIM_INPUT_LEFT : SIM_INPUT_RIGHT;
+        } else if (tick % 40 == 10) {
+            input = SIM_INPUT_ROTATE_CW;
+        }
+        replay_append(replay, input);
+    }
+}
+
+static long file_size(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return -1;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+static void overwrite_byte(const char *path, long offset, uint8_t value) {
+    FILE *file = fopen(path, "r+b");
+    if (file) {
+        fseek(file, offset, SEEK_SET);
+        fputc(value, file);
+        fclose(file);
+    }
+}
+
+static void frame_path(char *path, size_t size, uint32_t frame) {
+    snprintf(path, size, "%s/frame-%06lu.png", TEST_EXPORT_DIR, (unsigned long)frame);
+}
+
+/**
+ * Read a file whole (caller frees), NULL if it's missing
+ */
+static uint8_t *read_file(const char *path, long *size) {
+    *size = file_size(path);
+    FILE *file = *size >= 0 ? fopen(path, "rb") : NULL;
+    if (!file) {
+        return NULL;
+    }
+    uint8_t *data = malloc((size_t)*size + 1);
+    if (data && fread(data, 1, (size_t)*size, file) != (size_t)*size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    return data;
+}
+
+static void remove_frames(uint32_t frame_count) {
+    char path[REPLAY_EXPORT_PATH_SIZE + 32];
+    for (uint32_t frame = 0; frame < frame_count; frame++) {
+        frame_path(path, sizeof(path), frame);
+        remove(path);
+    }
+    remove(TEST_EXPORT_DIR);
+}
+
+// Test that a saved replay loads back with the same settings, seed and inputs
+void test_replay_file_round_trip(void) {
+    static replay_t replay;
+    static replay_t loaded;
+    make_replay(&replay);
+    TEST_ASSERT_EQUAL(TEST_REPLAY_TICKS, (int)replay.tick_count, "Every tick is recorded");
+    
+    TEST_ASSERT(replay_save(TEST_REPLAY_PATH, &replay), "The replay is saved");
+    TEST_ASSERT_EQUAL(REPLAY_FILE_HEADER_SIZE + TEST_REPLAY_TICKS, (int)file_size(TEST_REPLAY_PATH),
+                      "A replay is its header and a byte per tick");
+    TEST_ASSERT(replay_load(TEST_REPLAY_PATH, &loaded), "The replay loads");
+    TEST_ASSERT_EQUAL(8, loaded.config.board_width, "The board width is restored");
+    TEST_ASSERT_EQUAL(16, loaded.config.board_height, "The board height is restored");
+    TEST_ASSERT_EQUAL(replay.config.preview_depth, loaded.config.preview_depth, "The preview depth is restored");
+    TEST_ASSERT(loaded.seed == replay.seed, "The seed is restored");
+    TEST_ASSERT(loaded.tick_count == replay.tick_count &&
+                memcmp(loaded.inputs, replay.inputs, replay.tick_count) == 0, "The inputs are restored");
+    
+    replay_free(&loaded);
+    replay_free(&replay);
+    remove(TEST_REPLAY_PATH);
+}
+
+// Test that damaged or inconsistent files are refused
+void test_replay_file_rejects_damage(void) {
+    static replay_t replay;
+    static replay_t loaded;
+    make_replay(&replay);
+    
+    replay_save(TEST_REPLAY_PATH, &replay);
+    overwrite_byte(TEST_REPLAY_PATH, 0, 'X');
+    TEST_ASSERT(!replay_load(TEST_REPLAY_PATH, &loaded), "A file without the magic is refused");
+    
+    replay_save(TEST_REPLAY_PATH, &replay);
+    overwrite_byte(TEST_REPLAY_PATH, 6, 200);
+    TEST_ASSERT(!replay_load(TEST_REPLAY_PATH, &loaded), "An out-of-range board width is refused");
+    
+    replay_save(TEST_REPLAY_PATH, &replay);
+    overwrite_byte(TEST_REPLAY_PATH, REPLAY_FILE_HEADER_SIZE + 5, 0x80);
+    TEST_ASSERT(!replay_load(TEST_REPLAY_PATH, &loaded), "An input with unknown bits is refused");
+    
+    replay.tick_count--;
+    replay_save(TEST_REPLAY_PATH, &replay);
+    replay.tick_count++;
+    overwrite_byte(TEST_REPLAY_PATH, 24, TEST_REPLAY_TICKS & 0xFF);
+    overwrite_byte(TEST_REPLAY_PATH, 25, TEST_REPLAY_TICKS >> 8);
+    TEST_ASSERT(!replay_load(TEST_REPLAY_PATH, &loaded), "A truncated file is refused");
+    TEST_ASSERT(loaded.inputs == NULL && loaded.tick_count == 0, "A refused file leaves an empty replay");
+    
+    TEST_ASSERT(!replay_load("test_replay_missing.btrp", &loaded), "A missing file is refused");
+    
+    replay_free(&replay);
+    remove(TEST_REPLAY_PATH);
+}
+
+// Test the PNG framing and that flat frames compress well
+void test_replay_png_encoder(void) {
+    enum { WIDTH = 64, HEIGHT = 48 };
+    static uint32_t pixels[WIDTH * HEIGHT];
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            // Blocks of flat colour, as in a game frame
+            uint8_t r = (uint8_t)(x / 16 * 60);
+            uint8_t g = (uint8_t)(y / 12 * 50);
+            uint8_t rgba[4] = { r, g, 90, 255 };
+            memcpy(&pixels[y * WIDTH + x], rgba, sizeof(rgba));
+        }
+    }
+    
+    size_t bound = png_encoder_bound(WIDTH, HEIGHT);
+    uint8_t *png = malloc(bound);
+    size_t size = png_encoder_encode(pixels, WIDTH, HEIGHT, WIDTH, png, bound);
+    TEST_ASSERT(size > 0 && size <= bound, "The image is encoded within the bound");
+    
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    TEST_ASSERT(memcmp(png, signature, sizeof(signature)) == 0, "The PNG signature comes first");
+    TEST_ASSERT(memcmp(png + 12, "IHDR", 4) == 0 && png[19] == WIDTH && png[23] == HEIGHT,
+                "The header chunk holds the image size");
+    TEST_ASSERT(png[24] == 8 && png[25] == 2, "Pixels are stored as 8-bit RGB");
+    TEST_ASSERT(memcmp(png + size - 8, "IEND", 4) == 0, "The end chunk comes last");
+    TEST_ASSERT(size * 20 < (size_t)WIDTH * HEIGHT * 3, "A flat-coloured frame compresses well");
+    
+    TEST_ASSERT_EQUAL(0, (int)png_encoder_encode(pixels, WIDTH, HEIGHT, WIDTH, png, size / 2),
+                      "An output buffer too small is reported");
+    TEST_ASSERT_EQUAL(0, (int)png_encoder_bound(0, HEIGHT), "An empty image has no bound");
+    free(png);
+}
+
+// Test that raw export writes every frame, the same every time
+void test_replay_export_raw(void) {
+    static replay_t replay;
+    make_replay(&replay);
+    
+    int width = 0;
+    int height = 0;
+    replay_export_frame_size(&replay, TEST_CELL_SIZE, &width, &height);
+    TEST_ASSERT(width > 10 * TEST_CELL_SIZE && height >= 18 * TEST_CELL_SIZE, "A frame holds the board and its margins");
+    TEST_ASSERT(width % 2 == 0 && height % 2 == 0, "Frame sizes are even");
+    uint32_t frames = replay_export_frame_count(&replay, TEST_FRAME_RATE);
+    TEST_ASSERT_EQUAL(TEST_REPLAY_TICKS * TEST_FRAME_RATE / SIM_TICK_RATE + 1, (int)frames,
+                      "There is a frame for the start and one per frame period");
+    
+    replay_export_options_t options;
+    replay_export_options_init(&options);
+    options.frame_rate = TEST_FRAME_RATE;
+    options.cell_size = TEST_CELL_SIZE;
+    
+    long sizes[2];
+    uint8_t *outputs[2];
+    for (int run = 0; run < 2; run++) {
+        FILE *out = tmpfile();
+        options.raw_out = out;
+        replay_export_result_t result;
+        TEST_ASSERT(out && replay_export_run(&replay, &options, &result), "The replay is exported");
+        TEST_ASSERT(result.width == width && result.height == height && result.frames == frames,
+                    "The result reports the frame size and count");
+        
+        sizes[run] = out ? ftell(out) : -1;
+        outputs[run] = sizes[run] > 0 ? malloc((size_t)sizes[run]) : NULL;
+        if (outputs[run]) {
+            rewind(out);
+            fread(outputs[run], 1, (size_t)sizes[run], out);
+        }
+        if (out) {
+            fclose(out);
+        }
+    }
+    TEST_ASSERT(sizes[0] == (long)frames * width * height * 4, "Every frame is written as raw RGBA");
+    TEST_ASSERT(outputs[0] && outputs[1] && sizes[0] == sizes[1] &&
+                memcmp(outputs[0], outputs[1], (size_t)sizes[0]) == 0, "Exporting again gives the same frames");
+    
+    long frame_size = (long)width * height * 4;
+    TEST_ASSERT(outputs[0] && memcmp(outputs[0], outputs[0] + (frames - 1) * frame_size, (size_t)frame_size) != 0,
+                "The game moves between the first and last frames");
+    
+    free(outputs[0]);
+    free(outputs[1]);
+    replay_free(&replay);
+}
+
+// Test that the PNG sequence is complete and doesn't depend on the encoder threads
+void test_replay_export_png_sequence(void) {
+    static replay_t replay;
+    make_replay(&replay);
+    uint32_t frames = replay_export_frame_count(&replay, TEST_FRAME_RATE);
+    remove_frames(frames);
+    
+    replay_export_options_t options;
+    replay_export_options_init(&options);
+    options.format = REPLAY_EXPORT_PNG;
+    options.png_dir = TEST_EXPORT_DIR;
+    options.frame_rate = TEST_FRAME_RATE;
+    options.cell_size = TEST_CELL_SIZE;
+    options.threads = 1;
+    
+    replay_export_result_t result;
+    TEST_ASSERT(replay_export_run(&replay, &options, &result) && result.frames == frames,
+                "The replay is exported with one encoder");
+    
+    // Keep the single-threaded frames to compare with
+    static uint8_t *single[TEST_REPLAY_TICKS];
+    static long single_sizes[TEST_REPLAY_TICKS];
+    char path[REPLAY_EXPORT_PATH_SIZE + 32];
+    bool complete = true;
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        frame_path(path, sizeof(path), frame);
+        single[frame] = read_file(path, &single_sizes[frame]);
+        complete &= single[frame] != NULL;
+    }
+    TEST_ASSERT(complete, "Every frame has its file");
+    frame_path(path, sizeof(path), frames);
+    TEST_ASSERT_EQUAL(-1, (int)file_size(path), "No frame is written past the end");
+    
+    options.threads = 3;
+    TEST_ASSERT(replay_export_run(&replay, &options, &result) && result.frames == frames,
+                "The replay is exported with three encoders");
+    bool same = true;
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        long size = 0;
+        frame_path(path, sizeof(path), frame);
+        uint8_t *data = read_file(path, &size);
+        same &= data && single[frame] && size == single_sizes[frame] && memcmp(data, single[frame], (size_t)size) == 0;
+        free(data);
+        free(single[frame]);
+        single[frame] = NULL;
+    }
+    TEST_ASSERT(same, "Encoder threads give the same files");
+    
+    remove_frames(frames);
+    replay_free(&replay);
+}
+
+// Main replay test runner
+void run_replay_tests(void) {
+    printf("\n=== Replay Tests ===\n\n");
+    
+    RUN_TEST(test_replay_file_round_trip);
+    RUN_TEST(test_replay_file_rejects_damage);
+    RUN_TEST(test_replay_png_encoder);
+    RUN_TEST(test_replay_export_raw);
+    RUN_TEST(test_replay_export_png_sequence);
+}
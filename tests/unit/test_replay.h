@@ -0,0 +1,19 @@
+/**
+ * @file test_replay.h
+ * @brief Header for replay file and frame exporter tests
+ */
+
+#ifndef TEST_REPLAY_H
+#define TEST_REPLAY_H
+
+// Test function declarations
+void test_replay_file_round_trip(void);
+void test_replay_file_rejects_damage(void);
+void test_replay_png_encoder(void);
+void test_replay_export_raw(void);
+void test_replay_export_png_sequence(void);
+
+// Main test runner function
+void run_replay_tests(void);
+
+#endif // TEST_REPLAY_H
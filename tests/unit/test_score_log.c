@@ -0,0 +1,69 @@
+/**
+ * @file test_score_log.c
+ * @brief Tests for the per-event score log
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/scoring/score_log.h"
+#include "test_score_log.h"
+#include <stddef.h>
+
+static score_event_t make_event(uint32_t tick, score_event_type_t type, int amount, int points) {
+    score_event_t event;
+    event.tick = tick;
+    event.type = (uint8_t)type;
+    event.level = 1;
+    event.amount = (uint16_t)amount;
+    event.points = points;
+    return event;
+}
+
+// Test that events are kept in order and totalled per type
+void test_score_log_append_and_totals(void) {
+    static score_log_t log;
+    
+    score_log_reset(&log);
+    TEST_ASSERT_EQUAL(0, score_log_count(&log), "Reset log is empty");
+    TEST_ASSERT(score_log_get(&log, 0) == NULL, "Empty log has no events");
+    
+    score_event_t soft = make_event(10, SCORE_EVENT_SOFT_DROP, 3, 3);
+    score_event_t hard = make_event(20, SCORE_EVENT_HARD_DROP, 12, 24);
+    score_event_t clear = make_event(21, SCORE_EVENT_LINE_CLEAR, 2, 300);
+    score_log_append(&log, &soft);
+    score_log_append(&log, &hard);
+    score_log_append(&log, &clear);
+    
+    TEST_ASSERT_EQUAL(3, score_log_count(&log), "Three events logged");
+    TEST_ASSERT(score_log_get(&log, 0)->tick == 10 && score_log_get(&log, 2)->tick == 21,
+                "Events are read oldest first");
+    TEST_ASSERT(log.points_by_type[SCORE_EVENT_SOFT_DROP] == 3 &&
+                log.points_by_type[SCORE_EVENT_HARD_DROP] == 24 &&
+                log.points_by_type[SCORE_EVENT_LINE_CLEAR] == 300,
+                "Points are totalled per event type");
+}
+
+// Test that the log keeps the most recent events and complete totals after wrapping
+void test_score_log_wraps(void) {
+    static score_log_t log;
+    
+    score_log_reset(&log);
+    for (int i = 0; i < SCORE_LOG_CAPACITY + 10; i++) {
+        score_event_t event = make_event((uint32_t)i, SCORE_EVENT_SOFT_DROP, 1, 1);
+        score_log_append(&log, &event);
+    }
+    
+    TEST_ASSERT_EQUAL(SCORE_LOG_CAPACITY, score_log_count(&log), "Log holds at most its capacity");
+    TEST_ASSERT(score_log_get(&log, 0)->tick == 10, "Oldest events are overwritten first");
+    TEST_ASSERT(score_log_get(&log, SCORE_LOG_CAPACITY - 1)->tick == SCORE_LOG_CAPACITY + 9,
+                "Newest event is last");
+    TEST_ASSERT(log.points_by_type[SCORE_EVENT_SOFT_DROP] == SCORE_LOG_CAPACITY + 10,
+                "Totals include overwritten events");
+}
+
+// Main score log test runner
+void run_score_log_tests(void) {
+    printf("\n=== Score Log Tests ===\n\n");
+    
+    RUN_TEST(test_score_log_append_and_totals);
+    RUN_TEST(test_score_log_wraps);
+}
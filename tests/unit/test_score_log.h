@@ -0,0 +1,16 @@
+/**
+ * @file test_score_log.h
+ * @brief Header for score log tests
+ */
+
+#ifndef TEST_SCORE_LOG_H
+#define TEST_SCORE_LOG_H
+
+// Test function declarations
+void test_score_log_append_and_totals(void);
+void test_score_log_wraps(void);
+
+// Main test runner function
+void run_score_log_tests(void);
+
+#endif // TEST_SCORE_LOG_H
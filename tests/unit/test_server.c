@@ -0,0 +1,388 @@
+/**
+ * @file test_server.c
+ * @brief Tests for the tournament server: wire format, placements, and many
+ * bots playing at once over loopback against a local replay of their games
+ */
+
+// Sockets and threads are POSIX, not C99
+#define _POSIX_C_SOURCE 200809L
+
+#include "../test_framework.h"
+#include "../test_fixtures.h"
+#include "../../game/src/server/bot_session.h"
+#include "../../game/src/server/server_protocol.h"
+#include "../../game/src/server/tournament_server.h"
+#include "../../game/src/utils/utils.h"
+#include "test_server.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define TEST_BOTS 200
+#define TEST_PLACEMENTS 30
+#define PIPELINED_PLACEMENTS 150 // More than one worker turn and the reply buffer hold
+
+static bot_placement_t random_placement(uint64_t *rng_state, int board_width) {
+    uint32_t r = (uint32_t)(utils_next_random(rng_state) >> 32);
+    bot_placement_t placement;
+    placement.hold = r % 8 == 0;
+    placement.rotation = (int)((r >> 3) % 4);
+    placement.x = (int)((r >> 5) % (uint32_t)(board_width + 2)) - 2;
+    return placement;
+}
+
+// Test that requests and STATE replies survive encoding and that bad frames are caught
+void test_server_protocol_round_trip(void) {
+    uint8_t buffer[SERVER_FRAME_MAX_SIZE];
+    size_t frame_size = 0;
+    
+    server_request_t start;
+    memset(&start, 0, sizeof(start));
+    start.type = SERVER_MSG_START;
+    start.seed = 0x0123456789ABCDEFULL;
+    start.board_width = 10;
+    start.board_height = 20;
+    start.preview_depth = 5;
+    
+    size_t size = server_protocol_write_request(buffer, sizeof(buffer), &start);
+    TEST_ASSERT_EQUAL(SERVER_FRAME_INCOMPLETE, server_protocol_next_frame(buffer, size - 1, &frame_size),
+                      "A partial frame waits for more bytes");
+    TEST_ASSERT(server_protocol_next_frame(buffer, size, &frame_size) == SERVER_FRAME_READY && frame_size == size,
+                "A whole frame is found");
+    
+    server_request_t decoded;
+    TEST_ASSERT(server_protocol_read_request(buffer, size, &decoded), "START decodes");
+    TEST_ASSERT(decoded.type == SERVER_MSG_START && decoded.seed == start.seed &&
+                decoded.board_width == 10 && decoded.board_height == 20 && decoded.preview_depth == 5,
+                "START fields survive the round trip");
+    
+    server_request_t place;
+    memset(&place, 0, sizeof(place));
+    place.type = SERVER_MSG_PLACE;
+    place.placement.hold = true;
+    place.placement.rotation = 3;
+    place.placement.x = -2;
+    size = server_protocol_write_request(buffer, sizeof(buffer), &place);
+    TEST_ASSERT(server_protocol_read_request(buffer, size, &decoded) && decoded.type == SERVER_MSG_PLACE &&
+                decoded.placement.hold && decoded.placement.rotation == 3 && decoded.placement.x == -2,
+                "PLACE fields survive the round trip, negative column included");
+    
+    buffer[0] = 0xFF;
+    TEST_ASSERT_EQUAL(SERVER_FRAME_MALFORMED, server_protocol_next_frame(buffer, size, &frame_size),
+                      "An oversized length is malformed");
+    
+    // A STATE reply describes the game exactly
+    game_config_t config;
+    test_make_config(&config, 10, 20);
+    bot_session_t session;
+    bot_session_init(&session, NULL);
+    size = server_protocol_write_state(buffer, sizeof(buffer), &session, BOT_PLACE_NOT_STARTED);
+    server_state_t state;
+    TEST_ASSERT(server_protocol_read_state(buffer, size, &state) && state.result == BOT_PLACE_NOT_STARTED &&
+                state.board_width == 0, "STATE without a game carries no board");
+    
+    bot_session_start(&session, &config, 99);
+    uint64_t rng = 7;
+    for (int i = 0; i < 12; i++) {
+        bot_placement_t placement = random_placement(&rng, config.board_width);
+        bot_session_place(&session, &placement);
+    }
+    size = server_protocol_write_state(buffer, sizeof(buffer), &session, BOT_PLACE_OK);
+    TEST_ASSERT(server_protocol_read_state(buffer, size, &state), "STATE decodes");
+    TEST_ASSERT(state.board_width == 10 && state.board_height == 20 &&
+                state.piece_type == session.sim.piece.type && state.piece_x == session.sim.piece.x &&
+                state.hold_type == session.sim.hold_type && state.score == (uint32_t)session.sim.score &&
+                state.pieces_placed == session.sim.pieces_locked,
+                "STATE header matches the game");
+    TEST_ASSERT(state.preview_count == config.preview_depth &&
+                state.preview[0] == piece_queue_peek(&session.sim.queue, 0), "STATE preview matches the queue");
+    
+    bool rows_match = true;
+    for (int y = 0; y < state.board_height; y++) {
+        rows_match &= state.rows[y] == session.sim.board.rows[y];
+    }
+    TEST_ASSERT(rows_match, "STATE rows match the bitboard");
+    TEST_ASSERT(!server_protocol_read_state(buffer, size - 1, &state), "Truncated STATE is rejected");
+}
+
+// Test that placements land where asked, stop at walls and respect the game state
+void test_bot_session_placement(void) {
+    game_config_t config;
+    test_make_config(&config, 10, 20);
+    
+    bot_session_t session;
+    bot_session_init(&session, NULL);
+    bot_placement_t placement = { false, 0, 0 };
+    TEST_ASSERT_EQUAL(BOT_PLACE_NOT_STARTED, bot_session_place(&session, &placement),
+                      "Placing before a game starts is refused");
+    
+    bot_session_start(&session, &config, 1234);
+    piece_type_t second = piece_queue_peek(&session.sim.queue, 0);
+    placement.rotation = 1;
+    placement.x = 2;
+    TEST_ASSERT_EQUAL(BOT_PLACE_OK, bot_session_place(&session, &placement), "Reachable placement succeeds");
+    TEST_ASSERT_EQUAL(1, (int)session.sim.pieces_locked, "The piece locked");
+    TEST_ASSERT_EQUAL(second, session.sim.piece.type, "The next piece came up");
+    
+    placement.rotation = 0;
+    placement.x = -20;
+    TEST_ASSERT_EQUAL(BOT_PLACE_BLOCKED, bot_session_place(&session, &placement), "Placement past the wall is blocked");
+    TEST_ASSERT_EQUAL(2, (int)session.sim.pieces_locked, "A blocked piece still drops");
+    
+    placement.hold = true;
+    placement.x = 4;
+    piece_type_t held = session.sim.piece.type;
+    bot_session_place(&session, &placement);
+    TEST_ASSERT_EQUAL(held, session.sim.hold_type, "Hold keeps the current piece");
+    
+    // Stacking in one column ends the game
+    placement.hold = false;
+    bot_place_result_t result = BOT_PLACE_OK;
+    for (int i = 0; i < 100 && result != BOT_PLACE_GAME_OVER; i++) {
+        result = bot_session_place(&session, &placement);
+    }
+    TEST_ASSERT(session.sim.game_over, "Stacking one column tops out");
+    TEST_ASSERT_EQUAL(BOT_PLACE_GAME_OVER, bot_session_place(&session, &placement), "No placements after game over");
+}
+
+static void *server_thread(void *data) {
+    tournament_server_run((tournament_server_t *)data);
+    return NULL;
+}
+
+static int connect_bot(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    
+    return fd;
+}
+
+static bool send_all(int fd, const uint8_t *data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = send(fd, data, size, 0);
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= (size_t)sent;
+    }
+    return true;
+}
+
+static bool receive_all(int fd, uint8_t *data, size_t size) {
+    while (size > 0) {
+        ssize_t received = recv(fd, data, size, 0);
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        size -= (size_t)received;
+    }
+    return true;
+}
+
+static bool send_request(int fd, const server_request_t *request) {
+    uint8_t buffer[SERVER_FRAME_MAX_SIZE];
+    size_t size = server_protocol_write_request(buffer, sizeof(buffer), request);
+    return size > 0 && send_all(fd, buffer, size);
+}
+
+static bool receive_state(int fd, server_state_t *state) {
+    uint8_t buffer[SERVER_FRAME_MAX_SIZE];
+    if (!receive_all(fd, buffer, 2)) {
+        return false;
+    }
+    
+    size_t length = ((size_t)buffer[0] << 8) | buffer[1];
+    return length > 0 && length <= sizeof(buffer) - 2 && receive_all(fd, buffer + 2, length) &&
+           server_protocol_read_state(buffer, length + 2, state);
+}
+
+/**
+ * Check a reply against the same game played locally
+ */
+static bool state_matches(const server_state_t *state, const bot_session_t *session, bot_place_result_t result) {
+    if (state->result != result || state->pieces_placed != session->sim.pieces_locked ||
+        state->score != (uint32_t)session->sim.score || state->piece_type != (session->sim.piece.active ?
+        session->sim.piece.type : PIECE_EMPTY)) {
+        return false;
+    }
+    
+    for (int y = 0; y < state->board_height; y++) {
+        if (state->rows[y] != session->sim.board.rows[y]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static server_request_t start_request(uint64_t seed) {
+    server_request_t request;
+    memset(&request, 0, sizeof(request));
+    request.type = SERVER_MSG_START;
+    request.seed = seed;
+    request.board_width = 10;
+    request.board_height = 20;
+    return request;
+}
+
+// Test that a session records its games for spectators, from the first keyframe to every placement
+void test_bot_session_spectator_stream(void) {
+    game_config_t config;
+    test_make_config(&config, 10, 20);
+    
+    static spectator_stream_t stream;
+    static spectator_replica_t replica;
+    bot_session_t session;
+    bot_session_init(&session, &stream);
+    spectator_replica_init(&replica);
+    
+    bot_session_start(&session, &config, 2024);
+    size_t size;
+    const uint8_t *data = spectator_stream_catch_up(&stream, &size);
+    TEST_ASSERT(size > 0 && data[0] == 0x01, "Starting a game writes a keyframe");
+    
+    uint64_t rng = 11;
+    bool in_sync = spectator_replica_apply(&replica, data, size);
+    for (int i = 0; i < 40 && !session.sim.game_over; i++) {
+        bot_placement_t placement = random_placement(&rng, config.board_width);
+        bot_session_place(&session, &placement);
+    }
+    data = spectator_stream_catch_up(&stream, &size);
+    in_sync &= spectator_replica_apply(&replica, data, size);
+    
+    const blocktris_sim_t *watched = &replica.sim;
+    TEST_ASSERT(in_sync && replica.synced, "The recorded stream applies");
+    TEST_ASSERT(watched->pieces_locked == session.sim.pieces_locked && watched->score == session.sim.score &&
+                memcmp(watched->board.rows, session.sim.board.rows,
+                       (size_t)session.sim.board.height * sizeof(board_row_t)) == 0,
+                "A spectator sees the session's game");
+}
+
+// Test that hundreds of bots play at once, each getting exactly its own game
+void test_tournament_server_concurrent_games(void) {
+    tournament_server_config_t config;
+    tournament_server_config_init(&config);
+    config.port = 0;
+    config.threads = 4;
+    config.max_games = TEST_BOTS + 1;
+    config.spectate = true; // The workers record every game as well
+    test_make_config(&config.defaults, 10, 20);
+    
+    static tournament_server_t server;
+    TEST_ASSERT(tournament_server_open(&server, &config), "Server opens on a free port");
+    uint16_t port = tournament_server_port(&server);
+    pthread_t thread;
+    TEST_ASSERT(pthread_create(&thread, NULL, server_thread, &server) == 0, "Server thread starts");
+    
+    // Every bot starts a game, then they take turns placing pieces
+    static int fds[TEST_BOTS];
+    static bot_session_t expected[TEST_BOTS];
+    static uint64_t rng[TEST_BOTS];
+    game_config_t game_config;
+    test_make_config(&game_config, 10, 20);
+    
+    bool connected = true;
+    bool replies_match = true;
+    for (int i = 0; i < TEST_BOTS; i++) {
+        fds[i] = connect_bot(port);
+        connected &= fds[i] >= 0;
+        rng[i] = (uint64_t)i * 7919 + 1;
+        
+        server_request_t request = start_request((uint64_t)i + 1);
+        server_state_t state;
+        bot_session_init(&expected[i], NULL);
+        bot_session_start(&expected[i], &game_config, (uint64_t)i + 1);
+        replies_match &= fds[i] >= 0 && send_request(fds[i], &request) && receive_state(fds[i], &state) &&
+                         state_matches(&state, &expected[i], BOT_PLACE_OK);
+    }
+    TEST_ASSERT(connected, "All bots connect");
+    TEST_ASSERT_EQUAL(TEST_BOTS, tournament_server_active_games(&server), "One game per bot");
+    
+    for (int turn = 0; turn < TEST_PLACEMENTS && connected; turn++) {
+        // Send everyone's request before reading any reply, so the workers overlap
+        server_request_t requests[TEST_BOTS];
+        for (int i = 0; i < TEST_BOTS; i++) {
+            memset(&requests[i], 0, sizeof(requests[i]));
+            requests[i].type = SERVER_MSG_PLACE;
+            requests[i].placement = random_placement(&rng[i], game_config.board_width);
+            replies_match &= send_request(fds[i], &requests[i]);
+        }
+        for (int i = 0; i < TEST_BOTS; i++) {
+            server_state_t state;
+            bot_place_result_t result = bot_session_place(&expected[i], &requests[i].placement);
+            replies_match &= receive_state(fds[i], &state) && state_matches(&state, &expected[i], result);
+        }
+    }
+    TEST_ASSERT(replies_match, "Every reply matches the bot's game played locally");
+    
+    // One bot fires a long burst without reading; replies still come back in order
+    int burst_fd = connect_bot(port);
+    bot_session_t burst_expected;
+    bot_session_init(&burst_expected, NULL);
+    bot_session_start(&burst_expected, &game_config, 555);
+    server_request_t burst_start = start_request(555);
+    static uint8_t burst[PIPELINED_PLACEMENTS * 8];
+    static bot_placement_t burst_placements[PIPELINED_PLACEMENTS];
+    size_t burst_size = server_protocol_write_request(burst, sizeof(burst), &burst_start);
+    uint64_t burst_rng = 31;
+    for (int i = 0; i < PIPELINED_PLACEMENTS; i++) {
+        server_request_t request;
+        memset(&request, 0, sizeof(request));
+        request.type = SERVER_MSG_PLACE;
+        request.placement = random_placement(&burst_rng, game_config.board_width);
+        burst_placements[i] = request.placement;
+        burst_size += server_protocol_write_request(burst + burst_size, sizeof(burst) - burst_size, &request);
+    }
+    
+    bool burst_matches = burst_fd >= 0 && send_all(burst_fd, burst, burst_size);
+    server_state_t state;
+    burst_matches &= receive_state(burst_fd, &state) && state_matches(&state, &burst_expected, BOT_PLACE_OK);
+    for (int i = 0; i < PIPELINED_PLACEMENTS && burst_matches; i++) {
+        bot_place_result_t result = bot_session_place(&burst_expected, &burst_placements[i]);
+        burst_matches &= receive_state(burst_fd, &state) && state_matches(&state, &burst_expected, result);
+    }
+    TEST_ASSERT(burst_matches, "Pipelined requests are all answered in order");
+    
+    // Garbage gets the connection dropped
+    uint8_t junk[4] = { 0x00, 0x02, 0x7F, 0x00 };
+    uint8_t byte;
+    TEST_ASSERT(send_all(burst_fd, junk, sizeof(junk)) && recv(burst_fd, &byte, 1, 0) == 0,
+                "A malformed request closes the connection");
+    close(burst_fd);
+    
+    for (int i = 0; i < TEST_BOTS; i++) {
+        if (fds[i] >= 0) {
+            close(fds[i]);
+        }
+    }
+    
+    tournament_server_stop(&server);
+    pthread_join(thread, NULL);
+    tournament_server_close(&server);
+}
+
+// Main tournament server test runner
+void run_server_tests(void) {
+    printf("\n=== Tournament Server Tests ===\n\n");
+    
+    RUN_TEST(test_server_protocol_round_trip);
+    RUN_TEST(test_bot_session_placement);
+    RUN_TEST(test_bot_session_spectator_stream);
+    RUN_TEST(test_tournament_server_concurrent_games);
+}
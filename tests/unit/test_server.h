@@ -0,0 +1,18 @@
+/**
+ * @file test_server.h
+ * @brief Header for tournament server tests (protocol, placements, spectator stream, many concurrent bots)
+ */
+
+#ifndef TEST_SERVER_H
+#define TEST_SERVER_H
+
+// Test function declarations
+void test_server_protocol_round_trip(void);
+void test_bot_session_placement(void);
+void test_bot_session_spectator_stream(void);
+void test_tournament_server_concurrent_games(void);
+
+// Main test runner function
+void run_server_tests(void);
+
+#endif // TEST_SERVER_H
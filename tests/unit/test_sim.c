@@ -0,0 +1,182 @@
+/**
+ * @file test_sim.c
+ * @brief Tests for the player simulation shared by every mode: the hold
+ * slot, line clears with and without a delay, and points awarded through the
+ * score module
+ */
+
+#include "../test_framework.h"
+#include "../test_fixtures.h"
+#include "../../game/src/simulation/blocktris_sim.h"
+#include "../../game/src/collision/blocktris_collision.h"
+#include "../../game/src/scoring/blocktris_score.h"
+#include "test_sim.h"
+
+#define BOTTOM_ROW 19
+
+static void init_sim(blocktris_sim_t *sim) {
+    game_config_t config;
+    test_make_instant_lock_config(&config, 10, BOTTOM_ROW + 1);
+    blocktris_sim_init(sim, &config, 4321);
+}
+
+/**
+ * Fill the bottom row around where a hard drop puts the falling piece, so the drop completes it
+ */
+static void complete_bottom_row_on_drop(blocktris_sim_t *sim) {
+    blocktris_sim_t scratch;
+    blocktris_sim_copy(&scratch, sim);
+    blocktris_sim_step(&scratch, SIM_INPUT_HARD_DROP);
+    
+    for (int x = 0; x < sim->board.width; x++) {
+        if (!game_board_is_cell_filled(&scratch.board, x, BOTTOM_ROW)) {
+            game_board_set_cell(&sim->board, x, BOTTOM_ROW, PIECE_I, BOARD_CELL_LOCKED);
+        }
+    }
+}
+
+// Test that the first hold keeps the piece and takes the next one from the queue
+void test_sim_first_hold_takes_from_queue(void) {
+    blocktris_sim_t sim;
+    init_sim(&sim);
+    piece_type_t first = sim.piece.type;
+    piece_type_t next = piece_queue_peek(&sim.queue, 0);
+    piece_type_t after_next = piece_queue_peek(&sim.queue, 1);
+    
+    blocktris_sim_step(&sim, SIM_INPUT_HOLD);
+    TEST_ASSERT(sim.events.flags & SIM_EVENT_HELD, "The hold is reported");
+    TEST_ASSERT_EQUAL(first, sim.hold_type, "The falling piece went to the hold slot");
+    TEST_ASSERT_EQUAL(next, sim.piece.type, "The next piece came from the queue");
+    TEST_ASSERT_EQUAL(after_next, piece_queue_peek(&sim.queue, 0), "The queue moved on by one");
+    TEST_ASSERT(sim.piece.active && sim.piece.y == 0 && sim.piece.rotation == 0, "The new piece enters at the top");
+}
+
+// Test that a piece can only be held once, until the next piece locks
+void test_sim_hold_once_per_piece(void) {
+    blocktris_sim_t sim;
+    init_sim(&sim);
+    piece_type_t first = sim.piece.type;
+    
+    blocktris_sim_step(&sim, SIM_INPUT_HOLD);
+    piece_type_t second = sim.piece.type;
+    blocktris_sim_step(&sim, SIM_INPUT_HOLD);
+    TEST_ASSERT(!(sim.events.flags & SIM_EVENT_HELD), "A second hold is refused");
+    TEST_ASSERT_EQUAL(second, sim.piece.type, "The falling piece stays");
+    TEST_ASSERT_EQUAL(first, sim.hold_type, "The held piece stays");
+    TEST_ASSERT(sim.hold_used, "Hold stays used for this piece");
+    
+    blocktris_sim_step(&sim, SIM_INPUT_HARD_DROP);
+    TEST_ASSERT(!sim.hold_used, "The next piece may hold again");
+}
+
+// Test that a later hold swaps the falling piece with the held one, leaving the queue alone
+void test_sim_hold_swaps_with_held_piece(void) {
+    blocktris_sim_t sim;
+    init_sim(&sim);
+    piece_type_t first = sim.piece.type;
+    
+    blocktris_sim_step(&sim, SIM_INPUT_HOLD);
+    blocktris_sim_step(&sim, SIM_INPUT_HARD_DROP);
+    piece_type_t falling = sim.piece.type;
+    piece_type_t next = piece_queue_peek(&sim.queue, 0);
+    
+    blocktris_sim_step(&sim, SIM_INPUT_LEFT);
+    blocktris_sim_step(&sim, SIM_INPUT_HOLD);
+    TEST_ASSERT_EQUAL(first, sim.piece.type, "The held piece is back in play");
+    TEST_ASSERT_EQUAL(falling, sim.hold_type, "The falling piece is held");
+    TEST_ASSERT_EQUAL(next, piece_queue_peek(&sim.queue, 0), "The queue is untouched");
+    TEST_ASSERT(sim.piece.x == sim.board.width / 2 - 2 && sim.piece.y == 0,
+                "The swapped piece enters at the spawn position");
+}
+
+// Test that without a delay completed lines go in the step that completes them
+void test_sim_clears_lines_on_lock(void) {
+    blocktris_sim_t sim;
+    init_sim(&sim);
+    complete_bottom_row_on_drop(&sim);
+    
+    blocktris_sim_step(&sim, SIM_INPUT_HARD_DROP);
+    TEST_ASSERT(sim.events.flags & SIM_EVENT_LOCKED, "The drop locks the piece");
+    TEST_ASSERT((sim.events.flags & SIM_EVENT_CLEARED) && sim.events.cleared == (board_line_mask_t)1 << BOTTOM_ROW,
+                "The bottom row is reported cleared");
+    TEST_ASSERT(sim.board.rows[BOTTOM_ROW] != sim.board.full_row, "The row is gone at once");
+    TEST_ASSERT_EQUAL(0, (int)sim.clearing, "Nothing waits to be cleared");
+    TEST_ASSERT(sim.piece.active, "The next piece is in play");
+}
+
+// Test that with a delay the lines stay up, with no piece in play, until the delay is over
+void test_sim_line_clear_delay(void) {
+    const int delay_ticks = 5;
+    blocktris_sim_t sim;
+    init_sim(&sim);
+    blocktris_sim_set_line_clear_delay(&sim, delay_ticks);
+    complete_bottom_row_on_drop(&sim);
+    
+    blocktris_sim_step(&sim, SIM_INPUT_HARD_DROP);
+    TEST_ASSERT(sim.clearing == (board_line_mask_t)1 << BOTTOM_ROW, "The completed row waits to be cleared");
+    TEST_ASSERT(sim.board.rows[BOTTOM_ROW] == sim.board.full_row, "The row is still on the board");
+    TEST_ASSERT(!sim.piece.active, "No piece is in play during the delay");
+    TEST_ASSERT(!(sim.events.flags & SIM_EVENT_CLEARED), "No clear is reported at the lock");
+    TEST_ASSERT_EQUAL(1, sim.lines_cleared, "The lines are counted when they complete");
+    
+    for (int i = 1; i < delay_ticks; i++) {
+        blocktris_sim_step(&sim, SIM_INPUT_LEFT | SIM_INPUT_HOLD | SIM_INPUT_HARD_DROP);
+    }
+    TEST_ASSERT(sim.board.rows[BOTTOM_ROW] == sim.board.full_row, "The row stays up until the delay is over");
+    TEST_ASSERT_EQUAL(PIECE_EMPTY, sim.hold_type, "Inputs are ignored during the delay");
+    TEST_ASSERT_EQUAL(1, (int)sim.pieces_locked, "Nothing else locks during the delay");
+    
+    blocktris_sim_step(&sim, 0);
+    TEST_ASSERT_EQUAL(0, (int)sim.clearing, "The delay is over");
+    TEST_ASSERT(sim.board.rows[BOTTOM_ROW] != sim.board.full_row, "The row is gone");
+    TEST_ASSERT((sim.events.flags & SIM_EVENT_CLEARED) && sim.events.cleared == (board_line_mask_t)1 << BOTTOM_ROW,
+                "The clear is reported when the row goes");
+    TEST_ASSERT(sim.piece.active && !sim.game_over, "The next piece entered");
+}
+
+// Test that drops and line clears award their points as score events for the score log
+void test_sim_scores_through_score_module(void) {
+    blocktris_sim_t sim;
+    init_sim(&sim);
+    complete_bottom_row_on_drop(&sim);
+    
+    const blocktris_piece_t *piece = &sim.piece;
+    int drop_cells = blocktris_collision_find_drop_position(&sim.board, piece->type, piece->rotation,
+                                                            piece->x, piece->y) - piece->y;
+    blocktris_sim_step(&sim, SIM_INPUT_HARD_DROP);
+    
+    const sim_events_t *events = &sim.events;
+    TEST_ASSERT_EQUAL(2, events->num_scored, "The drop and the line clear are both scored");
+    TEST_ASSERT_EQUAL(SCORE_EVENT_HARD_DROP, events->scored[0].type, "The drop is scored first");
+    TEST_ASSERT_EQUAL(drop_cells * POINTS_HARD_DROP, events->scored[0].points, "Hard drop points per cell");
+    TEST_ASSERT_EQUAL(SCORE_EVENT_LINE_CLEAR, events->scored[1].type, "Then the line clear");
+    TEST_ASSERT_EQUAL(blocktris_score_get_line_clear_points(1), events->scored[1].points, "Single at level 1");
+    TEST_ASSERT_EQUAL(events->scored[0].points + events->scored[1].points, sim.score, "The score is the events' sum");
+    
+    score_log_t log;
+    score_log_reset(&log);
+    blocktris_score_log_events(&log, events);
+    TEST_ASSERT_EQUAL(2, score_log_count(&log), "Both events are logged");
+    TEST_ASSERT_EQUAL(sim.tick, score_log_get(&log, 1)->tick, "Events carry the tick they happened on");
+    
+    // Soft drop scores every row gravity moves the piece
+    int score = sim.score;
+    blocktris_sim_step(&sim, SIM_INPUT_SOFT_DROP);
+    for (int i = 0; i < 100 && sim.events.num_scored == 0; i++) {
+        blocktris_sim_step(&sim, SIM_INPUT_SOFT_DROP);
+    }
+    TEST_ASSERT_EQUAL(SCORE_EVENT_SOFT_DROP, sim.events.scored[0].type, "Soft drop is scored");
+    TEST_ASSERT_EQUAL(score + POINTS_SOFT_DROP, sim.score, "One point per row");
+}
+
+// Main simulation test runner
+void run_sim_tests(void) {
+    printf("\n=== Simulation Tests ===\n\n");
+    
+    RUN_TEST(test_sim_first_hold_takes_from_queue);
+    RUN_TEST(test_sim_hold_once_per_piece);
+    RUN_TEST(test_sim_hold_swaps_with_held_piece);
+    RUN_TEST(test_sim_clears_lines_on_lock);
+    RUN_TEST(test_sim_line_clear_delay);
+    RUN_TEST(test_sim_scores_through_score_module);
+}
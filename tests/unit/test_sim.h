@@ -0,0 +1,20 @@
+/**
+ * @file test_sim.h
+ * @brief Header for player simulation tests (hold, line clear delay, scoring)
+ */
+
+#ifndef TEST_SIM_H
+#define TEST_SIM_H
+
+// Test function declarations
+void test_sim_first_hold_takes_from_queue(void);
+void test_sim_hold_once_per_piece(void);
+void test_sim_hold_swaps_with_held_piece(void);
+void test_sim_clears_lines_on_lock(void);
+void test_sim_line_clear_delay(void);
+void test_sim_scores_through_score_module(void);
+
+// Main test runner function
+void run_sim_tests(void);
+
+#endif // TEST_SIM_H
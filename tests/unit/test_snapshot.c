@@ -0,0 +1,256 @@
+/**
+ * @file test_snapshot.c
+ * @brief Tests for saved games: round trip through a file, the fixed
+ * little-endian layout, and damaged, foreign or out-of-range files being
+ * turned away
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/save/game_snapshot.h"
+#include "../../game/src/simulation/blocktris_sim.h"
+#include "test_snapshot.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_SAVE_PATH "test_snapshot.sav"
+
+// Offset of the score in the file: header, board size, cells, piece, hold, queue, lock delay
+#define SCORE_OFFSET (GAME_SNAPSHOT_HEADER_SIZE + 2 + MAX_BOARD_HEIGHT * MAX_BOARD_WIDTH + 7 + 2 + 39 + 20)
+
+/**
+ * Snapshot of a game played for a while, so every field holds something
+ */
+static void make_snapshot(game_snapshot_t *snapshot) {
+    game_config_t config;
+    game_config_init(&config);
+    config.board_width = 10;
+    config.board_height = 20;
+    config.preview_depth = 5;
+    
+    blocktris_sim_t sim;
+    blocktris_sim_init(&sim, &config, 31337);
+    for (int i = 0; i < 400 && !sim.game_over; i++) {
+        sim_input_t input = i % 3 ? SIM_INPUT_LEFT : SIM_INPUT_ROTATE_CW;
+        blocktris_sim_step(&sim, i % 9 == 0 ? SIM_INPUT_HARD_DROP : input);
+    }
+    
+    game_board_copy(&snapshot->board, &sim.board);
+    snapshot->piece = sim.piece;
+    snapshot->hold_type = PIECE_T;
+    snapshot->hold_used = true;
+    snapshot->queue = sim.queue;
+    snapshot->lock_delay = sim.lock_delay;
+    snapshot->score = sim.score + 70000;
+    snapshot->level = 4;
+    snapshot->lines_cleared = 31;
+    snapshot->fall_speed = sim.fall_speed;
+    snapshot->fall_ticks = 7;
+    snapshot->sim_tick = sim.tick;
+    snapshot->line_clear_active = true;
+    snapshot->lines_to_clear = (board_line_mask_t)3 << 18;
+    snapshot->num_lines_to_clear = 2;
+    snapshot->line_clear_start_tick = sim.tick - 5;
+    snapshot->replay_hash = 0x0123456789ABCDEFULL;
+}
+
+static bool snapshots_equal(const game_snapshot_t *a, const game_snapshot_t *b) {
+    bool boards_equal = a->board.width == b->board.width && a->board.height == b->board.height &&
+                        memcmp(a->board.rows, b->board.rows, (size_t)a->board.height * sizeof(board_row_t)) == 0 &&
+                        memcmp(a->board.cells, b->board.cells,
+                               (size_t)a->board.width * a->board.height * sizeof(board_cell_t)) == 0;
+    
+    return boards_equal &&
+           a->piece.type == b->piece.type && a->piece.rotation == b->piece.rotation &&
+           a->piece.x == b->piece.x && a->piece.y == b->piece.y && a->piece.active == b->piece.active &&
+           a->hold_type == b->hold_type && a->hold_used == b->hold_used &&
+           memcmp(a->queue.types, b->queue.types, sizeof(a->queue.types)) == 0 &&
+           a->queue.head == b->queue.head && a->queue.count == b->queue.count &&
+           a->queue.depth == b->queue.depth && a->queue.seed == b->queue.seed &&
+           a->queue.rng_state == b->queue.rng_state && a->queue.generated == b->queue.generated &&
+           a->lock_delay.delay_ticks == b->lock_delay.delay_ticks &&
+           a->lock_delay.reset_limit == b->lock_delay.reset_limit && a->lock_delay.ticks == b->lock_delay.ticks &&
+           a->lock_delay.resets == b->lock_delay.resets && a->lock_delay.lowest_row == b->lock_delay.lowest_row &&
+           a->score == b->score && a->level == b->level && a->lines_cleared == b->lines_cleared &&
+           a->fall_speed == b->fall_speed && a->fall_ticks == b->fall_ticks && a->sim_tick == b->sim_tick &&
+           a->line_clear_active == b->line_clear_active && a->lines_to_clear == b->lines_to_clear &&
+           a->num_lines_to_clear == b->num_lines_to_clear && a->line_clear_start_tick == b->line_clear_start_tick &&
+           a->replay_hash == b->replay_hash;
+}
+
+// Test that a saved game loads back exactly, and the queue carries on with the same pieces
+void test_snapshot_round_trip(void) {
+    static game_snapshot_t saved;
+    static game_snapshot_t loaded;
+    make_snapshot(&saved);
+    
+    TEST_ASSERT(game_snapshot_save(TEST_SAVE_PATH, &saved), "The snapshot is saved");
+    TEST_ASSERT(game_snapshot_load(TEST_SAVE_PATH, &loaded), "The snapshot loads");
+    TEST_ASSERT(snapshots_equal(&saved, &loaded), "Every field survives the round trip");
+    
+    bool same_pieces = true;
+    for (int i = 0; i < 50; i++) {
+        same_pieces &= piece_queue_pop(&saved.queue) == piece_queue_pop(&loaded.queue);
+    }
+    TEST_ASSERT(same_pieces, "The resumed queue deals the same pieces");
+    
+    FILE *temp = fopen(TEST_SAVE_PATH ".tmp", "rb");
+    TEST_ASSERT(temp == NULL, "No temporary file is left behind");
+    if (temp) {
+        fclose(temp);
+    }
+    
+    game_snapshot_remove(TEST_SAVE_PATH);
+    TEST_ASSERT(!game_snapshot_load(TEST_SAVE_PATH, &loaded), "A removed save is gone");
+}
+
+// Test that garbage rows load back as garbage, not as empty cells or pieces
+void test_snapshot_round_trip_keeps_garbage(void) {
+    static game_snapshot_t saved;
+    static game_snapshot_t loaded;
+    static uint8_t image[GAME_SNAPSHOT_FILE_SIZE];
+    make_snapshot(&saved);
+    saved.piece.active = false; // The rows pushed up could reach the falling piece
+    game_board_add_garbage_rows(&saved.board, 3, 6);
+    int bottom = saved.board.height - 1;
+    
+    game_snapshot_encode(&saved, image, sizeof(image));
+    TEST_ASSERT(game_snapshot_decode(image, sizeof(image), &loaded), "A board with garbage rows decodes");
+    TEST_ASSERT(snapshots_equal(&saved, &loaded), "Every field survives the round trip");
+    TEST_ASSERT_EQUAL(BOARD_CELL_GARBAGE_TYPE, game_board_get_cell_type(&loaded.board, 0, bottom),
+                      "Garbage cells come back as garbage");
+    TEST_ASSERT(!game_board_is_cell_filled(&loaded.board, 6, bottom), "The garbage hole stays open");
+}
+
+// Test that the file has the same size and byte order whatever the game and machine
+void test_snapshot_layout(void) {
+    static game_snapshot_t snapshot;
+    static uint8_t image[GAME_SNAPSHOT_FILE_SIZE + 1];
+    make_snapshot(&snapshot);
+    snapshot.score = 0x01020304;
+    
+    TEST_ASSERT_EQUAL(0, (int)game_snapshot_encode(&snapshot, image, GAME_SNAPSHOT_FILE_SIZE - 1),
+                      "A short buffer is refused");
+    TEST_ASSERT_EQUAL(GAME_SNAPSHOT_FILE_SIZE, (int)game_snapshot_encode(&snapshot, image, sizeof(image)),
+                      "The file size doesn't depend on the board");
+    TEST_ASSERT(memcmp(image, "BTSV", 4) == 0 && image[4] == GAME_SNAPSHOT_VERSION && image[5] == 0,
+                "The header starts with the magic and a little-endian version");
+    TEST_ASSERT(image[SCORE_OFFSET] == 0x04 && image[SCORE_OFFSET + 1] == 0x03 &&
+                image[SCORE_OFFSET + 2] == 0x02 && image[SCORE_OFFSET + 3] == 0x01,
+                "Fields are little-endian at fixed offsets");
+}
+
+// Test that damaged, truncated and foreign files are turned away whole
+void test_snapshot_rejects_damaged_files(void) {
+    static game_snapshot_t snapshot;
+    static game_snapshot_t decoded;
+    static uint8_t image[GAME_SNAPSHOT_FILE_SIZE];
+    make_snapshot(&snapshot);
+    game_snapshot_encode(&snapshot, image, sizeof(image));
+    TEST_ASSERT(game_snapshot_decode(image, sizeof(image), &decoded), "An intact image decodes");
+    
+    image[GAME_SNAPSHOT_HEADER_SIZE + 500] ^= 0x10;
+    TEST_ASSERT(!game_snapshot_decode(image, sizeof(image), &decoded), "A flipped bit fails the checksum");
+    image[GAME_SNAPSHOT_HEADER_SIZE + 500] ^= 0x10;
+    
+    TEST_ASSERT(!game_snapshot_decode(image, sizeof(image) - 1, &decoded), "A truncated image is refused");
+    
+    image[4]++;
+    TEST_ASSERT(!game_snapshot_decode(image, sizeof(image), &decoded), "Another version is refused");
+    image[4]--;
+    
+    // A checksummed file can still be nonsense: a board narrower than the game allows
+    snapshot.board.width = MIN_BOARD_WIDTH - 1;
+    game_snapshot_encode(&snapshot, image, sizeof(image));
+    TEST_ASSERT(!game_snapshot_decode(image, sizeof(image), &decoded), "An out-of-range board is refused");
+    
+    FILE *file = fopen(TEST_SAVE_PATH, "wb");
+    if (file) {
+        fwrite(image, 1, 100, file);
+        fclose(file);
+    }
+    TEST_ASSERT(!game_snapshot_load(TEST_SAVE_PATH, &decoded), "A short file is refused");
+    game_snapshot_remove(TEST_SAVE_PATH);
+}
+
+/**
+ * Whether a snapshot survives encoding and decoding; the checksum is always
+ * right, so only the field checks can turn it away
+ */
+static bool snapshot_decodes(const game_snapshot_t *snapshot) {
+    static uint8_t image[GAME_SNAPSHOT_FILE_SIZE];
+    static game_snapshot_t decoded;
+    game_snapshot_encode(snapshot, image, sizeof(image));
+    return game_snapshot_decode(image, sizeof(image), &decoded);
+}
+
+// Test that every field a foreign file could set out of range is refused
+void test_snapshot_rejects_out_of_range_fields(void) {
+    static game_snapshot_t valid;
+    static game_snapshot_t snapshot;
+    make_snapshot(&valid);
+    TEST_ASSERT(snapshot_decodes(&valid), "The unchanged snapshot decodes");
+    
+    snapshot = valid;
+    snapshot.lock_delay.delay_ticks = -1;
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "A negative lock delay is refused");
+    
+    snapshot = valid;
+    snapshot.lock_delay.reset_limit = MAX_LOCK_RESET_LIMIT + 1;
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "A reset limit past the option's range is refused");
+    
+    snapshot = valid;
+    snapshot.lock_delay.ticks = snapshot.lock_delay.delay_ticks + 2;
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "Lock ticks past the delay are refused");
+    
+    snapshot = valid;
+    snapshot.lock_delay.resets = snapshot.lock_delay.reset_limit + 1;
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "More resets than the limit are refused");
+    
+    snapshot = valid;
+    snapshot.lock_delay.lowest_row = snapshot.board.height + 1;
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "A lowest row below the board is refused");
+    
+    snapshot = valid;
+    snapshot.level = 0;
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "Level 0 is refused");
+    
+    snapshot = valid;
+    snapshot.level = -3;
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "A negative level is refused");
+    
+    snapshot = valid;
+    snapshot.fall_speed = 0;
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "A fall speed no level gives is refused");
+    
+    snapshot = valid;
+    snapshot.fall_ticks = -1;
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "Negative fall ticks are refused");
+    
+    snapshot = valid;
+    snapshot.lines_to_clear |= (board_line_mask_t)1 << snapshot.board.height;
+    snapshot.num_lines_to_clear++;
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "A line to clear below the board is refused");
+    
+    snapshot = valid;
+    snapshot.num_lines_to_clear = 5;
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "A line count that doesn't match the lines is refused");
+    
+    snapshot = valid;
+    snapshot.piece.x = (int16_t)(snapshot.board.width + PIECE_SIZE);
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "A piece off the side of the board is refused");
+    
+    snapshot = valid;
+    snapshot.piece.y = (int16_t)(snapshot.board.height + PIECE_SIZE);
+    TEST_ASSERT(!snapshot_decodes(&snapshot), "A piece below the board is refused");
+}
+
+// Main saved game test runner
+void run_snapshot_tests(void) {
+    printf("\n=== Saved Game Tests ===\n\n");
+    
+    RUN_TEST(test_snapshot_round_trip);
+    RUN_TEST(test_snapshot_round_trip_keeps_garbage);
+    RUN_TEST(test_snapshot_layout);
+    RUN_TEST(test_snapshot_rejects_damaged_files);
+    RUN_TEST(test_snapshot_rejects_out_of_range_fields);
+}
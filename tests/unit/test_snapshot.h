@@ -0,0 +1,19 @@
+/**
+ * @file test_snapshot.h
+ * @brief Header for saved game tests (round trip, fixed layout, damaged and out-of-range files)
+ */
+
+#ifndef TEST_SNAPSHOT_H
+#define TEST_SNAPSHOT_H
+
+// Test function declarations
+void test_snapshot_round_trip(void);
+void test_snapshot_round_trip_keeps_garbage(void);
+void test_snapshot_layout(void);
+void test_snapshot_rejects_damaged_files(void);
+void test_snapshot_rejects_out_of_range_fields(void);
+
+// Main test runner function
+void run_snapshot_tests(void);
+
+#endif // TEST_SNAPSHOT_H
@@ -0,0 +1,224 @@
+/**
+ * @file test_soft_raster.c
+ * @brief Tests for the software rasterizer: clipping, blend rounding, lines,
+ * polygons and text, and a golden image of a full game frame
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/rendering/soft_raster.h"
+#include "../../game/src/rendering/blocktris_renderer.h"
+#include "test_soft_raster.h"
+#include <stdio.h>
+#include <string.h>
+
+// Hash of the frame drawn by test_soft_raster_golden_frame; when the picture
+// changes on purpose, check the PPM it writes and update this
+#define GOLDEN_FRAME_HASH 0x458B3631A09606EDULL
+#define GOLDEN_FRAME_PATH "test_soft_raster_frame.ppm"
+
+static const uint32_t *pixel(const soft_canvas_t *canvas, int x, int y) {
+    return canvas->pixels + y * canvas->pitch + x;
+}
+
+static int count_pixels(const soft_canvas_t *canvas, uint32_t value) {
+    int count = 0;
+    for (int y = 0; y < canvas->height; y++) {
+        for (int x = 0; x < canvas->width; x++) {
+            count += *pixel(canvas, x, y) == value;
+        }
+    }
+    return count;
+}
+
+// Test that fills are clipped to the canvas, over vector-sized spans and their tails
+void test_soft_raster_fill_clips(void) {
+    uint32_t pixels[21 * 9];
+    soft_canvas_t canvas;
+    TEST_ASSERT(soft_canvas_init(&canvas, pixels, 21, 9), "A canvas is set up over the buffer");
+    TEST_ASSERT(!soft_canvas_init(&canvas, pixels, 0, 9), "An empty canvas is refused");
+    
+    uint32_t black = soft_rgba(0, 0, 0, 255);
+    uint32_t red = soft_rgba(255, 0, 0, 255);
+    soft_canvas_clear(&canvas, black);
+    TEST_ASSERT_EQUAL(21 * 9, count_pixels(&canvas, black), "Clearing covers every pixel");
+    
+    soft_canvas_fill_rect(&canvas, -5, 7, 100, 10, red);
+    TEST_ASSERT_EQUAL(21 * 2, count_pixels(&canvas, red), "A rectangle past the edges is clipped to them");
+    TEST_ASSERT(*pixel(&canvas, 20, 8) == red && *pixel(&canvas, 20, 6) == black,
+                "The last column of the span is filled, the row above is not");
+    
+    soft_canvas_fill_rect(&canvas, 30, 0, 5, 5, black);
+    soft_canvas_fill_rect(&canvas, 0, 0, -3, 5, black);
+    TEST_ASSERT_EQUAL(21 * 2, count_pixels(&canvas, red), "Rectangles off the canvas or inside out draw nothing");
+    
+    const uint8_t *bytes = (const uint8_t *)pixel(&canvas, 0, 8);
+    TEST_ASSERT(bytes[0] == 255 && bytes[1] == 0 && bytes[3] == 255, "Pixels are R, G, B, A in memory");
+}
+
+// Test that blending rounds the same way for every pixel of a span
+void test_soft_raster_blend_rounds(void) {
+    enum { WIDTH = 19 };
+    uint32_t pixels[WIDTH];
+    soft_canvas_t canvas;
+    soft_canvas_init(&canvas, pixels, WIDTH, 1);
+    
+    static const int alphas[] = { 1, 51, 128, 200, 254 };
+    bool exact = true;
+    for (size_t a = 0; a < sizeof(alphas) / sizeof(alphas[0]); a++) {
+        int alpha = alphas[a];
+        for (int x = 0; x < WIDTH; x++) {
+            pixels[x] = soft_rgba(x * 13, 255 - x * 7, x * 3 + 1, 255);
+        }
+        soft_canvas_blend_rect(&canvas, 0, 0, WIDTH, 1, soft_rgba(32, 200, 0, 255), alpha);
+        
+        for (int x = 0; x < WIDTH; x++) {
+            const uint8_t *bytes = (const uint8_t *)&pixels[x];
+            int before[3] = { x * 13, 255 - x * 7, x * 3 + 1 };
+            int source[3] = { 32, 200, 0 };
+            for (int c = 0; c < 3; c++) {
+                // Rounded to nearest: the exact quotient is never more than half a step away
+                int scaled = before[c] * (255 - alpha) + source[c] * alpha;
+                int error = bytes[c] * 255 - scaled;
+                exact &= error <= 127 && error >= -127;
+            }
+        }
+    }
+    TEST_ASSERT(exact, "Every channel is the blend rounded to nearest, vector lanes and tail alike");
+    
+    uint32_t white = soft_rgba(255, 255, 255, 255);
+    soft_canvas_clear(&canvas, white);
+    soft_canvas_blend_rect(&canvas, 0, 0, WIDTH, 1, soft_rgba(0, 0, 0, 255), 0);
+    TEST_ASSERT_EQUAL(WIDTH, count_pixels(&canvas, white), "Alpha 0 leaves the canvas alone");
+}
+
+// Test line end points and polygon coverage
+void test_soft_raster_lines_and_polygons(void) {
+    uint32_t pixels[16 * 16];
+    soft_canvas_t canvas;
+    soft_canvas_init(&canvas, pixels, 16, 16);
+    uint32_t black = soft_rgba(0, 0, 0, 255);
+    uint32_t white = soft_rgba(255, 255, 255, 255);
+    
+    soft_canvas_clear(&canvas, black);
+    soft_canvas_draw_line(&canvas, 10, 3, 2, 3, white);
+    TEST_ASSERT_EQUAL(9, count_pixels(&canvas, white), "A horizontal line includes both ends");
+    
+    soft_canvas_clear(&canvas, black);
+    soft_canvas_draw_line(&canvas, 0, 0, 5, 5, white);
+    TEST_ASSERT(count_pixels(&canvas, white) == 6 && *pixel(&canvas, 5, 5) == white,
+                "A diagonal line steps one pixel per row and reaches its end");
+    
+    soft_canvas_clear(&canvas, black);
+    soft_canvas_draw_line(&canvas, -10, 25, 25, -10, white);
+    TEST_ASSERT_EQUAL(16, count_pixels(&canvas, white), "Lines leaving the canvas are clipped");
+    
+    soft_canvas_clear(&canvas, black);
+    soft_canvas_draw_thick_line(&canvas, 0, 8, 15, 8, 3, white);
+    TEST_ASSERT(count_pixels(&canvas, white) == 48 && *pixel(&canvas, 0, 7) == white && *pixel(&canvas, 0, 9) == white,
+                "A thick line is centred on the thin one");
+    
+    // Same corners as the renderer's cells: pixels [2, 12) in both axes
+    soft_canvas_clear(&canvas, black);
+    const soft_point_t square[4] = { { 2, 2 }, { 12, 2 }, { 12, 12 }, { 2, 12 } };
+    soft_canvas_fill_polygon(&canvas, square, 4, white);
+    TEST_ASSERT(count_pixels(&canvas, white) == 100 && *pixel(&canvas, 11, 11) == white &&
+                *pixel(&canvas, 12, 12) == black, "A square covers exactly the pixels inside it");
+    
+    soft_canvas_clear(&canvas, black);
+    const soft_point_t triangle[3] = { { 0, 0 }, { 16, 0 }, { 0, 16 } };
+    soft_canvas_fill_polygon(&canvas, triangle, 3, white);
+    TEST_ASSERT_EQUAL(16 * 15 / 2, count_pixels(&canvas, white), "A triangle covers the centres inside its edge");
+}
+
+// Test text measurement and drawing, and scaled image copies
+void test_soft_raster_text_and_blit(void) {
+    uint32_t pixels[40 * 20];
+    uint32_t other[40 * 20];
+    soft_canvas_t canvas;
+    soft_canvas_t lower;
+    soft_canvas_init(&canvas, pixels, 40, 20);
+    soft_canvas_init(&lower, other, 40, 20);
+    uint32_t black = soft_rgba(0, 0, 0, 255);
+    uint32_t white = soft_rgba(255, 255, 255, 255);
+    
+    TEST_ASSERT_EQUAL(3 * 6 * 2 - 2, soft_canvas_text_width("ABC", 2), "Width leaves no gap after the last character");
+    TEST_ASSERT_EQUAL(0, soft_canvas_text_width("", 2), "Empty text has no width");
+    
+    soft_canvas_clear(&canvas, black);
+    soft_canvas_clear(&lower, black);
+    soft_canvas_draw_text(&canvas, "SCORE 10", 1, 1, 1, white, 255);
+    soft_canvas_draw_text(&lower, "score 10", 1, 1, 1, white, 255);
+    TEST_ASSERT(count_pixels(&canvas, white) > 0, "Text is drawn");
+    TEST_ASSERT(soft_canvas_hash(&canvas) == soft_canvas_hash(&lower), "Lowercase is drawn as uppercase");
+    
+    // 2x2 image grown to 4x4: each source pixel becomes a 2x2 block
+    const uint32_t image_pixels[4] = { white, black, black, white };
+    soft_image_t image = { image_pixels, 2, 2, 2 };
+    soft_canvas_clear(&canvas, soft_rgba(1, 2, 3, 255));
+    soft_canvas_blit(&canvas, &image, 38, 18, 4, 4);
+    TEST_ASSERT(*pixel(&canvas, 38, 18) == white && *pixel(&canvas, 39, 19) == white,
+                "The visible corner of a clipped copy comes from the first source pixel");
+    soft_canvas_blit(&canvas, &image, 0, 0, 4, 4);
+    TEST_ASSERT(*pixel(&canvas, 1, 1) == white && *pixel(&canvas, 2, 1) == black && *pixel(&canvas, 3, 3) == white,
+                "Scaled copies take the nearest source pixel");
+}
+
+// Test a full game frame drawn headless against its golden hash
+void test_soft_raster_golden_frame(void) {
+    static game_t game;
+    static uint32_t pixels[1024 * 1024];
+    memset(&game, 0, sizeof(game));
+    
+    // 800x500 screen: 20 pixel cells and a 400x450 window
+    game_config_init(&game.config);
+    int width = game.config.board_width;
+    int height = game.config.board_height;
+    int window_width, window_height;
+    game_layout_window_size(width, height, 800, 500, &window_width, &window_height);
+    game_layout_calculate(&game.layout, width, height, window_width, window_height);
+    TEST_ASSERT(window_width * window_height <= 1024 * 1024, "The window fits the test buffer");
+    
+    game_board_init(&game.board, width, height);
+    for (int x = 0; x < width; x++) {
+        if (x != 4) {
+            game_board_set_cell(&game.board, x, height - 1, (piece_type_t)(x % NUM_PIECE_TYPES),
+                                BOARD_CELL_LOCKED);
+        }
+    }
+    game_board_set_cell(&game.board, 0, height - 2, BOARD_CELL_GARBAGE_TYPE, 0);
+    
+    blocktris_piece_reset(&game.current_piece, PIECE_T, 3, 2);
+    game.hold_type = PIECE_Z;
+    piece_queue_init(&game.piece_queue, game.config.preview_depth, 42);
+    game.score = 12345;
+    
+    soft_canvas_t canvas;
+    soft_canvas_init(&canvas, pixels, window_width, window_height);
+    graphics_context_t graphics_context;
+    memset(&graphics_context, 0, sizeof(graphics_context));
+    
+    game.layout.canvas = &canvas;
+    blocktris_renderer_render_game(&game, &game.layout, &graphics_context);
+    uint64_t first = soft_canvas_hash(&canvas);
+    blocktris_renderer_render_game(&game, &game.layout, &graphics_context);
+    game.layout.canvas = NULL;
+    
+    TEST_ASSERT(soft_canvas_hash(&canvas) == first, "The same state draws the same frame");
+    bool golden = first == GOLDEN_FRAME_HASH;
+    if (!golden) {
+        soft_canvas_write_ppm(&canvas, GOLDEN_FRAME_PATH);
+        printf("    frame hash 0x%016llX, written to %s\n", (unsigned long long)first, GOLDEN_FRAME_PATH);
+    }
+    TEST_ASSERT(golden, "The frame matches the golden image");
+}
+
+// Main software rasterizer test runner
+void run_soft_raster_tests(void) {
+    printf("\n=== Software Rasterizer Tests ===\n\n");
+    
+    RUN_TEST(test_soft_raster_fill_clips);
+    RUN_TEST(test_soft_raster_blend_rounds);
+    RUN_TEST(test_soft_raster_lines_and_polygons);
+    RUN_TEST(test_soft_raster_text_and_blit);
+    RUN_TEST(test_soft_raster_golden_frame);
+}
@@ -0,0 +1,19 @@
+/**
+ * @file test_soft_raster.h
+ * @brief Header for software rasterizer tests (primitives and golden frames)
+ */
+
+#ifndef TEST_SOFT_RASTER_H
+#define TEST_SOFT_RASTER_H
+
+// Test function declarations
+void test_soft_raster_fill_clips(void);
+void test_soft_raster_blend_rounds(void);
+void test_soft_raster_lines_and_polygons(void);
+void test_soft_raster_text_and_blit(void);
+void test_soft_raster_golden_frame(void);
+
+// Main test runner function
+void run_soft_raster_tests(void);
+
+#endif // TEST_SOFT_RASTER_H
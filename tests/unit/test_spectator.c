@@ -0,0 +1,215 @@
+/**
+ * @file test_spectator.c
+ * @brief Tests for the spectator stream: a replica rebuilds the watched game
+ * step by step, late joiners catch up from a keyframe, and the stream stays
+ * far smaller than sending the board
+ */
+
+#include "../test_framework.h"
+#include "../test_fixtures.h"
+#include "../../game/src/simulation/spectator_stream.h"
+#include "../../game/src/utils/utils.h"
+#include "test_spectator.h"
+#include <string.h>
+
+#define TEST_STEPS 6000
+#define GARBAGE_EVERY_STEPS 97
+
+/**
+ * Moves, turns and holds at random, with a hard drop now and then
+ */
+static sim_input_t random_input(uint64_t *rng_state) {
+    uint32_t r = (uint32_t)(utils_next_random(rng_state) >> 32);
+    sim_input_t input = (sim_input_t)(r & (SIM_INPUT_LEFT | SIM_INPUT_RIGHT | SIM_INPUT_ROTATE_CW));
+    if (r % 23 == 0) {
+        input |= SIM_INPUT_HOLD;
+    }
+    if (r % 7 == 0) {
+        input |= SIM_INPUT_HARD_DROP;
+    }
+    return input;
+}
+
+static bool replica_matches(const spectator_replica_t *replica, const blocktris_sim_t *sim) {
+    const game_board_t *a = &replica->sim.board;
+    const game_board_t *b = &sim->board;
+    bool boards_equal = a->width == b->width && a->height == b->height &&
+                        memcmp(a->rows, b->rows, (size_t)a->height * sizeof(board_row_t)) == 0 &&
+                        memcmp(a->cells, b->cells, (size_t)a->width * a->height * sizeof(board_cell_t)) == 0;
+    
+    const blocktris_sim_t *r = &replica->sim;
+    return replica->synced && boards_equal &&
+           r->hold_type == sim->hold_type && r->score == sim->score &&
+           r->lines_cleared == sim->lines_cleared && r->level == sim->level &&
+           r->pieces_locked == sim->pieces_locked && r->game_over == sim->game_over &&
+           r->piece.active == sim->piece.active && (!sim->piece.active || r->piece.type == sim->piece.type);
+}
+
+// Test that a replica fed every step matches the game after each one, through clears, holds and garbage
+void test_spectator_replica_follows_game(void) {
+    static const int widths[] = { 5, 6, 10 };
+    bool saw_clear = false; // Random play only clears lines on narrow boards
+    
+    for (int w = 0; w < (int)(sizeof(widths) / sizeof(widths[0])); w++) {
+        game_config_t config;
+        test_make_instant_lock_config(&config, widths[w], 12);
+        
+        blocktris_sim_t sim;
+        spectator_stream_t stream;
+        spectator_replica_t replica;
+        blocktris_sim_init(&sim, &config, 1000 + (uint64_t)w);
+        spectator_stream_init(&stream, DEFAULT_SPECTATOR_KEYFRAME_INTERVAL);
+        spectator_replica_init(&replica);
+        
+        size_t size;
+        spectator_stream_start(&stream, &sim);
+        const uint8_t *data = spectator_stream_latest(&stream, &size);
+        TEST_ASSERT(spectator_replica_apply(&replica, data, size) && replica_matches(&replica, &sim),
+                    "The first keyframe syncs the replica");
+        
+        uint64_t rng_state = 0x9E3779B97F4A7C15ULL + (uint64_t)w;
+        bool in_sync = true;
+        bool saw_hold = false;
+        bool saw_garbage = false;
+        int games = 1;
+        for (int step = 0; step < TEST_STEPS && in_sync; step++) {
+            if (sim.game_over) {
+                blocktris_sim_init(&sim, &config, 2000 + (uint64_t)step);
+                spectator_stream_start(&stream, &sim);
+                games++;
+            } else {
+                if (step % GARBAGE_EVERY_STEPS == 0) {
+                    blocktris_sim_receive_garbage(&sim, 1 + step % 3);
+                }
+                blocktris_sim_step(&sim, random_input(&rng_state));
+                spectator_stream_record(&stream, &sim);
+                saw_hold |= (sim.events.flags & SIM_EVENT_HELD) != 0;
+                saw_garbage |= (sim.events.flags & SIM_EVENT_GARBAGE) != 0;
+                saw_clear |= (sim.events.flags & SIM_EVENT_CLEARED) != 0;
+            }
+            
+            data = spectator_stream_latest(&stream, &size);
+            in_sync = spectator_replica_apply(&replica, data, size) && replica_matches(&replica, &sim);
+        }
+        
+        TEST_ASSERT(in_sync, "The replica matches the game after every step");
+        TEST_ASSERT(saw_hold && saw_garbage && games > 1, "The run went through holds, garbage and game overs");
+    }
+    TEST_ASSERT(saw_clear, "The runs went through line clears");
+}
+
+// Test that with a line clear delay the replica keeps the lines up, and sees the next piece, until the delay is over
+void test_spectator_replica_follows_line_clear_delay(void) {
+    game_config_t config;
+    test_make_instant_lock_config(&config, 5, 12);
+    
+    blocktris_sim_t sim;
+    spectator_stream_t stream;
+    spectator_replica_t replica;
+    blocktris_sim_init(&sim, &config, 4242);
+    blocktris_sim_set_line_clear_delay(&sim, 6);
+    spectator_stream_init(&stream, DEFAULT_SPECTATOR_KEYFRAME_INTERVAL);
+    spectator_replica_init(&replica);
+    spectator_stream_start(&stream, &sim);
+    
+    size_t size;
+    const uint8_t *data = spectator_stream_latest(&stream, &size);
+    bool in_sync = spectator_replica_apply(&replica, data, size);
+    uint64_t rng_state = 0xC0FFEEULL;
+    int delayed_clears = 0;
+    for (int step = 0; step < TEST_STEPS && in_sync; step++) {
+        if (sim.game_over) {
+            blocktris_sim_init(&sim, &config, 5000 + (uint64_t)step);
+            blocktris_sim_set_line_clear_delay(&sim, 6);
+            spectator_stream_start(&stream, &sim);
+        } else {
+            blocktris_sim_step(&sim, random_input(&rng_state));
+            spectator_stream_record(&stream, &sim);
+            delayed_clears += (sim.events.flags & (SIM_EVENT_CLEARED | SIM_EVENT_LOCKED)) == SIM_EVENT_CLEARED;
+        }
+        
+        data = spectator_stream_latest(&stream, &size);
+        in_sync = spectator_replica_apply(&replica, data, size) && replica_matches(&replica, &sim);
+    }
+    
+    TEST_ASSERT(in_sync, "The replica matches the game after every step, delays included");
+    TEST_ASSERT(delayed_clears > 0, "Lines went after the delay, steps after their placement");
+}
+
+// Test that a spectator joining mid-game is in sync after the catch-up bytes, and ignores deltas before them
+void test_spectator_late_join(void) {
+    game_config_t config;
+    test_make_instant_lock_config(&config, 10, 20);
+    
+    blocktris_sim_t sim;
+    spectator_stream_t stream;
+    blocktris_sim_init(&sim, &config, 77);
+    spectator_stream_init(&stream, 8);
+    spectator_stream_start(&stream, &sim);
+    
+    uint64_t rng_state = 12345;
+    while (sim.pieces_locked < 21 && !sim.game_over) {
+        blocktris_sim_step(&sim, random_input(&rng_state) | SIM_INPUT_HARD_DROP);
+        spectator_stream_record(&stream, &sim);
+    }
+    
+    spectator_replica_t replica;
+    spectator_replica_init(&replica);
+    
+    // Deltas alone mean nothing without the keyframe they follow
+    size_t size;
+    const uint8_t *data = spectator_stream_latest(&stream, &size);
+    TEST_ASSERT(spectator_replica_apply(&replica, data, size) && !replica.synced,
+                "Deltas before a keyframe are skipped");
+    
+    data = spectator_stream_catch_up(&stream, &size);
+    TEST_ASSERT(data[0] == 0x01 && size > 0, "The catch-up bytes start with a keyframe");
+    TEST_ASSERT(spectator_replica_apply(&replica, data, size) && replica_matches(&replica, &sim),
+                "A late joiner is in sync after catching up");
+    
+    TEST_ASSERT(!spectator_replica_apply(&replica, (const uint8_t *)"\x04\x63\x00\x00\x00", 5) && !replica.synced,
+                "A malformed message unsyncs the replica");
+}
+
+// Test that the stream costs far less than sending the board every frame
+void test_spectator_stream_size(void) {
+    game_config_t config;
+    test_make_instant_lock_config(&config, 10, 20);
+    
+    blocktris_sim_t sim;
+    spectator_stream_t stream;
+    blocktris_sim_init(&sim, &config, 4242);
+    spectator_stream_init(&stream, DEFAULT_SPECTATOR_KEYFRAME_INTERVAL);
+    spectator_stream_start(&stream, &sim);
+    
+    // Played at a human pace: a move or turn now and then, pieces falling under gravity
+    uint64_t rng_state = 99;
+    uint32_t pieces = 0;
+    for (int step = 0; step < TEST_STEPS; step++) {
+        if (sim.game_over) {
+            pieces += sim.pieces_locked;
+            blocktris_sim_init(&sim, &config, 4243 + (uint64_t)step);
+            spectator_stream_start(&stream, &sim);
+            continue;
+        }
+        sim_input_t input = random_input(&rng_state);
+        blocktris_sim_step(&sim, step % 8 == 0 ? (sim_input_t)(input & ~SIM_INPUT_HARD_DROP) : 0);
+        spectator_stream_record(&stream, &sim);
+    }
+    pieces += sim.pieces_locked;
+    
+    // Sending the board every step would cost a byte per cell
+    uint64_t board_bytes = (uint64_t)TEST_STEPS * (uint64_t)(config.board_width * config.board_height);
+    TEST_ASSERT(stream.bytes_written * 100 < board_bytes, "The stream is under 1% of sending the board every step");
+    TEST_ASSERT(pieces > 0 && stream.bytes_written / pieces < 64, "A piece costs tens of bytes, keyframes included");
+}
+
+// Main spectator stream test runner
+void run_spectator_tests(void) {
+    printf("\n=== Spectator Stream Tests ===\n\n");
+    
+    RUN_TEST(test_spectator_replica_follows_game);
+    RUN_TEST(test_spectator_replica_follows_line_clear_delay);
+    RUN_TEST(test_spectator_late_join);
+    RUN_TEST(test_spectator_stream_size);
+}
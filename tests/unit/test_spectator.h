@@ -0,0 +1,18 @@
+/**
+ * @file test_spectator.h
+ * @brief Header for spectator stream tests (replica stays in sync, late joiners, stream size)
+ */
+
+#ifndef TEST_SPECTATOR_H
+#define TEST_SPECTATOR_H
+
+// Test function declarations
+void test_spectator_replica_follows_game(void);
+void test_spectator_replica_follows_line_clear_delay(void);
+void test_spectator_late_join(void);
+void test_spectator_stream_size(void);
+
+// Main test runner function
+void run_spectator_tests(void);
+
+#endif // TEST_SPECTATOR_H
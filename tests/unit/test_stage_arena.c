@@ -0,0 +1,61 @@
+/**
+ * @file test_stage_arena.c
+ * @brief Tests for the stage arena allocator
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/stages/stage_arena.h"
+#include "test_stage_arena.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// Test that allocations are aligned and bounded by the arena capacity
+void test_stage_arena_alignment_and_capacity(void) {
+    void *memory = malloc(STAGE_ARENA_SIZE);
+    stage_arena_t arena;
+    
+    stage_arena_init(&arena, memory, STAGE_ARENA_SIZE);
+    void *first = stage_arena_alloc(&arena, 1);
+    void *second = stage_arena_alloc(&arena, 3);
+    TEST_ASSERT(first == memory, "First allocation starts at the arena memory");
+    TEST_ASSERT((uintptr_t)second % STAGE_ARENA_ALIGNMENT == 0, "Allocations are aligned");
+    TEST_ASSERT(stage_arena_alloc(&arena, STAGE_ARENA_SIZE) == NULL, "Oversized allocation fails");
+    TEST_ASSERT(stage_arena_alloc(&arena, 0) == NULL, "Empty allocation fails");
+    
+    free(memory);
+}
+
+// Test that a reset only releases allocations made after stage_arena_keep
+void test_stage_arena_reset_keeps_marked_allocations(void) {
+    void *memory = malloc(STAGE_ARENA_SIZE);
+    stage_arena_t arena;
+    
+    stage_arena_init(&arena, memory, STAGE_ARENA_SIZE);
+    void *stage = stage_arena_alloc(&arena, 64);
+    stage_arena_keep(&arena);
+    
+    void *state = stage_arena_alloc(&arena, 128);
+    stage_arena_reset(&arena);
+    TEST_ASSERT(stage != NULL && stage_arena_alloc(&arena, 128) == state,
+                "Reset reuses the state memory without touching kept allocations");
+    
+    // Cycling init/cleanup never exhausts the arena
+    bool exhausted = false;
+    for (int i = 0; i < 10000; i++) {
+        stage_arena_reset(&arena);
+        if (!stage_arena_alloc(&arena, 512)) {
+            exhausted = true;
+        }
+    }
+    TEST_ASSERT(!exhausted, "Repeated reset cycles reuse the same memory");
+    
+    free(memory);
+}
+
+// Main stage arena test runner
+void run_stage_arena_tests(void) {
+    printf("\n=== Stage Arena Tests ===\n\n");
+    
+    RUN_TEST(test_stage_arena_alignment_and_capacity);
+    RUN_TEST(test_stage_arena_reset_keeps_marked_allocations);
+}
@@ -0,0 +1,16 @@
+/**
+ * @file test_stage_arena.h
+ * @brief Header for stage arena tests
+ */
+
+#ifndef TEST_STAGE_ARENA_H
+#define TEST_STAGE_ARENA_H
+
+// Test function declarations
+void test_stage_arena_alignment_and_capacity(void);
+void test_stage_arena_reset_keeps_marked_allocations(void);
+
+// Main test runner function
+void run_stage_arena_tests(void);
+
+#endif // TEST_STAGE_ARENA_H
@@ -0,0 +1,113 @@
+/**
+ * @file test_triple_buffer.c
+ * @brief Tests for the triple buffer: slot ownership, only the latest publish
+ * being read, and a writer and reader thread never sharing a slot
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/simulation/triple_buffer.h"
+#include "test_triple_buffer.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Publishes made by the writer thread, and words in each slot it fills
+#define THREAD_PUBLISHES 200000
+#define SLOT_WORDS 64
+
+typedef struct {
+    triple_buffer_t buffer;
+    uint32_t slots[TRIPLE_BUFFER_SLOTS][SLOT_WORDS];
+} shared_slots_t;
+
+// Shared slot passed in as read from the buffer, with no unread publish pending
+static bool slots_distinct(const triple_buffer_t *buffer, int shared) {
+    int back = triple_buffer_back(buffer);
+    int front = triple_buffer_front(buffer);
+    return back != front && back != shared && front != shared;
+}
+
+// Test that the reader gets the latest publish once, and the writer never gets the reader's slot
+void test_triple_buffer_latest_wins(void) {
+    triple_buffer_t buffer;
+    triple_buffer_init(&buffer);
+    int values[TRIPLE_BUFFER_SLOTS] = { 0 };
+    
+    TEST_ASSERT(!triple_buffer_acquire(&buffer), "Nothing is read before the first publish");
+    TEST_ASSERT(slots_distinct(&buffer, buffer.shared), "Each side starts with a slot of its own");
+    
+    values[triple_buffer_back(&buffer)] = 1;
+    triple_buffer_publish(&buffer);
+    TEST_ASSERT(triple_buffer_acquire(&buffer), "A publish is picked up");
+    TEST_ASSERT_EQUAL(1, values[triple_buffer_front(&buffer)], "The reader sees what was written");
+    TEST_ASSERT(!triple_buffer_acquire(&buffer), "The same publish isn't picked up twice");
+    TEST_ASSERT_EQUAL(1, values[triple_buffer_front(&buffer)], "The reader keeps its slot without a new publish");
+    
+    for (int i = 2; i <= 5; i++) {
+        int back = triple_buffer_back(&buffer);
+        TEST_ASSERT(back != triple_buffer_front(&buffer), "The writer never gets the slot being read");
+        values[back] = i;
+        triple_buffer_publish(&buffer);
+    }
+    TEST_ASSERT(triple_buffer_acquire(&buffer), "Several publishes are picked up at once");
+    TEST_ASSERT_EQUAL(5, values[triple_buffer_front(&buffer)], "Only the latest publish is read");
+    TEST_ASSERT(slots_distinct(&buffer, buffer.shared), "The three slots stay with one owner each");
+}
+
+static void *writer_main(void *data) {
+    shared_slots_t *shared = (shared_slots_t *)data;
+    for (uint32_t sequence = 1; sequence <= THREAD_PUBLISHES; sequence++) {
+        uint32_t *slot = shared->slots[triple_buffer_back(&shared->buffer)];
+        for (int i = 0; i < SLOT_WORDS; i++) {
+            slot[i] = sequence;
+        }
+        triple_buffer_publish(&shared->buffer);
+    }
+    return NULL;
+}
+
+// Test a writer and a reader running flat out: every read is whole and newer than the last
+void test_triple_buffer_threads(void) {
+    static shared_slots_t shared;
+    triple_buffer_init(&shared.buffer);
+    for (int s = 0; s < TRIPLE_BUFFER_SLOTS; s++) {
+        for (int i = 0; i < SLOT_WORDS; i++) {
+            shared.slots[s][i] = 0;
+        }
+    }
+    
+    pthread_t writer;
+    TEST_ASSERT(pthread_create(&writer, NULL, writer_main, &shared) == 0, "Writer thread starts");
+    
+    uint32_t last = 0;
+    int reads = 0;
+    bool whole = true;
+    bool ordered = true;
+    while (last < THREAD_PUBLISHES) {
+        if (!triple_buffer_acquire(&shared.buffer)) {
+            continue;
+        }
+        
+        const uint32_t *slot = shared.slots[triple_buffer_front(&shared.buffer)];
+        uint32_t sequence = slot[0];
+        for (int i = 1; i < SLOT_WORDS; i++) {
+            whole &= slot[i] == sequence;
+        }
+        ordered &= sequence > last;
+        last = sequence;
+        reads++;
+    }
+    pthread_join(writer, NULL);
+    
+    TEST_ASSERT(whole, "No slot is read while it is being written");
+    TEST_ASSERT(ordered, "Every read is newer than the one before");
+    TEST_ASSERT(reads > 0 && last == THREAD_PUBLISHES, "The reader ends on the last publish");
+}
+
+// Main triple buffer test runner
+void run_triple_buffer_tests(void) {
+    printf("\n=== Triple Buffer Tests ===\n\n");
+    
+    RUN_TEST(test_triple_buffer_latest_wins);
+    RUN_TEST(test_triple_buffer_threads);
+}
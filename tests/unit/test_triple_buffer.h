@@ -0,0 +1,16 @@
+/**
+ * @file test_triple_buffer.h
+ * @brief Header for lock-free triple buffer tests
+ */
+
+#ifndef TEST_TRIPLE_BUFFER_H
+#define TEST_TRIPLE_BUFFER_H
+
+// Test function declarations
+void test_triple_buffer_latest_wins(void);
+void test_triple_buffer_threads(void);
+
+// Main test runner function
+void run_triple_buffer_tests(void);
+
+#endif // TEST_TRIPLE_BUFFER_H
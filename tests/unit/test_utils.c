@@ -0,0 +1,87 @@
+/**
+ * @file test_utils.c
+ * @brief Tests for the shared helpers: both byte orders, CRC-32 and FNV-1a
+ * against their reference values, option parsing and the random step
+ */
+
+#include "../test_framework.h"
+#include "../../game/src/utils/utils.h"
+#include "test_utils.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test that values are laid out in the right byte order and read back whole
+void test_utils_byte_order(void) {
+    uint8_t bytes[8];
+    
+    utils_write_u32_le(bytes, 0x12345678u);
+    TEST_ASSERT(bytes[0] == 0x78 && bytes[3] == 0x12, "Little-endian puts the low byte first");
+    TEST_ASSERT(utils_read_u32_le(bytes) == 0x12345678u, "A little-endian u32 reads back");
+    
+    utils_write_u32_be(bytes, 0x12345678u);
+    TEST_ASSERT(bytes[0] == 0x12 && bytes[3] == 0x78, "Big-endian puts the high byte first");
+    TEST_ASSERT(utils_read_u32_be(bytes) == 0x12345678u, "A big-endian u32 reads back");
+    
+    utils_write_u16_be(bytes, 0xBEEF);
+    TEST_ASSERT(utils_read_u16_be(bytes) == 0xBEEF && utils_read_u16_le(bytes) == 0xEFBE,
+                "A u16 reads back in its own order only");
+    
+    utils_write_u64_le(bytes, 0xFEDCBA9876543210ULL);
+    TEST_ASSERT(bytes[0] == 0x10 && bytes[7] == 0xFE, "A u64 is little-endian too");
+    TEST_ASSERT(utils_read_u64_le(bytes) == 0xFEDCBA9876543210ULL, "A u64 reads back");
+}
+
+// Test the checksums against the standard check values, whole and in pieces
+void test_utils_checksums(void) {
+    const char *check = "123456789";
+    
+    TEST_ASSERT(utils_crc32(0, check, 9) == 0xCBF43926u, "CRC-32 matches the zlib check value");
+    TEST_ASSERT(utils_crc32(utils_crc32(0, check, 4), check + 4, 5) == 0xCBF43926u,
+                "A CRC-32 continued over pieces matches the whole");
+    TEST_ASSERT(utils_crc32(0, check, 0) == 0, "The CRC-32 of nothing is 0");
+    
+    TEST_ASSERT(utils_fnv1a_32(UTILS_FNV32_OFFSET_BASIS, "a", 1) == 0xE40C292Cu, "FNV-1a 32 of \"a\"");
+    TEST_ASSERT(utils_fnv1a_64(UTILS_FNV64_OFFSET_BASIS, "a", 1) == 0xAF63DC4C8601EC8CULL, "FNV-1a 64 of \"a\"");
+    TEST_ASSERT(utils_fnv1a_64(utils_fnv1a_64(UTILS_FNV64_OFFSET_BASIS, check, 3), check + 3, 6) ==
+                utils_fnv1a_64(UTILS_FNV64_OFFSET_BASIS, check, 9), "An FNV-1a hash continues over pieces");
+}
+
+// Test that option values are taken only when whole numbers within range
+void test_utils_parse_int_option(void) {
+    int value = 7;
+    
+    TEST_ASSERT(utils_parse_int_option("--level", "12", 1, 20, &value) && value == 12, "A value in range is taken");
+    TEST_ASSERT(utils_parse_int_option("--level", "1", 1, 20, &value) && value == 1, "The range is inclusive");
+    TEST_ASSERT(!utils_parse_int_option("--level", "21", 1, 20, &value), "A value above the range is refused");
+    TEST_ASSERT(!utils_parse_int_option("--level", "3x", 1, 20, &value), "Trailing characters are refused");
+    TEST_ASSERT(!utils_parse_int_option("--level", "", 1, 20, &value), "An empty value is refused");
+    TEST_ASSERT(!utils_parse_int_option("--level", NULL, 1, 20, &value), "A missing value is refused");
+    TEST_ASSERT_EQUAL(1, value, "A refused value leaves the output alone");
+}
+
+// Test that the random step is deterministic and never gets stuck at zero
+void test_utils_next_random(void) {
+    uint64_t a = 42;
+    uint64_t b = 42;
+    bool same = true;
+    bool nonzero = true;
+    for (int i = 0; i < 1000; i++) {
+        same &= utils_next_random(&a) == utils_next_random(&b);
+        nonzero &= a != 0;
+    }
+    
+    TEST_ASSERT(same, "The same seed gives the same sequence");
+    TEST_ASSERT(nonzero, "The state never reaches zero");
+    uint64_t c = 43;
+    TEST_ASSERT(utils_next_random(&c) != utils_next_random(&a), "Another seed gives another sequence");
+}
+
+// Main shared helper test runner
+void run_utils_tests(void) {
+    printf("\n=== Utils Tests ===\n\n");
+    
+    RUN_TEST(test_utils_byte_order);
+    RUN_TEST(test_utils_checksums);
+    RUN_TEST(test_utils_parse_int_option);
+    RUN_TEST(test_utils_next_random);
+}
@@ -0,0 +1,18 @@
+/**
+ * @file test_utils.h
+ * @brief Header for shared helper tests
+ */
+
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+
+// Test function declarations
+void test_utils_byte_order(void);
+void test_utils_checksums(void);
+void test_utils_parse_int_option(void);
+void test_utils_next_random(void);
+
+// Main test runner function
+void run_utils_tests(void);
+
+#endif // TEST_UTILS_H
@@ -0,0 +1,258 @@
+/**
+ * @file test_versus.c
+ * @brief Tests for versus mode: garbage insertion, the garbage queue and match determinism
+ */
+
+#include "../test_framework.h"
+#include "../test_fixtures.h"
+#include "../../game/src/entities/game_board.h"
+#include "../../game/src/simulation/garbage_queue.h"
+#include "../../game/src/simulation/versus_match.h"
+#include "test_versus.h"
+#include <string.h>
+
+static bool boards_equal(const game_board_t *a, const game_board_t *b) {
+    return a->width == b->width && a->height == b->height &&
+           memcmp(a->rows, b->rows, (size_t)a->height * sizeof(board_row_t)) == 0 &&
+           memcmp(a->cells, b->cells, (size_t)a->width * a->height * sizeof(board_cell_t)) == 0;
+}
+
+// Test that garbage pushes the stack up and fills the new rows around the hole
+void test_garbage_rows_shift_stack(void) {
+    game_board_t board;
+    game_board_init(&board, 10, 20);
+    game_board_set_cell(&board, 3, 19, PIECE_T, BOARD_CELL_LOCKED);
+    game_board_set_cell(&board, 0, 10, PIECE_L, BOARD_CELL_LOCKED);
+    
+    TEST_ASSERT(!game_board_add_garbage_rows(&board, 2, 4), "Nothing is pushed off the top");
+    TEST_ASSERT_EQUAL(PIECE_T, game_board_get_cell_type(&board, 3, 17), "Bottom cell moved up two rows");
+    TEST_ASSERT_EQUAL(PIECE_L, game_board_get_cell_type(&board, 0, 8), "Upper cell moved up two rows");
+    
+    board_row_t garbage_row = BOARD_ROW_MASK(10) & ~((board_row_t)1 << 4);
+    TEST_ASSERT(board.rows[18] == garbage_row && board.rows[19] == garbage_row, "Garbage rows leave the hole open");
+    TEST_ASSERT_EQUAL(BOARD_CELL_GARBAGE, game_board_get_cell(&board, 0, 19), "Garbage cells hold the garbage type");
+    TEST_ASSERT_EQUAL(BOARD_CELL_GARBAGE_TYPE, game_board_get_cell_type(&board, 9, 18),
+                      "A garbage cell doesn't read as empty");
+    TEST_ASSERT_EQUAL(BOARD_CELL_EMPTY, game_board_get_cell(&board, 4, 19), "Hole cell is empty");
+    TEST_ASSERT_EQUAL(0, game_board_count_lines(game_board_find_complete_lines(&board)), "Garbage rows are not complete");
+    
+    game_board_set_cell(&board, 5, 0, PIECE_T, BOARD_CELL_LOCKED);
+    TEST_ASSERT(game_board_add_garbage_rows(&board, 1, 14), "Cells pushed off the top are reported");
+    TEST_ASSERT(!game_board_is_cell_filled(&board, 4, 19), "Hole column wraps around the width");
+}
+
+// Test FIFO order and the capacity limit of the garbage queue
+void test_garbage_queue_fifo(void) {
+    garbage_queue_t queue;
+    garbage_queue_init(&queue);
+    
+    garbage_message_t message;
+    TEST_ASSERT(!garbage_queue_peek(&queue, &message), "New queue is empty");
+    
+    int pushed = 0;
+    for (int i = 0; i < GARBAGE_QUEUE_CAPACITY + 1; i++) {
+        message.apply_tick = (uint32_t)i;
+        message.rows = (uint8_t)(i % 5 + 1);
+        pushed += garbage_queue_push(&queue, &message) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL(GARBAGE_QUEUE_CAPACITY, pushed, "Queue holds exactly its capacity");
+    
+    TEST_ASSERT(garbage_queue_peek(&queue, &message) && message.apply_tick == 0, "Peek shows the oldest message");
+    TEST_ASSERT(garbage_queue_pop(&queue, &message) && message.apply_tick == 0, "Peek doesn't remove the message");
+    TEST_ASSERT(garbage_queue_pop(&queue, &message) && message.apply_tick == 1, "Messages come out in order");
+    
+    message.apply_tick = 100;
+    TEST_ASSERT(garbage_queue_push(&queue, &message), "Popping frees a slot");
+    
+    uint32_t last_tick = 0;
+    while (garbage_queue_pop(&queue, &message)) {
+        last_tick = message.apply_tick;
+    }
+    TEST_ASSERT_EQUAL(100, (int)last_tick, "Wrapped message comes out last");
+}
+
+// Test that received garbage waits for the next lock that clears nothing
+void test_sim_inserts_pending_garbage(void) {
+    game_config_t config;
+    test_make_instant_lock_config(&config, 10, 20);
+    
+    blocktris_sim_t sim;
+    blocktris_sim_init(&sim, &config, 1234);
+    blocktris_sim_receive_garbage(&sim, 3);
+    TEST_ASSERT_EQUAL(3, sim.garbage_pending, "Garbage is pending until a piece locks");
+    TEST_ASSERT_EQUAL(0, (int)sim.board.rows[19], "Board is untouched before the lock");
+    
+    TEST_ASSERT_EQUAL(0, blocktris_sim_step(&sim, SIM_INPUT_HARD_DROP), "Lock without clears sends nothing");
+    TEST_ASSERT_EQUAL(0, sim.garbage_pending, "Pending garbage was inserted");
+    for (int y = 17; y < 20; y++) {
+        int garbage_cells = 0;
+        for (int x = 0; x < 10; x++) {
+            garbage_cells += game_board_get_cell_type(&sim.board, x, y) == BOARD_CELL_GARBAGE_TYPE ? 1 : 0;
+        }
+        TEST_ASSERT_EQUAL(9, garbage_cells, "Each garbage row has a single hole");
+    }
+    
+    TEST_ASSERT_EQUAL(0, blocktris_sim_garbage_for_lines(1), "Singles send no garbage");
+    TEST_ASSERT_EQUAL(4, blocktris_sim_garbage_for_lines(4), "Four lines send four rows");
+    TEST_ASSERT_EQUAL(7, blocktris_sim_garbage_for_lines(7), "Large clears send one row per line");
+}
+
+/**
+ * Greedy test player: tries every rotation and column on a copy of the
+ * simulation and plays the placement that clears lines while leaving few
+ * holes and a low stack. Emits one action per tick, ending each plan with a hard drop.
+ */
+typedef struct {
+    sim_input_t steps[16];
+    int count;
+    int next;
+} test_bot_t;
+
+static int stack_height(const game_board_t *board) {
+    for (int y = 0; y < board->height; y++) {
+        if (board->rows[y]) {
+            return board->height - y;
+        }
+    }
+    return 0;
+}
+
+// Empty cells with a filled cell somewhere above them
+static int count_holes(const game_board_t *board) {
+    board_row_t covered = 0;
+    int holes = 0;
+    for (int y = 0; y < board->height; y++) {
+        holes += game_board_count_lines(covered & ~board->rows[y]);
+        covered |= board->rows[y];
+    }
+    return holes;
+}
+
+static int plan_placement(test_bot_t *bot, const blocktris_sim_t *sim, int rotations, int dx) {
+    bot->count = 0;
+    for (int r = 0; r < rotations; r++) {
+        bot->steps[bot->count++] = SIM_INPUT_ROTATE_CW;
+    }
+    for (int i = 0; i < (dx < 0 ? -dx : dx); i++) {
+        bot->steps[bot->count++] = dx < 0 ? SIM_INPUT_LEFT : SIM_INPUT_RIGHT;
+    }
+    bot->steps[bot->count++] = SIM_INPUT_HARD_DROP;
+    bot->next = 0;
+    
+    // Score the plan on a scratch copy
+    static blocktris_sim_t scratch;
+    blocktris_sim_copy(&scratch, sim);
+    for (int i = 0; i < bot->count; i++) {
+        blocktris_sim_step(&scratch, bot->steps[i]);
+    }
+    if (scratch.game_over) {
+        return -100000;
+    }
+    return (scratch.lines_cleared - sim->lines_cleared) * 100 - count_holes(&scratch.board) * 40 -
+           stack_height(&scratch.board) * 5;
+}
+
+static sim_input_t bot_next_input(test_bot_t *bot, const blocktris_sim_t *sim) {
+    if (bot->next >= bot->count) {
+        int best_score = 0;
+        int best_rotations = 0;
+        int best_dx = 0;
+        bool found = false;
+        for (int r = 0; r < 4; r++) {
+            for (int dx = -sim->board.width; dx <= sim->board.width; dx++) {
+                int score = plan_placement(bot, sim, r, dx);
+                if (!found || score > best_score) {
+                    best_score = score;
+                    best_rotations = r;
+                    best_dx = dx;
+                    found = true;
+                }
+            }
+        }
+        plan_placement(bot, sim, best_rotations, best_dx);
+    }
+    
+    return bot->steps[bot->next++];
+}
+
+// Step both players in batches, choosing which player runs each batch first
+static void play_match(versus_match_t *match, bool second_player_first) {
+    test_bot_t bots[VERSUS_PLAYERS];
+    memset(bots, 0, sizeof(bots));
+    
+    for (int batch = 0; batch < 300 && versus_match_winner(match) == VERSUS_NO_WINNER; batch++) {
+        int ticks = batch % MAX_SIM_TICKS_PER_FRAME + 1;
+        
+        for (int n = 0; n < VERSUS_PLAYERS; n++) {
+            int p = second_player_first ? VERSUS_PLAYERS - 1 - n : n;
+            for (int t = 0; t < ticks; t++) {
+                versus_match_step_player(match, p, bot_next_input(&bots[p], &match->players[p].sim));
+            }
+        }
+    }
+}
+
+// Test that the match result doesn't depend on which player's batch runs first
+void test_versus_match_step_order_independent(void) {
+    game_config_t config;
+    test_make_instant_lock_config(&config, 8, 24); // Narrow board so lines (and garbage) come quickly
+    
+    static versus_match_t first;
+    static versus_match_t second;
+    versus_match_init(&first, &config, 99);
+    versus_match_init(&second, &config, 99);
+    
+    play_match(&first, false);
+    play_match(&second, true);
+    
+    int sent = first.players[0].sim.garbage_sent + first.players[1].sim.garbage_sent;
+    TEST_ASSERT(sent > 0, "Players exchanged garbage");
+    
+    bool same = true;
+    for (int p = 0; p < VERSUS_PLAYERS; p++) {
+        const blocktris_sim_t *a = &first.players[p].sim;
+        const blocktris_sim_t *b = &second.players[p].sim;
+        same = same && boards_equal(&a->board, &b->board) && a->tick == b->tick && a->score == b->score &&
+               a->garbage_pending == b->garbage_pending && a->game_over == b->game_over;
+    }
+    TEST_ASSERT(same, "Both step orders give the same match");
+    TEST_ASSERT_EQUAL(versus_match_winner(&first), versus_match_winner(&second), "Same winner either way");
+}
+
+// Test that a copied match carries on exactly like the original
+void test_versus_match_copy(void) {
+    game_config_t config;
+    test_make_instant_lock_config(&config, 8, 24);
+    
+    static versus_match_t match;
+    static versus_match_t copy;
+    versus_match_init(&match, &config, 7);
+    for (int t = 0; t < 400; t++) {
+        versus_match_step_player(&match, 0, t % 3 == 0 ? SIM_INPUT_HARD_DROP : 0);
+        versus_match_step_player(&match, 1, t % 5 == 0 ? SIM_INPUT_HARD_DROP : SIM_INPUT_LEFT);
+    }
+    
+    memset(&copy, 0xA5, sizeof(copy));
+    versus_match_copy(&copy, &match);
+    TEST_ASSERT_EQUAL(versus_match_checksum(&match), versus_match_checksum(&copy), "The copy has the same state");
+    
+    for (int t = 0; t < 200; t++) {
+        for (int p = 0; p < VERSUS_PLAYERS; p++) {
+            versus_match_step_player(&match, p, t % 4 == 0 ? SIM_INPUT_HARD_DROP : SIM_INPUT_ROTATE_CW);
+            versus_match_step_player(&copy, p, t % 4 == 0 ? SIM_INPUT_HARD_DROP : SIM_INPUT_ROTATE_CW);
+        }
+    }
+    TEST_ASSERT_EQUAL(versus_match_checksum(&match), versus_match_checksum(&copy), "The copy plays on identically");
+    TEST_ASSERT(boards_equal(&match.players[1].sim.board, &copy.players[1].sim.board), "The boards still match");
+}
+
+// Main versus test runner
+void run_versus_tests(void) {
+    printf("\n=== Versus Tests ===\n\n");
+    
+    RUN_TEST(test_garbage_rows_shift_stack);
+    RUN_TEST(test_garbage_queue_fifo);
+    RUN_TEST(test_sim_inserts_pending_garbage);
+    RUN_TEST(test_versus_match_step_order_independent);
+    RUN_TEST(test_versus_match_copy);
+}
@@ -0,0 +1,19 @@
+/**
+ * @file test_versus.h
+ * @brief Header for versus mode tests (garbage rows, garbage queue, match)
+ */
+
+#ifndef TEST_VERSUS_H
+#define TEST_VERSUS_H
+
+// Test function declarations
+void test_garbage_rows_shift_stack(void);
+void test_garbage_queue_fifo(void);
+void test_sim_inserts_pending_garbage(void);
+void test_versus_match_step_order_independent(void);
+void test_versus_match_copy(void);
+
+// Main test runner function
+void run_versus_tests(void);
+
+#endif // TEST_VERSUS_H
@@ -1,8 +1,16 @@
 #include "../test_framework.h"
 #include "../../game/src/main/constants.h"
+#include "../../game/src/main/game_layout.h"
 #include "test_window_dimensions.h"
 #include <stdlib.h>
 
+// Lay the board out in the window opened on a screen, as the game does at launch
+static void layout_for_screen(game_layout_t *layout, int screen_width, int screen_height) {
+    int width, height;
+    game_layout_window_size(DEFAULT_BOARD_WIDTH, DEFAULT_BOARD_HEIGHT, screen_width, screen_height, &width, &height);
+    game_layout_calculate(layout, DEFAULT_BOARD_WIDTH, DEFAULT_BOARD_HEIGHT, width, height);
+}
+
 // Test that validates window width calculation
 void test_window_width_calculation(void) {
     // Use a standard test screen size for calculation
@@ -10,12 +18,14 @@ void test_window_width_calculation(void) {
     int test_screen_height = 1080;
     
     // Calculate window dimensions using the same logic as the game
-    calculate_window_dimensions(test_screen_width, test_screen_height);
+    game_layout_t layout;
+    layout_for_screen(&layout, test_screen_width, test_screen_height);
+    int window_width = layout.width;
     
     // Calculate expected components
-    int expected_field_width = BOARD_WIDTH * cell_size;
-    int expected_ui_panel_width = cell_size * 7;  // As set in constants.c
-    int expected_margin_space = cell_size * 3;    // 3 margins as per calculation
+    int expected_field_width = DEFAULT_BOARD_WIDTH * layout.cell_size;
+    int expected_ui_panel_width = layout.cell_size * 7;  // As set in game_layout.c
+    int expected_margin_space = layout.cell_size * 3;    // 3 margins as per calculation
     
     // Calculate expected total with 5% tolerance
     int expected_base_width = expected_field_width + expected_ui_panel_width + expected_margin_space;
@@ -39,39 +49,82 @@ void test_window_width_calculation(void) {
 // Test specific dimension component calculations
 void test_window_component_calculation(void) {
     // Use standard test screen dimensions
-    calculate_window_dimensions(1920, 1080);
+    game_layout_t layout;
+    layout_for_screen(&layout, 1920, 1080);
     
     // Verify field width matches board dimensions
-    int expected_field_width = BOARD_WIDTH * cell_size;
-    TEST_ASSERT_EQUAL(expected_field_width, field_width,
+    int expected_field_width = DEFAULT_BOARD_WIDTH * layout.cell_size;
+    TEST_ASSERT_EQUAL(expected_field_width, layout.field_width,
                      "Field width calculation matches board dimensions");
     
     // Verify UI panel width is proportional to cell size
-    int expected_ui_width = cell_size * 7;
-    TEST_ASSERT_EQUAL(expected_ui_width, ui_panel_width,
+    int expected_ui_width = layout.cell_size * 7;
+    TEST_ASSERT_EQUAL(expected_ui_width, layout.ui_panel_width,
                      "UI panel width calculation correct");
     
     // Verify total window width calculation
-    int calculated_width = field_width + ui_panel_width + (ui_margin * 3);
-    TEST_ASSERT_EQUAL(calculated_width, window_width,
+    int calculated_width = layout.field_width + layout.ui_panel_width + (layout.ui_margin * 3);
+    TEST_ASSERT_EQUAL(calculated_width, layout.width,
                      "Window width calculation formula correct");
 }
 
 // Test that different screen sizes produce reasonable window widths
 void test_window_scaling(void) {
     // Test with smaller screen
-    calculate_window_dimensions(1366, 768);
-    int small_screen_width = window_width;
+    game_layout_t layout;
+    layout_for_screen(&layout, 1366, 768);
+    int small_screen_width = layout.width;
     
     // Test with larger screen  
-    calculate_window_dimensions(2560, 1440);
-    int large_screen_width = window_width;
+    layout_for_screen(&layout, 2560, 1440);
+    int large_screen_width = layout.width;
     
     // Verify scaling is reasonable (larger screen should have larger window)
     TEST_ASSERT(large_screen_width > small_screen_width,
                 "Window width scales appropriately with screen size");
 }
 
+// Test that a resized window is laid out again, with the board centred in it
+void test_window_layout_resize(void) {
+    // A 10x20 board on an 800x500 screen opens a 400x450 window with 20 pixel cells
+    game_layout_t layout;
+    int width, height;
+    game_layout_window_size(10, 20, 800, 500, &width, &height);
+    game_layout_calculate(&layout, 10, 20, width, height);
+    TEST_ASSERT(layout.width == 400 && layout.height == 450 && layout.cell_size == 20,
+                "The launch layout matches the window opened for it");
+    TEST_ASSERT_EQUAL(layout.ui_margin, layout.board_offset_x, "The content fills the window it was sized for");
+    
+    // Twice the pixels, as after a move to a high-density display
+    game_layout_calculate(&layout, 10, 20, 800, 900);
+    TEST_ASSERT_EQUAL(40, layout.cell_size, "Twice the drawable size doubles the cells");
+    TEST_ASSERT_EQUAL(layout.height, layout.board_offset_y * 2 + layout.field_height,
+                      "The board is centred vertically");
+    
+    // Wider than the content needs: the spare width is split on either side
+    game_layout_calculate(&layout, 10, 20, 1000, 450);
+    int content_width = layout.field_width + layout.ui_panel_width + layout.ui_margin * 3;
+    int left = layout.board_offset_x - layout.ui_margin;
+    TEST_ASSERT_EQUAL(20, layout.cell_size, "Extra width alone doesn't grow the cells");
+    TEST_ASSERT(left > 0 && abs(layout.width - content_width - left * 2) <= 1, "The content is centred horizontally");
+    
+    // Too small for anything: the cells stop shrinking
+    game_layout_calculate(&layout, 10, 20, 10, 10);
+    TEST_ASSERT_EQUAL(MIN_LAYOUT_CELL_SIZE, layout.cell_size, "Cells never get smaller than the minimum");
+}
+
+// Test that layouts are independent of each other
+void test_window_layout_independent(void) {
+    game_layout_t small, large;
+    game_layout_calculate(&small, 10, 20, 400, 450);
+    game_layout_calculate(&large, 20, 40, 1600, 1000);
+    
+    TEST_ASSERT(small.board_width == 10 && large.board_width == 20, "Each layout keeps its own board");
+    TEST_ASSERT(small.cell_size != large.cell_size, "Each layout has its own cell size");
+    TEST_ASSERT_EQUAL(small.board_offset_x + small.field_width + small.ui_margin, NEXT_PIECE_X(&small),
+                      "Side panel positions follow the layout they're given");
+}
+
 // Main test runner for window dimension tests
 void run_window_dimension_tests(void) {
     printf("\n=== Window Dimension Validation Tests ===\n\n");
@@ -79,4 +132,6 @@ void run_window_dimension_tests(void) {
     RUN_TEST(test_window_width_calculation);
     RUN_TEST(test_window_component_calculation); 
     RUN_TEST(test_window_scaling);
+    RUN_TEST(test_window_layout_resize);
+    RUN_TEST(test_window_layout_independent);
 }
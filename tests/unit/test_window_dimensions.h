@@ -10,6 +10,8 @@
 void test_window_width_calculation(void);
 void test_window_component_calculation(void);
 void test_window_scaling(void);
+void test_window_layout_resize(void);
+void test_window_layout_independent(void);
 
 // Main test runner for window dimension tests
 void run_window_dimension_tests(void);